@@ -20,6 +20,10 @@
  * THE SOFTWARE.
  */
 #include "BokehAlgorithm.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include "ConfigParser.h"
 #include "Log.h"
 
@@ -39,6 +43,27 @@ BokehAlgorithm::BokehAlgorithm() : AlgoBase(BOKEH_NAME) {
   if (parser.getErrorCode() == 0) {
     LOG(VERBOSE, ALGOBASE, "BOKEH Algo Version: %s", Version.c_str());
   }
+
+  auto readInt = [&parser](const std::string& key, int& value) {
+    if (!parser.getValue(key).empty()) {
+      value = parser.getIntValue(key);
+    }
+  };
+  readInt("Downscale", mDepthConfig.downscale);
+  readInt("MaxDisparity", mDepthConfig.maxDisparity);
+  readInt("BlockSize", mDepthConfig.blockSize);
+  readInt("TextureLimit", mDepthConfig.textureLimit);
+  readInt("ReseedInterval", mDepthConfig.reseedInterval);
+  readInt("EdgeSigma", mDepthConfig.edgeSigma);
+  readInt("FocusDisparity", mFocusDisparity);
+  readInt("DumpInterval", mDumpInterval);
+  readInt("LatencyBudgetMs", mLatencyBudgetMs);
+
+  BokehBlurConfig blurConfig;
+  readInt("MaxBlurRadius", blurConfig.maxRadius);
+  readInt("BlurStrength", blurConfig.strength);
+  readInt("BlurLayers", blurConfig.layers);
+  mBlur = std::make_unique<BokehBlur>(blurConfig);
 }
 
 /**
@@ -68,81 +93,78 @@ AlgoBase::AlgoStatus BokehAlgorithm::Open() {
 AlgoBase::AlgoStatus BokehAlgorithm::Process(std::shared_ptr<AlgoRequest> req) {
   std::lock_guard<std::mutex> lock(mutex_);
 
-  if (!req || req->GetImageCount() < 2) {
+  if (!req) {
     SetStatus(AlgoStatus::FAILURE);
     return GetAlgoStatus();
   }
 
-  auto inputImage0 = req->GetImage(0);
-  auto inputImage1 = req->GetImage(1);
-  if (!inputImage0 || !inputImage1) {
+  const size_t count = req->GetImageCount();
+  auto inputImage0   = count > 0 ? req->GetImage(0) : nullptr;
+  auto inputImage1   = count > 1 ? req->GetImage(1) : nullptr;
+  if (count > 0 && !inputImage0) {
     SetStatus(AlgoStatus::FAILURE);
     return GetAlgoStatus();
   }
 
-  const ImageFormat inputFormat0 = inputImage0->GetFormat();
-  const ImageFormat inputFormat1 = inputImage1->GetFormat();
-  const int width                = inputImage0->GetWidth();
-  const int height               = inputImage0->GetHeight();
-  const int reqid                = req->mRequestId;
-
-  if (CanProcessFormat(inputFormat0, inputFormat1)) {
-    // Allocate output buffer for a YUV420 image (Y plane + UV planes)
-    std::vector<unsigned char> outputData(width * height * 3 / 2, 0);
-    LOG(ERROR, ALGOBASE, "Processing Bokeh request ::%d", reqid);
-
-    // Stereo Disparity Map Calculation
-    cv::Mat img0(height, width, CV_8UC1, &inputImage0->GetData()[0]);
-    cv::Mat img1(height, width, CV_8UC1, &inputImage1->GetData()[0]);
-
-    // Convert to grayscale if the images are not already in grayscale
-    cv::Mat gray0, gray1;
-    if (img0.channels() == 3) {
-      cv::cvtColor(img0, gray0, cv::COLOR_BGR2GRAY);
-      cv::cvtColor(img1, gray1, cv::COLOR_BGR2GRAY);
-    } else {
-      gray0 = img0;
-      gray1 = img1;
+  // Without a stereo pair the request, images or none, passes through
+  if (inputImage1 && CanProcessFormat(inputImage0->GetFormat(),
+                                      inputImage1->GetFormat())) {
+    const int width       = inputImage0->GetWidth();
+    const int height      = inputImage0->GetHeight();
+    const int reqid       = req->mRequestId;
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const auto start      = std::chrono::steady_clock::now();
+    // Read only, so the cached pyramids stay valid
+    const ImageData& left = *inputImage0;
+    LOG(VERBOSE, ALGOBASE, "Processing Bokeh request ::%d", reqid);
+
+    auto& state = GetStreamState<BokehStreamState>(req);
+    if (!state.depth) {
+      state.depth = std::make_unique<BokehDepth>(mDepthConfig);
+    }
+
+    // Matched on the luma pyramids, shared with later users of the frames
+    const int level = state.depth->GetDownscale() == 4 ? 2 : 1;
+    std::shared_ptr<const ImageData> leftLow;
+    std::shared_ptr<const ImageData> rightLow;
+    if (!((width | height) & 1) && inputImage1->GetWidth() == width &&
+        inputImage1->GetHeight() == height) {
+      leftLow  = left.Pyramid(level);
+      rightLow = inputImage1->Pyramid(level);
+    }
+    if (!leftLow || !rightLow ||
+        inputImage0->GetDataSize() < lumaSize * 3 / 2 ||
+        inputImage1->GetDataSize() < lumaSize * 3 / 2 ||
+        !state.depth->Compute(left.GetData().data(), leftLow->GetData().data(),
+                              rightLow->GetData().data(), width, height,
+                              state.disparity)) {
+      LOG(ERROR, ALGOBASE, "Invalid stereo pair for request ::%d", reqid);
+      SetStatus(AlgoStatus::FAILURE);
+      return GetAlgoStatus();
+    }
+
+    int focus = mFocusDisparity;
+    if (focus <= 0) {
+      std::vector<size_t> histogram(256, 0);
+      for (unsigned char d : state.disparity) {
+        histogram[d]++;
+      }
+      size_t acc = 0;
+      while (focus < 255 && (acc += histogram[focus]) < lumaSize / 2) {
+        focus++;
+      }
+    }
+
+    // Blur the left (reference) view away from the focus plane
+    std::vector<unsigned char> outputData;
+    mBlur->Apply(left.GetData().data(), state.disparity.data(), width, height,
+                 focus, outputData);
+
+    if (mDumpInterval > 0 && state.frameCount % mDumpInterval == 0) {
+      DumpDisparityMap(state.disparity, width, height, reqid);
     }
+    state.frameCount++;
 
-    // Compute disparity using StereoBM (adjust parameters as needed)
-    cv::Ptr<cv::StereoBM> stereoBM = cv::StereoBM::create(64, 15);
-    cv::Mat disparity;
-    stereoBM->compute(gray0, gray1, disparity);
-
-    // Normalize disparity for visualization
-    cv::Mat dispNorm;
-    cv::normalize(disparity, dispNorm, 0, 255, cv::NORM_MINMAX, CV_8UC1);
-    // Normalize and convert to float for depth computation
-    cv::normalize(disparity, disparity, 0, 255, cv::NORM_MINMAX);
-    disparity.convertTo(disparity, CV_32F);
-
-    // Compute depth map from disparity (avoid division by zero)
-    const float baseline    = 0.1f;    // Example baseline in meters
-    const float focalLength = 800.0f;  // Example focal length in pixels
-    cv::Mat depthMap        = baseline * focalLength / (disparity + 1e-6);
-
-    // Apply threshold to create a depth mask (adjust threshold value as needed)
-    cv::Mat depthMask;
-    cv::threshold(depthMap, depthMask, 0.1, 255, cv::THRESH_BINARY);
-    depthMask.convertTo(depthMask,
-                        CV_8U);  // Convert to 8-bit for display/storage
-
-    // Fill outputData:
-    // For a YUV420 image, the first width*height bytes are the Y channel.
-    // We copy the depth mask into the Y plane.
-    unsigned char* yPlane = outputData.data();
-    std::memcpy(yPlane, depthMask.data, width * height);
-
-    // The remaining bytes are for the U and V planes.
-    // We'll fill them with 128 (neutral chroma) so that the image appears grayscale.
-    unsigned char* uvPlane = outputData.data() + width * height;
-    std::fill(uvPlane, uvPlane + (width * height / 2), 128);
-
-    // Dump debug images using the request id for unique filenames
-    //DumpDepthMask(depthMask, width, height, reqid);
-    DumpDisparityMap(dispNorm, width, height, reqid);
-    //DumpDepthMap(depthMap, width, height, reqid);
     // Replace input image with processed output
     req->ClearImages();
     if (req->AddImage(ImageFormat::YUV420, width, height,
@@ -150,11 +172,20 @@ AlgoBase::AlgoStatus BokehAlgorithm::Process(std::shared_ptr<AlgoRequest> req) {
       LOG(ERROR, ALGOBASE, "Error Filling Output Data");
       SetStatus(AlgoStatus::FAILURE);
     }
+
+    const int elapsedMs = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    req->mMetadata.SetMetadata(MetaId::BOKEH_LATENCY_MS, elapsedMs);
+    if (mLatencyBudgetMs > 0 && elapsedMs > mLatencyBudgetMs) {
+      LOG(WARNING, ALGOBASE, "Bokeh request ::%d took %d ms, budget %d ms",
+          reqid, elapsedMs, mLatencyBudgetMs);
+    }
   }
 
   int reqdone = 0x00;
-  if (req &&
-      (0 == req->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone))) {
+  if (0 == req->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone)) {
     reqdone |= ALGO_MASK(mAlgoId);
     req->mMetadata.SetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone);
   }
@@ -162,34 +193,27 @@ AlgoBase::AlgoStatus BokehAlgorithm::Process(std::shared_ptr<AlgoRequest> req) {
   return GetAlgoStatus();
 }
 
-// Function to dump depth mask for debugging with process count
-void BokehAlgorithm::DumpDepthMask(const cv::Mat& depthMask, int width,
-                                   int height, int processCount) {
-  (void)width;
-  (void)height;
-  std::string filename =
-      "dump/depth_mask_" + std::to_string(processCount) + ".png";
-  cv::imwrite(filename, depthMask);  // Save as an image file
-}
-
-// Function to dump disparity map for debugging with process count
-void BokehAlgorithm::DumpDisparityMap(const cv::Mat& disparityMap, int width,
-                                      int height, int processCount) {
-  (void)width;
-  (void)height;
-  std::string filename =
-      "dump/disparity_map_" + std::to_string(processCount) + ".png";
-  cv::imwrite(filename, disparityMap);  // Save as an image file
-}
-
-// Optionally, you can also dump depth map with process count
-void BokehAlgorithm::DumpDepthMap(const cv::Mat& depthMap, int width,
-                                  int height, int processCount) {
-  (void)width;
-  (void)height;
+/**
+ * @brief Write a disparity map to dump/ as a binary PGM
+ *
+ * @param disparity
+ * @param width
+ * @param height
+ * @param processCount
+ */
+void BokehAlgorithm::DumpDisparityMap(
+    const std::vector<unsigned char>& disparity, int width, int height,
+    int processCount) {
   std::string filename =
-      "dump/depth_map_" + std::to_string(processCount) + ".png";
-  cv::imwrite(filename, depthMap);  // Save as an image file
+      "dump/disparity_map_" + std::to_string(processCount) + ".pgm";
+  std::ofstream file(filename, std::ios::binary);
+  if (!file) {
+    LOG(ERROR, ALGOBASE, "Failed to open %s", filename.c_str());
+    return;
+  }
+  file << "P5\n" << width << " " << height << "\n255\n";
+  file.write(reinterpret_cast<const char*>(disparity.data()),
+             static_cast<std::streamsize>(width) * height);
 }
 
 /**
@@ -22,13 +22,24 @@
 #ifndef BOKEH_ALGORITHM_H
 #define BOKEH_ALGORITHM_H
 
-#include <opencv2/opencv.hpp>
-#include <opencv2/stereo.hpp>
+#include <memory>
 #include <vector>
 #include "AlgoBase.h"
+#include "BokehBlur.h"
+#include "BokehDepth.h"
 
 const char* BOKEH_NAME = "BokehAlgorithm";
 
+/**
+ * @brief Matcher and disparity of one stereo stream, the search range
+ * follows the scene of that stream only
+ */
+struct BokehStreamState : AlgoBase::StreamState {
+  std::unique_ptr<BokehDepth> depth;
+  std::vector<unsigned char> disparity;
+  int frameCount = 0;
+};
+
 /**
  * @brief BokehAlgorithm class derived from AlgoBase to perform BOKEH-specific
  * operations.
@@ -71,19 +82,25 @@ class BokehAlgorithm : public AlgoBase {
    * @return int
    */
   int GetTimeout() override;
-  void DumpDepthMask(const cv::Mat& depthMask, int width, int height,
-                     int processCount);
 
-  // Function to dump disparity map for debugging with process count
-  void DumpDisparityMap(const cv::Mat& disparityMap, int width, int height,
-                        int processCount);
-
-  // Optionally, you can also dump depth map with process count
-  void DumpDepthMap(const cv::Mat& depthMap, int width, int height,
-                    int processCount);
+  /**
+   * @brief Write a disparity map to dump/ as a binary PGM
+   *
+   * @param disparity
+   * @param width
+   * @param height
+   * @param processCount
+   */
+  void DumpDisparityMap(const std::vector<unsigned char>& disparity, int width,
+                        int height, int processCount);
 
  private:
   mutable std::mutex mutex_;  // Mutex to protect the shared state
+  BokehDepthConfig mDepthConfig;
+  std::unique_ptr<BokehBlur> mBlur;
+  int mFocusDisparity  = 0;  // 0 picks the median disparity
+  int mDumpInterval    = 0;  // 0 disables dumps
+  int mLatencyBudgetMs = 0;  // 0 disables the latency check
 };
 
 /**
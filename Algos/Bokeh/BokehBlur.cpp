@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "BokehBlur.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "TileExecutor.h"
+
+#define BOKEH_BLUR_BAND 32  // Rows or columns per parallel task
+#define BOKEH_BOX_PASSES 3  // Box passes approximating a Gaussian
+
+/**
+ * @brief Bilinear taps from a grid reduced by factor to the output grid,
+ * sample centres aligned, 8 fractional bits
+ */
+struct BlurTaps {
+  std::vector<int> i0;
+  std::vector<int> i1;
+  std::vector<int> frac;
+
+  BlurTaps(int outSize, int inSize, int factor)
+      : i0(outSize), i1(outSize), frac(outSize) {
+    for (int i = 0; i < outSize; i++) {
+      const int pos  = ((2 * i + 1) * 128) / factor - 128;
+      const int base = pos >> 8;
+      i0[i]          = std::max(0, std::min(base, inSize - 1));
+      i1[i]          = std::max(0, std::min(base + 1, inSize - 1));
+      frac[i]        = pos & 255;
+    }
+  }
+};
+
+/**
+ * @brief Box average of a plane by an integer factor
+ *
+ * @param src
+ * @param srcWidth
+ * @param factor
+ * @param width destination width
+ * @param height destination height
+ * @param dst
+ */
+static void AveragePlane(const unsigned char* src, int srcWidth, int factor,
+                         int width, int height, unsigned char* dst) {
+  if (factor == 2) {
+    for (int y = 0; y < height; y++) {
+      const unsigned char* r0 = src + (2 * y) * srcWidth;
+      const unsigned char* r1 = r0 + srcWidth;
+      for (int x = 0; x < width; x++) {
+        dst[y * width + x] = static_cast<unsigned char>(
+            (r0[2 * x] + r0[2 * x + 1] + r1[2 * x] + r1[2 * x + 1] + 2) >> 2);
+      }
+    }
+    return;
+  }
+  const int area = factor * factor;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int sum = 0;
+      for (int dy = 0; dy < factor; dy++) {
+        const unsigned char* row = src + (y * factor + dy) * srcWidth;
+        for (int dx = 0; dx < factor; dx++) {
+          sum += row[x * factor + dx];
+        }
+      }
+      dst[y * width + x] = static_cast<unsigned char>((sum + area / 2) / area);
+    }
+  }
+}
+
+/**
+ * @brief Construct a new Bokeh Blur:: Bokeh Blur object
+ *
+ * @param config
+ */
+BokehBlur::BokehBlur(const BokehBlurConfig& config) : mConfig(config) {
+  mConfig.maxRadius = std::max(1, std::min(mConfig.maxRadius, 255));
+  mConfig.strength  = std::max(0, mConfig.strength);
+  mConfig.layers    = std::max(2, std::min(mConfig.layers, 16));
+  if (mConfig.downscale != 2 && mConfig.downscale != 4) {
+    mConfig.downscale = 4;
+  }
+}
+
+/**
+ * @brief Blur radius per pixel at full, chroma and layer resolution
+ *
+ * @param disparity
+ * @param width
+ * @param height
+ * @param focus
+ */
+void BokehBlur::BuildCoc(const unsigned char* disparity, int width, int height,
+                         int focus) {
+  const size_t size = static_cast<size_t>(width) * height;
+  mCoc.resize(size);
+  mMaxCoc = 0;
+  for (size_t i = 0; i < size; i++) {
+    const int coc = std::min(mConfig.maxRadius,
+                             std::abs(disparity[i] - focus) * mConfig.strength);
+    mCoc[i]       = static_cast<unsigned char>(coc);
+    mMaxCoc       = std::max(mMaxCoc, coc);
+  }
+
+  mCocHalf.resize(size / 4);
+  AveragePlane(mCoc.data(), width, 2, width / 2, height / 2, mCocHalf.data());
+  mCocLow.resize(static_cast<size_t>(mLowWidth) * mLowHeight);
+  AveragePlane(mCocHalf.data(), width / 2, mConfig.downscale / 2, mLowWidth,
+               mLowHeight, mCocLow.data());
+}
+
+/**
+ * @brief Sharp layer 0 at layer resolution
+ *
+ * @param yuv
+ * @param width
+ * @param height
+ */
+void BokehBlur::Reduce(const unsigned char* yuv, int width, int height) {
+  const size_t lowSize  = static_cast<size_t>(mLowWidth) * mLowHeight;
+  const size_t lumaSize = static_cast<size_t>(width) * height;
+  const int factor      = mConfig.downscale;
+  for (int p = 0; p < 3; p++) {
+    mLayers[p].resize(lowSize);
+  }
+  AveragePlane(yuv, width, factor, mLowWidth, mLowHeight, mLayers[0].data());
+  AveragePlane(yuv + lumaSize, width / 2, factor / 2, mLowWidth, mLowHeight,
+               mLayers[1].data());
+  AveragePlane(yuv + lumaSize * 5 / 4, width / 2, factor / 2, mLowWidth,
+               mLowHeight, mLayers[2].data());
+}
+
+/**
+ * @brief Separable box blur, applied BOKEH_BOX_PASSES times, of the first
+ * planes of mPlanes. Edges replicate.
+ *
+ * @param planes
+ * @param radius
+ */
+void BokehBlur::BoxBlur(int planes, int radius) {
+  const int w         = mLowWidth;
+  const int h         = mLowHeight;
+  const float inv     = 1.0f / (2 * radius + 1);
+  const int rowBands  = (h + BOKEH_BLUR_BAND - 1) / BOKEH_BLUR_BAND;
+  const int colBands  = (w + BOKEH_BLUR_BAND - 1) / BOKEH_BLUR_BAND;
+  auto clampX         = [w](int x) { return std::max(0, std::min(x, w - 1)); };
+  auto clampY         = [h](int y) { return std::max(0, std::min(y, h - 1)); };
+  TileExecutor& tiles = TileExecutor::GetInstance();
+
+  // Columns where the window is inside the row and needs no clamping
+  const int inner = std::min(w, radius);
+  const int outer = std::max(inner, w - radius - 1);
+
+  for (int pass = 0; pass < BOKEH_BOX_PASSES; pass++) {
+    tiles.Run(planes * rowBands, [&](int task) {
+      const int plane = task / rowBands;
+      const int y0    = (task % rowBands) * BOKEH_BLUR_BAND;
+      const int y1    = std::min(h, y0 + BOKEH_BLUR_BAND);
+      for (int y = y0; y < y1; y++) {
+        const float* src = &mPlanes[plane][y * w];
+        float* dst       = &mScratch[plane][y * w];
+        float acc        = 0.0f;
+        for (int x = -radius; x <= radius; x++) {
+          acc += src[clampX(x)];
+        }
+        int x = 0;
+        for (; x < inner; x++) {
+          dst[x] = acc * inv;
+          acc += src[clampX(x + radius + 1)] - src[0];
+        }
+        for (; x < outer; x++) {
+          dst[x] = acc * inv;
+          acc += src[x + radius + 1] - src[x - radius];
+        }
+        for (; x < w; x++) {
+          dst[x] = acc * inv;
+          acc += src[w - 1] - src[clampX(x - radius)];
+        }
+      }
+    });
+
+    tiles.Run(planes * colBands, [&](int task) {
+      const int plane  = task / colBands;
+      const int x0     = (task % colBands) * BOKEH_BLUR_BAND;
+      const int n      = std::min(w, x0 + BOKEH_BLUR_BAND) - x0;
+      const float* src = &mScratch[plane][x0];
+      float* dst       = &mPlanes[plane][x0];
+      float acc[BOKEH_BLUR_BAND] = {0.0f};
+      for (int y = -radius; y <= radius; y++) {
+        const float* row = src + clampY(y) * w;
+        for (int x = 0; x < n; x++) {
+          acc[x] += row[x];
+        }
+      }
+      for (int y = 0; y < h; y++) {
+        const float* add = src + clampY(y + radius + 1) * w;
+        const float* sub = src + clampY(y - radius) * w;
+        float* out       = dst + y * w;
+        for (int x = 0; x < n; x++) {
+          out[x] = acc[x] * inv;
+          acc[x] += add[x] - sub[x];
+        }
+      }
+    });
+  }
+}
+
+/**
+ * @brief Blur layer k from the sharp layer 0. Only pixels at least as
+ * blurred as layer k - 1 contribute, the result is normalised by the blurred
+ * weight.
+ *
+ * @param layer
+ */
+void BokehBlur::BlurLayer(int layer) {
+  const size_t size = static_cast<size_t>(mLowWidth) * mLowHeight;
+  const int steps   = mConfig.layers - 1;
+  const int limit   = (layer - 1) * mConfig.maxRadius;
+  for (int p = 0; p < 4; p++) {
+    mPlanes[p].resize(size);
+    mScratch[p].resize(size);
+  }
+  for (size_t i = 0; i < size; i++) {
+    const float weight = mCocLow[i] * steps >= limit ? 1.0f : 0.0f;
+    mPlanes[0][i]      = mLayers[0][i] * weight;
+    mPlanes[1][i]      = mLayers[1][i] * weight;
+    mPlanes[2][i]      = mLayers[2][i] * weight;
+    mPlanes[3][i]      = weight;
+  }
+
+  // Three box passes of radius r give a sigma of about r + 0.5, half the
+  // layer radius at layer resolution
+  const float radius =
+      layer * mConfig.maxRadius / static_cast<float>(steps * mConfig.downscale);
+  BoxBlur(4, std::max(1, static_cast<int>(std::lround(radius / 2.0f))));
+
+  for (int p = 0; p < 3; p++) {
+    std::vector<unsigned char>& dst      = mLayers[layer * 3 + p];
+    const std::vector<unsigned char>& lo = mLayers[(layer - 1) * 3 + p];
+    dst.resize(size);
+    for (size_t i = 0; i < size; i++) {
+      const float weight = mPlanes[3][i];
+      if (weight > 1e-3f) {
+        dst[i] = static_cast<unsigned char>(
+            std::min(255.0f, mPlanes[p][i] / weight + 0.5f));
+      } else {
+        dst[i] = lo[i];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Blend the two layers around each pixel's blur radius, upsampling
+ * the layers bilinearly
+ *
+ * @param yuv
+ * @param width
+ * @param height
+ * @param layerCount
+ * @param output
+ */
+void BokehBlur::Composite(const unsigned char* yuv, int width, int height,
+                          int layerCount,
+                          std::vector<unsigned char>& output) const {
+  const int hw     = width / 2;
+  const int hh     = height / 2;
+  const int steps  = mConfig.layers - 1;
+  const int factor = mConfig.downscale;
+  const BlurTaps lumaX(width, mLowWidth, factor);
+  const BlurTaps lumaY(height, mLowHeight, factor);
+  const BlurTaps chromaX(hw, mLowWidth, factor / 2);
+  const BlurTaps chromaY(hh, mLowHeight, factor / 2);
+
+  // Layer position of each blur radius, 8 fractional bits, and the layers
+  // it reads
+  int position[256];
+  unsigned int reads[256];
+  for (int coc = 0; coc < 256; coc++) {
+    position[coc] = std::min((coc * steps * 256) / mConfig.maxRadius,
+                             (layerCount - 1) * 256);
+    const int k   = position[coc] >> 8;
+    reads[coc]    = (1u << k) | ((position[coc] & 255) ? 2u << k : 0u);
+  }
+
+  // Upsample one row of the layers in use, then blend layer k and k + 1 per
+  // pixel
+  auto blendRow = [&](const unsigned char* src, const unsigned char* coc,
+                      int plane, const BlurTaps& tx, int count, int r0,
+                      int r1, int ay, std::vector<int>& column,
+                      std::vector<unsigned char>& rows, unsigned char* dst) {
+    unsigned int used = 0;
+    for (int x = 0; x < count; x++) {
+      used |= reads[coc[x]];
+    }
+    for (int layer = 1; layer < layerCount; layer++) {
+      if (!(used & (1u << layer))) {
+        continue;
+      }
+      const unsigned char* low = mLayers[layer * 3 + plane].data();
+      for (int x = 0; x < mLowWidth; x++) {
+        column[x] = low[r0 + x] * (256 - ay) + low[r1 + x] * ay;
+      }
+      unsigned char* row = &rows[layer * count];
+      for (int x = 0; x < count; x++) {
+        const int ax = tx.frac[x];
+        row[x]       = static_cast<unsigned char>(
+            (column[tx.i0[x]] * (256 - ax) + column[tx.i1[x]] * ax + 32768) >>
+            16);
+      }
+    }
+    std::copy_n(src, count, rows.begin());
+    for (int x = 0; x < count; x++) {
+      const int p    = position[coc[x]];
+      const int k    = p >> 8;
+      const int frac = p & 255;
+      int value      = rows[k * count + x];
+      if (frac) {
+        value = (value * (256 - frac) + rows[(k + 1) * count + x] * frac +
+                 128) >>
+                8;
+      }
+      dst[x] = static_cast<unsigned char>(value);
+    }
+  };
+
+  const int bands = (hh + BOKEH_BLUR_BAND - 1) / BOKEH_BLUR_BAND;
+  TileExecutor::GetInstance().Run(bands, [&](int band) {
+    const int cy0 = band * BOKEH_BLUR_BAND;
+    const int cy1 = std::min(hh, cy0 + BOKEH_BLUR_BAND);
+    std::vector<int> column(mLowWidth);
+    std::vector<unsigned char> rows(static_cast<size_t>(layerCount) * width);
+    for (int y = 2 * cy0; y < 2 * cy1; y++) {
+      blendRow(yuv + y * width, &mCoc[y * width], 0, lumaX, width,
+               lumaY.i0[y] * mLowWidth, lumaY.i1[y] * mLowWidth, lumaY.frac[y],
+               column, rows, &output[y * width]);
+    }
+
+    for (int plane = 1; plane < 3; plane++) {
+      const size_t offset = static_cast<size_t>(width) * height +
+                            static_cast<size_t>(plane - 1) * hw * hh;
+      for (int y = cy0; y < cy1; y++) {
+        blendRow(yuv + offset + y * hw, &mCocHalf[y * hw], plane, chromaX, hw,
+                 chromaY.i0[y] * mLowWidth, chromaY.i1[y] * mLowWidth,
+                 chromaY.frac[y], column, rows, &output[offset + y * hw]);
+      }
+    }
+  });
+}
+
+/**
+ * @brief Blur a frame
+ *
+ * @param yuv
+ * @param disparity
+ * @param width
+ * @param height
+ * @param focus
+ * @param output
+ */
+void BokehBlur::Apply(const unsigned char* yuv, const unsigned char* disparity,
+                      int width, int height, int focus,
+                      std::vector<unsigned char>& output) {
+  output.resize(static_cast<size_t>(width) * height * 3 / 2);
+  mLowWidth  = width / mConfig.downscale;
+  mLowHeight = height / mConfig.downscale;
+  BuildCoc(disparity, width, height, focus);
+  if (mMaxCoc == 0 || mLowWidth == 0 || mLowHeight == 0) {
+    std::copy(yuv, yuv + output.size(), output.begin());
+    return;
+  }
+
+  // Only the layers reaching the largest blur radius in the frame
+  const int steps      = mConfig.layers - 1;
+  const int layerCount = 1 + (mMaxCoc * steps + mConfig.maxRadius - 1) /
+                                 mConfig.maxRadius;
+  mLayers.resize(static_cast<size_t>(mConfig.layers) * 3);
+  Reduce(yuv, width, height);
+  for (int layer = 1; layer < layerCount; layer++) {
+    BlurLayer(layer);
+  }
+  Composite(yuv, width, height, layerCount, output);
+}
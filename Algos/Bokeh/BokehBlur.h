@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef BOKEH_BLUR_H
+#define BOKEH_BLUR_H
+
+#include <vector>
+
+/**
+ * @brief Tuning of the blur stage, read from BokehAlgorithm.config
+ */
+struct BokehBlurConfig {
+  int maxRadius = 24;  // Largest blur radius, full resolution pixels
+  int strength  = 2;   // Blur radius per pixel of distance from focus
+  int layers    = 4;   // Radius levels including the sharp one
+  int downscale = 4;   // Layers are blurred at 1/2 or 1/4 resolution
+};
+
+/**
+ * @brief Synthetic aperture blur of a YUV420 frame driven by a disparity
+ * map. The circle of confusion of every pixel is quantised into a few
+ * radius layers; each layer is blurred at reduced resolution with separable
+ * box passes, excluding pixels sharper than the layer so in focus subjects
+ * do not bleed into the background, and the layers are blended per pixel by
+ * depth. Buffers are kept across frames.
+ */
+class BokehBlur {
+ public:
+  explicit BokehBlur(const BokehBlurConfig& config);
+
+  /**
+   * @brief Blur a frame
+   *
+   * @param yuv YUV420 input, even width and height
+   * @param disparity full resolution disparity
+   * @param width
+   * @param height
+   * @param focus disparity that stays sharp
+   * @param output YUV420 output
+   */
+  void Apply(const unsigned char* yuv, const unsigned char* disparity,
+             int width, int height, int focus,
+             std::vector<unsigned char>& output);
+
+ private:
+  void BuildCoc(const unsigned char* disparity, int width, int height,
+                int focus);
+  void Reduce(const unsigned char* yuv, int width, int height);
+  void BlurLayer(int layer);
+  void BoxBlur(int planes, int radius);
+  void Composite(const unsigned char* yuv, int width, int height,
+                 int layerCount, std::vector<unsigned char>& output) const;
+
+  BokehBlurConfig mConfig;
+  std::vector<unsigned char> mCoc;      // Full resolution blur radius
+  std::vector<unsigned char> mCocHalf;  // Chroma resolution blur radius
+  std::vector<unsigned char> mCocLow;   // Layer resolution blur radius
+  int mMaxCoc    = 0;
+  int mLowWidth  = 0;
+  int mLowHeight = 0;
+  // Per layer Y, U, V at layer resolution, layer 0 is the sharp frame
+  std::vector<std::vector<unsigned char>> mLayers;
+  std::vector<float> mPlanes[4];  // Weighted Y, U, V and weight
+  std::vector<float> mScratch[4];
+};
+
+#endif  // BOKEH_BLUR_H
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "BokehDepth.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include "TileExecutor.h"
+
+#define BOKEH_BAND_ROWS 32  // Rows per parallel matching / upsampling task
+
+/**
+ * @brief Sliding (2r+1)^2 box sum of per pixel costs over rows [y0, y1).
+ * Rows and columns outside the image replicate the edge. rowOf(y) returns
+ * the cost row y, onRow(y, sums) gets each finished row.
+ *
+ * @param width
+ * @param height
+ * @param y0
+ * @param y1
+ * @param radius
+ * @param column scratch, width entries, radius below 128
+ * @param sums scratch, width entries
+ * @param rowOf
+ * @param onRow
+ */
+template <typename RowOf, typename OnRow>
+static void BoxSumBand(int width, int height, int y0, int y1, int radius,
+                       uint16_t* column, int* sums, RowOf rowOf,
+                       OnRow onRow) {
+  auto clampY = [height](int y) {
+    return std::max(0, std::min(y, height - 1));
+  };
+  // Columns where the window is inside the row and needs no clamping
+  const int inner = std::min(width, radius);
+  const int outer = std::max(inner, width - radius - 1);
+
+  std::fill(column, column + width, 0);
+  for (int y = y0 - radius; y <= y0 + radius; y++) {
+    const unsigned char* row = rowOf(clampY(y));
+    for (int x = 0; x < width; x++) {
+      column[x] = static_cast<uint16_t>(column[x] + row[x]);
+    }
+  }
+  for (int y = y0; y < y1; y++) {
+    if (y > y0) {
+      const unsigned char* add = rowOf(clampY(y + radius));
+      const unsigned char* sub = rowOf(clampY(y - radius - 1));
+      for (int x = 0; x < width; x++) {
+        column[x] = static_cast<uint16_t>(column[x] + add[x] - sub[x]);
+      }
+    }
+    int acc = 0;
+    for (int x = -radius; x <= radius; x++) {
+      acc += column[std::max(0, std::min(x, width - 1))];
+    }
+    int x = 0;
+    for (; x < inner; x++) {
+      sums[x] = acc;
+      acc += column[std::min(x + radius + 1, width - 1)] - column[0];
+    }
+    for (; x < outer; x++) {
+      sums[x] = acc;
+      acc += column[x + radius + 1] - column[x - radius];
+    }
+    for (; x < width; x++) {
+      sums[x] = acc;
+      acc += column[width - 1] - column[std::max(x - radius, 0)];
+    }
+    onRow(y, sums);
+  }
+}
+
+/**
+ * @brief Construct a new Bokeh Depth:: Bokeh Depth object
+ *
+ * @param config
+ */
+BokehDepth::BokehDepth(const BokehDepthConfig& config) : mConfig(config) {
+  if (mConfig.downscale != 2 && mConfig.downscale != 4) {
+    mConfig.downscale = 2;
+  }
+  mConfig.blockSize      = std::max(5, std::min(mConfig.blockSize | 1, 255));
+  mConfig.maxDisparity   = std::max(mConfig.downscale, mConfig.maxDisparity);
+  mConfig.reseedInterval = std::max(1, mConfig.reseedInterval);
+  mConfig.edgeSigma      = std::max(1, mConfig.edgeSigma);
+
+  mRangeWeight.resize(256);
+  const double sigma2 = 2.0 * mConfig.edgeSigma * mConfig.edgeSigma;
+  for (int i = 0; i < 256; i++) {
+    mRangeWeight[i] = static_cast<uint16_t>(
+        std::max(1.0, std::round(256.0 * std::exp(-(i * i) / sigma2))));
+  }
+#ifdef _CV_ENABLED_
+  mStereoBM = cv::StereoBM::create(16, mConfig.blockSize);
+#endif
+}
+
+/**
+ * @brief Block matching over the current search range. Low texture blocks and
+ * pixels with no candidate in range are marked invalid.
+ *
+ */
+void BokehDepth::Match() {
+  const int w = mLowWidth;
+  const int h = mLowHeight;
+  mDisparityLow.assign(static_cast<size_t>(w) * h, 0);
+  mValidLow.assign(static_cast<size_t>(w) * h, 0);
+
+#ifdef _CV_ENABLED_
+  if (mStereoBM) {
+    cv::Mat left(h, w, CV_8UC1, const_cast<unsigned char*>(mLeftLow));
+    cv::Mat right(h, w, CV_8UC1, const_cast<unsigned char*>(mRightLow));
+    const int numDisparities = ((mSearchMax - mSearchMin + 1) + 15) & ~15;
+    mStereoBM->setMinDisparity(mSearchMin);
+    mStereoBM->setNumDisparities(numDisparities);
+    cv::Mat disparity16;
+    mStereoBM->compute(left, right, disparity16);
+    for (int y = 0; y < h; y++) {
+      const short* row = disparity16.ptr<short>(y);
+      for (int x = 0; x < w; x++) {
+        if (row[x] >= mSearchMin * 16) {
+          mDisparityLow[y * w + x] =
+              static_cast<unsigned char>(std::min(255, (row[x] + 8) >> 4));
+          mValidLow[y * w + x] = 1;
+        }
+      }
+    }
+    return;
+  }
+#endif
+
+  const int radius       = mConfig.blockSize / 2;
+  const int textureLimit = mConfig.textureLimit * mConfig.blockSize *
+                           mConfig.blockSize;
+  const unsigned char* L = mLeftLow;
+  const unsigned char* R = mRightLow;
+  const int bands        = (h + BOKEH_BAND_ROWS - 1) / BOKEH_BAND_ROWS;
+
+  TileExecutor::GetInstance().Run(bands, [&](int band) {
+    const int y0 = band * BOKEH_BAND_ROWS;
+    const int y1 = std::min(h, y0 + BOKEH_BAND_ROWS);
+    std::vector<uint16_t> column(w);
+    std::vector<int> sums(w);
+    std::vector<int> best(static_cast<size_t>(y1 - y0) * w, INT_MAX);
+    std::vector<unsigned char> textured(static_cast<size_t>(y1 - y0) * w);
+
+    // Rows of the band and its halo, each cost is evaluated once
+    const int yh0 = std::max(0, y0 - radius);
+    const int yh1 = std::min(h, y1 + radius);
+    std::vector<unsigned char> cost(static_cast<size_t>(yh1 - yh0) * w);
+    auto rowOf = [&](int y) { return &cost[(y - yh0) * w]; };
+
+    for (int y = yh0; y < yh1; y++) {
+      const unsigned char* l = L + y * w;
+      unsigned char* c       = rowOf(y);
+      for (int x = 0; x < w - 1; x++) {
+        c[x] = static_cast<unsigned char>(std::abs(l[x + 1] - l[x]));
+      }
+      c[w - 1] = 0;
+    }
+    BoxSumBand(w, h, y0, y1, radius, column.data(), sums.data(), rowOf,
+               [&](int y, const int* rowSums) {
+                 for (int x = 0; x < w; x++) {
+                   textured[(y - y0) * w + x] = rowSums[x] >= textureLimit;
+                 }
+               });
+
+    for (int d = mSearchMin; d <= mSearchMax && d < w; d++) {
+      for (int y = yh0; y < yh1; y++) {
+        const unsigned char* l = L + y * w;
+        const unsigned char* r = R + y * w;
+        unsigned char* c       = rowOf(y);
+        for (int x = 0; x < d; x++) {
+          c[x] = static_cast<unsigned char>(std::abs(l[x] - r[0]));
+        }
+        for (int x = d; x < w; x++) {
+          c[x] = static_cast<unsigned char>(std::abs(l[x] - r[x - d]));
+        }
+      }
+      BoxSumBand(w, h, y0, y1, radius, column.data(), sums.data(), rowOf,
+                 [&](int y, const int* rowSums) {
+                   int* bestRow           = &best[(y - y0) * w];
+                   unsigned char* dispRow = &mDisparityLow[y * w];
+                   for (int x = d; x < w; x++) {
+                     const bool better = rowSums[x] < bestRow[x];
+                     bestRow[x] = better ? rowSums[x] : bestRow[x];
+                     dispRow[x] = better ? static_cast<unsigned char>(d)
+                                         : dispRow[x];
+                   }
+                 });
+    }
+
+    for (int i = 0; i < (y1 - y0) * w; i++) {
+      mValidLow[y0 * w + i] = textured[i] && best[i] != INT_MAX;
+    }
+  });
+}
+
+/**
+ * @brief Fill invalid runs from the farther (smaller disparity) neighbour, as
+ * holes are mostly occlusions of the background
+ *
+ */
+void BokehDepth::FillHoles() {
+  const int w = mLowWidth;
+  for (int y = 0; y < mLowHeight; y++) {
+    unsigned char* disparity   = &mDisparityLow[y * w];
+    const unsigned char* valid = &mValidLow[y * w];
+    int x = 0;
+    while (x < w) {
+      if (valid[x]) {
+        x++;
+        continue;
+      }
+      const int start = x;
+      while (x < w && !valid[x]) {
+        x++;
+      }
+      int fill = 0;
+      if (start > 0 && x < w) {
+        fill = std::min(disparity[start - 1], disparity[x]);
+      } else if (start > 0) {
+        fill = disparity[start - 1];
+      } else if (x < w) {
+        fill = disparity[x];
+      }
+      std::fill(disparity + start, disparity + x,
+                static_cast<unsigned char>(fill));
+    }
+  }
+}
+
+/**
+ * @brief Narrow the next search to the 2nd..98th percentile of this frame with
+ * a margin, or search the full range again when matching was poor
+ *
+ */
+void BokehDepth::UpdateSearchRange() {
+  std::vector<int> histogram(256, 0);
+  int valid = 0;
+  for (size_t i = 0; i < mDisparityLow.size(); i++) {
+    if (mValidLow[i]) {
+      histogram[mDisparityLow[i]]++;
+      valid++;
+    }
+  }
+  if (valid * 2 < static_cast<int>(mDisparityLow.size())) {
+    mFrameCount = 0;  // Next frame does a full search
+    return;
+  }
+
+  const int lowCount  = valid * 2 / 100;
+  const int highCount = valid * 98 / 100;
+  int low = 0, high = 255, acc = 0;
+  for (int d = 0; d < 256; d++) {
+    if (acc <= lowCount && acc + histogram[d] > lowCount) {
+      low = d;
+    }
+    acc += histogram[d];
+    if (acc >= highCount) {
+      high = d;
+      break;
+    }
+  }
+  const int maxLow = mConfig.maxDisparity / mConfig.downscale;
+  const int margin = std::max(2, (high - low) / 4);
+  mSearchMin       = std::max(0, low - margin);
+  mSearchMax       = std::min(maxLow, high + margin);
+}
+
+/**
+ * @brief Joint bilateral upsampling: bilinear weights of the four nearest low
+ * resolution samples, scaled by how close their luma is to the full
+ * resolution guide pixel, so depth edges follow image edges
+ *
+ * @param guide full resolution left luma
+ * @param width
+ * @param height
+ * @param disparity
+ */
+void BokehDepth::Upsample(const unsigned char* guide, int width, int height,
+                          std::vector<unsigned char>& disparity) const {
+  const int ds = mConfig.downscale;
+  const int lw = mLowWidth;
+  const int lh = mLowHeight;
+  disparity.resize(static_cast<size_t>(width) * height);
+
+  // Low resolution neighbours and 8 bit bilinear weight per column
+  std::vector<int> x0(width), x1(width), ax(width);
+  for (int x = 0; x < width; x++) {
+    const int pos = ((2 * x + 1) * 256) / (2 * ds) - 128;
+    const int base = pos >> 8;
+    x0[x] = std::max(0, std::min(base, lw - 1));
+    x1[x] = std::max(0, std::min(base + 1, lw - 1));
+    ax[x] = pos & 255;
+  }
+
+  const int bands = (height + BOKEH_BAND_ROWS - 1) / BOKEH_BAND_ROWS;
+  TileExecutor::GetInstance().Run(bands, [&](int band) {
+    const int yStart = band * BOKEH_BAND_ROWS;
+    const int yEnd   = std::min(height, yStart + BOKEH_BAND_ROWS);
+    for (int y = yStart; y < yEnd; y++) {
+      const int pos  = ((2 * y + 1) * 256) / (2 * ds) - 128;
+      const int base = pos >> 8;
+      const int y0   = std::max(0, std::min(base, lh - 1));
+      const int y1   = std::max(0, std::min(base + 1, lh - 1));
+      const int ay   = pos & 255;
+      const unsigned char* g   = guide + y * width;
+      unsigned char* out       = &disparity[y * width];
+      const unsigned char* d0  = &mDisparityLow[y0 * lw];
+      const unsigned char* d1  = &mDisparityLow[y1 * lw];
+      const unsigned char* l0  = &mLeftLow[y0 * lw];
+      const unsigned char* l1  = &mLeftLow[y1 * lw];
+      for (int x = 0; x < width; x++) {
+        const int wx1 = ax[x], wx0 = 256 - wx1;
+        const int wy1 = ay, wy0 = 256 - wy1;
+        const int c   = g[x];
+        const int a = d0[x0[x]], b = d0[x1[x]];
+        const int e = d1[x0[x]], f = d1[x1[x]];
+        if (a == b && a == e && a == f) {
+          out[x] = static_cast<unsigned char>(std::min(255, a * ds));
+          continue;
+        }
+        const int w00 =
+            ((wx0 * wy0) >> 8) * mRangeWeight[std::abs(c - l0[x0[x]])];
+        const int w01 =
+            ((wx1 * wy0) >> 8) * mRangeWeight[std::abs(c - l0[x1[x]])];
+        const int w10 =
+            ((wx0 * wy1) >> 8) * mRangeWeight[std::abs(c - l1[x0[x]])];
+        const int w11 =
+            ((wx1 * wy1) >> 8) * mRangeWeight[std::abs(c - l1[x1[x]])];
+        const int sum = w00 + w01 + w10 + w11;
+        const int acc   = w00 * a + w01 * b + w10 * e + w11 * f;
+        const int value = sum ? (acc * ds + sum / 2) / sum : a * ds;
+        out[x]          = static_cast<unsigned char>(std::min(255, value));
+      }
+    }
+  });
+}
+
+/**
+ * @brief Full resolution disparity of the left image
+ *
+ * @param left
+ * @param leftLow
+ * @param rightLow
+ * @param width
+ * @param height
+ * @param disparity
+ * @return true
+ * @return false
+ */
+bool BokehDepth::Compute(const unsigned char* left,
+                         const unsigned char* leftLow,
+                         const unsigned char* rightLow, int width, int height,
+                         std::vector<unsigned char>& disparity) {
+  const int lw = width / mConfig.downscale;
+  const int lh = height / mConfig.downscale;
+  if (lw < mConfig.blockSize || lh < mConfig.blockSize) {
+    return false;
+  }
+
+  // Full range on the first frame, after a size change and periodically
+  const int maxLow = mConfig.maxDisparity / mConfig.downscale;
+  if (lw != mLowWidth || lh != mLowHeight ||
+      mFrameCount % mConfig.reseedInterval == 0) {
+    mLowWidth   = lw;
+    mLowHeight  = lh;
+    mFrameCount = 0;
+    mSearchMin  = 0;
+    mSearchMax  = maxLow;
+  }
+  mFrameCount++;
+
+  mLeftLow  = leftLow;
+  mRightLow = rightLow;
+  Match();
+  UpdateSearchRange();
+  FillHoles();
+  Upsample(left, width, height, disparity);
+  mLeftLow  = nullptr;
+  mRightLow = nullptr;
+  return true;
+}
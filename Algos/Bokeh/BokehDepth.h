@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef BOKEH_DEPTH_H
+#define BOKEH_DEPTH_H
+
+#include <cstdint>
+#include <vector>
+#ifdef _CV_ENABLED_
+#include <opencv2/opencv.hpp>
+#endif
+
+/**
+ * @brief Tuning of the stereo depth stage, read from BokehAlgorithm.config
+ */
+struct BokehDepthConfig {
+  int downscale      = 2;   // Match at 1/2 or 1/4 resolution
+  int maxDisparity   = 64;  // Full resolution pixels
+  int blockSize      = 9;   // Odd SAD window at match resolution
+  int textureLimit   = 4;   // Mean |gradient| below this is unreliable
+  int reseedInterval = 30;  // Frames between full range searches
+  int edgeSigma      = 12;  // Luma range sigma of the upsampler
+};
+
+/**
+ * @brief Stereo disparity for the Bokeh node. Left/right luma is matched at
+ * reduced resolution within a search range seeded from the previous frame,
+ * holes are filled from the background side and the result is upsampled to
+ * full resolution guided by the left image edges. One instance per node
+ * keeps its buffers and matcher across frames.
+ */
+class BokehDepth {
+ public:
+  explicit BokehDepth(const BokehDepthConfig& config);
+
+  /**
+   * @brief Full resolution disparity of the left image, in pixels clamped to
+   * 255
+   *
+   * @param left left luma, width x height
+   * @param leftLow left luma box averaged by GetDownscale()
+   * @param rightLow right luma box averaged by GetDownscale()
+   * @param width
+   * @param height
+   * @param disparity output, width x height
+   * @return true
+   * @return false frame too small to match
+   */
+  bool Compute(const unsigned char* left, const unsigned char* leftLow,
+               const unsigned char* rightLow, int width, int height,
+               std::vector<unsigned char>& disparity);
+
+  // Factor the low resolution views passed to Compute are reduced by
+  int GetDownscale() const { return mConfig.downscale; }
+  // Search range of the next frame, in match resolution pixels
+  int GetSearchMin() const { return mSearchMin; }
+  int GetSearchMax() const { return mSearchMax; }
+
+ private:
+  void Match();
+  void FillHoles();
+  void UpdateSearchRange();
+  void Upsample(const unsigned char* guide, int width, int height,
+                std::vector<unsigned char>& disparity) const;
+
+  BokehDepthConfig mConfig;
+  int mLowWidth   = 0;
+  int mLowHeight  = 0;
+  int mSearchMin  = 0;
+  int mSearchMax  = 0;
+  int mFrameCount = 0;
+  const unsigned char* mLeftLow  = nullptr;  // Views of the running Compute
+  const unsigned char* mRightLow = nullptr;
+  std::vector<unsigned char> mDisparityLow;  // Match resolution pixels
+  std::vector<unsigned char> mValidLow;
+  std::vector<uint16_t> mRangeWeight;  // Upsampler weight per luma difference
+#ifdef _CV_ENABLED_
+  cv::Ptr<cv::StereoBM> mStereoBM;
+#endif
+};
+
+#endif  // BOKEH_DEPTH_H
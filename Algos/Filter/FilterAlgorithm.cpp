@@ -20,7 +20,9 @@
  * THE SOFTWARE.
  */
 #include "FilterAlgorithm.h"
+#include <algorithm>
 #include <cmath>
+#include "BilateralGrid.h"
 #include "ConfigParser.h"
 #include "Log.h"
 
@@ -31,7 +33,10 @@
 FilterAlgorithm::FilterAlgorithm() : AlgoBase(FILTER_NAME) {
   mAlgoId = ALGO_FILTER;  // Unique ID for Filter algorithm
   SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::RGB});
+  SupportedFormatsMap.push_back({ImageFormat::RGBP, ImageFormat::RGBP});
   SupportedFormatsMap.push_back({ImageFormat::YUV420, ImageFormat::YUV420});
+  SupportedFormatsMap.push_back({ImageFormat::NV12, ImageFormat::NV12});
+  SupportedFormatsMap.push_back({ImageFormat::NV21, ImageFormat::NV21});
   ConfigParser parser;
   mConfigFile = CONFIGPATH;
   mConfigFile += AlgoBase::GetAlgorithmName();
@@ -41,6 +46,17 @@ FilterAlgorithm::FilterAlgorithm() : AlgoBase(FILTER_NAME) {
   if (parser.getErrorCode() == 0) {
     LOG(VERBOSE, ALGOBASE, "Filter Algo Version: %s", Version.c_str());
   }
+
+  if (parser.getValue("Mode") == "Bilateral") {
+    mMode = FilterMode::BILATERAL;
+  }
+  auto readFloat = [&parser](const std::string &key, float &value) {
+    if (!parser.getValue(key).empty()) {
+      value = parser.getFloatValue(key);
+    }
+  };
+  readFloat("SigmaSpatial", mSigmaSpatial);
+  readFloat("SigmaRange", mSigmaRange);
 }
 
 /**
@@ -61,51 +77,93 @@ AlgoBase::AlgoStatus FilterAlgorithm::Open() {
   SetStatus(AlgoStatus::SUCCESS);
   return GetAlgoStatus();
 }
-AlgoBase::AlgoStatus FilterAlgorithm::SobelRGB(
-    std::shared_ptr<AlgoRequest> req) {
+/**
+ * @brief Call func(x0, y0, x1, y1) for each output rectangle to compute, the
+ * dirty blocks of mask or the whole frame without one
+ *
+ * @tparam Func
+ * @param mask
+ * @param width
+ * @param height
+ * @param func
+ */
+template <typename Func>
+static void ForEachDirtyRect(const DirtyBlockMask *mask, int width, int height,
+                             Func func) {
+  if (!mask) {
+    func(0, 0, width, height);
+    return;
+  }
+  const int block = mask->blockSize;
+  for (int by = 0; by < mask->blocksY; ++by) {
+    for (int bx = 0; bx < mask->blocksX; ++bx) {
+      if (mask->IsDirty(bx, by)) {
+        func(bx * block, by * block, std::min((bx + 1) * block, width),
+             std::min((by + 1) * block, height));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Sobel on the colour planes, RGB or luma; chroma planes are carried
+ * over. Instantiated per format layout.
+ *
+ * @param req
+ * @param reuse previous output of the stream, kept in the clean blocks
+ * @param mask dirty blocks, nullptr for the whole frame
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus FilterAlgorithm::Sobel(
+    std::shared_ptr<AlgoRequest> req, std::shared_ptr<const ImageData> reuse,
+    const DirtyBlockMask *mask) {
   auto inputImage = req->GetImage(0);  // Assume the first image as input
   if (!inputImage) {
     SetStatus(AlgoStatus::FAILURE);
     return GetAlgoStatus();
   }
+
+  const ImageFormat format                    = inputImage->GetFormat();
   const int width                             = inputImage->GetWidth();
   const int height                            = inputImage->GetHeight();
-  const std::vector<unsigned char>& inputData = inputImage->GetData();
-
-  std::vector<unsigned char> outputData(width * height * 3, 0);  // RGB output
-
-  // Compute Sobel filter sequentially for each color channel
-  for (int y = 1; y < height - 1; ++y) {
-    for (int x = 1; x < width - 1; ++x) {
-      int gradientX[3] = {0, 0, 0};
-      int gradientY[3] = {0, 0, 0};
-
-      // Apply Sobel kernels for each color channel
-      for (int ky = -1; ky <= 1; ++ky) {
-        for (int kx = -1; kx <= 1; ++kx) {
-          int pixelIndex = ((y + ky) * width + (x + kx)) * 3;
-          for (int c = 0; c < 3; ++c) {  // Iterate over R, G, B channels
-            int pixelValue = inputData[pixelIndex + c];
-            gradientX[c] += pixelValue * Gx[ky + 1][kx + 1];
-            gradientY[c] += pixelValue * Gy[ky + 1][kx + 1];
-          }
+  // Read only, the frame may be shared with the stream history
+  const ImageData& input                      = *inputImage;
+  const std::vector<unsigned char>& inputData = input.GetData();
+  std::vector<unsigned char> outputData;
+
+  DispatchFormat(format, [&](auto layout) {
+    using Layout       = decltype(layout);
+    using Plane        = typename Layout::template Plane<0>;
+    constexpr int cn   = Plane::kChannels;
+    const size_t size  = Layout::Size(width, height);
+    const size_t plane = Plane::Size(width, height);
+    const size_t color = plane * Layout::kColorPlanes;
+    const int stride   = Plane::RowSamples(width);
+
+    // Clean blocks keep the previous output of the stream
+    outputData = reuse ? reuse->GetData() : std::vector<unsigned char>(size);
+    ForEachDirtyRect(mask, width, height, [&](int x0, int y0, int x1, int y1) {
+      for (size_t base = 0; base < color; base += plane) {
+        const unsigned char* in = &inputData[base];
+        unsigned char* out      = &outputData[base];
+        for (int y = std::max(y0, 1); y < std::min(y1, height - 1); ++y) {
+          const unsigned char* rows[3] = {in + (y - 1) * stride,
+                                          in + y * stride,
+                                          in + (y + 1) * stride};
+          SobelRow<cn>(rows, out + y * stride, std::max(x0, 1),
+                       std::min(x1, width - 1));
         }
       }
+    });
 
-      // Compute gradient magnitude for each channel and clamp to 255
-      int outputIndex = (y * width + x) * 3;
-      for (int c = 0; c < 3; ++c) {
-        int magnitude = static_cast<int>(std::sqrt(
-            gradientX[c] * gradientX[c] + gradientY[c] * gradientY[c]));
-        outputData[outputIndex + c] =
-            static_cast<unsigned char>(std::min(magnitude, 255));
-      }
-    }
-  }
+    // Chroma planes are copied from input
+    std::copy(inputData.begin() + color, inputData.begin() + size,
+              outputData.begin() + color);
+  });
 
   // Replace input image with output image
   req->ClearImages();
-  if (req->AddImage(ImageFormat::RGB, width, height, std::move(outputData))) {
+  if (req->AddImage(format, width, height, std::move(outputData))) {
     LOG(ERROR, ALGOBASE, "Error Filling Output data");
     SetStatus(AlgoStatus::FAILURE);
   }
@@ -113,51 +171,47 @@ AlgoBase::AlgoStatus FilterAlgorithm::SobelRGB(
   return GetAlgoStatus();
 }
 
-AlgoBase::AlgoStatus FilterAlgorithm::SobelYuv(
+/**
+ * @brief Bilateral grid noise reduction of the colour planes, every RGB
+ * channel on its own; chroma planes are carried over
+ *
+ * @param req
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus FilterAlgorithm::Bilateral(
     std::shared_ptr<AlgoRequest> req) {
-  auto inputImage = req->GetImage(0);
+  auto inputImage = req->GetImage(0);  // Assume the first image as input
   if (!inputImage) {
     SetStatus(AlgoStatus::FAILURE);
     return GetAlgoStatus();
   }
 
+  const ImageFormat format                    = inputImage->GetFormat();
   const int width                             = inputImage->GetWidth();
   const int height                            = inputImage->GetHeight();
-  const std::vector<unsigned char>& inputData = inputImage->GetData();
-
-  // YUV420 - Y plane size = width * height
-  // UV planes = (width * height) / 4 each
-  std::vector<unsigned char> outputData(width * height * 3 / 2, 0);
-
-  // Sobel on Y channel only
-  for (int y = 1; y < height - 1; ++y) {
-    for (int x = 1; x < width - 1; ++x) {
-      int gradientX = 0, gradientY = 0;
-
-      for (int ky = -1; ky <= 1; ++ky) {
-        for (int kx = -1; kx <= 1; ++kx) {
-          int pixelIndex = (y + ky) * width + (x + kx);  // Correct indexing
-          int pixelValue = inputData[pixelIndex];        // Y channel
-          gradientX += pixelValue * Gx[ky + 1][kx + 1];
-          gradientY += pixelValue * Gy[ky + 1][kx + 1];
-        }
-      }
+  // Read only, the frame may be shared with the stream history
+  const ImageData& input                      = *inputImage;
+  const std::vector<unsigned char>& inputData = input.GetData();
+  std::vector<unsigned char> outputData(inputData);
 
-      int magnitude = static_cast<int>(
-          std::sqrt(gradientX * gradientX + gradientY * gradientY));
-      outputData[y * width + x] = static_cast<unsigned char>(
-          std::min(magnitude, 255));  // Store in Y plane
+  DispatchFormat(format, [&](auto layout) {
+    using Layout       = decltype(layout);
+    using Plane        = typename Layout::template Plane<0>;
+    constexpr int cn   = Plane::kChannels;
+    const size_t plane = Plane::Size(width, height);
+    const int stride   = Plane::RowSamples(width);
+    for (int p = 0; p < Layout::kColorPlanes; p++) {
+      for (int c = 0; c < cn; c++) {
+        const size_t base = p * plane + c;
+        BilateralFilterPlane(&inputData[base], &outputData[base], width,
+                             height, stride, cn, mSigmaSpatial, mSigmaRange);
+      }
     }
-  }
-
-  // Copy U and V channels from input
-  int uvOffset = width * height;
-  std::copy(inputData.begin() + uvOffset, inputData.end(),
-            outputData.begin() + uvOffset);
+  });
 
+  // Replace input image with output image
   req->ClearImages();
-  if (req->AddImage(ImageFormat::YUV420, width, height,
-                    std::move(outputData))) {
+  if (req->AddImage(format, width, height, std::move(outputData))) {
     LOG(ERROR, ALGOBASE, "Error Filling Output data");
     SetStatus(AlgoStatus::FAILURE);
   }
@@ -189,19 +243,30 @@ AlgoBase::AlgoStatus FilterAlgorithm::Process(
 
   const ImageFormat inputFormat = inputImage->GetFormat();
 
-  switch (inputFormat) {
-    case ImageFormat::RGB: {
-      if (true == CanProcessFormat(inputFormat, ImageFormat::RGB)) {
-        rc = SobelRGB(req);
-      }
-    } break;
-    case ImageFormat::YUV420: {
-      if (true == CanProcessFormat(inputFormat, ImageFormat::YUV420)) {
-        rc = SobelYuv(req);
-      }
-    } break;
-    default:
-      break;
+  if (mMode == FilterMode::BILATERAL) {
+    // Every output pixel depends on a wide area, no block stays clean
+    req->mDirtyBlocks = nullptr;
+    if (true == CanProcessFormat(inputFormat, inputFormat)) {
+      rc = Bilateral(req);
+    }
+  } else {
+    // A changed pixel alters the gradients one pixel around it
+    if (req->mDirtyBlocks) {
+      auto grown = std::make_shared<DirtyBlockMask>(*req->mDirtyBlocks);
+      grown->Dilate(1);
+      req->mDirtyBlocks = grown;
+    }
+    auto& state = GetStreamState<FilterStreamState>(req);
+    auto mask   = GetReusableBlocks(req, state.history);
+    std::shared_ptr<const ImageData> reuse;
+    if (mask) {
+      reuse = state.history.output;
+    }
+
+    if (true == CanProcessFormat(inputFormat, inputFormat)) {
+      rc = Sobel(req, reuse, mask.get());
+    }
+    UpdateBlockHistory(state.history, req);
   }
 
   int reqdone = 0x00;
@@ -232,6 +297,50 @@ int FilterAlgorithm::GetTimeout() {
   return 5000;
 }
 
+/**
+ * @brief output depends only on the request
+ *
+ * @return bool
+ */
+bool FilterAlgorithm::IsCacheable() const {
+  return true;
+}
+
+/**
+ * @brief Sobel recomputes dirty blocks grown by the kernel radius only, the
+ * bilateral grid always runs on the whole frame
+ *
+ * @return bool
+ */
+bool FilterAlgorithm::SupportsDirtyBlocks() const {
+  return mMode == FilterMode::SOBEL;
+}
+
+/**
+ * @brief the Sobel kernel reads one row above and below, the bilateral grid
+ * needs the whole frame
+ *
+ * @param format
+ * @return int
+ */
+int FilterAlgorithm::GetStripeHalo(ImageFormat format) const {
+  return mMode == FilterMode::SOBEL && IsStripeFormat(format) ? 1 : -1;
+}
+
+/**
+ * @brief Sobel on the rows of a stripe; frame borders are 0 and chroma is
+ * carried over, as in Process
+ *
+ * @param in
+ * @param out
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus FilterAlgorithm::ProcessStripe(const ImageStripe& in,
+                                                    ImageStripe& out) {
+  SobelStripe(in, out);
+  return AlgoStatus::SUCCESS;
+}
+
 // Public Exposed API for Filter
 /**
  * @brief Factory function to expose FilterAlgorithm via shared library.
@@ -23,7 +23,18 @@
 #define FILTER_ALGORITHM_H
 
 #include "AlgoBase.h"
+#include "StripeKernels.h"
 const char *FILTER_NAME = "FilterAlgorithm";
+
+enum class FilterMode { SOBEL, BILATERAL };
+
+/**
+ * @brief Last output of one stream, reused where its input did not change
+ */
+struct FilterStreamState : AlgoBase::StreamState {
+  AlgoBase::BlockHistory history;
+};
+
 /**
  * @brief FilterAlgorithm class derived from AlgoBase to perform Filter-specific
  * operations.
@@ -66,15 +77,21 @@ public:
    * @return int
    */
   int GetTimeout() override;
+  bool IsCacheable() const override;
+  bool SupportsDirtyBlocks() const override;
+  int GetStripeHalo(ImageFormat format) const override;
+  AlgoStatus ProcessStripe(const ImageStripe &in, ImageStripe &out) override;
 
 private:
   mutable std::mutex mutex_; // Mutex to protect the shared state
-                             /* Sobel kernels for X and Y gradients*/
-  const int Gx[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
-  const int Gy[3][3] = {{1, 2, 1}, {0, 0, 0}, {-1, -2, -1}};
+  FilterMode mMode    = FilterMode::SOBEL;
+  float mSigmaSpatial = 8.0f;  // Bilateral spatial sigma in pixels
+  float mSigmaRange   = 16.0f; // Bilateral range sigma in sample levels
 
-  AlgoStatus SobelRGB(std::shared_ptr<AlgoRequest> req);
-  AlgoStatus SobelYuv(std::shared_ptr<AlgoRequest> req);
+  AlgoStatus Sobel(std::shared_ptr<AlgoRequest> req,
+                   std::shared_ptr<const ImageData> reuse,
+                   const DirtyBlockMask *mask);
+  AlgoStatus Bilateral(std::shared_ptr<AlgoRequest> req);
 };
 
 /**
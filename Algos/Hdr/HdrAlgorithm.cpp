@@ -20,16 +20,54 @@
  * THE SOFTWARE.
  */
 #include "HdrAlgorithm.h"
+#include <algorithm>
 #include "ConfigParser.h"
 #include "Log.h"
 
+/**
+ * @brief BT.601 full range RGB to YUV420, chroma averaged over 2x2
+ *
+ * @param rgb
+ * @param width even
+ * @param height even
+ * @param yuv
+ */
+static void ConvertRGBToYUV420(const unsigned char* rgb, int width,
+                               int height, std::vector<unsigned char>& yuv) {
+  const size_t lumaSize = static_cast<size_t>(width) * height;
+  yuv.resize(lumaSize * 3 / 2);
+  unsigned char* u = yuv.data() + lumaSize;
+  unsigned char* v = u + lumaSize / 4;
+  for (int y = 0; y < height; y += 2) {
+    for (int x = 0; x < width; x += 2) {
+      int sumU = 0, sumV = 0;
+      for (int dy = 0; dy < 2; dy++) {
+        for (int dx = 0; dx < 2; dx++) {
+          const size_t i       = static_cast<size_t>(y + dy) * width + x + dx;
+          const unsigned char* p = rgb + 3 * i;
+          yuv[i] = static_cast<unsigned char>(
+              (77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+          sumU += -43 * p[0] - 85 * p[1] + 128 * p[2];
+          sumV += 128 * p[0] - 107 * p[1] - 21 * p[2];
+        }
+      }
+      const size_t c = static_cast<size_t>(y / 2) * (width / 2) + x / 2;
+      u[c] = static_cast<unsigned char>(
+          std::min(255, std::max(0, ((sumU + 512) >> 10) + 128)));
+      v[c] = static_cast<unsigned char>(
+          std::min(255, std::max(0, ((sumV + 512) >> 10) + 128)));
+    }
+  }
+}
+
 /**
  * @brief Constructor for HdrAlgorithm.
  * @param name Name of the Hdr algorithm.
  */
 HdrAlgorithm::HdrAlgorithm() : AlgoBase(HDR_NAME) {
   mAlgoId = ALGO_HDR;  // Unique ID for Hdr algorithm
-  SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::RGB});
+  SupportedFormatsMap.push_back({ImageFormat::YUV420, ImageFormat::YUV420});
+  SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::YUV420});
   ConfigParser parser;
   mConfigFile = CONFIGPATH;
   mConfigFile += AlgoBase::GetAlgorithmName();
@@ -39,6 +77,20 @@ HdrAlgorithm::HdrAlgorithm() : AlgoBase(HDR_NAME) {
   if (parser.getErrorCode() == 0) {
     LOG(VERBOSE, ALGOBASE, "Hdr Algo Version: %s", Version.c_str());
   }
+
+  HdrFusionConfig fusionConfig;
+  auto readFloat = [&parser](const std::string& key, float& value) {
+    if (!parser.getValue(key).empty()) {
+      value = parser.getFloatValue(key);
+    }
+  };
+  readFloat("ContrastWeight", fusionConfig.contrastWeight);
+  readFloat("SaturationWeight", fusionConfig.saturationWeight);
+  readFloat("ExposureWeight", fusionConfig.exposureWeight);
+  if (!parser.getValue("PyramidLevels").empty()) {
+    fusionConfig.levels = parser.getIntValue("PyramidLevels");
+  }
+  mFusion = std::make_unique<HdrFusion>(fusionConfig);
 }
 
 /**
@@ -61,13 +113,63 @@ AlgoBase::AlgoStatus HdrAlgorithm::Open() {
 }
 
 /**
- * @brief Process the Hdr algorithm, simulating input validation and Hdr
- * computation.
+ * @brief Fuse the exposures of a request into one YUV420 frame. Requests
+ * with a single image pass through.
  * @return Status of the operation.
  */
 AlgoBase::AlgoStatus HdrAlgorithm::Process(std::shared_ptr<AlgoRequest> req) {
   std::lock_guard<std::mutex> lock(mutex_);
 
+  // Every exposure must share the size of the first one
+  const size_t count = req ? req->GetImageCount() : 0;
+  bool fuse          = count > 1;
+  int width = 0, height = 0;
+  for (size_t i = 0; fuse && i < count; i++) {
+    auto image = req->GetImage(i);
+    if (!image || !CanProcessFormat(image->GetFormat(), ImageFormat::YUV420)) {
+      fuse = false;
+      break;
+    }
+    if (i == 0) {
+      width  = image->GetWidth();
+      height = image->GetHeight();
+    }
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const size_t expected = image->GetFormat() == ImageFormat::RGB
+                                ? lumaSize * 3
+                                : lumaSize * 3 / 2;
+    fuse = width > 0 && height > 0 && !((width | height) & 1) &&
+           image->GetWidth() == width && image->GetHeight() == height &&
+           image->GetDataSize() >= expected;
+  }
+
+  if (fuse) {
+    LOG(VERBOSE, ALGOBASE, "Fusing %zu exposures of request ::%d", count,
+        req->mRequestId);
+    mFusion->Begin(width, height);
+    for (size_t i = 0; i < count; i++) {
+      // Read only, the exposures may be shared with other requests
+      const ImageData& image = *req->GetImage(i);
+      if (image.GetFormat() == ImageFormat::RGB) {
+        ConvertRGBToYUV420(image.GetData().data(), width, height, mConverted);
+        mFusion->Add(mConverted.data());
+      } else {
+        mFusion->Add(image.GetData().data());
+      }
+    }
+    std::vector<unsigned char> outputData;
+    mFusion->Finish(outputData);
+
+    // Replace the exposures with the fused frame
+    req->ClearImages();
+    if (req->AddImage(ImageFormat::YUV420, width, height,
+                      std::move(outputData))) {
+      LOG(ERROR, ALGOBASE, "Error Filling Output Data");
+      SetStatus(AlgoStatus::FAILURE);
+      return GetAlgoStatus();
+    }
+  }
+
   int reqdone = 0x00;
   if (req &&
       (0 == req->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone))) {
@@ -98,6 +200,15 @@ int HdrAlgorithm::GetTimeout() {
   return 1000;
 }
 
+/**
+ * @brief output depends only on the request
+ *
+ * @return bool
+ */
+bool HdrAlgorithm::IsCacheable() const {
+  return true;
+}
+
 // Public Exposed API for Hdr
 /**
  * @brief Factory function to expose HdrAlgorithm via shared library.
@@ -22,7 +22,10 @@
 #ifndef HDR_ALGORITHM_H
 #define HDR_ALGORITHM_H
 
+#include <memory>
+#include <vector>
 #include "AlgoBase.h"
+#include "HdrFusion.h"
 const char *HDR_NAME = "HdrAlgorithm";
 
 /**
@@ -49,7 +52,8 @@ public:
   AlgoStatus Open() override;
 
   /**
-   * @brief Process the Hdr algorithm, simulating Hdr computation.
+   * @brief Fuse the exposures of a request into one YUV420 frame. Requests
+   * with a single image pass through.
    * @return Status of the operation.
    */
   AlgoStatus Process(std::shared_ptr<AlgoRequest> req) override;
@@ -67,9 +71,12 @@ public:
    * @return int
    */
   int GetTimeout() override;
+  bool IsCacheable() const override;
 
 private:
   mutable std::mutex mutex_; // Mutex to protect the shared state
+  std::unique_ptr<HdrFusion> mFusion;
+  std::vector<unsigned char> mConverted; // YUV420 copy of an RGB exposure
 };
 
 /**
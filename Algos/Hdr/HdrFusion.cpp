@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "HdrFusion.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "TileExecutor.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define HDR_BAND_ROWS 32       // Rows per parallel task
+#define HDR_MIN_LEVEL_SIZE 8   // Smallest side of the coarsest level
+#define HDR_WEIGHT_EPS 1e-4f   // Keeps every measure above zero
+
+/**
+ * @brief Resize a level to width x height, filled with zero
+ *
+ * @param plane
+ * @param width
+ * @param height
+ */
+static void HdrResize(HdrPlane& plane, int width, int height) {
+  plane.width  = width;
+  plane.height = height;
+  plane.data.assign(static_cast<size_t>(width) * height, 0.0f);
+}
+
+/**
+ * @brief Run func(y0, y1) over bands of rows on TileExecutor
+ *
+ * @param height
+ * @param func
+ */
+template <typename Func>
+static void HdrForBands(int height, Func func) {
+  const int bands = (height + HDR_BAND_ROWS - 1) / HDR_BAND_ROWS;
+  TileExecutor::GetInstance().Run(bands, [&](int band) {
+    const int y0 = band * HDR_BAND_ROWS;
+    func(y0, std::min(height, y0 + HDR_BAND_ROWS));
+  });
+}
+
+/**
+ * @brief 5-tap binomial blur and decimation by 2, edges replicate
+ *
+ * @param src
+ * @param dst
+ */
+static void HdrReduce(const HdrPlane& src, HdrPlane& dst) {
+  const int sw = src.width;
+  const int sh = src.height;
+  const int dw = (sw + 1) / 2;
+  dst.width    = dw;
+  dst.height   = (sh + 1) / 2;
+  dst.data.resize(static_cast<size_t>(dw) * dst.height);
+
+  HdrForBands(dst.height, [&](int y0, int y1) {
+    // Horizontally reduced source rows 2 * y0 - 2 ... 2 * y1
+    const int first = 2 * y0 - 2;
+    const int count = 2 * (y1 - y0) + 3;
+    std::vector<float> rows(static_cast<size_t>(count) * dw);
+    for (int r = 0; r < count; r++) {
+      const int sy     = std::max(0, std::min(first + r, sh - 1));
+      const float* in  = &src.data[static_cast<size_t>(sy) * sw];
+      float* out       = &rows[static_cast<size_t>(r) * dw];
+      for (int x = 0; x < dw; x++) {
+        const int c = 2 * x;
+        const float a = in[std::max(c - 2, 0)];
+        const float b = in[std::max(c - 1, 0)];
+        const float d = in[std::min(c + 1, sw - 1)];
+        const float e = in[std::min(c + 2, sw - 1)];
+        out[x]        = (a + e + 4.0f * (b + d) + 6.0f * in[c]) * 0.0625f;
+      }
+    }
+    for (int y = y0; y < y1; y++) {
+      const float* r0 = &rows[static_cast<size_t>(2 * (y - y0)) * dw];
+      const float* r1 = r0 + dw;
+      const float* r2 = r1 + dw;
+      const float* r3 = r2 + dw;
+      const float* r4 = r3 + dw;
+      float* out      = &dst.data[static_cast<size_t>(y) * dw];
+      for (int x = 0; x < dw; x++) {
+        out[x] = (r0[x] + r4[x] + 4.0f * (r1[x] + r3[x]) + 6.0f * r2[x]) *
+                 0.0625f;
+      }
+    }
+  });
+}
+
+/**
+ * @brief Rows [y0, y1) of a coarse level expanded to width x height, the
+ * transpose of HdrReduce
+ *
+ * @param coarse
+ * @param width
+ * @param y0
+ * @param y1
+ * @param rows scratch, grows as needed
+ * @param out (y1 - y0) x width
+ */
+static void HdrExpandBand(const HdrPlane& coarse, int width, int y0, int y1,
+                          std::vector<float>& rows, float* out) {
+  const int cw    = coarse.width;
+  const int ch    = coarse.height;
+  const int first = y0 / 2 - 1;
+  const int count = (y1 - 1) / 2 + 2 - first;
+  rows.resize(static_cast<size_t>(count) * width);
+
+  for (int r = 0; r < count; r++) {
+    const int cy    = std::max(0, std::min(first + r, ch - 1));
+    const float* in = &coarse.data[static_cast<size_t>(cy) * cw];
+    float* row      = &rows[static_cast<size_t>(r) * width];
+    // Even outputs sit on a coarse sample, odd ones between two
+    float left = in[0];
+    for (int i = 0; 2 * i < width; i++) {
+      const float right = in[std::min(i + 1, cw - 1)];
+      row[2 * i]        = 0.125f * (left + right) + 0.75f * in[i];
+      if (2 * i + 1 < width) {
+        row[2 * i + 1] = 0.5f * (in[i] + right);
+      }
+      left = in[i];
+    }
+  }
+  for (int y = y0; y < y1; y++) {
+    const int j        = y / 2 - first;
+    const float* above = &rows[static_cast<size_t>(j - 1) * width];
+    const float* mid   = above + width;
+    const float* below = mid + width;
+    float* dst         = out + static_cast<size_t>(y - y0) * width;
+    if (y & 1) {
+      for (int x = 0; x < width; x++) {
+        dst[x] = 0.5f * (mid[x] + below[x]);
+      }
+    } else {
+      for (int x = 0; x < width; x++) {
+        dst[x] = 0.125f * (above[x] + below[x]) + 0.75f * mid[x];
+      }
+    }
+  }
+}
+
+/**
+ * @brief sum += weight * (a - b), or sum += weight * a when b is null
+ *
+ * @param sum
+ * @param weight
+ * @param a
+ * @param b
+ * @param n
+ */
+static void HdrMultiplyAdd(float* sum, const float* weight, const float* a,
+                           const float* b, int n) {
+  int x = 0;
+#ifdef __SSE2__
+  for (; x + 4 <= n; x += 4) {
+    __m128 v = _mm_loadu_ps(a + x);
+    if (b) {
+      v = _mm_sub_ps(v, _mm_loadu_ps(b + x));
+    }
+    const __m128 s = _mm_loadu_ps(sum + x);
+    const __m128 w = _mm_loadu_ps(weight + x);
+    _mm_storeu_ps(sum + x, _mm_add_ps(s, _mm_mul_ps(w, v)));
+  }
+#endif
+  for (; x < n; x++) {
+    sum[x] += weight[x] * (b ? a[x] - b[x] : a[x]);
+  }
+}
+
+/**
+ * @brief sum += a
+ *
+ * @param sum
+ * @param a
+ * @param n
+ */
+static void HdrAdd(float* sum, const float* a, size_t n) {
+  size_t x = 0;
+#ifdef __SSE2__
+  for (; x + 4 <= n; x += 4) {
+    _mm_storeu_ps(sum + x,
+                  _mm_add_ps(_mm_loadu_ps(sum + x), _mm_loadu_ps(a + x)));
+  }
+#endif
+  for (; x < n; x++) {
+    sum[x] += a[x];
+  }
+}
+
+/**
+ * @brief out = sum / weightSum + expanded, expanded may be null
+ *
+ * @param out
+ * @param sum
+ * @param weightSum
+ * @param expanded
+ * @param n
+ */
+static void HdrNormalise(float* out, const float* sum, const float* weightSum,
+                         const float* expanded, int n) {
+  int x = 0;
+#ifdef __SSE2__
+  const __m128 tiny = _mm_set1_ps(1e-30f);
+  for (; x + 4 <= n; x += 4) {
+    __m128 v = _mm_div_ps(_mm_loadu_ps(sum + x),
+                          _mm_max_ps(_mm_loadu_ps(weightSum + x), tiny));
+    if (expanded) {
+      v = _mm_add_ps(v, _mm_loadu_ps(expanded + x));
+    }
+    _mm_storeu_ps(out + x, v);
+  }
+#endif
+  for (; x < n; x++) {
+    const float v = sum[x] / std::max(weightSum[x], 1e-30f);
+    out[x]        = expanded ? v + expanded[x] : v;
+  }
+}
+
+/**
+ * @brief Construct a new Hdr Fusion:: Hdr Fusion object
+ *
+ * @param config
+ */
+HdrFusion::HdrFusion(const HdrFusionConfig& config) : mConfig(config) {
+  for (int i = 0; i < 256; i++) {
+    const float v = i / 255.0f - 0.5f;
+    mExposure[i]  = std::pow(std::exp(-v * v / (2.0f * 0.2f * 0.2f)),
+                             mConfig.exposureWeight) +
+                   HDR_WEIGHT_EPS;
+  }
+}
+
+/**
+ * @brief Start a fused frame
+ *
+ * @param width
+ * @param height
+ */
+void HdrFusion::Begin(int width, int height) {
+  mWidth  = width;
+  mHeight = height;
+
+  int levels = 1;
+  for (int side = std::min(width, height);
+       (side + 1) / 2 >= HDR_MIN_LEVEL_SIZE; side = (side + 1) / 2) {
+    levels++;
+  }
+  if (mConfig.levels > 0) {
+    levels = std::min(levels, mConfig.levels);
+  }
+  mLevels = std::max(2, levels);
+
+  mWeight.resize(mLevels);
+  mWeightSum.resize(mLevels);
+  mSum[0].resize(mLevels);
+  mSum[1].resize(mLevels - 1);
+  mSum[2].resize(mLevels - 1);
+  int w = width, h = height;
+  for (int l = 0; l < mLevels; l++) {
+    HdrResize(mWeightSum[l], w, h);
+    HdrResize(mSum[0][l], w, h);
+    if (l > 0) {
+      HdrResize(mSum[1][l - 1], w, h);
+      HdrResize(mSum[2][l - 1], w, h);
+    }
+    w = (w + 1) / 2;
+    h = (h + 1) / 2;
+  }
+}
+
+/**
+ * @brief Mertens weight of every luma pixel: local contrast, chroma
+ * saturation and closeness to mid grey
+ *
+ * @param yuv
+ */
+void HdrFusion::ComputeWeights(const unsigned char* yuv) {
+  const int w           = mWidth;
+  const int h           = mHeight;
+  const int hw          = w / 2;
+  const unsigned char* u = yuv + static_cast<size_t>(w) * h;
+  const unsigned char* v = u + static_cast<size_t>(hw) * (h / 2);
+  const bool linear     = mConfig.contrastWeight == 1.0f &&
+                      mConfig.saturationWeight == 1.0f;
+  HdrPlane& weight = mWeight[0];
+  weight.width     = w;
+  weight.height    = h;
+  weight.data.resize(static_cast<size_t>(w) * h);
+
+  HdrForBands(h, [&](int y0, int y1) {
+    std::vector<float> saturation(hw + 1);
+    std::vector<float> contrast(w);
+    for (int y = y0; y < y1; y++) {
+      const unsigned char* up   = yuv + std::max(y - 1, 0) * w;
+      const unsigned char* row  = yuv + y * w;
+      const unsigned char* down = yuv + std::min(y + 1, h - 1) * w;
+      const unsigned char* ur   = u + (y / 2) * hw;
+      const unsigned char* vr   = v + (y / 2) * hw;
+      float* out                = &weight.data[static_cast<size_t>(y) * w];
+
+      int i = 0;
+#ifdef __SSE2__
+      const __m128i zero  = _mm_setzero_si128();
+      const __m128 bias   = _mm_set1_ps(128.0f);
+      const __m128 scale  = _mm_set1_ps(1.0f / 128.0f);
+      const __m128 eps    = _mm_set1_ps(HDR_WEIGHT_EPS);
+      const __m128 inv255 = _mm_set1_ps(1.0f / 255.0f);
+      const __m128 four   = _mm_set1_ps(4.0f);
+      const __m128 sign   = _mm_set1_ps(-0.0f);
+      auto load4 = [&](const unsigned char* p) {
+        int bytes;
+        std::memcpy(&bytes, p, 4);
+        __m128i b = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero);
+        return _mm_cvtepi32_ps(_mm_unpacklo_epi16(b, zero));
+      };
+      for (; i + 4 <= hw; i += 4) {
+        const __m128 du = _mm_sub_ps(load4(ur + i), bias);
+        const __m128 dv = _mm_sub_ps(load4(vr + i), bias);
+        const __m128 s  = _mm_sqrt_ps(
+            _mm_add_ps(_mm_mul_ps(du, du), _mm_mul_ps(dv, dv)));
+        _mm_storeu_ps(&saturation[i], _mm_add_ps(_mm_mul_ps(s, scale), eps));
+      }
+#endif
+      for (; i < hw; i++) {
+        const float du = ur[i] - 128.0f;
+        const float dv = vr[i] - 128.0f;
+        saturation[i] =
+            std::sqrt(du * du + dv * dv) / 128.0f + HDR_WEIGHT_EPS;
+      }
+      saturation[hw] = saturation[hw > 0 ? hw - 1 : 0];
+
+      // Absolute Laplacian of luma, edges replicate
+      auto edge = [&](int x) {
+        const int l = row[std::max(x - 1, 0)];
+        const int r = row[std::min(x + 1, w - 1)];
+        return std::abs(l + r + up[x] + down[x] - 4 * row[x]) / 255.0f +
+               HDR_WEIGHT_EPS;
+      };
+      contrast[0] = edge(0);
+      int x       = 1;
+#ifdef __SSE2__
+      for (; x + 4 <= w - 1; x += 4) {
+        const __m128 sum = _mm_add_ps(
+            _mm_add_ps(load4(row + x - 1), load4(row + x + 1)),
+            _mm_add_ps(load4(up + x), load4(down + x)));
+        const __m128 lap = _mm_sub_ps(sum, _mm_mul_ps(four, load4(row + x)));
+        _mm_storeu_ps(&contrast[x],
+                      _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, lap), inv255),
+                                 eps));
+      }
+#endif
+      for (; x < w; x++) {
+        contrast[x] = edge(x);
+      }
+
+      if (!linear) {
+        for (x = 0; x < w; x++) {
+          out[x] = std::pow(contrast[x], mConfig.contrastWeight) *
+                   std::pow(saturation[x >> 1], mConfig.saturationWeight) *
+                   mExposure[row[x]];
+        }
+        continue;
+      }
+      x = 0;
+#ifdef __SSE2__
+      for (; x + 4 <= w; x += 4) {
+        const __m128 s  = _mm_castsi128_ps(_mm_loadl_epi64(
+            reinterpret_cast<const __m128i*>(&saturation[x >> 1])));
+        const __m128 ss = _mm_unpacklo_ps(s, s);
+        const __m128 e  = _mm_setr_ps(mExposure[row[x]], mExposure[row[x + 1]],
+                                     mExposure[row[x + 2]],
+                                     mExposure[row[x + 3]]);
+        const __m128 c  = _mm_loadu_ps(&contrast[x]);
+        _mm_storeu_ps(out + x, _mm_mul_ps(_mm_mul_ps(c, ss), e));
+      }
+#endif
+      for (; x < w; x++) {
+        out[x] = contrast[x] * saturation[x >> 1] * mExposure[row[x]];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Level 0 of mGaussian from an 8 bit plane
+ *
+ * @param src
+ * @param dst
+ */
+void HdrFusion::LoadPlane(const unsigned char* src, HdrPlane& dst) const {
+  dst.data.resize(static_cast<size_t>(dst.width) * dst.height);
+  for (size_t i = 0; i < dst.data.size(); i++) {
+    dst.data[i] = src[i];
+  }
+}
+
+/**
+ * @brief Add the weighted Laplacian pyramid of mGaussian to sum. Each band
+ * expands the coarser level and blends the difference right away, so the
+ * Laplacian level is never stored.
+ *
+ * @param gaussian
+ * @param weightOffset weight level matching level 0 of gaussian
+ * @param sum
+ */
+void HdrFusion::Accumulate(std::vector<HdrPlane>& gaussian, int weightOffset,
+                           std::vector<HdrPlane>& sum) {
+  const int levels = static_cast<int>(sum.size());
+  for (int l = 0; l + 1 < levels; l++) {
+    HdrReduce(gaussian[l], gaussian[l + 1]);
+  }
+  for (int l = 0; l < levels; l++) {
+    const HdrPlane& fine   = gaussian[l];
+    const HdrPlane& weight = mWeight[l + weightOffset];
+    HdrPlane& acc          = sum[l];
+    const int w            = fine.width;
+    const bool top         = l + 1 == levels;
+    HdrForBands(fine.height, [&](int y0, int y1) {
+      std::vector<float> rows;
+      std::vector<float> expanded;
+      if (!top) {
+        expanded.resize(static_cast<size_t>(y1 - y0) * w);
+        HdrExpandBand(gaussian[l + 1], w, y0, y1, rows, expanded.data());
+      }
+      for (int y = y0; y < y1; y++) {
+        const size_t offset = static_cast<size_t>(y) * w;
+        HdrMultiplyAdd(&acc.data[offset], &weight.data[offset],
+                       &fine.data[offset],
+                       top ? nullptr : &expanded[(y - y0) * w], w);
+      }
+    });
+  }
+}
+
+/**
+ * @brief Normalise the sums and collapse the pyramid into an 8 bit plane
+ *
+ * @param sum
+ * @param weightOffset
+ * @param dst
+ */
+void HdrFusion::Collapse(std::vector<HdrPlane>& sum, int weightOffset,
+                         unsigned char* dst) {
+  const int levels = static_cast<int>(sum.size());
+  for (int l = levels - 1; l >= 0; l--) {
+    HdrPlane& level            = sum[l];
+    const HdrPlane& weightSum  = mWeightSum[l + weightOffset];
+    const int w                = level.width;
+    const bool top             = l + 1 == levels;
+    HdrForBands(level.height, [&](int y0, int y1) {
+      std::vector<float> rows;
+      std::vector<float> expanded;
+      if (!top) {
+        expanded.resize(static_cast<size_t>(y1 - y0) * w);
+        HdrExpandBand(sum[l + 1], w, y0, y1, rows, expanded.data());
+      }
+      for (int y = y0; y < y1; y++) {
+        const size_t offset = static_cast<size_t>(y) * w;
+        HdrNormalise(&level.data[offset], &level.data[offset],
+                     &weightSum.data[offset],
+                     top ? nullptr : &expanded[(y - y0) * w], w);
+      }
+    });
+  }
+
+  const std::vector<float>& result = sum[0].data;
+  for (size_t i = 0; i < result.size(); i++) {
+    dst[i] = static_cast<unsigned char>(
+        std::min(255.0f, std::max(0.0f, result[i] + 0.5f)));
+  }
+}
+
+/**
+ * @brief Blend in one exposure
+ *
+ * @param yuv
+ */
+void HdrFusion::Add(const unsigned char* yuv) {
+  ComputeWeights(yuv);
+  for (int l = 0; l + 1 < mLevels; l++) {
+    HdrReduce(mWeight[l], mWeight[l + 1]);
+  }
+  for (int l = 0; l < mLevels; l++) {
+    HdrAdd(mWeightSum[l].data.data(), mWeight[l].data.data(),
+           mWeight[l].data.size());
+  }
+
+  const size_t lumaSize   = static_cast<size_t>(mWidth) * mHeight;
+  const size_t chromaSize = lumaSize / 4;
+  mGaussian.resize(mLevels);
+  for (int plane = 0; plane < 3; plane++) {
+    HdrPlane& base = mGaussian[0];
+    base.width     = plane ? mWidth / 2 : mWidth;
+    base.height    = plane ? mHeight / 2 : mHeight;
+    LoadPlane(plane ? yuv + lumaSize + (plane - 1) * chromaSize : yuv, base);
+    Accumulate(mGaussian, plane ? 1 : 0, mSum[plane]);
+  }
+}
+
+/**
+ * @brief Write the fused YUV420 frame
+ *
+ * @param output
+ */
+void HdrFusion::Finish(std::vector<unsigned char>& output) {
+  const size_t lumaSize   = static_cast<size_t>(mWidth) * mHeight;
+  const size_t chromaSize = lumaSize / 4;
+  output.resize(lumaSize + 2 * chromaSize);
+  Collapse(mSum[0], 0, output.data());
+  Collapse(mSum[1], 1, output.data() + lumaSize);
+  Collapse(mSum[2], 1, output.data() + lumaSize + chromaSize);
+}
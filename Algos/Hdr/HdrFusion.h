@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef HDR_FUSION_H
+#define HDR_FUSION_H
+
+#include <vector>
+
+/**
+ * @brief Exponents of the Mertens quality measures, read from
+ * HdrAlgorithm.config
+ */
+struct HdrFusionConfig {
+  float contrastWeight   = 1.0f;
+  float saturationWeight = 1.0f;
+  float exposureWeight   = 1.0f;
+  int levels             = 0;  // Pyramid levels, 0 picks from the size
+};
+
+/**
+ * @brief One float plane of a pyramid level
+ */
+struct HdrPlane {
+  int width  = 0;
+  int height = 0;
+  std::vector<float> data;
+};
+
+/**
+ * @brief Mertens exposure fusion of YUV420 frames. Exposures are added one
+ * at a time: each gets a weight map (contrast, saturation, well-exposedness)
+ * whose Gaussian pyramid blends its Laplacian pyramid into running sums, so
+ * only one input pyramid is alive at any time. Pyramid levels are built,
+ * blended and collapsed in row bands on TileExecutor. Every level is still
+ * a whole float plane: the coarse levels draw on most of the frame, so a
+ * tile would need a halo nearly as large as the frame to give the same
+ * result.
+ */
+class HdrFusion {
+ public:
+  explicit HdrFusion(const HdrFusionConfig& config);
+
+  // Start a fused frame, even width and height
+  void Begin(int width, int height);
+
+  // Blend in one YUV420 exposure of the Begin() size
+  void Add(const unsigned char* yuv);
+
+  // Normalise, collapse and write the YUV420 result
+  void Finish(std::vector<unsigned char>& output);
+
+ private:
+  void ComputeWeights(const unsigned char* yuv);
+  void LoadPlane(const unsigned char* src, HdrPlane& dst) const;
+  void Accumulate(std::vector<HdrPlane>& gaussian, int weightOffset,
+                  std::vector<HdrPlane>& sum);
+  void Collapse(std::vector<HdrPlane>& sum, int weightOffset,
+                unsigned char* dst);
+
+  HdrFusionConfig mConfig;
+  int mWidth  = 0;
+  int mHeight = 0;
+  int mLevels = 0;
+  float mExposure[256];  // Well-exposedness per luma value
+  std::vector<HdrPlane> mWeight;     // Gaussian pyramid of this exposure
+  std::vector<HdrPlane> mWeightSum;  // Sum of weight pyramids
+  std::vector<HdrPlane> mGaussian;   // Gaussian pyramid of one plane
+  std::vector<HdrPlane> mSum[3];     // Weighted Laplacian sums, Y U V
+};
+
+#endif  // HDR_FUSION_H
@@ -20,12 +20,36 @@
  * THE SOFTWARE.
  */
 #include "LdcAlgorithm.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
 #include "ConfigParser.h"
 #include "Log.h"
-#ifdef __OPENCV_ENABLE__
-#include <cmath>
-#include <opencv2/opencv.hpp>
-#endif
+#include "WarpEngine.h"
+
+/**
+ * @brief Remap tables for one (resolution, lens) pair
+ */
+struct LdcRemapTable {
+  WarpMap luma;
+  WarpMap chroma;  // Half resolution, shared by U and V of any 4:2:0 layout
+};
+
+/**
+ * @brief Input blocks read by each output block of a remap table
+ */
+struct LdcBlockSources {
+  std::shared_ptr<const LdcRemapTable> table;
+  int blockSize = 0;
+  std::vector<WarpTile> sources;  // In blocks, width 0 if only border is read
+};
+
+bool LdcParams::operator<(const LdcParams& other) const {
+  return std::tie(k1, k2, k3, p1, p2, fx, fy, cx, cy) <
+         std::tie(other.k1, other.k2, other.k3, other.p1, other.p2, other.fx,
+                  other.fy, other.cx, other.cy);
+}
 
 /**
  * @brief Constructor for LdcAlgorithm.
@@ -35,6 +59,8 @@ LdcAlgorithm::LdcAlgorithm() : AlgoBase(LDC_NAME) {
   mAlgoId = ALGO_LDC;  // Unique ID for ldc algorithm
 
   SupportedFormatsMap.push_back({ImageFormat::YUV420, ImageFormat::YUV420});
+  SupportedFormatsMap.push_back({ImageFormat::NV12, ImageFormat::NV12});
+  SupportedFormatsMap.push_back({ImageFormat::NV21, ImageFormat::NV21});
   SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::RGB});
   SupportedFormatsMap.push_back(
       {ImageFormat::GRAYSCALE, ImageFormat::GRAYSCALE});
@@ -47,6 +73,26 @@ LdcAlgorithm::LdcAlgorithm() : AlgoBase(LDC_NAME) {
   if (parser.getErrorCode() == 0) {
     LOG(VERBOSE, ALGOBASE, "Ldc Algo Version: %s", Version.c_str());
   }
+
+  if (parser.getValue("Mode") == "Perspective") {
+    mMode = LdcMode::PERSPECTIVE;
+  }
+  auto readFloat = [&parser](const std::string& key, float& value) {
+    if (!parser.getValue(key).empty()) {
+      value = parser.getFloatValue(key);
+    }
+  };
+  readFloat("K1", mParams.k1);
+  readFloat("K2", mParams.k2);
+  readFloat("K3", mParams.k3);
+  readFloat("P1", mParams.p1);
+  readFloat("P2", mParams.p2);
+  readFloat("Fx", mParams.fx);
+  readFloat("Fy", mParams.fy);
+  readFloat("Cx", mParams.cx);
+  readFloat("Cy", mParams.cy);
+  LOG(VERBOSE, ALGOBASE, "Ldc k=(%f %f %f) p=(%f %f)", mParams.k1,
+      mParams.k2, mParams.k3, mParams.p1, mParams.p2);
 }
 
 /**
@@ -68,48 +114,429 @@ AlgoBase::AlgoStatus LdcAlgorithm::Open() {
   return GetAlgoStatus();
 }
 
-#if __OPENCV_ENABLE__
 /**
- * @brief Get the Transformation Matrix object
- * 
- * @param scale 
- * @param rotationDeg 
- * @param tx 
- * @param ty 
- * @return cv::Mat 
+ * @brief Fill the remap table of one plane. For every output (undistorted)
+ * pixel the lens model gives the distorted position to sample in the input.
+ *
+ * @param params
+ * @param width luma width
+ * @param height luma height
+ * @param subsample 1 for luma, 2 for 4:2:0 chroma
+ * @param map
  */
-cv::Mat GetTransformationMatrix(float scale = 1.0, float rotationDeg = 0.0,
-                                float tx = 0.0, float ty = 0.0) {
-  // Define source points (original image corners)
-  cv::Point2f srcPoints[4] = {
-      cv::Point2f(0, 0),  // Top-left
-      cv::Point2f(1, 0),  // Top-right
-      cv::Point2f(1, 1),  // Bottom-right
-      cv::Point2f(0, 1)   // Bottom-left
-  };
+static void BuildLdcPlaneMap(const LdcParams& params, int width, int height,
+                             int subsample, WarpMap& map) {
+  WarpInitMap(map, width / subsample, height / subsample);
+
+  const double fx = params.fx > 0.0f
+                        ? params.fx * width
+                        : 0.5 * std::sqrt(double(width) * width +
+                                          double(height) * height);
+  const double fy = params.fy > 0.0f ? params.fy * width : fx;
+  const double cx = params.cx * width;
+  const double cy = params.cy * height;
+  // Plane sample centre in luma coordinates and back
+  const double offset = (subsample - 1) * 0.5;
 
-  // Convert rotation from degrees to radians
-  float rotationRad = rotationDeg * (CV_PI / 180.0);
+  for (int v = 0; v < map.height; v++) {
+    const double y = (v * subsample + offset - cy) / fy;
+    for (int u = 0; u < map.width; u++) {
+      const double x  = (u * subsample + offset - cx) / fx;
+      const double r2 = x * x + y * y;
+      const double radial =
+          1.0 + r2 * (params.k1 + r2 * (params.k2 + r2 * params.k3));
+      const double xd = x * radial + 2.0 * params.p1 * x * y +
+                        params.p2 * (r2 + 2.0 * x * x);
+      const double yd = y * radial + params.p1 * (r2 + 2.0 * y * y) +
+                        2.0 * params.p2 * x * y;
+      WarpSetEntry(map, u, v, ((xd * fx + cx) - offset) / subsample,
+                   ((yd * fy + cy) - offset) / subsample);
+    }
+  }
+  WarpBuildTiles(map);
+}
 
-  // Compute transformed destination points
-  cv::Point2f dstPoints[4];
-  for (int i = 0; i < 4; ++i) {
-    // Apply scaling and rotation
-    float x = srcPoints[i].x - 0.5;  // Centering
-    float y = srcPoints[i].y - 0.5;
+/**
+ * @brief Remap tables are cached per (resolution, lens) and shared by every
+ * LDC instance in the process; a table lives while some instance holds it.
+ *
+ * @param width
+ * @param height
+ * @param params
+ * @return std::shared_ptr<const LdcRemapTable>
+ */
+static std::shared_ptr<const LdcRemapTable> GetLdcRemapTable(
+    int width, int height, const LdcParams& params) {
+  using Key = std::tuple<int, int, LdcParams>;
+  static std::mutex cacheMutex;
+  static std::map<Key, std::weak_ptr<const LdcRemapTable>> cache;
 
-    float xNew = scale * (x * cos(rotationRad) - y * sin(rotationRad));
-    float yNew = scale * (x * sin(rotationRad) + y * cos(rotationRad));
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  const Key key(width, height, params);
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    if (auto table = it->second.lock()) {
+      return table;
+    }
+  }
 
-    // Apply translation
-    dstPoints[i] = cv::Point2f(xNew + 0.5 + tx, yNew + 0.5 + ty);
+  // Drop tables nobody uses any more before adding a new one
+  for (auto entry = cache.begin(); entry != cache.end();) {
+    entry = entry->second.expired() ? cache.erase(entry) : std::next(entry);
   }
 
-  // Compute perspective transformation matrix
-  return cv::getPerspectiveTransform(srcPoints, dstPoints);
+  auto table = std::make_shared<LdcRemapTable>();
+  BuildLdcPlaneMap(params, width, height, 1, table->luma);
+  BuildLdcPlaneMap(params, width, height, 2, table->chroma);
+  cache[key] = table;
+  LOG(VERBOSE, ALGOBASE, "Ldc remap table built for %dx%d", width, height);
+  return table;
+}
+
+/**
+ * @brief Smallest tile holding both, a tile of width 0 is empty
+ *
+ * @param a
+ * @param b
+ * @return WarpTile
+ */
+static WarpTile LdcUnionTiles(const WarpTile& a, const WarpTile& b) {
+  if (a.width <= 0) {
+    return b;
+  }
+  if (b.width <= 0) {
+    return a;
+  }
+  WarpTile tile;
+  tile.x      = std::min(a.x, b.x);
+  tile.y      = std::min(a.y, b.y);
+  tile.width  = std::max(a.x + a.width, b.x + b.width) - tile.x;
+  tile.height = std::max(a.y + a.height, b.y + b.height) - tile.y;
+  return tile;
 }
 
-#endif
+/**
+ * @brief Output blocks that read a dirty input block. The source footprint
+ * of every output block is scanned once per table and block size.
+ *
+ * @param input
+ * @return std::shared_ptr<DirtyBlockMask>
+ */
+std::shared_ptr<DirtyBlockMask> LdcAlgorithm::GetDirtyOutputBlocks(
+    const DirtyBlockMask& input) {
+  const int block = input.blockSize;
+  if (!mBlockSources || mBlockSources->table != mRemap ||
+      mBlockSources->blockSize != block) {
+    auto sources       = std::make_shared<LdcBlockSources>();
+    sources->table     = mRemap;
+    sources->blockSize = block;
+
+    const WarpMap& luma   = mRemap->luma;
+    const WarpMap& chroma = mRemap->chroma;
+    for (int by = 0; by < input.blocksY; by++) {
+      for (int bx = 0; bx < input.blocksX; bx++) {
+        WarpTile tile;
+        tile.x      = bx * block;
+        tile.y      = by * block;
+        tile.width  = std::min(block, luma.width - tile.x);
+        tile.height = std::min(block, luma.height - tile.y);
+
+        WarpTile bounds = WarpGetSourceBounds(luma, tile);
+
+        // 4:2:0 chroma samples its own map, count its footprint in luma units
+        WarpTile half;
+        half.x      = tile.x / 2;
+        half.y      = tile.y / 2;
+        half.width  = std::min(block / 2, chroma.width - half.x);
+        half.height = std::min(block / 2, chroma.height - half.y);
+        if (half.width > 0 && half.height > 0) {
+          WarpTile c = WarpGetSourceBounds(chroma, half);
+          c.x *= 2;
+          c.y *= 2;
+          c.width *= 2;
+          c.height *= 2;
+          bounds = LdcUnionTiles(bounds, c);
+        }
+
+        WarpTile range;
+        if (bounds.width > 0) {
+          range.x      = bounds.x / block;
+          range.y      = bounds.y / block;
+          range.width  = std::min((bounds.x + bounds.width - 1) / block,
+                                  input.blocksX - 1) - range.x + 1;
+          range.height = std::min((bounds.y + bounds.height - 1) / block,
+                                  input.blocksY - 1) - range.y + 1;
+        }
+        sources->sources.push_back(range);
+      }
+    }
+    mBlockSources = sources;
+  }
+
+  auto output = std::make_shared<DirtyBlockMask>(input);
+  for (int i = 0; i < input.blocksX * input.blocksY; i++) {
+    const WarpTile& range = mBlockSources->sources[i];
+    uint8_t dirty         = 0;
+    for (int y = range.y; !dirty && y < range.y + range.height; y++) {
+      for (int x = range.x; !dirty && x < range.x + range.width; x++) {
+        dirty = input.IsDirty(x, y) ? 1 : 0;
+      }
+    }
+    output->dirty[i] = dirty;
+  }
+  return output;
+}
+
+/**
+ * @brief Undistort one image with the cached tables. The input is read in
+ * place and the result swapped into it, the old buffer is kept for the next
+ * frame. With a dirty block mask only output blocks reading changed input
+ * are remapped, the rest is copied from the stream's previous output.
+ *
+ * @param image
+ * @param req
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus LdcAlgorithm::ProcessDistortion(
+    std::shared_ptr<ImageData> image, std::shared_ptr<AlgoRequest> req) {
+  const ImageFormat format = image->GetFormat();
+  const int width          = image->GetWidth();
+  const int height         = image->GetHeight();
+  std::vector<unsigned char>& data = image->GetData();
+
+  size_t expected = 0;
+  switch (format) {
+    case ImageFormat::YUV420:
+    case ImageFormat::NV12:
+    case ImageFormat::NV21:
+      expected = static_cast<size_t>(width) * height * 3 / 2;
+      break;
+    case ImageFormat::RGB:
+      expected = static_cast<size_t>(width) * height * 3;
+      break;
+    case ImageFormat::GRAYSCALE:
+      expected = static_cast<size_t>(width) * height;
+      break;
+    default:
+      // Nothing to correct, leave the image as it is
+      return GetAlgoStatus();
+  }
+  if (width <= 0 || height <= 0 || data.size() < expected) {
+    LOG(ERROR, ALGOBASE, "Ldc input %dx%d has %zu bytes", width, height,
+        data.size());
+    SetStatus(AlgoStatus::FAILURE);
+    return GetAlgoStatus();
+  }
+
+  if (!mRemap || mRemap->luma.width != width ||
+      mRemap->luma.height != height) {
+    mRemap = GetLdcRemapTable(width, height, mParams);
+  }
+
+  auto& state = GetStreamState<LdcStreamState>(req);
+  std::shared_ptr<DirtyBlockMask> outputBlocks;
+  if (req->mDirtyBlocks && req->mDirtyBlocks->width == width &&
+      req->mDirtyBlocks->height == height) {
+    outputBlocks = GetDirtyOutputBlocks(*req->mDirtyBlocks);
+  }
+  const bool reuse =
+      outputBlocks && GetReusableBlocks(req, state.history) != nullptr;
+
+  // Whole planes, or the dirty output blocks on top of the last output
+  std::vector<WarpTile> lumaTiles;
+  std::vector<WarpTile> chromaTiles;
+  if (reuse) {
+    mOutput = static_cast<const ImageData&>(*state.history.output).GetData();
+
+    const int block = outputBlocks->blockSize;
+    for (int by = 0; by < outputBlocks->blocksY; by++) {
+      for (int bx = 0; bx < outputBlocks->blocksX; bx++) {
+        if (!outputBlocks->IsDirty(bx, by)) {
+          continue;
+        }
+        WarpTile tile;
+        tile.x      = bx * block;
+        tile.y      = by * block;
+        tile.width  = std::min(block, width - tile.x);
+        tile.height = std::min(block, height - tile.y);
+        lumaTiles.push_back(tile);
+        WarpTile half;
+        half.x      = tile.x / 2;
+        half.y      = tile.y / 2;
+        half.width  = std::min(block / 2, width / 2 - half.x);
+        half.height = std::min(block / 2, height / 2 - half.y);
+        if (half.width > 0 && half.height > 0) {
+          chromaTiles.push_back(half);
+        }
+      }
+    }
+  } else {
+    mOutput.resize(data.size());
+    lumaTiles   = mRemap->luma.tiles;
+    chromaTiles = mRemap->chroma.tiles;
+  }
+
+  if (format == ImageFormat::YUV420) {
+    const unsigned char* ySrc = data.data();
+    unsigned char* yDst       = mOutput.data();
+    WarpRemapTiles(mRemap->luma, lumaTiles, &ySrc, &yDst, 1, 1, 16);
+
+    const size_t chromaSize = static_cast<size_t>(width / 2) * (height / 2);
+    const unsigned char* uvSrc[2] = {data.data() + width * height,
+                                     data.data() + width * height + chromaSize};
+    unsigned char* uvDst[2]       = {mOutput.data() + width * height,
+                                     mOutput.data() + width * height + chromaSize};
+    WarpRemapTiles(mRemap->chroma, chromaTiles, uvSrc, uvDst, 2, 1, 128);
+  } else if (format == ImageFormat::NV12 || format == ImageFormat::NV21) {
+    const unsigned char* ySrc = data.data();
+    unsigned char* yDst       = mOutput.data();
+    WarpRemapTiles(mRemap->luma, lumaTiles, &ySrc, &yDst, 1, 1, 16);
+
+    // U and V interleaved share the chroma map, one pass for both
+    const unsigned char* uvSrc = data.data() + width * height;
+    unsigned char* uvDst       = mOutput.data() + width * height;
+    WarpRemapTiles(mRemap->chroma, chromaTiles, &uvSrc, &uvDst, 1, 2, 128);
+  } else {
+    const int cn             = (format == ImageFormat::RGB) ? 3 : 1;
+    const unsigned char* src = data.data();
+    unsigned char* dst       = mOutput.data();
+    WarpRemapTiles(mRemap->luma, lumaTiles, &src, &dst, 1, cn, 0);
+  }
+
+  data.swap(mOutput);
+  req->mDirtyBlocks = outputBlocks;
+  UpdateBlockHistory(state.history, req);
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief Get the output to source matrix of the zoom. The forward transform
+ * scales and rotates about (0.5, 0.5) and translates, as the unit square
+ * perspective transform used to.
+ *
+ * @param matrix row major 3x3
+ * @param scale
+ * @param rotationDeg
+ * @param tx
+ * @param ty
+ * @return true
+ * @return false the transform is singular
+ */
+static bool GetInverseTransformationMatrix(double matrix[9], float scale = 1.0,
+                                           float rotationDeg = 0.0,
+                                           float tx = 0.0, float ty = 0.0) {
+  if (scale == 0.0f) {
+    return false;
+  }
+  const double rotationRad = rotationDeg * (M_PI / 180.0);
+  const double c           = std::cos(rotationRad) / scale;
+  const double s           = std::sin(rotationRad) / scale;
+  // Undo the translation, then the rotation and scale about the centre
+  const double ux = -0.5 - tx;
+  const double uy = -0.5 - ty;
+  matrix[0]       = c;
+  matrix[1]       = s;
+  matrix[2]       = c * ux + s * uy + 0.5;
+  matrix[3]       = -s;
+  matrix[4]       = c;
+  matrix[5]       = -s * ux + c * uy + 0.5;
+  matrix[6]       = 0.0;
+  matrix[7]       = 0.0;
+  matrix[8]       = 1.0;
+  return true;
+}
+
+/**
+ * @brief Same mapping on half resolution 4:2:0 chroma, where chroma sample c
+ * sits at luma position 2c + 0.5
+ *
+ * @param luma
+ * @param chroma
+ */
+static void GetChromaMatrix(const double luma[9], double chroma[9]) {
+  const double toLuma[9]   = {2.0, 0.0, 0.5, 0.0, 2.0, 0.5, 0.0, 0.0, 1.0};
+  const double toChroma[9] = {0.5, 0.0, -0.25, 0.0, 0.5, -0.25, 0.0, 0.0, 1.0};
+  double tmp[9];
+  for (int r = 0; r < 3; r++) {
+    for (int c = 0; c < 3; c++) {
+      tmp[r * 3 + c] = luma[r * 3] * toLuma[c] + luma[r * 3 + 1] * toLuma[3 + c] +
+                       luma[r * 3 + 2] * toLuma[6 + c];
+    }
+  }
+  for (int r = 0; r < 3; r++) {
+    for (int c = 0; c < 3; c++) {
+      chroma[r * 3 + c] = toChroma[r * 3] * tmp[c] +
+                          toChroma[r * 3 + 1] * tmp[3 + c] +
+                          toChroma[r * 3 + 2] * tmp[6 + c];
+    }
+  }
+}
+
+/**
+ * @brief Animated perspective zoom, kept as the demo mode
+ *
+ * @param image
+ * @param req
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus LdcAlgorithm::ProcessPerspective(
+    std::shared_ptr<ImageData> image, std::shared_ptr<AlgoRequest> req) {
+  const int width                  = image->GetWidth();
+  const int height                 = image->GetHeight();
+  const ImageFormat format         = image->GetFormat();
+  std::vector<unsigned char>& data = image->GetData();
+  if ((format != ImageFormat::YUV420 && format != ImageFormat::NV12 &&
+       format != ImageFormat::NV21) ||
+      data.size() < static_cast<size_t>(width) * height * 3 / 2) {
+    return GetAlgoStatus();
+  }
+
+  // Every stream sweeps the scale on its own frame count
+  auto& state           = GetStreamState<LdcStreamState>(req);
+  constexpr float delta = 0.01f;
+
+  if (state.frameCount++ % 10 == 0) {
+    if (state.scale >= 1.0f) {
+      state.scale      = 1.0f;
+      state.increasing = false;
+    } else if (state.scale <= 0.0f) {
+      state.scale      = 0.0f;
+      state.increasing = true;
+    }
+
+    // Adjust scale based on direction
+    state.scale += (state.increasing ? delta : -delta);
+  }
+
+  double lumaMatrix[9];
+  double chromaMatrix[9];
+  if (!GetInverseTransformationMatrix(lumaMatrix, state.scale, 0.0, 0, 0)) {
+    return GetAlgoStatus();
+  }
+  GetChromaMatrix(lumaMatrix, chromaMatrix);
+
+  // Warp each plane from the input buffer straight into the output buffer
+  mOutput.resize(data.size());
+  const size_t chromaSize = static_cast<size_t>(width / 2) * (height / 2);
+  const unsigned char* ySrc = data.data();
+  unsigned char* yDst       = mOutput.data();
+  WarpPerspective(&ySrc, &yDst, 1, width, height, 1, lumaMatrix, 16);
+
+  const unsigned char* uvSrc[2] = {data.data() + width * height,
+                                   data.data() + width * height + chromaSize};
+  unsigned char* uvDst[2]       = {mOutput.data() + width * height,
+                                   mOutput.data() + width * height + chromaSize};
+  if (format == ImageFormat::YUV420) {
+    WarpPerspective(uvSrc, uvDst, 2, width / 2, height / 2, 1, chromaMatrix,
+                    128);
+  } else {
+    // Interleaved U,V pairs in one pass
+    WarpPerspective(uvSrc, uvDst, 1, width / 2, height / 2, 2, chromaMatrix,
+                    128);
+  }
+  data.swap(mOutput);
+  return GetAlgoStatus();
+}
 
 /**
  * @brief Process the ldc algorithm, simulating input validation and ldc
@@ -123,82 +550,19 @@ AlgoBase::AlgoStatus LdcAlgorithm::Process(std::shared_ptr<AlgoRequest> req) {
     SetStatus(AlgoStatus::FAILURE);
     return GetAlgoStatus();
   }
-#ifdef __OPENCV_ENABLE__
   auto inputImage = req->GetImage(0);  // Assume first image as input
   if (!inputImage) {
     SetStatus(AlgoStatus::FAILURE);
     return GetAlgoStatus();
   }
 
-  const ImageFormat inputFormat = inputImage->GetFormat();
-  const int width               = inputImage->GetWidth();
-  const int height              = inputImage->GetHeight();
-
-  if (CanProcessFormat(inputFormat, inputFormat)) {
-    // Extract YUV data from the input image
-    std::vector<unsigned char> yuvData = inputImage->GetData();
-    if (yuvData.empty()) {
-      SetStatus(AlgoStatus::FAILURE);
-      return GetAlgoStatus();
-    }
-
-    // Split Y, U, and V planes (Assuming YUV420 format)
-    cv::Mat yPlane(height, width, CV_8UC1, yuvData.data());
-    cv::Mat uPlane(height / 2, width / 2, CV_8UC1,
-                   yuvData.data() + width * height);
-    cv::Mat vPlane(
-        height / 2, width / 2, CV_8UC1,
-        yuvData.data() + width * height + (width / 2) * (height / 2));
-
-    // Get transformation matrix (Assume it’s precomputed)
-    static float scale     = 0.0f;
-    constexpr float delta  = 0.01f;
-    static bool increasing = true;
-
-    if (req->mRequestId % 10 == 0) {
-      if (scale >= 1.0f) {
-        scale      = 1.0f;
-        increasing = false;
-      } else if (scale <= 0.0f) {
-        scale      = 0.0f;
-        increasing = true;
-      }
-
-      // Adjust scale based on direction
-      scale += (increasing ? delta : -delta);
-    }
-
-    cv::Mat transformationMatrix = GetTransformationMatrix(scale, 0.0, 0, 0);
-
-    // Apply LDC transformation on the Y channel
-    cv::Mat yPlaneWarped;
-    cv::warpPerspective(yPlane, yPlaneWarped, transformationMatrix,
-                        yPlane.size());
-
-    // Apply LDC transformation on UV channels using lower resolution
-    cv::Mat uPlaneWarped, vPlaneWarped;
-    cv::warpPerspective(uPlane, uPlaneWarped, transformationMatrix,
-                        uPlane.size());
-    cv::warpPerspective(vPlane, vPlaneWarped, transformationMatrix,
-                        vPlane.size());
-
-    // Merge back into YUV buffer
-    std::vector<unsigned char> outputData(yuvData.size());
-    std::memcpy(outputData.data(), yPlaneWarped.data, width * height);
-    std::memcpy(outputData.data() + width * height, uPlaneWarped.data,
-                (width / 2) * (height / 2));
-    std::memcpy(outputData.data() + width * height + (width / 2) * (height / 2),
-                vPlaneWarped.data, (width / 2) * (height / 2));
-
-    // Replace input image with transformed YUV image
-    req->ClearImages();
-    if (req->AddImage(ImageFormat::YUV420, width, height,
-                      std::move(outputData))) {
-      LOG(ERROR, ALGOBASE, "Error Filling Output data");
-      SetStatus(AlgoStatus::FAILURE);
-    }
+  SetStatus(AlgoStatus::SUCCESS);
+  if (mMode == LdcMode::PERSPECTIVE) {
+    ProcessPerspective(inputImage, req);
+  } else {
+    ProcessDistortion(inputImage, req);
   }
-#endif
+
   // Update metadata to mark process completion
   int reqdone = 0x00;
   if (req &&
@@ -207,7 +571,6 @@ AlgoBase::AlgoStatus LdcAlgorithm::Process(std::shared_ptr<AlgoRequest> req) {
     req->mMetadata.SetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone);
   }
 
-  SetStatus(AlgoStatus::SUCCESS);
   return GetAlgoStatus();
 }
 
@@ -231,6 +594,24 @@ int LdcAlgorithm::GetTimeout() {
   return 1000;
 }
 
+/**
+ * @brief distortion correction is stateless, perspective warp is temporal
+ *
+ * @return bool
+ */
+bool LdcAlgorithm::IsCacheable() const {
+  return mMode == LdcMode::DISTORTION;
+}
+
+/**
+ * @brief the distortion map is fixed, perspective moves every frame
+ *
+ * @return bool
+ */
+bool LdcAlgorithm::SupportsDirtyBlocks() const {
+  return mMode == LdcMode::DISTORTION;
+}
+
 // Public Exposed API for ldc
 /**
  * @brief Factory function to expose LdcAlgorithm via shared library.
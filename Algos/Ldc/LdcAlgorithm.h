@@ -22,9 +22,47 @@
 #ifndef LDC_ALGORITHM_H
 #define LDC_ALGORITHM_H
 
+#include <cstdint>
+#include <memory>
+#include <vector>
 #include "AlgoBase.h"
 const char* LDC_NAME = "LdcAlgorithm";
 
+enum class LdcMode { DISTORTION, PERSPECTIVE };
+
+/**
+ * @brief Lens model read from LdcAlgorithm.config. Brown-Conrady radial
+ * (k1..k3) and tangential (p1, p2) terms. Focal length is a fraction of the
+ * image width (0 picks half the diagonal) and the principal point a fraction
+ * of width/height, so one config fits every resolution.
+ */
+struct LdcParams {
+  float k1 = 0.0f;
+  float k2 = 0.0f;
+  float k3 = 0.0f;
+  float p1 = 0.0f;
+  float p2 = 0.0f;
+  float fx = 0.0f;
+  float fy = 0.0f;
+  float cx = 0.5f;
+  float cy = 0.5f;
+
+  bool operator<(const LdcParams& other) const;
+};
+
+struct LdcRemapTable;
+struct LdcBlockSources;
+
+/**
+ * @brief Perspective sweep position and last corrected output of one stream
+ */
+struct LdcStreamState : AlgoBase::StreamState {
+  float scale     = 0.0f;
+  bool increasing = true;
+  int frameCount  = 0;
+  AlgoBase::BlockHistory history;
+};
+
 /**
  * @brief LdcAlgorithm class derived from AlgoBase to perform LDC-specific
  * operations.
@@ -67,9 +105,23 @@ class LdcAlgorithm : public AlgoBase {
    * @return int
    */
   int GetTimeout() override;
+  bool IsCacheable() const override;
+  bool SupportsDirtyBlocks() const override;
 
  private:
   mutable std::mutex mutex_;  // Mutex to protect the shared state
+  LdcMode mMode = LdcMode::DISTORTION;
+  LdcParams mParams;
+  std::shared_ptr<const LdcRemapTable> mRemap;  // Table for last resolution
+  std::vector<unsigned char> mOutput;  // Swapped with the input every frame
+  std::shared_ptr<const LdcBlockSources> mBlockSources;
+
+  AlgoStatus ProcessDistortion(std::shared_ptr<ImageData> image,
+                               std::shared_ptr<AlgoRequest> req);
+  std::shared_ptr<DirtyBlockMask> GetDirtyOutputBlocks(
+      const DirtyBlockMask& input);
+  AlgoStatus ProcessPerspective(std::shared_ptr<ImageData> image,
+                                std::shared_ptr<AlgoRequest> req);
 };
 
 /**
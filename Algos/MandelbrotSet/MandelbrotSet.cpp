@@ -22,6 +22,7 @@
 #include "MandelbrotSet.h"
 #include <cmath>
 #include <complex>
+#include "ColorConvert.h"
 #include "ConfigParser.h"
 #include "Log.h"
 
@@ -50,14 +51,11 @@ std::pair<double, double> MapToComplexPlane(int px, int py, int width,
 /**
  * @brief Constructor for MandelbrotSet.
  */
-MandelbrotSet::MandelbrotSet()
-    : AlgoBase(MANDELBROTSET_NAME), zoomLevel(INITIAL_ZOOM) {
-  modelIdx = (int)MandelbrotSetCentre::Seahorse_Valley;
-  offsetX  = CentreCordinates[modelIdx][0];
-  offsetY  = CentreCordinates[modelIdx][1];
-  mAlgoId  = ALGO_MANDELBROTSET;  // Unique ID for MANDELBROTSET algorithm
+MandelbrotSet::MandelbrotSet() : AlgoBase(MANDELBROTSET_NAME) {
+  mAlgoId = ALGO_MANDELBROTSET;  // Unique ID for MANDELBROTSET algorithm
   SupportedFormatsMap.push_back({ImageFormat::YUV420, ImageFormat::YUV420});
   SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::RGB});
+  SupportedFormatsMap.push_back({ImageFormat::RGBP, ImageFormat::RGBP});
   ConfigParser parser;
   mConfigFile = CONFIGPATH;
   mConfigFile += AlgoBase::GetAlgorithmName();
@@ -110,27 +108,47 @@ AlgoBase::AlgoStatus MandelbrotSet::Process(std::shared_ptr<AlgoRequest> req) {
   const int width               = inputImage->GetWidth();
   const int height              = inputImage->GetHeight();
   if (true == CanProcessFormat(inputFormat, inputFormat)) {
+    auto& state = GetStreamState<MandelbrotStreamState>(req);
 
-    if (req->mRequestId % 30 == 0) {
+    if (state.frameCount++ % 30 == 0) {
       /* Reset offset and zoom level smoothly */
-      modelIdx++;
-      modelIdx = modelIdx % 3;
-      offsetX += (CentreCordinates[modelIdx][0] - offsetX) * 0.1;
-      offsetY += (CentreCordinates[modelIdx][1] - offsetY) * 0.1;
-      zoomLevel = INITIAL_ZOOM;
+      state.modelIdx++;
+      state.modelIdx = state.modelIdx % 3;
+      state.offsetX += (CentreCordinates[state.modelIdx][0] - state.offsetX) *
+                       0.1;
+      state.offsetY += (CentreCordinates[state.modelIdx][1] - state.offsetY) *
+                       0.1;
+      state.zoomLevel = INITIAL_ZOOM;
     }
 
-    // Preallocate combined YUV420 buffer for output
-
-    std::vector<unsigned char> outputData(width * height * 3, 0);  // RGB format
+    // RGB output, as R, G and B planes when fed planar RGB so every channel
+    // is stored to its own row
+    const ImageFormat outputFormat = inputFormat == ImageFormat::RGBP
+                                         ? ImageFormat::RGBP
+                                         : ImageFormat::RGB;
+    const bool planar = outputFormat == ImageFormat::RGBP;
+    std::vector<unsigned char> outputData(width * height * 3, 0);
+    const size_t planeSize = static_cast<size_t>(width) * height;
+    // Each row is coloured into one R, G and B row: straight into the planes
+    // for planar output, into scratch rows interleaved afterwards otherwise
+    std::vector<unsigned char> scratch(planar ? 0 : width * 3);
+    unsigned char* rows[3] = {scratch.data(), scratch.data() + width,
+                              scratch.data() + 2 * width};
 
     // Parallelized computation using OpenMP
     //#pragma omp parallel for schedule(dynamic)
     for (int py = 0; py < height; ++py) {
+      const size_t rowStart = static_cast<size_t>(py) * width;
+      if (planar) {
+        for (int c = 0; c < 3; c++) {
+          rows[c] = outputData.data() + c * planeSize + rowStart;
+        }
+      }
       for (int px = 0; px < width; ++px) {
         // Map pixel to the complex plane
-        auto [cx, cy] = MapToComplexPlane(px, py, width, height, zoomLevel,
-                                          offsetX, offsetY);
+        auto [cx, cy] = MapToComplexPlane(px, py, width, height,
+                                          state.zoomLevel, state.offsetX,
+                                          state.offsetY);
 
         // Compute Mandelbrot iterations
         int iterations = ComputeMandelbrot(cx, cy);
@@ -148,24 +166,26 @@ AlgoBase::AlgoStatus MandelbrotSet::Process(std::shared_ptr<AlgoRequest> req) {
             8.5 * (1 - normalized) * (1 - normalized) * (1 - normalized) *
             normalized * 255);
 
-        int pixelIndex = (py * width + px) * 3;
-
-        outputData[pixelIndex + 0] = r;
-        outputData[pixelIndex + 1] = g;
-        outputData[pixelIndex + 2] = b;
+        rows[0][px] = r;
+        rows[1][px] = g;
+        rows[2][px] = b;
+      }
+      if (!planar) {
+        InterleaveRgb(rows[0], rows[1], rows[2],
+                      outputData.data() + rowStart * 3, width);
       }
       // LOG(VERBOSE, ALGOBASE, "Processed Frames::%d", req->mRequestId);
     }
 
     // Replace input image with output image
     req->ClearImages();
-    if (req->AddImage(ImageFormat::RGB, width, height, std::move(outputData))) {
+    if (req->AddImage(outputFormat, width, height, std::move(outputData))) {
       LOG(ERROR, ALGOBASE, "Error Filling Output data");
       SetStatus(AlgoStatus::FAILURE);
     }
 
     // Update zoom level for the next frame
-    zoomLevel *= ZOOM_FACTOR;
+    state.zoomLevel *= ZOOM_FACTOR;
   } else {
     // skip processing
   }
@@ -39,6 +39,17 @@ enum MandelbrotSetCentre {
   Spiral_formation,
   Main,
 };
+
+/**
+ * @brief Zoom position of one stream
+ */
+struct MandelbrotStreamState : AlgoBase::StreamState {
+  int modelIdx     = (int)MandelbrotSetCentre::Seahorse_Valley;
+  double offsetX   = CentreCordinates[modelIdx][0];
+  double offsetY   = CentreCordinates[modelIdx][1];
+  double zoomLevel = INITIAL_ZOOM;
+  int frameCount   = 0;
+};
 /**
  * @brief MandelbrotSet class derived from AlgoBase to perform
  * MANDELBROTSET-specific operations.
@@ -85,10 +96,6 @@ public:
 
 private:
   mutable std::mutex mutex_; // Mutex to protect the shared state
-  double zoomLevel;
-  double offsetX;
-  double offsetY;
-  int modelIdx;
 };
 
 /**
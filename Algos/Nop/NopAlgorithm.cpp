@@ -101,6 +101,15 @@ int NopAlgorithm::GetTimeout() {
   return 1000;
 }
 
+/**
+ * @brief output depends only on the request
+ *
+ * @return bool
+ */
+bool NopAlgorithm::IsCacheable() const {
+  return true;
+}
+
 // Public Exposed API for Nop
 /**
  * @brief Factory function to expose NopAlgorithm via shared library.
@@ -67,6 +67,7 @@ public:
    * @return int
    */
   int GetTimeout() override;
+  bool IsCacheable() const override;
 
 private:
   mutable std::mutex mutex_; // Mutex to protect the shared state
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "RotateAlgorithm.h"
+#include "ConfigParser.h"
+#include "Log.h"
+#include "RotateEngine.h"
+
+/**
+ * @brief Constructor for RotateAlgorithm.
+ */
+RotateAlgorithm::RotateAlgorithm() : AlgoBase(ROTATE_NAME) {
+  mAlgoId = ALGO_ROTATE;  // Unique ID for Rotate algorithm
+  SupportedFormatsMap.push_back({ImageFormat::YUV420, ImageFormat::YUV420});
+  SupportedFormatsMap.push_back({ImageFormat::NV12, ImageFormat::NV12});
+  SupportedFormatsMap.push_back({ImageFormat::NV21, ImageFormat::NV21});
+  SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::RGB});
+  SupportedFormatsMap.push_back(
+      {ImageFormat::GRAYSCALE, ImageFormat::GRAYSCALE});
+  ConfigParser parser;
+  mConfigFile = CONFIGPATH;
+  mConfigFile += AlgoBase::GetAlgorithmName();
+  mConfigFile += ".config";
+  parser.loadFile(mConfigFile.c_str());
+  if (parser.getErrorCode() == 0) {
+    LOG(VERBOSE, ALGOBASE, "Rotate Algo Version: %s",
+        parser.getValue("Version").c_str());
+  }
+}
+
+/**
+ * @brief Destructor for RotateAlgorithm.
+ */
+RotateAlgorithm::~RotateAlgorithm() {
+  StopAlgoThread();
+  Close();
+};
+
+/**
+ * @brief Open the Rotate algorithm, simulating resource checks.
+ * @return Status of the operation.
+ */
+AlgoBase::AlgoStatus RotateAlgorithm::Open() {
+  std::lock_guard<std::mutex> lock(mutex_);  // Protect the shared state
+
+  SetStatus(AlgoStatus::SUCCESS);
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief Rotate one image plane by plane into a new image
+ *
+ * @param input
+ * @param degrees
+ * @param mirror
+ * @return std::shared_ptr<ImageData> nullptr if the data is too small
+ */
+static std::shared_ptr<ImageData> RotateImage(const ImageData& input,
+                                              int degrees, bool mirror) {
+  const ImageFormat format = input.GetFormat();
+  const int width          = input.GetWidth();
+  const int height         = input.GetHeight();
+  const bool planar        = format == ImageFormat::YUV420;
+  const bool yuv           = planar || format == ImageFormat::NV12 ||
+                             format == ImageFormat::NV21;
+  const int cn             = format == ImageFormat::RGB ? 3 : 1;
+  const size_t lumaSize    = static_cast<size_t>(width) * height;
+  const size_t size        = yuv ? lumaSize * 3 / 2 : lumaSize * cn;
+  if (input.GetDataSize() < size || (yuv && (width % 2 || height % 2))) {
+    return nullptr;
+  }
+
+  int outWidth  = 0;
+  int outHeight = 0;
+  RotateGetSize(width, height, degrees, outWidth, outHeight);
+  auto output = std::make_shared<ImageData>(format, outWidth, outHeight);
+  output->SetData(std::vector<unsigned char>(size));
+  const unsigned char* src = input.GetData().data();
+  unsigned char* dst       = output->GetData().data();
+
+  int rc = RotatePlane(src, width, height, width * cn, cn, dst,
+                       outWidth * cn, degrees, mirror);
+  if (planar) {
+    // U then V, each a quarter of the luma
+    for (size_t offset = lumaSize; rc == 0 && offset < size;
+         offset += lumaSize / 4) {
+      rc = RotatePlane(src + offset, width / 2, height / 2, width / 2, 1,
+                       dst + offset, outWidth / 2, degrees, mirror);
+    }
+  } else if (yuv && rc == 0) {
+    // U,V pairs move together as 2 byte elements
+    rc = RotatePlane(src + lumaSize, width / 2, height / 2, width, 2,
+                     dst + lumaSize, outWidth, degrees, mirror);
+  }
+  return rc == 0 ? output : nullptr;
+}
+
+/**
+ * @brief Mirror and rotate every image as the metadata asks. The
+ * metadata is reset afterwards so later nodes see an upright frame, and
+ * IMAGE_WIDTH/IMAGE_HEIGHT follow the rotated size.
+ *
+ * @param req
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus RotateAlgorithm::Process(
+    std::shared_ptr<AlgoRequest> req) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!req || req->GetImageCount() == 0) {
+    SetStatus(AlgoStatus::FAILURE);
+    return GetAlgoStatus();
+  }
+  int degrees = 0;
+  bool mirror = false;
+  req->mMetadata.GetMetadata(MetaId::IMAGE_ORIENTATION, degrees);
+  req->mMetadata.GetMetadata(MetaId::IMAGE_MIRROR, mirror);
+  if (degrees % 90 != 0) {
+    LOG(ERROR, ALGOBASE, "Unsupported orientation %d.", degrees);
+    SetStatus(AlgoStatus::FAILURE);
+    return GetAlgoStatus();
+  }
+
+  if (degrees % 360 != 0 || mirror) {
+    std::vector<std::shared_ptr<ImageData>> images;
+    for (size_t i = 0; i < req->GetImageCount(); i++) {
+      auto image = req->GetImage(i);
+      if (!CanProcessFormat(image->GetFormat(), image->GetFormat())) {
+        LOG(ERROR, ALGOBASE, "Unsupported image format.");
+        SetStatus(AlgoStatus::FAILURE);
+        return GetAlgoStatus();
+      }
+      // Read through a const image, the writable accessor would unshare it
+      images.push_back(RotateImage(*image, degrees, mirror));
+      if (!images.back()) {
+        LOG(ERROR, ALGOBASE, "Input image %zu does not match its size.", i);
+        SetStatus(AlgoStatus::FAILURE);
+        return GetAlgoStatus();
+      }
+    }
+    req->ClearImages();
+    for (auto& image : images) {
+      req->AddImage(image);
+    }
+    req->mMetadata.SetMetadata(MetaId::IMAGE_ORIENTATION, 0);
+    req->mMetadata.SetMetadata(MetaId::IMAGE_MIRROR, false);
+    // A quarter turn swaps the size the encoders write into their headers
+    int width  = 0;
+    int height = 0;
+    if (degrees % 180 != 0 &&
+        req->mMetadata.GetMetadata(MetaId::IMAGE_WIDTH, width) == 0 &&
+        req->mMetadata.GetMetadata(MetaId::IMAGE_HEIGHT, height) == 0) {
+      req->mMetadata.SetMetadata(MetaId::IMAGE_WIDTH, height);
+      req->mMetadata.SetMetadata(MetaId::IMAGE_HEIGHT, width);
+    }
+  }
+
+  int reqdone = 0x00;
+  if (0 == req->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone)) {
+    reqdone |= ALGO_MASK(mAlgoId);
+    req->mMetadata.SetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone);
+  }
+  SetStatus(AlgoStatus::SUCCESS);
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief Close the Rotate algorithm, simulating cleanup.
+ * @return Status of the operation.
+ */
+AlgoBase::AlgoStatus RotateAlgorithm::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);  // Protect the shared state
+
+  SetStatus(AlgoStatus::SUCCESS);
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief max time taken by algo to process a request
+ *
+ * @return int
+ */
+int RotateAlgorithm::GetTimeout() {
+  return 1000;
+}
+
+/**
+ * @brief output depends only on the request
+ *
+ * @return bool
+ */
+bool RotateAlgorithm::IsCacheable() const {
+  return true;
+}
+
+// Public Exposed API for Rotate
+/**
+ * @brief Factory function to expose RotateAlgorithm via shared library.
+ * @return A pointer to the RotateAlgorithm instance.
+ */
+extern "C" AlgoBase* GetAlgoMethod() {
+  RotateAlgorithm* pInstance = new RotateAlgorithm();
+  return pInstance;
+}
+
+/**
+@brief Get the algorithm ID.
+ *
+ */
+extern "C" AlgoId GetAlgoId() {
+  return ALGO_ROTATE;
+}
+/**
+@brief Get the algorithm name.
+ *
+ */
+extern "C" const char* GetAlgorithmName() {
+  return ROTATE_NAME;
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "ScalerAlgorithm.h"
+#include <algorithm>
+#include <cstdio>
+#include "ConfigParser.h"
+#include "Log.h"
+#include "PixelKernels.h"
+
+/**
+ * @brief Parse "WxH" or "1/N" into an output size
+ *
+ * @param text
+ * @param output
+ * @return bool false if the text is neither
+ */
+static bool ParseOutput(const std::string& text, ScalerOutput& output) {
+  int a = 0;
+  int b = 0;
+  if (sscanf(text.c_str(), "1/%d", &a) == 1 && a > 0) {
+    output.denom = a;
+    return true;
+  }
+  if (sscanf(text.c_str(), "%dx%d", &a, &b) == 2 && a >= 0 && b >= 0) {
+    output.width  = a;
+    output.height = b;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Constructor for ScalerAlgorithm.
+ */
+ScalerAlgorithm::ScalerAlgorithm() : AlgoBase(SCALER_NAME) {
+  mAlgoId = ALGO_SCALER;  // Unique ID for Scaler algorithm
+  SupportedFormatsMap.push_back({ImageFormat::YUV420, ImageFormat::YUV420});
+  SupportedFormatsMap.push_back({ImageFormat::NV12, ImageFormat::NV12});
+  SupportedFormatsMap.push_back({ImageFormat::NV21, ImageFormat::NV21});
+  SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::RGB});
+  SupportedFormatsMap.push_back({ImageFormat::RGBP, ImageFormat::RGBP});
+  SupportedFormatsMap.push_back(
+      {ImageFormat::GRAYSCALE, ImageFormat::GRAYSCALE});
+  ConfigParser parser;
+  mConfigFile = CONFIGPATH;
+  mConfigFile += AlgoBase::GetAlgorithmName();
+  mConfigFile += ".config";
+  parser.loadFile(mConfigFile.c_str());
+  if (parser.getErrorCode() == 0) {
+    LOG(VERBOSE, ALGOBASE, "Scaler Algo Version: %s",
+        parser.getValue("Version").c_str());
+    if (!parser.getValue("Mode").empty()) {
+      const int mode = parser.getIntValue("Mode");
+      if (mode >= static_cast<int>(ScaleMode::BILINEAR) &&
+          mode <= static_cast<int>(ScaleMode::LANCZOS)) {
+        mMode = static_cast<ScaleMode>(mode);
+      }
+    }
+    const std::string outputs = parser.getValue("Outputs");
+    for (const auto& item : outputs.empty() ? std::vector<std::string>()
+                                            : parser.parseArray(outputs)) {
+      ScalerOutput output;
+      if (ParseOutput(item, output)) {
+        mOutputs.push_back(output);
+      } else {
+        LOG(ERROR, ALGOBASE, "Scaler output '%s' ignored", item.c_str());
+      }
+    }
+    if (!ParseOutput(parser.getValue("Thumbnail"), mThumbnail)) {
+      mThumbnail = ScalerOutput();
+    }
+  }
+  if (mOutputs.empty()) {
+    mOutputs.push_back({0, 0, 1});
+  }
+}
+
+/**
+ * @brief Destructor for ScalerAlgorithm.
+ */
+ScalerAlgorithm::~ScalerAlgorithm() {
+  StopAlgoThread();
+  Close();
+};
+
+/**
+ * @brief Open the Scaler algorithm, simulating resource checks.
+ * @return Status of the operation.
+ */
+AlgoBase::AlgoStatus ScalerAlgorithm::Open() {
+  std::lock_guard<std::mutex> lock(mutex_);  // Protect the shared state
+
+  SetStatus(AlgoStatus::SUCCESS);
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief Taps of one axis, built once per size pair
+ *
+ * @param srcSize
+ * @param dstSize
+ * @return std::shared_ptr<const ScaleAxis>
+ */
+std::shared_ptr<const ScaleAxis> ScalerAlgorithm::GetAxis(int srcSize,
+                                                          int dstSize) {
+  auto& axis = mAxes[{srcSize, dstSize}];
+  if (!axis) {
+    auto built = std::make_shared<ScaleAxis>();
+    ScaleInitAxis(*built, srcSize, dstSize, mMode);
+    axis = built;
+  }
+  return axis;
+}
+
+/**
+ * @brief Resize the first image to every output. Outputs of the input size
+ * share its buffer, the others are filtered plane by plane with all sizes
+ * of a plane produced in one pass over it.
+ *
+ * @param req
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus ScalerAlgorithm::Process(
+    std::shared_ptr<AlgoRequest> req) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!req || req->GetImageCount() == 0) {
+    SetStatus(AlgoStatus::FAILURE);
+    return GetAlgoStatus();
+  }
+  auto inputImage          = req->GetImage(0);
+  const ImageFormat format = inputImage->GetFormat();
+  if (!CanProcessFormat(format, format)) {
+    LOG(ERROR, ALGOBASE, "Unsupported image format.");
+    SetStatus(AlgoStatus::FAILURE);
+    return GetAlgoStatus();
+  }
+
+  // Read through a const image, the writable accessor would unshare it
+  const ImageData& input = *inputImage;
+  const int width        = input.GetWidth();
+  const int height       = input.GetHeight();
+
+  std::vector<ScalerOutput> outputs = mOutputs;
+  if (mThumbnail.width > 0 && mThumbnail.height > 0) {
+    outputs.push_back(mThumbnail);
+  }
+  std::vector<std::shared_ptr<ImageData>> images;
+  bool sized = true;
+
+  // Planes are scaled one by one, with the geometry of each fixed per format
+  DispatchFormat(format, [&](auto layout) {
+    using Layout = decltype(layout);
+    if (input.GetDataSize() < Layout::Size(width, height)) {
+      sized = false;
+      return;
+    }
+
+    std::vector<std::shared_ptr<const ScaleAxis>> axes;
+    std::vector<ScaleTarget> targets[Layout::kPlanes];
+    for (const auto& output : outputs) {
+      int outWidth  = output.denom ? width / output.denom : output.width;
+      int outHeight = output.denom ? height / output.denom : output.height;
+      // Subsampled planes need sizes that divide evenly
+      outWidth  = std::max(Layout::kAlignX,
+                           outWidth - outWidth % Layout::kAlignX);
+      outHeight = std::max(Layout::kAlignY,
+                           outHeight - outHeight % Layout::kAlignY);
+      if (outWidth == width && outHeight == height) {
+        images.push_back(input.Share());
+        continue;
+      }
+
+      auto image = std::make_shared<ImageData>(format, outWidth, outHeight);
+      image->SetData(
+          std::vector<unsigned char>(Layout::Size(outWidth, outHeight)));
+      unsigned char* dst = image->GetData().data();
+      images.push_back(image);
+
+      ForEachPlane<Layout>([&](auto plane) {
+        constexpr int p = decltype(plane)::value;
+        using Plane     = typename Layout::template Plane<p>;
+        axes.push_back(GetAxis(Plane::Width(width), Plane::Width(outWidth)));
+        axes.push_back(
+            GetAxis(Plane::Height(height), Plane::Height(outHeight)));
+        targets[p].push_back(
+            {axes[axes.size() - 2].get(), axes.back().get(),
+             dst + Layout::template Offset<p>(outWidth, outHeight),
+             static_cast<int>(Plane::RowSize(outWidth))});
+      });
+    }
+
+    const unsigned char* src = input.GetData().data();
+    ForEachPlane<Layout>([&](auto plane) {
+      constexpr int p = decltype(plane)::value;
+      using Plane     = typename Layout::template Plane<p>;
+      static_assert(sizeof(typename Plane::Sample) == 1,
+                    "ScalePlane takes 8-bit samples");
+      if (!targets[p].empty()) {
+        ScalePlane(src + Layout::template Offset<p>(width, height),
+                   Plane::Width(width), Plane::Height(height),
+                   static_cast<int>(Plane::RowSize(width)), Plane::kChannels,
+                   targets[p]);
+      }
+    });
+  });
+  if (!sized) {
+    LOG(ERROR, ALGOBASE, "Input image is smaller than its size.");
+    SetStatus(AlgoStatus::FAILURE);
+    return GetAlgoStatus();
+  }
+
+  req->ClearImages();
+  for (auto& image : images) {
+    req->AddImage(image);
+  }
+  if (outputs.size() > mOutputs.size()) {
+    req->mMetadata.SetMetadata(MetaId::THUMBNAIL,
+                               static_cast<int>(images.size()) - 1);
+  }
+
+  int reqdone = 0x00;
+  if (0 == req->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone)) {
+    reqdone |= ALGO_MASK(mAlgoId);
+    req->mMetadata.SetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone);
+  }
+  SetStatus(AlgoStatus::SUCCESS);
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief Close the Scaler algorithm, simulating cleanup.
+ * @return Status of the operation.
+ */
+AlgoBase::AlgoStatus ScalerAlgorithm::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);  // Protect the shared state
+
+  SetStatus(AlgoStatus::SUCCESS);
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief max time taken by algo to process a request
+ *
+ * @return int
+ */
+int ScalerAlgorithm::GetTimeout() {
+  return 1000;
+}
+
+/**
+ * @brief output depends only on the request
+ *
+ * @return bool
+ */
+bool ScalerAlgorithm::IsCacheable() const {
+  return true;
+}
+
+// Public Exposed API for Scaler
+/**
+ * @brief Factory function to expose ScalerAlgorithm via shared library.
+ * @return A pointer to the ScalerAlgorithm instance.
+ */
+extern "C" AlgoBase* GetAlgoMethod() {
+  ScalerAlgorithm* pInstance = new ScalerAlgorithm();
+  return pInstance;
+}
+
+/**
+@brief Get the algorithm ID.
+ *
+ */
+extern "C" AlgoId GetAlgoId() {
+  return ALGO_SCALER;
+}
+/**
+@brief Get the algorithm name.
+ *
+ */
+extern "C" const char* GetAlgorithmName() {
+  return SCALER_NAME;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef SCALER_ALGORITHM_H
+#define SCALER_ALGORITHM_H
+
+#include <map>
+#include <utility>
+#include <vector>
+#include "AlgoBase.h"
+#include "ScaleEngine.h"
+const char *SCALER_NAME = "ScalerAlgorithm";
+
+/**
+ * @brief Size of one scaler output, either fixed or a fraction of the input
+ */
+struct ScalerOutput {
+  int width  = 0;  // Fixed size, used when denom is 0
+  int height = 0;
+  int denom  = 0;  // Input size divided by this
+};
+
+/**
+ * @brief ScalerAlgorithm class derived from AlgoBase to resize the first
+ * image into one or more output sizes, e.g. full frame, preview and
+ * thumbnail, in a single pass.
+ */
+class ScalerAlgorithm : public AlgoBase {
+public:
+  /**
+   * @brief Constructor for ScalerAlgorithm.
+   *
+   */
+  ScalerAlgorithm();
+
+  /**
+   * @brief Destructor for ScalerAlgorithm.
+   */
+  ~ScalerAlgorithm() override;
+
+  /**
+   * @brief Open the Scaler algorithm, simulating resource checks.
+   * @return Status of the operation.
+   */
+  AlgoStatus Open() override;
+
+  /**
+   * @brief Replace the images of the request by the first image resized to
+   * every configured output, the thumbnail last.
+   * @return Status of the operation.
+   */
+  AlgoStatus Process(std::shared_ptr<AlgoRequest> req) override;
+
+  /**
+   * @brief Close the Scaler algorithm, simulating cleanup.
+   * @return Status of the operation.
+   */
+  AlgoStatus Close() override;
+  // cppcheck-suppress virtualCallInConstructor
+
+  /**
+   * @brief Get the Timeout object
+   *
+   * @return int
+   */
+  int GetTimeout() override;
+  bool IsCacheable() const override;
+
+private:
+  mutable std::mutex mutex_;  // Mutex to protect the shared state
+  ScaleMode mMode = ScaleMode::AREA;
+  std::vector<ScalerOutput> mOutputs;  // Output sizes in order
+  ScalerOutput mThumbnail;             // Appended last, width 0 for none
+  // Axes keyed by (source size, output size), built on first use
+  std::map<std::pair<int, int>, std::shared_ptr<const ScaleAxis>> mAxes;
+
+  std::shared_ptr<const ScaleAxis> GetAxis(int srcSize, int dstSize);
+};
+
+extern "C" AlgoBase *GetAlgoMethod();
+
+#endif  // SCALER_ALGORITHM_H
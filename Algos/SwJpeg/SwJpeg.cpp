@@ -35,6 +35,8 @@
 SwJpeg::SwJpeg() : AlgoBase(SWJPEG_NAME) {
   mAlgoId = ALGO_SWJPEG;  // Unique ID for SWJPEG algorithm
   SupportedFormatsMap.push_back({ImageFormat::YUV420, ImageFormat::JPEG});
+  SupportedFormatsMap.push_back({ImageFormat::NV12, ImageFormat::JPEG});
+  SupportedFormatsMap.push_back({ImageFormat::NV21, ImageFormat::JPEG});
   SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::JPEG});
   ConfigParser parser;
   mConfigFile = CONFIGPATH;
@@ -76,17 +78,25 @@ AlgoBase::AlgoStatus SwJpeg::Open() {
  */
 void ConvertYUVToRGB(const unsigned char* yuvData, unsigned char* rgbData,
                      int width, int height, ImageFormat format) {
-  (void)(format);
   int frameSize               = width * height;
   const unsigned char* yPlane = yuvData;
   const unsigned char* uPlane = yuvData + frameSize;
   const unsigned char* vPlane = yuvData + frameSize + (frameSize / 4);
+  // Chroma sample step and row stride, NV12/NV21 read the pairs in place
+  int cStep   = 1;
+  int cStride = width / 2;
+  if (format == ImageFormat::NV12 || format == ImageFormat::NV21) {
+    cStep   = 2;
+    cStride = width / 2 * 2;
+    uPlane  = yuvData + frameSize + (format == ImageFormat::NV21 ? 1 : 0);
+    vPlane  = yuvData + frameSize + (format == ImageFormat::NV21 ? 0 : 1);
+  }
 
   for (int j = 0; j < height; j++) {
     for (int i = 0; i < width; i++) {
       int y = yPlane[j * width + i];
-      int u = uPlane[(j / 2) * (width / 2) + (i / 2)];
-      int v = vPlane[(j / 2) * (width / 2) + (i / 2)];
+      int u = uPlane[(j / 2) * cStride + (i / 2) * cStep];
+      int v = vPlane[(j / 2) * cStride + (i / 2) * cStep];
 
       int c = y - 16;
       int d = u - 128;
@@ -148,9 +158,84 @@ static int ComposeMetadata(std::shared_ptr<AlgoRequest> req,
 }
 #endif
 
+#ifdef __JPEGLIB__
+/**
+ * @brief Encode one YUV420, NV12, NV21 or RGB image
+ *
+ * @param req source of the header metadata, nullptr for none
+ * @param image
+ * @param jpegData
+ */
+static void EncodeJpeg(std::shared_ptr<AlgoRequest> req,
+                       const ImageData& image,
+                       std::vector<unsigned char>& jpegData) {
+  const ImageFormat inputFormat                  = image.GetFormat();
+  const int width                                = image.GetWidth();
+  const int height                               = image.GetHeight();
+  const std::vector<unsigned char>& inputDataVec = image.GetData();
+  const unsigned char* inputData                 = inputDataVec.data();
+  std::shared_ptr<const ImageData> rgb;
+  std::vector<unsigned char> rgbData;
+
+  if (inputFormat == ImageFormat::YUV420 ||
+      inputFormat == ImageFormat::YUV422 || inputFormat == ImageFormat::NV12 ||
+      inputFormat == ImageFormat::NV21) {
+    // Shared with any other user of the frame's RGB, odd sizes fall back
+    rgb = image.AsRGB();
+    if (rgb) {
+      inputData = rgb->GetData().data();
+    } else {
+      rgbData.resize(width * height * 3);
+      ConvertYUVToRGB(inputData, rgbData.data(), width, height, inputFormat);
+      inputData = rgbData.data();
+    }
+  }
+  struct jpeg_compress_struct cinfo;
+  struct jpeg_error_mgr jerr;
+
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_compress(&cinfo);
+
+  unsigned char* outBuffer = nullptr;
+  unsigned long outSize    = 0;
+  jpeg_mem_dest(&cinfo, &outBuffer, &outSize);
+
+  cinfo.image_width      = width;
+  cinfo.image_height     = height;
+  cinfo.input_components = 3;  // RGB
+  cinfo.in_color_space   = JCS_RGB;
+
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, 75, TRUE);  // Set quality to 75%
+
+  jpeg_start_compress(&cinfo, TRUE);
+
+  // Add metadata first, before scanlines
+  if (req) {
+    ComposeMetadata(req, cinfo);
+  }
+
+  // Write image scanlines
+  JSAMPROW row_pointer[1];
+  int row_stride = width * 3;
+  while (cinfo.next_scanline < cinfo.image_height) {
+    row_pointer[0] = const_cast<unsigned char*>(
+        &inputData[cinfo.next_scanline * row_stride]);
+    jpeg_write_scanlines(&cinfo, row_pointer, 1);
+  }
+
+  jpeg_finish_compress(&cinfo);   // Finish compression
+  jpeg_destroy_compress(&cinfo);  // Cleanup
+
+  jpegData.assign(outBuffer, outBuffer + outSize);
+  free(outBuffer);  // Free memory allocated for the buffer
+}
+#endif
+
 /**
  * @brief Process the SWJPEG algorithm, simulating input validation and
- * ShJpeg computation.
+ * ShJpeg computation. The image MetaId::THUMBNAIL points at is encoded too
+ * and kept as the second image.
  * @param req A shared pointer to the AlgoRequest object.
  * @return Status of the operation.
  */
@@ -167,64 +252,38 @@ AlgoBase::AlgoStatus SwJpeg::Process(std::shared_ptr<AlgoRequest> req) {
     return GetAlgoStatus();
   }
 
-  const ImageFormat inputFormat                  = inputImage->GetFormat();
-  const int width                                = inputImage->GetWidth();
-  const int height                               = inputImage->GetHeight();
-  const std::vector<unsigned char>& inputDataVec = inputImage->GetData();
-  const unsigned char* inputData                 = inputDataVec.data();
-  std::vector<unsigned char> rgbData;
-
-  if (inputFormat == ImageFormat::YUV420 ||
-      inputFormat == ImageFormat::YUV422) {
-    rgbData.resize(width * height * 3);
-    ConvertYUVToRGB(inputData, rgbData.data(), width, height, inputFormat);
-    inputData = rgbData.data();
+  int thumbnailIndex = 0;
+  std::shared_ptr<ImageData> thumbnail;
+  if (req->mMetadata.GetMetadata(MetaId::THUMBNAIL, thumbnailIndex) == 0 &&
+      thumbnailIndex > 0 &&
+      static_cast<size_t>(thumbnailIndex) < req->GetImageCount()) {
+    thumbnail = req->GetImage(thumbnailIndex);
   }
+
+  const ImageFormat inputFormat = inputImage->GetFormat();
   if (CanProcessFormat(inputFormat, ImageFormat::JPEG)) {
     std::vector<unsigned char> jpegData;
-    struct jpeg_compress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-
-    cinfo.err = jpeg_std_error(&jerr);
-    jpeg_create_compress(&cinfo);
-
-    unsigned char* outBuffer = nullptr;
-    unsigned long outSize    = 0;
-    jpeg_mem_dest(&cinfo, &outBuffer, &outSize);
-
-    cinfo.image_width      = width;
-    cinfo.image_height     = height;
-    cinfo.input_components = 3;  // RGB
-    cinfo.in_color_space   = JCS_RGB;
-
-    jpeg_set_defaults(&cinfo);
-    jpeg_set_quality(&cinfo, 75, TRUE);  // Set quality to 75%
-
-    jpeg_start_compress(&cinfo, TRUE);
-
-    // Add metadata first, before scanlines
-    ComposeMetadata(req, cinfo);
-
-    // Write image scanlines
-    JSAMPROW row_pointer[1];
-    int row_stride = width * 3;
-    while (cinfo.next_scanline < cinfo.image_height) {
-      row_pointer[0] = const_cast<unsigned char*>(
-          &inputData[cinfo.next_scanline * row_stride]);
-      jpeg_write_scanlines(&cinfo, row_pointer, 1);
-    }
-
-    jpeg_finish_compress(&cinfo);   // Finish compression
-    jpeg_destroy_compress(&cinfo);  // Cleanup
-
-    jpegData.assign(outBuffer, outBuffer + outSize);
-    free(outBuffer);  // Free memory allocated for the buffer
+    EncodeJpeg(req, *inputImage, jpegData);
 
     req->ClearImages();
-    if (req->AddImage(ImageFormat::JPEG, width, height, std::move(jpegData))) {
+    if (req->AddImage(ImageFormat::JPEG, inputImage->GetWidth(),
+                      inputImage->GetHeight(), std::move(jpegData))) {
       LOG(ERROR, ALGOBASE, "Error Filling Output data");
       SetStatus(AlgoStatus::FAILURE);
     }
+    if (thumbnail) {
+      // Index of the encoded thumbnail, 0 if it could not be encoded
+      int index = 0;
+      if (CanProcessFormat(thumbnail->GetFormat(), ImageFormat::JPEG)) {
+        std::vector<unsigned char> data;
+        EncodeJpeg(nullptr, *thumbnail, data);
+        if (req->AddImage(ImageFormat::JPEG, thumbnail->GetWidth(),
+                          thumbnail->GetHeight(), std::move(data)) == 0) {
+          index = 1;
+        }
+      }
+      req->mMetadata.SetMetadata(MetaId::THUMBNAIL, index);
+    }
   }
 #endif
   int reqdone = 0x00;
@@ -256,6 +315,15 @@ int SwJpeg::GetTimeout() {
   return 10000;
 }
 
+/**
+ * @brief output depends only on the request
+ *
+ * @return bool
+ */
+bool SwJpeg::IsCacheable() const {
+  return true;
+}
+
 /**
  * @brief Factory function to expose SwJpeg via shared library.
  * @return A pointer to the SwJpeg instance.
@@ -68,6 +68,7 @@ class SwJpeg : public AlgoBase {
    * @return int
    */
   int GetTimeout() override;
+  bool IsCacheable() const override;
 
  private:
   mutable std::mutex mutex_;  // Mutex to protect the shared state
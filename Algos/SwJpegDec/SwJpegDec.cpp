@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "SwJpegDec.h"
+#ifdef __JPEGLIB__
+#include <jpeglib.h>
+#include <csetjmp>
+#endif
+#include <algorithm>
+#include <string>
+#include "ConfigParser.h"
+#include "Log.h"
+
+/**
+ * @brief Check DCT scale denominator is one libjpeg can do in the IDCT
+ *
+ * @param scaleDenom
+ * @return true
+ * @return false
+ */
+static bool IsValidScaleDenom(int scaleDenom) {
+  return (scaleDenom == 1) || (scaleDenom == 2) || (scaleDenom == 4) ||
+         (scaleDenom == 8);
+}
+
+/**
+ * @brief Constructor for SwJpegDec.
+ */
+SwJpegDec::SwJpegDec() : AlgoBase(SWJPEGDEC_NAME) {
+  mAlgoId = ALGO_SWJPEGDEC;  // Unique ID for SWJPEGDEC algorithm
+  SupportedFormatsMap.push_back({ImageFormat::JPEG, ImageFormat::YUV420});
+  ConfigParser parser;
+  mConfigFile = CONFIGPATH;
+  mConfigFile += AlgoBase::GetAlgorithmName();
+  mConfigFile += ".config";
+  parser.loadFile(mConfigFile.c_str());
+  std::string Version = parser.getValue("Version");
+  if (parser.getErrorCode() == 0) {
+    LOG(VERBOSE, ALGOBASE, "SwJpegDec Algo Version: %s", Version.c_str());
+  }
+  int scaleDenom = parser.getIntValue("ScaleDenom");
+  if (IsValidScaleDenom(scaleDenom)) {
+    mScaleDenom = scaleDenom;
+  }
+}
+
+/**
+ * @brief Destructor for SwJpegDec.
+ */
+SwJpegDec::~SwJpegDec() {
+  StopAlgoThread();
+  Close();
+}
+
+/**
+ * @brief Open the SWJPEGDEC algorithm, simulating resource checks.
+ * @return Status of the operation.
+ */
+AlgoBase::AlgoStatus SwJpegDec::Open() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SetStatus(AlgoStatus::SUCCESS);
+  return GetAlgoStatus();
+}
+
+#ifdef __JPEGLIB__
+#if JPEG_LIB_VERSION >= 70
+#define JPEGDEC_MIN_SCALED_SIZE(cinfo) ((cinfo).min_DCT_h_scaled_size)
+#define JPEGDEC_COMP_SCALED_SIZE(comp) ((comp).DCT_h_scaled_size)
+#else
+#define JPEGDEC_MIN_SCALED_SIZE(cinfo) ((cinfo).min_DCT_scaled_size)
+#define JPEGDEC_COMP_SCALED_SIZE(comp) ((comp).DCT_scaled_size)
+#endif
+
+/**
+ * @brief libjpeg error manager which returns control to the decoder instead
+ * of calling exit() on corrupt input
+ */
+struct JpegDecErrorMgr {
+  struct jpeg_error_mgr pub;
+  jmp_buf setjmpBuffer;
+};
+
+static void JpegDecErrorExit(j_common_ptr cinfo) {
+  char message[JMSG_LENGTH_MAX];
+  (*cinfo->err->format_message)(cinfo, message);
+  LOG(ERROR, ALGOBASE, "Jpeg decode error: %s", message);
+  longjmp(reinterpret_cast<JpegDecErrorMgr*>(cinfo->err)->setjmpBuffer, 1);
+}
+
+/**
+ * @brief Stream is YCbCr with 2x2 subsampled chroma, so libjpeg can hand the
+ * planes out raw without upsampling or colour conversion
+ *
+ * @param cinfo
+ * @return true
+ * @return false
+ */
+static bool IsRawYuv420(const struct jpeg_decompress_struct& cinfo) {
+  return (cinfo.num_components == 3) &&
+         (cinfo.jpeg_color_space == JCS_YCbCr) &&
+         (cinfo.comp_info[0].h_samp_factor == 2) &&
+         (cinfo.comp_info[0].v_samp_factor == 2) &&
+         (cinfo.comp_info[1].h_samp_factor == 1) &&
+         (cinfo.comp_info[1].v_samp_factor == 1) &&
+         (cinfo.comp_info[2].h_samp_factor == 1) &&
+         (cinfo.comp_info[2].v_samp_factor == 1);
+}
+
+/**
+ * @brief JFIF YCbCr is full range while the rest of the pipeline (SwJpeg's
+ * converter included) treats YUV as BT.601 video range, map on the way out
+ */
+struct JpegDecRangeLut {
+  unsigned char luma[256];
+  unsigned char chroma[256];
+  JpegDecRangeLut() {
+    for (int i = 0; i < 256; ++i) {
+      luma[i]   = static_cast<unsigned char>(16 + (i * 219 + 127) / 255);
+      chroma[i] = static_cast<unsigned char>(
+          128 + ((i - 128) * 224 + (i >= 128 ? 127 : -127)) / 255);
+    }
+  }
+};
+static const JpegDecRangeLut kRangeLut;
+
+/**
+ * @brief Copy one row through a range LUT
+ *
+ * @param src
+ * @param dst
+ * @param count
+ * @param lut
+ */
+static void MapRow(const unsigned char* src, unsigned char* dst, int count,
+                   const unsigned char* lut) {
+  for (int x = 0; x < count; ++x) {
+    dst[x] = lut[src[x]];
+  }
+}
+
+/**
+ * @brief Average 2x2 neighbourhoods of two chroma rows into one I420 row
+ *
+ * @param r0
+ * @param r1
+ * @param out
+ * @param cWidth
+ */
+static void DownsampleChromaRow(const unsigned char* r0,
+                                const unsigned char* r1, unsigned char* out,
+                                int cWidth) {
+  for (int cx = 0; cx < cWidth; ++cx) {
+    out[cx] = kRangeLut.chroma[(r0[2 * cx] + r0[2 * cx + 1] + r1[2 * cx] +
+                                r1[2 * cx + 1] + 2) >>
+                               2];
+  }
+}
+
+/**
+ * @brief Read raw Y/Cb/Cr planes one iMCU row at a time into a strip buffer
+ * and crop them into the I420 output. When DCT scaling is active libjpeg
+ * may decode chroma at luma resolution instead of upsampling, in that case
+ * chroma is folded back 2x2 here.
+ *
+ * @param cinfo
+ * @param output
+ * @param strip
+ * @param width
+ * @param height
+ * @return true
+ * @return false
+ */
+static bool ReadRawYuv420(struct jpeg_decompress_struct& cinfo,
+                          unsigned char* output,
+                          std::vector<unsigned char>& strip, int width,
+                          int height) {
+  const jpeg_component_info& yComp = cinfo.comp_info[0];
+  const jpeg_component_info& uComp = cinfo.comp_info[1];
+  const jpeg_component_info& vComp = cinfo.comp_info[2];
+  const int lumaRows = cinfo.max_v_samp_factor * JPEGDEC_MIN_SCALED_SIZE(cinfo);
+  const int chromaRows = uComp.v_samp_factor * JPEGDEC_COMP_SCALED_SIZE(uComp);
+  if ((JPEGDEC_COMP_SCALED_SIZE(uComp) != JPEGDEC_COMP_SCALED_SIZE(vComp)) ||
+      (yComp.v_samp_factor * JPEGDEC_COMP_SCALED_SIZE(yComp) != lumaRows) ||
+      (lumaRows > 2 * DCTSIZE) || (chromaRows == 0) ||
+      ((lumaRows != chromaRows) && (lumaRows != 2 * chromaRows))) {
+    return false;
+  }
+  const bool fullChroma = (lumaRows == chromaRows);
+  const size_t yStride  = yComp.width_in_blocks * JPEGDEC_COMP_SCALED_SIZE(yComp);
+  const size_t cStride =
+      std::max(uComp.width_in_blocks * JPEGDEC_COMP_SCALED_SIZE(uComp),
+               vComp.width_in_blocks * JPEGDEC_COMP_SCALED_SIZE(vComp));
+
+  strip.resize(yStride * lumaRows + 2 * cStride * chromaRows);
+  JSAMPROW yRows[2 * DCTSIZE];
+  JSAMPROW uRows[2 * DCTSIZE];
+  JSAMPROW vRows[2 * DCTSIZE];
+  for (int r = 0; r < lumaRows; ++r) {
+    yRows[r] = strip.data() + r * yStride;
+  }
+  unsigned char* uStrip = strip.data() + yStride * lumaRows;
+  unsigned char* vStrip = uStrip + cStride * chromaRows;
+  for (int r = 0; r < chromaRows; ++r) {
+    uRows[r] = uStrip + r * cStride;
+    vRows[r] = vStrip + r * cStride;
+  }
+  JSAMPARRAY planes[3] = {yRows, uRows, vRows};
+
+  const int cWidth      = width / 2;
+  const int cHeight     = height / 2;
+  unsigned char* yPlane = output;
+  unsigned char* uPlane = output + width * height;
+  unsigned char* vPlane = uPlane + cWidth * cHeight;
+  while (cinfo.output_scanline < cinfo.output_height) {
+    const int lumaRow = cinfo.output_scanline;
+    if (jpeg_read_raw_data(&cinfo, planes, lumaRows) == 0) {
+      return false;
+    }
+    for (int r = 0; (r < lumaRows) && (lumaRow + r < height); ++r) {
+      MapRow(yRows[r], yPlane + (lumaRow + r) * width, width, kRangeLut.luma);
+    }
+    const int chromaRow = lumaRow / 2;
+    for (int r = 0; (r < lumaRows / 2) && (chromaRow + r < cHeight); ++r) {
+      unsigned char* uOut = uPlane + (chromaRow + r) * cWidth;
+      unsigned char* vOut = vPlane + (chromaRow + r) * cWidth;
+      if (fullChroma) {
+        DownsampleChromaRow(uRows[2 * r], uRows[2 * r + 1], uOut, cWidth);
+        DownsampleChromaRow(vRows[2 * r], vRows[2 * r + 1], vOut, cWidth);
+      } else {
+        MapRow(uRows[r], uOut, cWidth, kRangeLut.chroma);
+        MapRow(vRows[r], vOut, cWidth, kRangeLut.chroma);
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Read YCbCr (or gray) scanlines, two at a time, and subsample the
+ * chroma 2x2 into I420. Used for 4:4:4/4:2:2/gray streams; never goes
+ * through RGB.
+ *
+ * @param cinfo
+ * @param output
+ * @param lines
+ * @param width
+ * @param height
+ * @return true
+ * @return false
+ */
+static bool ReadScanlinesYuv420(struct jpeg_decompress_struct& cinfo,
+                                unsigned char* output,
+                                std::vector<unsigned char>& lines, int width,
+                                int height) {
+  const int comps        = cinfo.output_components;
+  const size_t rowBytes  = cinfo.output_width * comps;
+  const int cWidth       = width / 2;
+  const int cHeight      = height / 2;
+  unsigned char* yPlane  = output;
+  unsigned char* uPlane  = output + width * height;
+  unsigned char* vPlane  = uPlane + cWidth * cHeight;
+  lines.resize(2 * rowBytes);
+
+  for (int y = 0; cinfo.output_scanline < cinfo.output_height; ++y) {
+    JSAMPROW row = lines.data() + (y & 1) * rowBytes;
+    if (jpeg_read_scanlines(&cinfo, &row, 1) != 1) {
+      return false;
+    }
+    if (y >= height) {
+      continue;  // odd trailing row, I420 needs even height
+    }
+    unsigned char* yOut = yPlane + y * width;
+    for (int x = 0; x < width; ++x) {
+      yOut[x] = kRangeLut.luma[row[x * comps]];
+    }
+    if ((comps == 3) && (y & 1)) {
+      const unsigned char* r0 = lines.data();
+      const unsigned char* r1 = lines.data() + rowBytes;
+      unsigned char* uOut     = uPlane + (y / 2) * cWidth;
+      unsigned char* vOut     = vPlane + (y / 2) * cWidth;
+      for (int cx = 0; cx < cWidth; ++cx) {
+        const int i0 = cx * 6;  // two YCbCr triplets per chroma sample
+        uOut[cx]     = kRangeLut.chroma[(r0[i0 + 1] + r0[i0 + 4] + r1[i0 + 1] +
+                                     r1[i0 + 4] + 2) >>
+                                    2];
+        vOut[cx]     = kRangeLut.chroma[(r0[i0 + 2] + r0[i0 + 5] + r1[i0 + 2] +
+                                     r1[i0 + 5] + 2) >>
+                                    2];
+      }
+    }
+  }
+  if (comps == 1) {
+    std::fill(uPlane, uPlane + 2 * cWidth * cHeight, 128);
+  }
+  return true;
+}
+
+/**
+ * @brief Decode a JPEG bitstream into I420 with optional DCT domain scaling.
+ * Buffers are owned by the caller so nothing with a destructor lives between
+ * setjmp and longjmp.
+ *
+ * @param jpegData
+ * @param jpegSize
+ * @param scaleDenom
+ * @param output
+ * @param scratch
+ * @param outWidth
+ * @param outHeight
+ * @return true
+ * @return false
+ */
+static bool DecodeJpegToYuv420(const unsigned char* jpegData, size_t jpegSize,
+                               int scaleDenom,
+                               std::vector<unsigned char>& output,
+                               std::vector<unsigned char>& scratch,
+                               int& outWidth, int& outHeight) {
+  struct jpeg_decompress_struct cinfo;
+  struct JpegDecErrorMgr jerr;
+
+  cinfo.err           = jpeg_std_error(&jerr.pub);
+  jerr.pub.error_exit = JpegDecErrorExit;
+  if (setjmp(jerr.setjmpBuffer)) {
+    jpeg_destroy_decompress(&cinfo);
+    return false;
+  }
+  jpeg_create_decompress(&cinfo);
+  jpeg_mem_src(&cinfo, const_cast<unsigned char*>(jpegData), jpegSize);
+  if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
+    jpeg_destroy_decompress(&cinfo);
+    return false;
+  }
+
+  const bool raw        = IsRawYuv420(cinfo);
+  cinfo.scale_num       = 1;
+  cinfo.scale_denom     = scaleDenom;
+  cinfo.raw_data_out    = raw ? TRUE : FALSE;
+  cinfo.out_color_space = (cinfo.num_components == 1) ? JCS_GRAYSCALE
+                                                      : JCS_YCbCr;
+  jpeg_start_decompress(&cinfo);
+
+  // I420 carries chroma at half resolution, keep dimensions even
+  outWidth  = cinfo.output_width & ~1u;
+  outHeight = cinfo.output_height & ~1u;
+  if ((outWidth == 0) || (outHeight == 0)) {
+    jpeg_destroy_decompress(&cinfo);
+    return false;
+  }
+  output.resize(outWidth * outHeight * 3 / 2);
+
+  bool rc = raw ? ReadRawYuv420(cinfo, output.data(), scratch, outWidth,
+                                outHeight)
+                : ReadScanlinesYuv420(cinfo, output.data(), scratch, outWidth,
+                                      outHeight);
+  if (rc) {
+    jpeg_finish_decompress(&cinfo);
+  }
+  jpeg_destroy_decompress(&cinfo);
+  return rc;
+}
+#endif
+
+/**
+ * @brief Decode the JPEG input to YUV420. Non JPEG input is passed through
+ * untouched so the node can sit in front of mixed sources.
+ * @param req A shared pointer to the AlgoRequest object.
+ * @return Status of the operation.
+ */
+AlgoBase::AlgoStatus SwJpegDec::Process(std::shared_ptr<AlgoRequest> req) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!req || req->GetImageCount() == 0) {
+    SetStatus(AlgoStatus::FAILURE);
+    return GetAlgoStatus();
+  }
+  auto inputImage = req->GetImage(0);
+  if (!inputImage) {
+    SetStatus(AlgoStatus::FAILURE);
+    return GetAlgoStatus();
+  }
+  SetStatus(AlgoStatus::SUCCESS);
+
+#ifdef __JPEGLIB__
+  if (CanProcessFormat(inputImage->GetFormat(), ImageFormat::YUV420)) {
+    int scaleDenom = mScaleDenom;
+    int reqScale   = 0;
+    if ((0 == req->mMetadata.GetMetadata(MetaId::JPEG_DECODE_SCALE,
+                                         reqScale)) &&
+        IsValidScaleDenom(reqScale)) {
+      scaleDenom = reqScale;
+    }
+
+    // Read only, the bitstream may be shared with other requests
+    const ImageData& jpeg                      = *inputImage;
+    const std::vector<unsigned char>& jpegData = jpeg.GetData();
+    std::vector<unsigned char> yuvData;
+    std::vector<unsigned char> scratch;
+    int width  = 0;
+    int height = 0;
+    if (!DecodeJpegToYuv420(jpegData.data(), jpegData.size(), scaleDenom,
+                            yuvData, scratch, width, height)) {
+      LOG(ERROR, ALGOBASE, "Failed to decode Jpeg request ::%d",
+          req->mRequestId);
+      SetStatus(AlgoStatus::FAILURE);
+    } else {
+      req->ClearImages();
+      if (req->AddImage(ImageFormat::YUV420, width, height,
+                        std::move(yuvData))) {
+        LOG(ERROR, ALGOBASE, "Error Filling Output data");
+        SetStatus(AlgoStatus::FAILURE);
+        return GetAlgoStatus();
+      }
+      req->mMetadata.SetMetadata(MetaId::IMAGE_WIDTH, width);
+      req->mMetadata.SetMetadata(MetaId::IMAGE_HEIGHT, height);
+    }
+  }
+#endif
+  int reqdone = 0x00;
+  if (0 == req->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone)) {
+    reqdone |= ALGO_MASK(mAlgoId);
+    req->mMetadata.SetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone);
+  }
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief Close the SWJPEGDEC algorithm, simulating cleanup.
+ * @return Status of the operation.
+ */
+AlgoBase::AlgoStatus SwJpegDec::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SetStatus(AlgoStatus::SUCCESS);
+  return GetAlgoStatus();
+}
+
+/**
+ * @brief max time taken by algo to process a request
+ *
+ * @return int
+ */
+int SwJpegDec::GetTimeout() {
+  return 10000;
+}
+
+/**
+ * @brief output depends only on the request
+ *
+ * @return bool
+ */
+bool SwJpegDec::IsCacheable() const {
+  return true;
+}
+
+/**
+ * @brief Factory function to expose SwJpegDec via shared library.
+ * @return A pointer to the SwJpegDec instance.
+ */
+extern "C" AlgoBase* GetAlgoMethod() {
+  SwJpegDec* pInstance = new SwJpegDec();
+  return pInstance;
+}
+
+/**
+ * @brief Get the algorithm ID.
+ */
+extern "C" AlgoId GetAlgoId() {
+  return ALGO_SWJPEGDEC;
+}
+
+/**
+ * @brief Get the algorithm name.
+ */
+extern "C" const char* GetAlgorithmName() {
+  return SWJPEGDEC_NAME;
+}
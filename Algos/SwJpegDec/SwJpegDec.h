@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef SWJPEGDEC_ALGORITHM_H
+#define SWJPEGDEC_ALGORITHM_H
+
+#include "AlgoBase.h"
+const char* SWJPEGDEC_NAME = "SwJpegDecAlgorithm";
+
+/**
+ * @brief SwJpegDec class derived from AlgoBase to decode JPEG input
+ * straight into YUV420, the reverse of SwJpeg.
+ */
+class SwJpegDec : public AlgoBase {
+ public:
+  /**
+   * @brief Constructor for SwJpegDec.
+   *
+   */
+  SwJpegDec();
+
+  /**
+   * @brief Destructor for SwJpegDec.
+   */
+  ~SwJpegDec() override;
+
+  /**
+   * @brief Open the SWJPEGDEC algorithm, simulating resource checks.
+   * @return Status of the operation.
+   */
+  AlgoStatus Open() override;
+
+  /**
+   * @brief Decode the JPEG image of the request into YUV420, optionally
+   * downscaled in the DCT domain.
+   * @return Status of the operation.
+   */
+  AlgoStatus Process(std::shared_ptr<AlgoRequest> req) override;
+
+  /**
+   * @brief Close the SWJPEGDEC algorithm, simulating cleanup.
+   * @return Status of the operation.
+   */
+  // cppcheck-suppress virtualCallInConstructor
+  AlgoStatus Close() override;
+
+  /**
+   * @brief Get the Timeout object
+   *
+   * @return int
+   */
+  int GetTimeout() override;
+  bool IsCacheable() const override;
+
+ private:
+  mutable std::mutex mutex_;  // Mutex to protect the shared state
+  int mScaleDenom = 1;        // Default DCT scale 1/mScaleDenom
+};
+
+/**
+ * @brief Factory function to expose SwJpegDec via shared library.
+ * @return A pointer to the SwJpegDec instance.
+ */
+extern "C" AlgoBase* GetAlgoMethod();
+
+#endif  // SWJPEGDEC_ALGORITHM_H
@@ -21,8 +21,10 @@
  */
 #include "WaterMarkAlgorithm.h"
 #include "ConfigParser.h"
+#include "FormatPlanner.h"
 #include "Log.h"
-//#include <unistd.h>
+#include <algorithm>
+#include <cmath>
 
 /**
  * @brief Constructor for WaterMarkAlgorithm.
@@ -31,7 +33,10 @@
 WaterMarkAlgorithm::WaterMarkAlgorithm() : AlgoBase(WATERMARK_NAME) {
   mAlgoId = ALGO_WATERMARK;  // Unique ID for WaterMark algorithm
   SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::RGB});
+  SupportedFormatsMap.push_back({ImageFormat::RGBP, ImageFormat::RGBP});
   SupportedFormatsMap.push_back({ImageFormat::YUV420, ImageFormat::YUV420});
+  SupportedFormatsMap.push_back({ImageFormat::NV12, ImageFormat::NV12});
+  SupportedFormatsMap.push_back({ImageFormat::NV21, ImageFormat::NV21});
   ConfigParser parser;
   mConfigFile = CONFIGPATH;
   mConfigFile += AlgoBase::GetAlgorithmName();
@@ -73,7 +78,17 @@ WaterMarkAlgorithm::~WaterMarkAlgorithm() {
  */
 AlgoBase::AlgoStatus WaterMarkAlgorithm::Open() {
   std::lock_guard<std::mutex> lock(mutex_);  // Protect the shared state
-
+#ifdef _CV_ENABLED_
+  // Logo is only read here, overlays are rendered from this copy
+  if (mLogo.empty()) {
+    mLogo = cv::imread(watermarkLogoPath.c_str(), cv::IMREAD_UNCHANGED);
+    if (mLogo.empty()) {
+      LOG(WARNING, ALGOBASE, "Failed to load logo %s, text only watermark",
+          watermarkLogoPath.c_str());
+    }
+  }
+#endif
+  mOverlays.clear();
   SetStatus(AlgoStatus::SUCCESS);
   return GetAlgoStatus();
 }
@@ -108,249 +123,216 @@ cv::Point GetWatermarkPosition(WatermarkPosition position, int imageWidth,
 }
 #endif
 
-AlgoBase::AlgoStatus WaterMarkAlgorithm::ProcessRGB(
-    std::shared_ptr<AlgoRequest> req) {
 #ifdef _CV_ENABLED_
-  auto inputImage = req->GetImage(0);
-  if (!inputImage) {
-    LOG(ERROR, ALGOBASE, "Input image is null.");
-    SetStatus(AlgoStatus::FAILURE);
-    return GetAlgoStatus();
-  }
-
-  const ImageFormat inputFormat = inputImage->GetFormat();
-  const int width               = inputImage->GetWidth();
-  const int height              = inputImage->GetHeight();
-
-  if (CanProcessFormat(inputFormat, ImageFormat::RGB)) {
-    // Convert input RGB image to BGR for OpenCV processing
-    cv::Mat rgbImage(height, width, CV_8UC3, inputImage->GetData().data());
-    cv::Mat bgrImage;
-    cv::cvtColor(rgbImage, bgrImage, cv::COLOR_RGB2BGR);
-
-    // Load watermark logo with alpha channel
-    cv::Mat logo = cv::imread(watermarkLogoPath.c_str(), cv::IMREAD_UNCHANGED);
-    if (logo.empty()) {
-      LOG(ERROR, ALGOBASE, "Failed to load the logo image.");
-      SetStatus(AlgoStatus::FAILURE);
-      return GetAlgoStatus();
-    }
-
-    // Resize logo
-    const int logoWidth  = width / 5;
-    const int logoHeight = logoWidth * logo.rows / logo.cols;
-    cv::resize(logo, logo, cv::Size(logoWidth, logoHeight));
-
-    // Determine logo position based on WatermarkPosition
-    WatermarkPosition position =
-        WatermarkPosition::BOTTOM_RIGHT;  // Example position
-    cv::Point logoPos =
-        GetWatermarkPosition(position, width, height, logoWidth, logoHeight);
-
-    // Adjust position if out of bounds
-    if (logoPos.x < 0 || logoPos.y < 0 || logoPos.x + logoWidth > width ||
-        logoPos.y + logoHeight > height) {
-      LOG(WARNING, ALGOBASE, "Adjusting logo position to fit within image.");
-      logoPos.x = std::max(0, std::min(logoPos.x, width - logoWidth));
-      logoPos.y = std::max(0, std::min(logoPos.y, height - logoHeight));
-    }
-
-    cv::Rect roi(logoPos.x, logoPos.y, logoWidth, logoHeight);
-    if (roi.x < 0 || roi.y < 0 || roi.width + roi.x > bgrImage.cols ||
-        roi.height + roi.y > bgrImage.rows) {
-      LOG(ERROR, ALGOBASE, "Logo region out of image bounds.");
-      SetStatus(AlgoStatus::FAILURE);
-      return GetAlgoStatus();
+/**
+ * @brief Fill the overlay planes from a premultiplied RGBA canvas covering the
+ * ROI. Luma and chroma use the BT.601 video range matrix; since it is affine
+ * the premultiplied colour maps to alpha * YUV directly.
+ *
+ * @param rgba premultiplied R,G,B,A, roiWidth x roiHeight
+ * @param overlay
+ */
+static void BuildOverlayPlanes(const std::vector<uint8_t>& rgba,
+                               WaterMarkOverlay& overlay) {
+  const int w  = overlay.roiWidth;
+  const int h  = overlay.roiHeight;
+  const int cw = w / 2;
+  const int ch = h / 2;
+
+  overlay.yColor.assign(w * h, 0);
+  overlay.yInvAlpha.assign(w * h, 255);
+  overlay.rgbColor.assign(w * h * 3, 0);
+  overlay.rgbInvAlpha.assign(w * h * 3, 255);
+  overlay.rgbPlanes.assign(w * h * 3, 0);
+  overlay.uColor.assign(cw * ch, 0);
+  overlay.vColor.assign(cw * ch, 0);
+  overlay.cInvAlpha.assign(cw * ch, 255);
+  overlay.uvColor.assign(cw * ch * 2, 0);
+  overlay.vuColor.assign(cw * ch * 2, 0);
+  overlay.uvInvAlpha.assign(cw * ch * 2, 255);
+
+  auto clamp8 = [](int v) -> uint8_t {
+    return static_cast<uint8_t>(std::max(0, std::min(255, v)));
+  };
+
+  for (int i = 0; i < w * h; i++) {
+    const int r = rgba[i * 4 + 0];
+    const int g = rgba[i * 4 + 1];
+    const int b = rgba[i * 4 + 2];
+    const int a = rgba[i * 4 + 3];
+    overlay.yColor[i] = clamp8(((66 * r + 129 * g + 25 * b + 128) >> 8) +
+                               (16 * a + 127) / 255);
+    overlay.yInvAlpha[i] = static_cast<uint8_t>(255 - a);
+    for (int c = 0; c < 3; c++) {
+      overlay.rgbColor[i * 3 + c]      = static_cast<uint8_t>(rgba[i * 4 + c]);
+      overlay.rgbInvAlpha[i * 3 + c]   = static_cast<uint8_t>(255 - a);
+      overlay.rgbPlanes[c * w * h + i] = static_cast<uint8_t>(rgba[i * 4 + c]);
     }
+  }
 
-    cv::Mat region = bgrImage(roi);
-
-    // Process logo with alpha blending
-    if (logo.channels() == 4) {
-      cv::Mat channels[4];
-      cv::split(logo, channels);
-      cv::Mat logoBGR;
-      cv::merge(std::vector<cv::Mat>{channels[0], channels[1], channels[2]},
-                logoBGR);
-      cv::Mat alpha = channels[3];
-
-      cv::Mat mask;
-      alpha.convertTo(mask, CV_8UC1, 1.0 / 255.0);
-      cv::threshold(mask, mask, 0.1, 1.0, cv::THRESH_BINARY);
-
-      logoBGR.copyTo(region, mask);
-    } else {
-      cv::Mat logoBGR;
-      if (logo.channels() == 3) {
-        logoBGR = logo;
-      } else {
-        cv::cvtColor(logo, logoBGR, cv::COLOR_GRAY2BGR);
+  // Chroma: average premultiplied colour and alpha over each 2x2 block
+  for (int cy = 0; cy < ch; cy++) {
+    for (int cx = 0; cx < cw; cx++) {
+      int r = 0, g = 0, b = 0, a = 0;
+      for (int dy = 0; dy < 2; dy++) {
+        for (int dx = 0; dx < 2; dx++) {
+          const int i = ((cy * 2 + dy) * w + (cx * 2 + dx)) * 4;
+          r += rgba[i + 0];
+          g += rgba[i + 1];
+          b += rgba[i + 2];
+          a += rgba[i + 3];
+        }
       }
-      logoBGR.copyTo(region);
+      const double bias = 128.0 * a / 255.0;
+      const int u = static_cast<int>(
+          std::lround(((-38 * r - 74 * g + 112 * b) / 256.0 + bias) / 4));
+      const int v = static_cast<int>(
+          std::lround(((112 * r - 94 * g - 18 * b) / 256.0 + bias) / 4));
+      const int j = cy * cw + cx;
+      overlay.uColor[j]    = clamp8(u);
+      overlay.vColor[j]    = clamp8(v);
+      overlay.cInvAlpha[j] = static_cast<uint8_t>(255 - (a + 2) / 4);
+      // Semi-planar layouts blend a row of pairs in one go
+      overlay.uvColor[j * 2]        = overlay.uColor[j];
+      overlay.uvColor[j * 2 + 1]    = overlay.vColor[j];
+      overlay.vuColor[j * 2]        = overlay.vColor[j];
+      overlay.vuColor[j * 2 + 1]    = overlay.uColor[j];
+      overlay.uvInvAlpha[j * 2]     = overlay.cInvAlpha[j];
+      overlay.uvInvAlpha[j * 2 + 1] = overlay.cInvAlpha[j];
     }
-
-    // Add watermark text below the logo
-    int fontFace = cv::FONT_HERSHEY_SCRIPT_SIMPLEX;  // FONT_HERSHEY_SIMPLEX;
-    double fontScale = 1.0;
-    int thickness    = 2;
-    cv::Scalar textColor(255, 255, 255);  // White in BGR
-
-    // Calculate text position below the logo
-    int textX = logoPos.x;
-    int textY = logoPos.y + logoHeight + 30;  // 30 pixels below the logo
-
-    cv::putText(bgrImage, watermarkText, cv::Point(textX, textY), fontFace,
-                fontScale, textColor, thickness);
-
-    // Convert BGR back to RGB for output
-    cv::Mat outputRgbImage;
-    cv::cvtColor(bgrImage, outputRgbImage, cv::COLOR_BGR2RGB);
-    std::vector<uint8_t> outputData(outputRgbImage.total() *
-                                    outputRgbImage.elemSize());
-    memcpy(outputData.data(), outputRgbImage.data, outputData.size());
-
-    req->ClearImages();
-    if (req->AddImage(ImageFormat::RGB, width, height, std::move(outputData))) {
-      LOG(ERROR, ALGOBASE, "Error Filling Output data");
-      SetStatus(AlgoStatus::FAILURE);
-    }
-
-    // LOG(VERBOSE, ALGOBASE, "Watermark processing completed successfully.");
-  } else {
-    LOG(ERROR, ALGOBASE, "Unsupported image format for watermark processing.");
-    SetStatus(AlgoStatus::FAILURE);
-    return GetAlgoStatus();
   }
-#else
-  (void)req;
-#endif
-  return GetAlgoStatus();
 }
-AlgoBase::AlgoStatus WaterMarkAlgorithm::ProcessYUV(
-    std::shared_ptr<AlgoRequest> req) {
+#endif
+
+/**
+ * @brief Render logo and text for a frame size into a premultiplied overlay.
+ * Runs once per resolution, never per frame.
+ *
+ * @param width
+ * @param height
+ * @return std::shared_ptr<const WaterMarkOverlay> nullptr if nothing to draw
+ */
+std::shared_ptr<const WaterMarkOverlay> WaterMarkAlgorithm::RenderOverlay(
+    int width, int height) const {
 #ifdef _CV_ENABLED_
-  auto inputImage = req->GetImage(0);
-  if (!inputImage) {
-    LOG(ERROR, ALGOBASE, "Input image is null.");
-    SetStatus(AlgoStatus::FAILURE);
-    return GetAlgoStatus();
+  // Logo scaled to a fifth of the frame width, converted to BGRA
+  cv::Mat logo;
+  int logoWidth  = 0;
+  int logoHeight = 0;
+  if (!mLogo.empty()) {
+    logoWidth  = width / 5;
+    logoHeight = logoWidth * mLogo.rows / mLogo.cols;
   }
-
-  const ImageFormat inputFormat = inputImage->GetFormat();
-  const int width               = inputImage->GetWidth();
-  const int height              = inputImage->GetHeight();
-  if (CanProcessFormat(inputFormat, ImageFormat::YUV420)) {
-    cv::Mat bgrImage;
-
-    if (inputFormat == ImageFormat::RGB) {
-      // Convert input RGB image to BGR for OpenCV processing
-      cv::Mat rgbImage(height, width, CV_8UC3, inputImage->GetData().data());
-      cv::cvtColor(rgbImage, bgrImage, cv::COLOR_RGB2BGR);
-    } else if (inputFormat == ImageFormat::YUV420) {
-      // Convert YUV420 to BGR
-      cv::Mat yuvImage(height + height / 2, width, CV_8UC1,
-                       inputImage->GetData().data());
-      cv::cvtColor(yuvImage, bgrImage, cv::COLOR_YUV2BGR_I420);
-    } else {
-      LOG(ERROR, ALGOBASE, "Unsupported input format.");
-      SetStatus(AlgoStatus::FAILURE);
-      return GetAlgoStatus();
-    }
-
-    // Load watermark logo with alpha channel
-    cv::Mat logo = cv::imread(watermarkLogoPath.c_str(), cv::IMREAD_UNCHANGED);
-    if (logo.empty()) {
-      LOG(ERROR, ALGOBASE, "Failed to load the logo image.");
-      SetStatus(AlgoStatus::FAILURE);
-      return GetAlgoStatus();
-    }
-
-    // Resize logo
-    const int logoWidth  = width / 5;
-    const int logoHeight = logoWidth * logo.rows / logo.cols;
-    cv::resize(logo, logo, cv::Size(logoWidth, logoHeight));
-
-    // Determine logo position
-    WatermarkPosition position = WatermarkPosition::BOTTOM_RIGHT;
-    cv::Point logoPos =
-        GetWatermarkPosition(position, width, height, logoWidth, logoHeight);
-
-    // Adjust position if out of bounds
-    logoPos.x = std::max(0, std::min(logoPos.x, width - logoWidth));
-    logoPos.y = std::max(0, std::min(logoPos.y, height - logoHeight));
-
-    cv::Rect roi(logoPos.x, logoPos.y, logoWidth, logoHeight);
-    if (roi.x < 0 || roi.y < 0 || roi.width + roi.x > bgrImage.cols ||
-        roi.height + roi.y > bgrImage.rows) {
-      LOG(ERROR, ALGOBASE, "Logo region out of image bounds.");
-      SetStatus(AlgoStatus::FAILURE);
-      return GetAlgoStatus();
+  if (logoWidth > 0 && logoHeight > 0) {
+    cv::resize(mLogo, logo, cv::Size(logoWidth, logoHeight), 0, 0,
+               cv::INTER_AREA);
+    if (logo.channels() == 3) {
+      cv::cvtColor(logo, logo, cv::COLOR_BGR2BGRA);
+    } else if (logo.channels() == 1) {
+      cv::cvtColor(logo, logo, cv::COLOR_GRAY2BGRA);
     }
+  } else {
+    logoWidth  = 0;
+    logoHeight = 0;
+  }
 
-    cv::Mat region = bgrImage(roi);
-
-    // Process logo with alpha blending
-    if (logo.channels() == 4) {
-      cv::Mat channels[4];
-      cv::split(logo, channels);
-      cv::Mat logoBGR;
-      cv::merge(std::vector<cv::Mat>{channels[0], channels[1], channels[2]},
-                logoBGR);
-      cv::Mat alpha = channels[3];
-
-      cv::Mat mask;
-      alpha.convertTo(mask, CV_8UC1, 1.0 / 255.0);
-      cv::threshold(mask, mask, 0.1, 1.0, cv::THRESH_BINARY);
+  // Determine logo position
+  WatermarkPosition position = WatermarkPosition::BOTTOM_RIGHT;
+  cv::Point logoPos =
+      GetWatermarkPosition(position, width, height, logoWidth, logoHeight);
+  logoPos.x = std::max(0, std::min(logoPos.x, width - logoWidth));
+  logoPos.y = std::max(0, std::min(logoPos.y, height - logoHeight));
+
+  // Watermark text below the logo
+  const int fontFace     = cv::FONT_HERSHEY_SCRIPT_SIMPLEX;
+  const double fontScale = 1.0;
+  const int thickness    = 2;
+  int baseline           = 0;
+  const cv::Size textSize =
+      cv::getTextSize(watermarkText, fontFace, fontScale, thickness, &baseline);
+  const cv::Point textPos(logoPos.x, logoPos.y + logoHeight + 30);
+
+  // ROI is the union of logo and text boxes, clipped and even aligned
+  cv::Rect box(logoPos.x, logoPos.y, logoWidth, logoHeight);
+  if (!watermarkText.empty()) {
+    box |= cv::Rect(textPos.x, textPos.y - textSize.height, textSize.width,
+                    textSize.height + baseline + thickness);
+  }
+  const int x0 = std::max(0, box.x) & ~1;
+  const int y0 = std::max(0, box.y) & ~1;
+  const int x1 = std::min(width & ~1, (box.x + box.width + 1) & ~1);
+  const int y1 = std::min(height & ~1, (box.y + box.height + 1) & ~1);
+  if (x1 <= x0 || y1 <= y0) {
+    return nullptr;
+  }
 
-      logoBGR.copyTo(region, mask);
-    } else {
-      cv::Mat logoBGR;
-      if (logo.channels() == 3) {
-        logoBGR = logo;
-      } else {
-        cv::cvtColor(logo, logoBGR, cv::COLOR_GRAY2BGR);
+  auto overlay       = std::make_shared<WaterMarkOverlay>();
+  overlay->roiX      = x0;
+  overlay->roiY      = y0;
+  overlay->roiWidth  = x1 - x0;
+  overlay->roiHeight = y1 - y0;
+
+  // Text coverage rendered anti-aliased into its own alpha mask
+  cv::Mat textMask(overlay->roiHeight, overlay->roiWidth, CV_8UC1,
+                   cv::Scalar(0));
+  cv::putText(textMask, watermarkText,
+              cv::Point(textPos.x - x0, textPos.y - y0), fontFace, fontScale,
+              cv::Scalar(255), thickness, cv::LINE_AA);
+
+  // White text over the logo, composited as premultiplied RGBA
+  std::vector<uint8_t> rgba(overlay->roiWidth * overlay->roiHeight * 4, 0);
+  for (int y = 0; y < overlay->roiHeight; y++) {
+    for (int x = 0; x < overlay->roiWidth; x++) {
+      int r = 0, g = 0, b = 0, a = 0;
+      const int lx = x + x0 - logoPos.x;
+      const int ly = y + y0 - logoPos.y;
+      if (lx >= 0 && ly >= 0 && lx < logoWidth && ly < logoHeight) {
+        const cv::Vec4b& p = logo.at<cv::Vec4b>(ly, lx);
+        a                  = p[3];
+        r                  = (p[2] * a + 127) / 255;
+        g                  = (p[1] * a + 127) / 255;
+        b                  = (p[0] * a + 127) / 255;
       }
-      logoBGR.copyTo(region);
-    }
-
-    // Add watermark text below the logo
-    int fontFace     = cv::FONT_HERSHEY_SCRIPT_SIMPLEX;
-    double fontScale = 1.0;
-    int thickness    = 2;
-    cv::Scalar textColor(255, 255, 255);  // White in BGR
-
-    int textX = logoPos.x;
-    int textY = logoPos.y + logoHeight + 30;
-
-    cv::putText(bgrImage, watermarkText, cv::Point(textX, textY), fontFace,
-                fontScale, textColor, thickness);
-
-    // Convert output back to original format
-    std::vector<uint8_t> outputData;
-
-    if (inputFormat == ImageFormat::RGB) {
-      cv::Mat outputRgbImage;
-      cv::cvtColor(bgrImage, outputRgbImage, cv::COLOR_BGR2RGB);
-      outputData.resize(outputRgbImage.total() * outputRgbImage.elemSize());
-      memcpy(outputData.data(), outputRgbImage.data, outputData.size());
-    } else if (inputFormat == ImageFormat::YUV420) {
-      cv::Mat yuvImage;
-      cv::cvtColor(bgrImage, yuvImage, cv::COLOR_BGR2YUV_I420);
-      outputData.resize(yuvImage.total() * yuvImage.elemSize());
-      memcpy(outputData.data(), yuvImage.data, outputData.size());
-    }
-
-    req->ClearImages();
-    if (req->AddImage(inputFormat, width, height, std::move(outputData))) {
-      LOG(ERROR, ALGOBASE, "Error Filling Output data");
-      SetStatus(AlgoStatus::FAILURE);
+      const int t = textMask.at<uint8_t>(y, x);
+      uint8_t* o  = &rgba[(y * overlay->roiWidth + x) * 4];
+      o[0]        = static_cast<uint8_t>(t + (r * (255 - t) + 127) / 255);
+      o[1]        = static_cast<uint8_t>(t + (g * (255 - t) + 127) / 255);
+      o[2]        = static_cast<uint8_t>(t + (b * (255 - t) + 127) / 255);
+      o[3]        = static_cast<uint8_t>(t + (a * (255 - t) + 127) / 255);
     }
   }
+  BuildOverlayPlanes(rgba, *overlay);
+  LOG(VERBOSE, ALGOBASE, "Watermark overlay %dx%d at (%d,%d) for %dx%d",
+      overlay->roiWidth, overlay->roiHeight, overlay->roiX, overlay->roiY,
+      width, height);
+  return overlay;
 #else
-  (void)req;
+  (void)width;
+  (void)height;
+  return nullptr;
 #endif
-  return GetAlgoStatus();
 }
+
+/**
+ * @brief Overlay for a frame size, rendered on first use and reused after
+ *
+ * @param width
+ * @param height
+ * @return std::shared_ptr<const WaterMarkOverlay>
+ */
+std::shared_ptr<const WaterMarkOverlay> WaterMarkAlgorithm::GetOverlay(
+    int width, int height) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key = std::make_pair(width, height);
+  auto it  = mOverlays.find(key);
+  if (it != mOverlays.end()) {
+    return it->second;
+  }
+  auto overlay   = RenderOverlay(width, height);
+  mOverlays[key] = overlay;
+  return overlay;
+}
+
 /**
  * @brief Process the WaterMark algorithm, simulating input validation and
  * WaterMark computation.
@@ -369,18 +351,29 @@ AlgoBase::AlgoStatus WaterMarkAlgorithm::Process(
     return GetAlgoStatus();
   }
 
-  switch (inputImage->GetFormat()) {
-    case ImageFormat::YUV420:
-      rc = ProcessYUV(req);
-      break;
-    case ImageFormat::RGB:
-      rc = ProcessRGB(req);
-      break;
-    default:
-      LOG(ERROR, ALGOBASE, "Unsupported image format.");
-      SetStatus(AlgoStatus::FAILURE);
-      rc = GetAlgoStatus();
-      break;
+  const ImageFormat format = inputImage->GetFormat();
+  const int width          = inputImage->GetWidth();
+  const int height         = inputImage->GetHeight();
+  if (!IsStripeFormat(format)) {
+    LOG(ERROR, ALGOBASE, "Unsupported image format.");
+    SetStatus(AlgoStatus::FAILURE);
+    rc = GetAlgoStatus();
+  } else if (inputImage->GetDataSize() <
+             GetStripeSize(format, width, 0, height)) {
+    LOG(ERROR, ALGOBASE, "%s buffer too small for %dx%d",
+        GetFormatName(format), width, height);
+    SetStatus(AlgoStatus::FAILURE);
+    rc = GetAlgoStatus();
+  } else {
+    auto overlay = GetOverlay(width, height);
+    if (overlay) {
+      // Blends in place, so this read has to be the writable one, which
+      // copies a shared buffer and drops its cached hash and views
+      BlendOverlay(*overlay,
+                   MapFrameStripe(format, width, height,
+                                  inputImage->GetData().data(), 0, height));
+    }
+    rc = GetAlgoStatus();
   }
 
   int reqdone = 0x00;
@@ -411,6 +404,70 @@ int WaterMarkAlgorithm::GetTimeout() {
   return 1000;
 }
 
+/**
+ * @brief output depends only on the request
+ *
+ * @return bool
+ */
+bool WaterMarkAlgorithm::IsCacheable() const {
+  return true;
+}
+
+/**
+ * @brief the overlay is blended per pixel at a fixed place, so unchanged
+ * input stays unchanged output and the mask passes through as it is
+ *
+ * @return bool
+ */
+bool WaterMarkAlgorithm::SupportsDirtyBlocks() const {
+  return true;
+}
+
+/**
+ * @brief only the overlay ROI is blended, the rest of the frame is left as
+ * it is; an empty rect when there is nothing to draw
+ *
+ * @return bool
+ */
+bool WaterMarkAlgorithm::GetWrittenRect(ImageFormat format, int width,
+                                        int height, DirtyRect &rect) const {
+  (void)format;
+  auto overlay = GetOverlay(width, height);
+  rect         = DirtyRect{};
+  if (overlay) {
+    rect = DirtyRect{overlay->roiX, overlay->roiY, overlay->roiWidth,
+                     overlay->roiHeight};
+  }
+  return true;
+}
+
+/**
+ * @brief the overlay is blended per pixel, no rows around are read
+ *
+ * @param format
+ * @return int
+ */
+int WaterMarkAlgorithm::GetStripeHalo(ImageFormat format) const {
+  return IsStripeFormat(format) ? 0 : -1;
+}
+
+/**
+ * @brief Copy the rows of a stripe and blend the overlay part they hold
+ *
+ * @param in
+ * @param out
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus WaterMarkAlgorithm::ProcessStripe(const ImageStripe& in,
+                                                       ImageStripe& out) {
+  CopyStripe(in, out);
+  auto overlay = GetOverlay(out.width, out.height);
+  if (overlay) {
+    BlendOverlay(*overlay, out);
+  }
+  return AlgoStatus::SUCCESS;
+}
+
 // Public Exposed API for WaterMark
 /**
  * @brief Factory function to expose WaterMarkAlgorithm via shared library.
@@ -23,10 +23,15 @@
 #define WATERMARK_ALGORITHM_H
 
 #include "AlgoBase.h"
+#include "StripeKernels.h"
 #ifdef _CV_ENABLED_
 #include <opencv2/opencv.hpp>
 #endif
+#include <cstdint>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 const char *WATERMARK_NAME = "WaterMarkAlgorithm";
 
 enum class WatermarkPosition { TOP_LEFT,
@@ -76,18 +81,29 @@ public:
    * @return int
    */
   int GetTimeout() override;
+  bool IsCacheable() const override;
+  bool SupportsDirtyBlocks() const override;
+  int GetStripeHalo(ImageFormat format) const override;
+  bool GetWrittenRect(ImageFormat format, int width, int height,
+                      DirtyRect &rect) const override;
+  AlgoStatus ProcessStripe(const ImageStripe &in, ImageStripe &out) override;
 
 private:
   mutable std::mutex mutex_;     // Mutex to protect the shared state
 #ifdef _CV_ENABLED_
-  cv::Mat image_;                // Original image
-  cv::Mat watermark_;            // Watermark (text or image)
+  cv::Mat mLogo;                 // Logo as loaded from disk, read once in Open
 #endif
   std::string watermarkText;     // If you want to apply text watermark
   std::string watermarkLogoPath; // If you want to apply logo
+  // Overlays keyed by frame (width, height), rendered on first use
+  mutable std::map<std::pair<int, int>,
+                   std::shared_ptr<const WaterMarkOverlay>>
+      mOverlays;
 
-  AlgoStatus ProcessRGB(std::shared_ptr<AlgoRequest> req);
-  AlgoStatus ProcessYUV(std::shared_ptr<AlgoRequest> req);
+  std::shared_ptr<const WaterMarkOverlay> GetOverlay(int width,
+                                                     int height) const;
+  std::shared_ptr<const WaterMarkOverlay> RenderOverlay(int width,
+                                                        int height) const;
 };
 
 /**
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef BILATERAL_GRID_H
+#define BILATERAL_GRID_H
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#define BILATERAL_GRID_PAD 1        // Empty cells around the grid on each axis
+#define BILATERAL_SLICE_BAND 32     // Image rows sliced as one tile
+#define BILATERAL_MIN_WEIGHT 1e-3f  // Less weight keeps the source sample
+
+/**
+ * @brief Downsampled (x, y, value) grid of an 8-bit plane. Cell z of column
+ * gx of row gy holds the sum of the samples splatted into it and their
+ * count at cells[2 * ((gy * width + gx) * depth + z)] and the float after.
+ */
+struct BilateralGrid {
+  int cellSize    = 0;     // Image pixels per cell along x and y
+  float cellRange = 0.0f;  // Sample levels per cell along z
+  int width       = 0;     // Cells per axis, padding included
+  int height      = 0;
+  int depth       = 0;
+  std::vector<float> cells;
+};
+
+// Size the grid for a plane, spatial and range sigma are the cell sizes
+void BilateralInitGrid(BilateralGrid& grid, int width, int height,
+                       float sigmaSpatial, float sigmaRange);
+
+// Add every sample to its nearest cell, samples are step bytes apart
+void BilateralSplat(BilateralGrid& grid, const unsigned char* src, int width,
+                    int height, int stride, int step);
+
+// Separable [1 2 1] / 4 blur along x, y and value
+void BilateralBlur(BilateralGrid& grid);
+
+// Trilinear read of the blurred grid at every sample, normalised by weight
+void BilateralSlice(const BilateralGrid& grid, const unsigned char* src,
+                    unsigned char* dst, int width, int height, int stride,
+                    int step);
+
+// Edge preserving smoothing: splat, blur and slice with a grid of its own
+void BilateralFilterPlane(const unsigned char* src, unsigned char* dst,
+                          int width, int height, int stride, int step,
+                          float sigmaSpatial, float sigmaRange);
+
+#endif  // BILATERAL_GRID_H
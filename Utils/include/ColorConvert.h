@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef COLOR_CONVERT_H
+#define COLOR_CONVERT_H
+#pragma once
+#include <cstddef>
+
+// Row kernels between the planar, semi-planar and RGB24 layouts. YUV is
+// BT.601 video range, the same equations SwJpeg uses to encode YUV input.
+
+// dst[2 * i] = a[i], dst[2 * i + 1] = b[i]
+void InterleavePlanes(const unsigned char* a, const unsigned char* b,
+                      unsigned char* dst, size_t count);
+
+// Inverse of InterleavePlanes
+void DeinterleavePlanes(const unsigned char* src, unsigned char* a,
+                        unsigned char* b, size_t count);
+
+// rgb[3 * i + c] = plane c[i], RGB24 from R, G and B planes
+void InterleaveRgb(const unsigned char* r, const unsigned char* g,
+                   const unsigned char* b, unsigned char* rgb, size_t count);
+
+// Inverse of InterleaveRgb
+void DeinterleaveRgb(const unsigned char* rgb, unsigned char* r,
+                     unsigned char* g, unsigned char* b, size_t count);
+
+// Swap the two bytes of count pairs, src may equal dst
+void SwapPairs(const unsigned char* src, unsigned char* dst, size_t count);
+
+// One RGB24 row from a luma row and its width / 2 U and V samples
+void YuvToRgbRow(const unsigned char* y, const unsigned char* u,
+                 const unsigned char* v, unsigned char* rgb, int width);
+
+// One luma row from an RGB24 row
+void RgbToLumaRow(const unsigned char* rgb, unsigned char* y, int width);
+
+// Two RGB24 rows to two luma rows and width / 2 U and V samples, chroma
+// from the average of each 2x2 block. width is even.
+void RgbToYuvRows(const unsigned char* rgb0, const unsigned char* rgb1,
+                  unsigned char* y0, unsigned char* y1, unsigned char* u,
+                  unsigned char* v, int width);
+
+#endif  // COLOR_CONVERT_H
@@ -41,6 +41,7 @@ class ConfigParser {
   bool loadFile(const std::string& filename);
   std::string getValue(const std::string& key);
   int getIntValue(const std::string& key);
+  float getFloatValue(const std::string& key);
   int getErrorCode() const;
 
   std::string trim(const std::string& str);
@@ -37,7 +37,8 @@ class EventHandlerThread {
 
   // Constructor
   EventHandlerThread(EventHandler handler, void* context)
-      : mHandler(handler), mContext(context), mRunning(false) {
+      : mHandler(handler), mContext(context), mRunning(true) {
+    // Running before the thread starts, so an early stop() still joins it
 
     mPthread =
         std::make_shared<ThreadWrapper>(&EventHandlerThread::threadFunc, this);
@@ -72,8 +73,7 @@ class EventHandlerThread {
  private:
   // The function executed by the thread
   static void* threadFunc(void* arg) {
-    auto self      = static_cast<EventHandlerThread*>(arg);
-    self->mRunning = true;
+    auto self = static_cast<EventHandlerThread*>(arg);
     while (true) {
       std::shared_ptr<T> event = nullptr;
       {
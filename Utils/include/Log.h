@@ -66,6 +66,9 @@ extern LogLevel logLevel;
 #define REQUESTMONITOR "REQUESTMONITOR"
 #define KPI "KPI"
 #define ALGODECISIONMANAGER "ALGODECISIONMANAGER"
+#define FRAMEASSEMBLER "FRAMEASSEMBLER"
+#define RESULTCACHE "RESULTCACHE"
+#define TILEDIMAGE "TILEDIMAGE"
 
 // Function declarations
 std::string getCurrentTime();
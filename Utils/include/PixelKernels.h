@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef PIXEL_KERNELS_H
+#define PIXEL_KERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "AlgoRequest.h"
+
+// Pixel loops written once as functors and instantiated per layout. A layout
+// fixes the sample type, channel count and subsampling of every plane at
+// compile time, so the inner loops walk contiguous samples with a constant
+// step and no format branches, which is the shape the compiler vectorises.
+
+/**
+ * @brief One plane of Cn interleaved channels of type T, subsampled by
+ * 1 << ShiftX along x and 1 << ShiftY along y
+ */
+template <typename T, int Cn, int ShiftX = 0, int ShiftY = 0>
+struct PlaneLayout {
+  using Sample                   = T;
+  static constexpr int kChannels = Cn;
+  static constexpr int kShiftX   = ShiftX;
+  static constexpr int kShiftY   = ShiftY;
+
+  static constexpr int Width(int width) { return width >> ShiftX; }
+  static constexpr int Height(int height) { return height >> ShiftY; }
+  // Samples of a row
+  static constexpr int RowSamples(int width) { return Width(width) * Cn; }
+  // Bytes of a row
+  static constexpr size_t RowSize(int width) {
+    return static_cast<size_t>(RowSamples(width)) * sizeof(T);
+  }
+  static constexpr size_t Size(int width, int height) {
+    return RowSize(width) * Height(height);
+  }
+};
+
+/**
+ * @brief Planes of a frame stored back to back
+ */
+template <typename... Planes>
+struct FrameLayout {
+  static constexpr int kPlanes = sizeof...(Planes);
+  // Frame width and height are multiples of these
+  static constexpr int kAlignX = std::max({(1 << Planes::kShiftX)...});
+  static constexpr int kAlignY = std::max({(1 << Planes::kShiftY)...});
+
+  template <int P>
+  using Plane = std::tuple_element_t<P, std::tuple<Planes...>>;
+
+  // Byte offset of plane P
+  template <int P>
+  static constexpr size_t Offset(int width, int height) {
+    if constexpr (P == 0) {
+      return 0;
+    } else {
+      return Offset<P - 1>(width, height) +
+             Plane<P - 1>::Size(width, height);
+    }
+  }
+  static constexpr size_t Size(int width, int height) {
+    return (Planes::Size(width, height) + ... + 0);
+  }
+};
+
+/**
+ * @brief Layout of an ImageFormat, defined for the raw formats only
+ */
+template <ImageFormat F>
+struct FormatLayout;
+
+template <ImageFormat F, int ColorPlanes, typename... Planes>
+struct FormatLayoutOf : FrameLayout<Planes...> {
+  static constexpr ImageFormat kFormat = F;
+  // Leading planes a kernel treats alike: R, G and B, or luma alone
+  static constexpr int kColorPlanes = ColorPlanes;
+};
+
+template <>
+struct FormatLayout<ImageFormat::GRAYSCALE>
+    : FormatLayoutOf<ImageFormat::GRAYSCALE, 1, PlaneLayout<uint8_t, 1>> {};
+template <>
+struct FormatLayout<ImageFormat::RGB>
+    : FormatLayoutOf<ImageFormat::RGB, 1, PlaneLayout<uint8_t, 3>> {};
+template <>
+struct FormatLayout<ImageFormat::RGBP>
+    : FormatLayoutOf<ImageFormat::RGBP, 3, PlaneLayout<uint8_t, 1>,
+                     PlaneLayout<uint8_t, 1>, PlaneLayout<uint8_t, 1>> {};
+template <>
+struct FormatLayout<ImageFormat::YUV420>
+    : FormatLayoutOf<ImageFormat::YUV420, 1, PlaneLayout<uint8_t, 1>,
+                     PlaneLayout<uint8_t, 1, 1, 1>,
+                     PlaneLayout<uint8_t, 1, 1, 1>> {};
+template <>
+struct FormatLayout<ImageFormat::YUV422>
+    : FormatLayoutOf<ImageFormat::YUV422, 1, PlaneLayout<uint8_t, 1>,
+                     PlaneLayout<uint8_t, 1, 1, 0>,
+                     PlaneLayout<uint8_t, 1, 1, 0>> {};
+template <>
+struct FormatLayout<ImageFormat::YUV444>
+    : FormatLayoutOf<ImageFormat::YUV444, 1, PlaneLayout<uint8_t, 1>,
+                     PlaneLayout<uint8_t, 1>, PlaneLayout<uint8_t, 1>> {};
+template <>
+struct FormatLayout<ImageFormat::NV12>
+    : FormatLayoutOf<ImageFormat::NV12, 1, PlaneLayout<uint8_t, 1>,
+                     PlaneLayout<uint8_t, 2, 1, 1>> {};
+template <>
+struct FormatLayout<ImageFormat::NV21>
+    : FormatLayoutOf<ImageFormat::NV21, 1, PlaneLayout<uint8_t, 1>,
+                     PlaneLayout<uint8_t, 2, 1, 1>> {};
+
+/**
+ * @brief Call func(FormatLayout<F>()) for the F of format, so one generic
+ * lambda is instantiated once per layout
+ *
+ * @param format
+ * @param func
+ * @return bool false if format has no layout, func is not called
+ */
+template <typename Func>
+bool DispatchFormat(ImageFormat format, Func&& func) {
+  switch (format) {
+    case ImageFormat::GRAYSCALE:
+      func(FormatLayout<ImageFormat::GRAYSCALE>());
+      return true;
+    case ImageFormat::RGB:
+      func(FormatLayout<ImageFormat::RGB>());
+      return true;
+    case ImageFormat::RGBP:
+      func(FormatLayout<ImageFormat::RGBP>());
+      return true;
+    case ImageFormat::YUV420:
+      func(FormatLayout<ImageFormat::YUV420>());
+      return true;
+    case ImageFormat::YUV422:
+      func(FormatLayout<ImageFormat::YUV422>());
+      return true;
+    case ImageFormat::YUV444:
+      func(FormatLayout<ImageFormat::YUV444>());
+      return true;
+    case ImageFormat::NV12:
+      func(FormatLayout<ImageFormat::NV12>());
+      return true;
+    case ImageFormat::NV21:
+      func(FormatLayout<ImageFormat::NV21>());
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename Func, int... P>
+void ForEachPlaneImpl(Func& func, std::integer_sequence<int, P...>) {
+  (func(std::integral_constant<int, P>()), ...);
+}
+
+/**
+ * @brief Call func(std::integral_constant<int, P>()) for every plane P of
+ * Layout, in order
+ *
+ * @param func
+ */
+template <typename Layout, typename Func>
+void ForEachPlane(Func&& func) {
+  ForEachPlaneImpl(func, std::make_integer_sequence<int, Layout::kPlanes>());
+}
+
+// True if op.Row(count, dst, src...) exists
+template <typename Op, typename Sig, typename = void>
+struct HasRowKernel : std::false_type {};
+template <typename Op, typename T, typename... Srcs>
+struct HasRowKernel<
+    Op, void(T*, const Srcs*...),
+    std::void_t<decltype(std::declval<Op&>().Row(
+        0, std::declval<T*>(), std::declval<const Srcs*>()...))>>
+    : std::true_type {};
+
+/**
+ * @brief dst[i] = op(src[i]...) for count samples. An op may also provide
+ * int Row(count, dst, src...), a vector body run first that returns how many
+ * samples it wrote; op() finishes the tail. dst may be one of the sources.
+ *
+ * @param op
+ * @param count
+ * @param dst
+ * @param src
+ */
+template <typename Op, typename T, typename... Srcs>
+inline void PointwiseRow(Op& op, int count, T* dst, const Srcs*... src) {
+  int i = 0;
+  if constexpr (HasRowKernel<Op, void(T*, const Srcs*...)>::value) {
+    i = op.Row(count, dst, src...);
+  }
+  for (; i < count; i++) {
+    dst[i] = op(src[i]...);
+  }
+}
+
+/**
+ * @brief dst[i] = op(rows, i, step) for the samples of pixels [x0, x1) of a
+ * row of Cn channels. rows holds the 2 * Op::kRadius + 1 rows centred on the
+ * output row, step is std::integral_constant<int, Cn>, the distance from a
+ * sample to the same channel of the next pixel. The rows must be readable
+ * kRadius pixels before x0 and after x1.
+ *
+ * @param op
+ * @param rows
+ * @param dst output row
+ * @param x0
+ * @param x1
+ */
+template <int Cn, typename Op, typename T>
+inline void NeighbourhoodRow(Op& op, const T* const* rows, T* dst, int x0,
+                             int x1) {
+  constexpr std::integral_constant<int, Cn> step{};
+  for (int i = x0 * Cn; i < x1 * Cn; i++) {
+    dst[i] = op(rows, i, step);
+  }
+}
+
+#endif  // PIXEL_KERNELS_H
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef ROTATE_ENGINE_H
+#define ROTATE_ENGINE_H
+#pragma once
+
+#define ROTATE_TILE 64  // Edge in elements of the square tile one task moves
+
+// Size of a plane after rotating it clockwise by degrees
+void RotateGetSize(int width, int height, int degrees, int& outWidth,
+                   int& outHeight);
+
+// Mirror a plane left-right when mirror is set, then rotate it clockwise by
+// 0, 90, 180 or 270 degrees. Elements are elemSize bytes, 1 for planar
+// samples, 2 for interleaved chroma, 3 for RGB. dst must not overlap src.
+// Returns -1 for an unsupported angle or element size.
+int RotatePlane(const unsigned char* src, int width, int height,
+                int srcStride, int elemSize, unsigned char* dst,
+                int dstStride, int degrees, bool mirror);
+
+#endif  // ROTATE_ENGINE_H
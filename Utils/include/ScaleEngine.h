@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef SCALE_ENGINE_H
+#define SCALE_ENGINE_H
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#define SCALE_COEF_BITS 14  // Taps of an output sample sum to 1 << this
+#define SCALE_MID_BITS 6    // Fraction bits of horizontally filtered samples
+
+enum class ScaleMode {
+  BILINEAR = 0,  // 2 taps, fastest, aliases when shrinking a lot
+  AREA,          // Box average when shrinking, bilinear when growing
+  LANCZOS        // Lanczos3, sharpest, widest
+};
+
+/**
+ * @brief Fixed-point filter taps of one axis. Output sample i reads taps
+ * consecutive source samples from start[i], weighted by
+ * coef[i * taps + k]. Edge samples are repeated, so no tap reads outside.
+ */
+struct ScaleAxis {
+  int srcSize = 0;
+  int dstSize = 0;
+  int taps    = 0;
+  std::vector<int32_t> start;
+  std::vector<int16_t> coef;
+};
+
+/**
+ * @brief One output of ScalePlane, axes built for the plane size
+ */
+struct ScaleTarget {
+  const ScaleAxis* xAxis = nullptr;
+  const ScaleAxis* yAxis = nullptr;
+  unsigned char* dst     = nullptr;
+  int dstStride          = 0;  // Bytes per output row
+};
+
+// Build the taps of an axis resizing srcSize samples to dstSize
+void ScaleInitAxis(ScaleAxis& axis, int srcSize, int dstSize, ScaleMode mode);
+
+// Separable resize of a plane of cn interleaved channels to every target,
+// reading each source row once
+void ScalePlane(const unsigned char* src, int srcWidth, int srcHeight,
+                int srcStride, int cn, const std::vector<ScaleTarget>& targets);
+
+// One row of a 2x2 box downscale, dst[i] is the rounded mean of the 2x2 block
+// at column 2 * i of row0 and row1
+void ScaleHalfRow(const unsigned char* row0, const unsigned char* row1,
+                  unsigned char* dst, int dstWidth);
+
+#endif  // SCALE_ENGINE_H
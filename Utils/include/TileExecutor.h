@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef TILE_EXECUTOR_H
+#define TILE_EXECUTOR_H
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ThreadWrapper.h"
+
+/**
+ * @brief Fixed pool of worker threads running a function over a range of
+ * tiles. Run() blocks until every tile is done and the calling thread works
+ * on tiles too. A Run() issued while the pool is busy (another node, or a
+ * nested call from inside a tile) executes inline on the caller.
+ */
+class TileExecutor {
+ public:
+  // Constructor, threads is the number of workers besides the caller
+  explicit TileExecutor(int threads);
+
+  // Destructor
+  ~TileExecutor();
+
+  // Process wide instance sized to the hardware
+  static TileExecutor& GetInstance();
+
+  // Run func(tile) for tile in [0, tileCount) and wait for all of them
+  void Run(int tileCount, const std::function<void(int)>& func);
+
+  // Number of threads taking part in a Run, caller included
+  int GetConcurrency() const;
+
+ private:
+  // Internal worker thread function
+  static void* WorkerThreadFunction(void* arg);
+
+  // Claim and run tiles of the current job until none are left
+  void RunTiles();
+
+  std::vector<std::shared_ptr<ThreadWrapper>> mWorkers;
+  std::mutex mRunMux;  // Held by the Run() that owns the pool
+  std::mutex mJobMux;  // Protects the job fields below
+  std::condition_variable mWorkCondVar;
+  std::condition_variable mDoneCondVar;
+  const std::function<void(int)>* mJob = nullptr;
+  int mTileCount                      = 0;
+  std::atomic<int> mNextTile{0};
+  size_t mActiveWorkers = 0;
+  uint64_t mGeneration  = 0;
+  bool bIsRunning       = true;
+};
+
+#endif  // TILE_EXECUTOR_H
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef WARP_ENGINE_H
+#define WARP_ENGINE_H
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define WARP_MAP_BITS 5  // Fractional bits of a source position
+#define WARP_MAP_SCALE (1 << WARP_MAP_BITS)
+#define WARP_COEF_BITS (2 * WARP_MAP_BITS)  // Bilinear weights sum to 1 << this
+#define WARP_TILE_WIDTH 256   // Largest output tile, split further for L2
+#define WARP_TILE_HEIGHT 64
+#define WARP_MIN_TILE 16
+
+/**
+ * @brief Output rectangle processed as one unit of work
+ */
+struct WarpTile {
+  int x      = 0;
+  int y      = 0;
+  int width  = 0;
+  int height = 0;
+};
+
+/**
+ * @brief Fixed-point remap table, same layout as OpenCV's CV_16SC2 + CV_16UC1
+ * pair. Entry i holds the integer source position and the 1/WARP_MAP_SCALE
+ * fraction of output pixel i. Tiles are filled by WarpBuildTiles.
+ */
+struct WarpMap {
+  int width  = 0;
+  int height = 0;
+  std::vector<int16_t> xy;     // sx, sy per output pixel
+  std::vector<uint16_t> frac;  // (fy << WARP_MAP_BITS) | fx
+  std::vector<WarpTile> tiles;
+};
+
+// Allocate a width x height map
+void WarpInitMap(WarpMap& map, int width, int height);
+
+// Store the source position of output pixel (x, y) in fixed point
+void WarpSetEntry(WarpMap& map, int x, int y, double sx, double sy);
+
+// Split the map into output tiles whose source footprint fits in L2
+void WarpBuildTiles(WarpMap& map);
+
+// Bilinear remap of planes sharing one map, cn interleaved channels each
+void WarpRemap(const WarpMap& map, const unsigned char* const* src,
+               unsigned char* const* dst, int planes, int cn,
+               unsigned char border);
+
+// Same as WarpRemap over the given output tiles only
+void WarpRemapTiles(const WarpMap& map, const std::vector<WarpTile>& tiles,
+                    const unsigned char* const* src, unsigned char* const* dst,
+                    int planes, int cn, unsigned char border);
+
+// Source pixels read by an output tile, width 0 if it reads only the border
+WarpTile WarpGetSourceBounds(const WarpMap& map, const WarpTile& tile);
+
+// Bilinear perspective warp, matrix maps output to source coordinates
+void WarpPerspective(const unsigned char* const* src,
+                     unsigned char* const* dst, int planes, int width,
+                     int height, int cn, const double matrix[9],
+                     unsigned char border);
+
+// L2 cache size used to size tiles
+size_t WarpGetL2CacheSize();
+
+#endif  // WARP_ENGINE_H
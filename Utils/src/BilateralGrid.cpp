@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "../include/BilateralGrid.h"
+#include <algorithm>
+#include <cmath>
+#include "../include/TileExecutor.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Size the grid for a plane and clear it. A cell spans one sigma on
+ * every axis, the blur then gives about a one sigma Gaussian.
+ *
+ * @param grid
+ * @param width image width
+ * @param height image height
+ * @param sigmaSpatial pixels
+ * @param sigmaRange sample levels
+ */
+void BilateralInitGrid(BilateralGrid& grid, int width, int height,
+                       float sigmaSpatial, float sigmaRange) {
+  grid.cellSize  = std::max(1, static_cast<int>(std::lround(sigmaSpatial)));
+  grid.cellRange = std::max(1.0f, sigmaRange);
+  // Cells reached by rounding, plus one to interpolate past the last one
+  auto cells = [&grid](int size) {
+    return (std::max(size, 1) - 1 + grid.cellSize - 1) / grid.cellSize + 1 +
+           2 * BILATERAL_GRID_PAD;
+  };
+  grid.width  = cells(width);
+  grid.height = cells(height);
+  grid.depth  = static_cast<int>(std::ceil(255.0f / grid.cellRange)) + 1 +
+               2 * BILATERAL_GRID_PAD;
+  grid.cells.assign(
+      static_cast<size_t>(grid.width) * grid.height * grid.depth * 2, 0.0f);
+}
+
+/**
+ * @brief Nearest cell splat. Tiles own whole grid rows and the image rows
+ * rounding to them, so no two tiles add to the same cell.
+ *
+ * @param grid
+ * @param src
+ * @param width
+ * @param height
+ * @param stride bytes per image row
+ * @param step bytes between samples
+ */
+void BilateralSplat(BilateralGrid& grid, const unsigned char* src, int width,
+                    int height, int stride, int step) {
+  const int s    = grid.cellSize;
+  const int half = s / 2;
+  std::vector<int> cellX(width);
+  for (int x = 0; x < width; x++) {
+    cellX[x] = (x + half) / s + BILATERAL_GRID_PAD;
+  }
+  int cellZ[256];
+  for (int v = 0; v < 256; v++) {
+    cellZ[v] = static_cast<int>(std::lround(v / grid.cellRange)) +
+               BILATERAL_GRID_PAD;
+  }
+  const size_t rowCells = static_cast<size_t>(grid.width) * grid.depth;
+  TileExecutor::GetInstance().Run(grid.height, [&](int gy) {
+    // Rows with (y + half) / s == gy - pad
+    const int k  = gy - BILATERAL_GRID_PAD;
+    const int y0 = std::max(0, k * s - half);
+    const int y1 = std::min(height, k * s - half + s);
+    float* cells = &grid.cells[static_cast<size_t>(gy) * rowCells * 2];
+    for (int y = y0; y < y1; y++) {
+      const unsigned char* row = src + static_cast<size_t>(y) * stride;
+      for (int x = 0; x < width; x++) {
+        const int v = row[x * step];
+        float* cell = cells + (cellX[x] * grid.depth + cellZ[v]) * 2;
+        cell[0] += v;
+        cell[1] += 1.0f;
+      }
+    }
+  });
+}
+
+/**
+ * @brief One [1 2 1] / 4 pass over count groups of inner floats, group i
+ * of dst from groups i - 1, i and i + 1 of src. Groups 0 and count - 1 are
+ * padding and are left as they are.
+ *
+ * @param src
+ * @param dst
+ * @param count
+ * @param inner
+ */
+static void BlurLine(const float* src, float* dst, int count, size_t inner) {
+  for (int i = 1; i < count - 1; i++) {
+    const float* a = src + (i - 1) * inner;
+    const float* b = a + inner;
+    const float* c = b + inner;
+    float* out     = dst + i * inner;
+    for (size_t j = 0; j < inner; j++) {
+      out[j] = 0.25f * (a[j] + c[j]) + 0.5f * b[j];
+    }
+  }
+}
+
+/**
+ * @brief Blur along value, x and then y, ping-ponging with a second grid.
+ * Every pass runs a grid row per tile on the executor.
+ *
+ * @param grid
+ */
+void BilateralBlur(BilateralGrid& grid) {
+  std::vector<float> other(grid.cells.size(), 0.0f);
+  const size_t cell = 2;
+  const size_t line = static_cast<size_t>(grid.depth) * cell;
+  const size_t row  = grid.width * line;
+  TileExecutor& tiles = TileExecutor::GetInstance();
+  tiles.Run(grid.height, [&](int gy) {
+    const float* src = &grid.cells[gy * row];
+    float* dst       = &other[gy * row];
+    for (int gx = 0; gx < grid.width; gx++) {
+      BlurLine(src + gx * line, dst + gx * line, grid.depth, cell);
+    }
+  });
+  tiles.Run(grid.height, [&](int gy) {
+    BlurLine(&other[gy * row], &grid.cells[gy * row], grid.width, line);
+  });
+  // Row gy of other from rows gy - 1 to gy + 1, the padding rows stay empty
+  tiles.Run(grid.height - 2, [&](int tile) {
+    const size_t gy = tile + 1;
+    BlurLine(&grid.cells[(gy - 1) * row], &other[(gy - 1) * row], 3, row);
+  });
+  grid.cells.swap(other);
+}
+
+/**
+ * @brief Trilinear read of a y interpolated grid row. The two value cells
+ * around z sit next to each other, so one 4 float load takes value and
+ * weight of both; x is blended on the vector, then z on its halves.
+ *
+ * @param slab y interpolated grid row
+ * @param depth
+ * @param x0 cell column left of the sample
+ * @param fx
+ * @param z0 cell below the sample value
+ * @param fz
+ * @param weight
+ * @return float weighted sum
+ */
+static inline float SliceSample(const float* slab, int depth, int x0, float fx,
+                                int z0, float fz, float& weight) {
+  const float* a = slab + (x0 * depth + z0) * 2;
+  const float* b = a + depth * 2;
+#ifdef __SSE2__
+  const __m128 va = _mm_loadu_ps(a);
+  const __m128 vb = _mm_loadu_ps(b);
+  const __m128 t =
+      _mm_add_ps(va, _mm_mul_ps(_mm_set1_ps(fx), _mm_sub_ps(vb, va)));
+  const __m128 hi = _mm_movehl_ps(t, t);
+  const __m128 r =
+      _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(fz), _mm_sub_ps(hi, t)));
+  weight = _mm_cvtss_f32(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1)));
+  return _mm_cvtss_f32(r);
+#else
+  float t[4];
+  for (int i = 0; i < 4; i++) {
+    t[i] = a[i] + fx * (b[i] - a[i]);
+  }
+  weight = t[1] + fz * (t[3] - t[1]);
+  return t[0] + fz * (t[2] - t[0]);
+#endif
+}
+
+/**
+ * @brief Slice bands of image rows on the executor. Each row first blends
+ * the two grid rows around it into a slab, a straight vector pass, then
+ * reads every sample from the slab.
+ *
+ * @param grid blurred
+ * @param src image the grid was splatted from, picks the value cell
+ * @param dst may equal src
+ * @param width
+ * @param height
+ * @param stride
+ * @param step
+ */
+void BilateralSlice(const BilateralGrid& grid, const unsigned char* src,
+                    unsigned char* dst, int width, int height, int stride,
+                    int step) {
+  const float inv = 1.0f / grid.cellSize;
+  std::vector<int> cellX(width);
+  std::vector<float> fracX(width);
+  for (int x = 0; x < width; x++) {
+    const float gx = x * inv + BILATERAL_GRID_PAD;
+    cellX[x]       = static_cast<int>(gx);
+    fracX[x]       = gx - cellX[x];
+  }
+  int cellZ[256];
+  float fracZ[256];
+  for (int v = 0; v < 256; v++) {
+    const float gz = v / grid.cellRange + BILATERAL_GRID_PAD;
+    cellZ[v]       = static_cast<int>(gz);
+    fracZ[v]       = gz - cellZ[v];
+  }
+
+  const size_t row = static_cast<size_t>(grid.width) * grid.depth * 2;
+  const int bands  = (height + BILATERAL_SLICE_BAND - 1) / BILATERAL_SLICE_BAND;
+  TileExecutor::GetInstance().Run(bands, [&](int band) {
+    std::vector<float> slab(row);
+    const int yEnd = std::min(height, (band + 1) * BILATERAL_SLICE_BAND);
+    for (int y = band * BILATERAL_SLICE_BAND; y < yEnd; y++) {
+      const float gy     = y * inv + BILATERAL_GRID_PAD;
+      const int y0       = static_cast<int>(gy);
+      const float fy     = gy - y0;
+      const float* top   = &grid.cells[y0 * row];
+      const float* below = top + row;
+      size_t i           = 0;
+#ifdef __SSE2__
+      const __m128 vfy = _mm_set1_ps(fy);
+      for (; i + 4 <= row; i += 4) {
+        const __m128 t = _mm_loadu_ps(top + i);
+        const __m128 b = _mm_loadu_ps(below + i);
+        _mm_storeu_ps(&slab[i],
+                      _mm_add_ps(t, _mm_mul_ps(vfy, _mm_sub_ps(b, t))));
+      }
+#endif
+      for (; i < row; i++) {
+        slab[i] = top[i] + fy * (below[i] - top[i]);
+      }
+
+      const unsigned char* in = src + static_cast<size_t>(y) * stride;
+      unsigned char* out      = dst + static_cast<size_t>(y) * stride;
+      for (int x = 0; x < width; x++) {
+        const int v  = in[x * step];
+        float weight = 0.0f;
+        const float sum =
+            SliceSample(slab.data(), grid.depth, cellX[x], fracX[x],
+                        cellZ[v], fracZ[v], weight);
+        const int value = weight < BILATERAL_MIN_WEIGHT
+                              ? v
+                              : static_cast<int>(sum / weight + 0.5f);
+        out[x * step] = static_cast<unsigned char>(std::clamp(value, 0, 255));
+      }
+    }
+  });
+}
+
+/**
+ * @brief Bilateral filter of one plane through a grid, cost grows with the
+ * pixel count and the grid size but not with the sigmas
+ *
+ * @param src
+ * @param dst may equal src
+ * @param width
+ * @param height
+ * @param stride
+ * @param step
+ * @param sigmaSpatial
+ * @param sigmaRange
+ */
+void BilateralFilterPlane(const unsigned char* src, unsigned char* dst,
+                          int width, int height, int stride, int step,
+                          float sigmaSpatial, float sigmaRange) {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  BilateralGrid grid;
+  BilateralInitGrid(grid, width, height, sigmaSpatial, sigmaRange);
+  BilateralSplat(grid, src, width, height, stride, step);
+  BilateralBlur(grid);
+  BilateralSlice(grid, src, dst, width, height, stride, step);
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "../include/ColorConvert.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Interleave two planes into one plane of pairs
+ *
+ * @param a first byte of every pair
+ * @param b second byte of every pair
+ * @param dst 2 * count bytes
+ * @param count
+ */
+void InterleavePlanes(const unsigned char* a, const unsigned char* b,
+                      unsigned char* dst, size_t count) {
+  size_t i = 0;
+#ifdef __SSE2__
+  for (; i + 16 <= count; i += 16) {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    __m128i* out     = reinterpret_cast<__m128i*>(dst + 2 * i);
+    _mm_storeu_si128(out, _mm_unpacklo_epi8(va, vb));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(va, vb));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[2 * i]     = a[i];
+    dst[2 * i + 1] = b[i];
+  }
+}
+
+/**
+ * @brief Split a plane of pairs into two planes
+ *
+ * @param src 2 * count bytes
+ * @param a first byte of every pair
+ * @param b second byte of every pair
+ * @param count
+ */
+void DeinterleavePlanes(const unsigned char* src, unsigned char* a,
+                        unsigned char* b, size_t count) {
+  size_t i = 0;
+#ifdef __SSE2__
+  const __m128i low = _mm_set1_epi16(0x00FF);
+  for (; i + 16 <= count; i += 16) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(src + 2 * i);
+    const __m128i s0  = _mm_loadu_si128(in);
+    const __m128i s1  = _mm_loadu_si128(in + 1);
+    const __m128i va  = _mm_packus_epi16(_mm_and_si128(s0, low),
+                                         _mm_and_si128(s1, low));
+    const __m128i vb  = _mm_packus_epi16(_mm_srli_epi16(s0, 8),
+                                         _mm_srli_epi16(s1, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), va);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), vb);
+  }
+#endif
+  for (; i < count; i++) {
+    a[i] = src[2 * i];
+    b[i] = src[2 * i + 1];
+  }
+}
+
+/**
+ * @brief Interleave three planes into RGB24
+ *
+ * @param r
+ * @param g
+ * @param b
+ * @param rgb 3 * count bytes
+ * @param count pixels
+ */
+void InterleaveRgb(const unsigned char* r, const unsigned char* g,
+                   const unsigned char* b, unsigned char* rgb, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    rgb[3 * i]     = r[i];
+    rgb[3 * i + 1] = g[i];
+    rgb[3 * i + 2] = b[i];
+  }
+}
+
+/**
+ * @brief Split RGB24 into three planes
+ *
+ * @param rgb 3 * count bytes
+ * @param r
+ * @param g
+ * @param b
+ * @param count pixels
+ */
+void DeinterleaveRgb(const unsigned char* rgb, unsigned char* r,
+                     unsigned char* g, unsigned char* b, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    r[i] = rgb[3 * i];
+    g[i] = rgb[3 * i + 1];
+    b[i] = rgb[3 * i + 2];
+  }
+}
+
+/**
+ * @brief Swap the bytes of every pair, turns NV12 chroma into NV21 and back
+ *
+ * @param src
+ * @param dst
+ * @param count pairs
+ */
+void SwapPairs(const unsigned char* src, unsigned char* dst, size_t count) {
+  size_t i = 0;
+#ifdef __SSE2__
+  for (; i + 8 <= count; i += 8) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i),
+                     _mm_or_si128(_mm_slli_epi16(s, 8), _mm_srli_epi16(s, 8)));
+  }
+#endif
+  for (; i < count; i++) {
+    const unsigned char first = src[2 * i];
+    dst[2 * i]                = src[2 * i + 1];
+    dst[2 * i + 1]            = first;
+  }
+}
+
+/**
+ * @brief One pixel of YuvToRgbRow
+ *
+ * @param y
+ * @param u
+ * @param v
+ * @param rgb
+ */
+static inline void YuvToRgbPixel(int y, int u, int v, unsigned char* rgb) {
+  const int c = y - 16;
+  const int d = u - 128;
+  const int e = v - 128;
+  rgb[0]      = static_cast<unsigned char>(
+      std::clamp((298 * c + 409 * e + 128) >> 8, 0, 255));
+  rgb[1] = static_cast<unsigned char>(
+      std::clamp((298 * c - 100 * d - 208 * e + 128) >> 8, 0, 255));
+  rgb[2] = static_cast<unsigned char>(
+      std::clamp((298 * c + 516 * d + 128) >> 8, 0, 255));
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Eight pixels of one channel: the (p0, q0) pairs dotted with w0
+ * plus the (p1, q1) pairs dotted with w1, shifted down by 8
+ *
+ * @param p0
+ * @param q0
+ * @param w0
+ * @param p1
+ * @param q1
+ * @param w1
+ * @return __m128i
+ */
+static inline __m128i WeighPairs(__m128i p0, __m128i q0, __m128i w0,
+                                 __m128i p1, __m128i q1, __m128i w1) {
+  const __m128i lo =
+      _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(p0, q0), w0),
+                    _mm_madd_epi16(_mm_unpacklo_epi16(p1, q1), w1));
+  const __m128i hi =
+      _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(p0, q0), w0),
+                    _mm_madd_epi16(_mm_unpackhi_epi16(p1, q1), w1));
+  return _mm_packs_epi32(_mm_srai_epi32(lo, 8), _mm_srai_epi32(hi, 8));
+}
+
+/**
+ * @brief Four chroma samples, each repeated for two pixels, minus 128
+ *
+ * @param src
+ * @return __m128i eight 16-bit lanes
+ */
+static inline __m128i LoadChroma(const unsigned char* src) {
+  int32_t bits;
+  std::memcpy(&bits, src, sizeof(bits));
+  const __m128i c = _mm_cvtsi32_si128(bits);
+  return _mm_sub_epi16(
+      _mm_unpacklo_epi8(_mm_unpacklo_epi8(c, c), _mm_setzero_si128()),
+      _mm_set1_epi16(128));
+}
+#endif
+
+/**
+ * @brief One RGB24 row from a luma row and its chroma samples
+ *
+ * @param y width samples
+ * @param u width / 2 samples
+ * @param v width / 2 samples
+ * @param rgb 3 * width bytes
+ * @param width even
+ */
+void YuvToRgbRow(const unsigned char* y, const unsigned char* u,
+                 const unsigned char* v, unsigned char* rgb, int width) {
+  int x = 0;
+#ifdef __SSE2__
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one  = _mm_set1_epi16(1);
+  // Rounding term as a (1, 1) pair weighted (128, 0)
+  const __m128i wRnd = _mm_setr_epi16(128, 0, 128, 0, 128, 0, 128, 0);
+  const __m128i wR   = _mm_setr_epi16(298, 409, 298, 409, 298, 409, 298, 409);
+  const __m128i wGc  = _mm_setr_epi16(298, -100, 298, -100, 298, -100, 298,
+                                      -100);
+  const __m128i wGe  = _mm_setr_epi16(-208, 128, -208, 128, -208, 128, -208,
+                                      128);
+  const __m128i wB   = _mm_setr_epi16(298, 516, 298, 516, 298, 516, 298, 516);
+  alignas(16) unsigned char planes[3][16];
+  for (; x + 8 <= width; x += 8) {
+    const __m128i luma =
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + x));
+    const __m128i c =
+        _mm_sub_epi16(_mm_unpacklo_epi8(luma, zero), _mm_set1_epi16(16));
+    const __m128i d = LoadChroma(u + x / 2);
+    const __m128i e = LoadChroma(v + x / 2);
+    const __m128i r = WeighPairs(c, e, wR, one, one, wRnd);
+    const __m128i g = WeighPairs(c, d, wGc, e, one, wGe);
+    const __m128i b = WeighPairs(c, d, wB, one, one, wRnd);
+    _mm_store_si128(reinterpret_cast<__m128i*>(planes[0]),
+                    _mm_packus_epi16(r, zero));
+    _mm_store_si128(reinterpret_cast<__m128i*>(planes[1]),
+                    _mm_packus_epi16(g, zero));
+    _mm_store_si128(reinterpret_cast<__m128i*>(planes[2]),
+                    _mm_packus_epi16(b, zero));
+    unsigned char* out = rgb + 3 * x;
+    for (int i = 0; i < 8; i++) {
+      out[3 * i]     = planes[0][i];
+      out[3 * i + 1] = planes[1][i];
+      out[3 * i + 2] = planes[2][i];
+    }
+  }
+#endif
+  for (; x < width; x++) {
+    YuvToRgbPixel(y[x], u[x / 2], v[x / 2], rgb + 3 * x);
+  }
+}
+
+/**
+ * @brief Video range luma of one RGB24 pixel
+ *
+ * @param p
+ * @return unsigned char
+ */
+static inline unsigned char RgbToLuma(const unsigned char* p) {
+  return static_cast<unsigned char>(
+      ((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+}
+
+/**
+ * @brief One luma row from an RGB24 row
+ *
+ * @param rgb 3 * width bytes
+ * @param y
+ * @param width
+ */
+void RgbToLumaRow(const unsigned char* rgb, unsigned char* y, int width) {
+  for (int x = 0; x < width; x++) {
+    y[x] = RgbToLuma(rgb + 3 * x);
+  }
+}
+
+/**
+ * @brief Two RGB24 rows to luma rows and one row of U and V
+ *
+ * @param rgb0
+ * @param rgb1 row below rgb0
+ * @param y0
+ * @param y1
+ * @param u width / 2 samples
+ * @param v width / 2 samples
+ * @param width even
+ */
+void RgbToYuvRows(const unsigned char* rgb0, const unsigned char* rgb1,
+                  unsigned char* y0, unsigned char* y1, unsigned char* u,
+                  unsigned char* v, int width) {
+  RgbToLumaRow(rgb0, y0, width);
+  RgbToLumaRow(rgb1, y1, width);
+  for (int x = 0; x < width / 2; x++) {
+    const unsigned char* a = rgb0 + 6 * x;
+    const unsigned char* b = rgb1 + 6 * x;
+    const int r            = (a[0] + a[3] + b[0] + b[3] + 2) >> 2;
+    const int g            = (a[1] + a[4] + b[1] + b[4] + 2) >> 2;
+    const int bl           = (a[2] + a[5] + b[2] + b[5] + 2) >> 2;
+    // Both stay within [16, 240] for any input, no clamp needed
+    u[x] = static_cast<unsigned char>(
+        ((-38 * r - 74 * g + 112 * bl + 128) >> 8) + 128);
+    v[x] = static_cast<unsigned char>(
+        ((112 * r - 94 * g - 18 * bl + 128) >> 8) + 128);
+  }
+}
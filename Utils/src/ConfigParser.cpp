@@ -166,6 +166,19 @@ int ConfigParser::getIntValue(const std::string& key) {
   return 0;
 }
 
+float ConfigParser::getFloatValue(const std::string& key) {
+  if (keyValueStore.find(key) != keyValueStore.end()) {
+    try {
+      return stof(keyValueStore[key]);  // Convert to float
+    } catch (...) {
+      errorCode = 4;  // Conversion error
+      return 0.0f;
+    }
+  }
+  errorCode = 3;  // Key not found
+  return 0.0f;
+}
+
 int ConfigParser::getErrorCode() const {
   return errorCode;  // Return the error code
 }
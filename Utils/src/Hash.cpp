@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "Hash.h"
+#include <cstring>
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+static constexpr uint64_t PRIME32_1 = 0x9E3779B1ULL;
+
+// Buffers from this size on take the wide stripe hash
+static constexpr size_t kWideMinSize = 1024;
+// A stripe feeds one 64-bit word to each of the 8 accumulators
+static constexpr size_t kStripeSize      = 64;
+static constexpr size_t kStripesPerBlock = 16;
+static constexpr size_t kBlockSize       = kStripeSize * kStripesPerBlock;
+// Stripe n of a block uses keys n..n+7, the scramble the last 8
+static constexpr size_t kSecretWords = kStripesPerBlock + 16;
+
+static inline uint64_t Rotl64(uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t Read64(const unsigned char* p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t Read32(const unsigned char* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint64_t Round64(uint64_t acc, uint64_t input) {
+  acc += input * PRIME64_2;
+  acc = Rotl64(acc, 31);
+  return acc * PRIME64_1;
+}
+
+static inline uint64_t MergeRound64(uint64_t acc, uint64_t value) {
+  acc ^= Round64(0, value);
+  return acc * PRIME64_1 + PRIME64_4;
+}
+
+/**
+ * @brief 64-bit xxHash of a buffer, four lanes of 8 bytes
+ *
+ * @param p
+ * @param size
+ * @param seed
+ * @return uint64_t
+ */
+static uint64_t XxHash64(const unsigned char* p, size_t size, uint64_t seed) {
+  const unsigned char* end = p + size;
+  uint64_t h;
+
+  if (size >= 32) {
+    uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+    uint64_t v2 = seed + PRIME64_2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - PRIME64_1;
+    const unsigned char* limit = end - 32;
+    do {
+      v1 = Round64(v1, Read64(p));
+      v2 = Round64(v2, Read64(p + 8));
+      v3 = Round64(v3, Read64(p + 16));
+      v4 = Round64(v4, Read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    h = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+    h = MergeRound64(h, v1);
+    h = MergeRound64(h, v2);
+    h = MergeRound64(h, v3);
+    h = MergeRound64(h, v4);
+  } else {
+    h = seed + PRIME64_5;
+  }
+  h += static_cast<uint64_t>(size);
+
+  for (; p + 8 <= end; p += 8) {
+    h ^= Round64(0, Read64(p));
+    h = Rotl64(h, 27) * PRIME64_1 + PRIME64_4;
+  }
+  if (p + 4 <= end) {
+    h ^= static_cast<uint64_t>(Read32(p)) * PRIME64_1;
+    h = Rotl64(h, 23) * PRIME64_2 + PRIME64_3;
+    p += 4;
+  }
+  for (; p < end; p++) {
+    h ^= (*p) * PRIME64_5;
+    h = Rotl64(h, 11) * PRIME64_1;
+  }
+
+  h ^= h >> 33;
+  h *= PRIME64_2;
+  h ^= h >> 29;
+  h *= PRIME64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+/**
+ * @brief Key words of the wide hash, fixed pseudo random numbers
+ *
+ * @return const uint64_t*
+ */
+static const uint64_t* GetSecret() {
+  static const struct Secret {
+    uint64_t words[kSecretWords];
+    Secret() {
+      uint64_t state = PRIME64_3;
+      for (auto& word : words) {
+        // splitmix64
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+
+        z    = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z    = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        word = z ^ (z >> 31);
+      }
+    }
+  } secret;
+  return secret.words;
+}
+
+/**
+ * @brief Fold the 128-bit product of two words to 64 bits
+ *
+ * @param a
+ * @param b
+ * @return uint64_t
+ */
+static inline uint64_t Mul128Fold64(uint64_t a, uint64_t b) {
+  const uint64_t loLo  = (a & 0xFFFFFFFFULL) * (b & 0xFFFFFFFFULL);
+  const uint64_t hiLo  = (a >> 32) * (b & 0xFFFFFFFFULL);
+  const uint64_t loHi  = (a & 0xFFFFFFFFULL) * (b >> 32);
+  const uint64_t hiHi  = (a >> 32) * (b >> 32);
+  const uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFFULL) + loHi;
+  const uint64_t upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+  const uint64_t lower = (cross << 32) | (loLo & 0xFFFFFFFFULL);
+  return lower ^ upper;
+}
+
+static inline uint64_t Avalanche64(uint64_t h) {
+  h ^= h >> 37;
+  h *= 0x165667919E3779F9ULL;
+  return h ^ (h >> 32);
+}
+
+/**
+ * @brief Feed stripes of one block to the accumulators. Each word adds its
+ * 32x32 bit key product to its own lane and its raw value to the neighbour
+ * lane, which maps onto one multiply and one shuffle per 128-bit register.
+ *
+ * @param acc 8 accumulators
+ * @param p
+ * @param stripes at most kStripesPerBlock
+ * @param secret
+ */
+static void AccumulateStripes(uint64_t* acc, const unsigned char* p,
+                              size_t stripes, const uint64_t* secret) {
+#ifdef __AVX2__
+  __m256i a[2];
+  for (int j = 0; j < 2; j++) {
+    a[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + j);
+  }
+  for (size_t n = 0; n < stripes; n++) {
+    const __m256i* in  = reinterpret_cast<const __m256i*>(p + n * kStripeSize);
+    const __m256i* key = reinterpret_cast<const __m256i*>(secret + n);
+    for (int j = 0; j < 2; j++) {
+      const __m256i d    = _mm256_loadu_si256(in + j);
+      const __m256i k    = _mm256_xor_si256(d, _mm256_loadu_si256(key + j));
+      const __m256i kHi  = _mm256_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1));
+      const __m256i prod = _mm256_mul_epu32(k, kHi);
+      const __m256i swap = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+      a[j] = _mm256_add_epi64(a[j], _mm256_add_epi64(prod, swap));
+    }
+  }
+  for (int j = 0; j < 2; j++) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + j, a[j]);
+  }
+#elif defined(__SSE2__)
+  __m128i a[4];
+  for (int j = 0; j < 4; j++) {
+    a[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + j);
+  }
+  for (size_t n = 0; n < stripes; n++) {
+    const __m128i* in  = reinterpret_cast<const __m128i*>(p + n * kStripeSize);
+    const __m128i* key = reinterpret_cast<const __m128i*>(secret + n);
+    for (int j = 0; j < 4; j++) {
+      const __m128i d    = _mm_loadu_si128(in + j);
+      const __m128i k    = _mm_xor_si128(d, _mm_loadu_si128(key + j));
+      const __m128i kHi  = _mm_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1));
+      const __m128i prod = _mm_mul_epu32(k, kHi);
+      const __m128i swap = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+      a[j] = _mm_add_epi64(a[j], _mm_add_epi64(prod, swap));
+    }
+  }
+  for (int j = 0; j < 4; j++) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + j, a[j]);
+  }
+#else
+  for (size_t n = 0; n < stripes; n++) {
+    const unsigned char* in = p + n * kStripeSize;
+    for (int i = 0; i < 8; i++) {
+      const uint64_t d = Read64(in + 8 * i);
+      const uint64_t k = d ^ secret[n + i];
+      acc[i ^ 1] += d;
+      acc[i] += (k & 0xFFFFFFFFULL) * (k >> 32);
+    }
+  }
+#endif
+}
+
+/**
+ * @brief Mix the high bits of the accumulators back into their low bits
+ * once per block, so the 32-bit products keep seeing all of the state
+ *
+ * @param acc
+ * @param secret
+ */
+static void ScrambleAccumulators(uint64_t* acc, const uint64_t* secret) {
+  for (int i = 0; i < 8; i++) {
+    uint64_t a = acc[i];
+    a ^= a >> 47;
+    a ^= secret[kStripesPerBlock + 8 + i];
+    acc[i] = a * PRIME32_1;
+  }
+}
+
+/**
+ * @brief Hash of buffers of at least kWideMinSize bytes. Eight lanes consume
+ * a 64-byte stripe per iteration without a serial multiply chain, so the loop
+ * keeps up with memory bandwidth.
+ *
+ * @param p
+ * @param size
+ * @param seed
+ * @return uint64_t
+ */
+static uint64_t WideHash64(const unsigned char* p, size_t size,
+                           uint64_t seed) {
+  const uint64_t* secret = GetSecret();
+  uint64_t acc[8]        = {
+      PRIME32_1 ^ seed, PRIME64_1,        PRIME64_2,        PRIME64_3,
+      PRIME64_4,        PRIME64_5 ^ seed, PRIME64_1 - seed, PRIME64_2 + seed};
+
+  const size_t blocks = size / kBlockSize;
+  for (size_t b = 0; b < blocks; b++) {
+    AccumulateStripes(acc, p + b * kBlockSize, kStripesPerBlock, secret);
+    ScrambleAccumulators(acc, secret);
+  }
+  const size_t done    = blocks * kBlockSize;
+  const size_t stripes = (size - done) / kStripeSize;
+  AccumulateStripes(acc, p + done, stripes, secret);
+
+  const size_t tail = done + stripes * kStripeSize;
+  uint64_t h        = static_cast<uint64_t>(size) * PRIME64_1;
+  for (int i = 0; i < 8; i += 2) {
+    h += Mul128Fold64(acc[i] ^ secret[i], acc[i + 1] ^ secret[i + 1]);
+  }
+  h = Avalanche64(h);
+  h = MergeRound64(h, XxHash64(p + tail, size - tail, seed));
+  return Avalanche64(h);
+}
+
+/**
+ * @brief 64-bit hash of a buffer. Short buffers take xxHash64, larger ones
+ * the vectorised stripe hash. SIMD and scalar builds give the same value.
+ *
+ * @param data
+ * @param size
+ * @param seed
+ * @return uint64_t
+ */
+uint64_t Hash64(const void* data, size_t size, uint64_t seed) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  if (size >= kWideMinSize) {
+    return WideHash64(p, size, seed);
+  }
+  return XxHash64(p, size, seed);
+}
+
+/**
+ * @brief Fold a value into a running hash
+ *
+ * @param hash
+ * @param value
+ * @return uint64_t
+ */
+uint64_t HashCombine(uint64_t hash, uint64_t value) {
+  return MergeRound64(hash, value);
+}
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "../include/RotateEngine.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include "../include/TileExecutor.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Where destination element (x, y) is read from: base + x * a + y * b.
+ * For the transposing angles one step is a source row, the other an element.
+ */
+struct RotateWalk {
+  const unsigned char* base = nullptr;
+  ptrdiff_t a               = 0;
+  ptrdiff_t b               = 0;
+};
+
+/**
+ * @brief Angle folded into 0, 90, 180 or 270, -1 when not a right angle
+ *
+ * @param degrees
+ * @return int
+ */
+static int NormalizeDegrees(int degrees) {
+  if (degrees % 90 != 0) {
+    return -1;
+  }
+  return ((degrees % 360) + 360) % 360;
+}
+
+/**
+ * @brief Size of a plane after rotating it clockwise by degrees
+ *
+ * @param width
+ * @param height
+ * @param degrees
+ * @param outWidth
+ * @param outHeight
+ */
+void RotateGetSize(int width, int height, int degrees, int& outWidth,
+                   int& outHeight) {
+  const int angle = NormalizeDegrees(degrees);
+  const bool swap = angle == 90 || angle == 270;
+  outWidth        = swap ? height : width;
+  outHeight       = swap ? width : height;
+}
+
+template <int kElem>
+static inline void CopyElem(unsigned char* dst, const unsigned char* src) {
+  std::memcpy(dst, src, kElem);
+}
+
+#ifdef __SSE2__
+/**
+ * @brief One interleave round over n rows: row i pairs with row i + n / 2,
+ * which moves the top bit of the column index into the row index
+ *
+ * @param v n rows in, n rows out
+ */
+template <int kElem>
+static inline void InterleaveRound(__m128i* v) {
+  constexpr int n = 16 / kElem;
+  __m128i t[n];
+  for (int i = 0; i < n / 2; i++) {
+    if (kElem == 1) {
+      t[2 * i]     = _mm_unpacklo_epi8(v[i], v[i + n / 2]);
+      t[2 * i + 1] = _mm_unpackhi_epi8(v[i], v[i + n / 2]);
+    } else {
+      t[2 * i]     = _mm_unpacklo_epi16(v[i], v[i + n / 2]);
+      t[2 * i + 1] = _mm_unpackhi_epi16(v[i], v[i + n / 2]);
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    v[i] = t[i];
+  }
+}
+
+/**
+ * @brief Transpose a block of 16 bytes by 16 rows, or 8 words by 8 rows;
+ * log2(n) interleave rounds swap the row and column indices
+ *
+ * @param walk
+ * @param x first destination column of the block
+ * @param y first destination row of the block
+ * @param dst
+ * @param dstStride
+ */
+template <int kElem>
+static void TransposeBlock(const RotateWalk& walk, int x, int y,
+                           unsigned char* dst, ptrdiff_t dstStride) {
+  constexpr int n = 16 / kElem;
+  // Destination column x + i is a source run, loaded lowest address first
+  const ptrdiff_t first = walk.b > 0 ? y : y + n - 1;
+  __m128i v[n];
+  for (int i = 0; i < n; i++) {
+    v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+        walk.base + (x + i) * walk.a + first * walk.b));
+  }
+  InterleaveRound<kElem>(v);
+  InterleaveRound<kElem>(v);
+  InterleaveRound<kElem>(v);
+  if (kElem == 1) {
+    InterleaveRound<kElem>(v);
+  }
+  for (int k = 0; k < n; k++) {
+    const ptrdiff_t row = walk.b > 0 ? y + k : y + n - 1 - k;
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(dst + row * dstStride + x * kElem), v[k]);
+  }
+}
+
+/**
+ * @brief Reverse the order of the 16 bytes, or of the 8 words
+ *
+ * @param v
+ * @return __m128i
+ */
+template <int kElem>
+static inline __m128i ReverseVector(__m128i v) {
+  if (kElem == 1) {
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+  }
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+#endif
+
+/**
+ * @brief Fill one destination tile of a transposing rotation. Whole blocks
+ * go through the SIMD transpose, the ragged edge element by element.
+ *
+ * @param walk
+ * @param x0
+ * @param y0
+ * @param tileWidth
+ * @param tileHeight
+ * @param dst
+ * @param dstStride
+ */
+template <int kElem>
+static void TransposeTile(const RotateWalk& walk, int x0, int y0,
+                          int tileWidth, int tileHeight, unsigned char* dst,
+                          ptrdiff_t dstStride) {
+  int blockWidth  = 0;
+  int blockHeight = 0;
+#ifdef __SSE2__
+  // RGB never takes the SIMD path, the lane only keeps it compiling
+  constexpr int kLane = kElem == 2 ? 2 : 1;
+  if (kElem == kLane) {
+    constexpr int n = 16 / kLane;
+    blockWidth      = tileWidth / n * n;
+    blockHeight     = tileHeight / n * n;
+    // Column of blocks at a time, so the source rows are read in order
+    for (int x = 0; x < blockWidth; x += n) {
+      for (int y = 0; y < blockHeight; y += n) {
+        TransposeBlock<kLane>(walk, x0 + x, y0 + y, dst, dstStride);
+      }
+    }
+  }
+#endif
+  for (int y = 0; y < tileHeight; y++) {
+    unsigned char* d       = dst + (y0 + y) * dstStride + x0 * kElem;
+    const unsigned char* s = walk.base + x0 * walk.a + (y0 + y) * walk.b;
+    for (int x = y < blockHeight ? blockWidth : 0; x < tileWidth; x++) {
+      CopyElem<kElem>(d + x * kElem, s + x * walk.a);
+    }
+  }
+}
+
+/**
+ * @brief Copy a row, reversing the element order
+ *
+ * @param src
+ * @param width
+ * @param dst
+ */
+template <int kElem>
+static void ReverseRow(const unsigned char* src, int width,
+                       unsigned char* dst) {
+  int x = 0;
+#ifdef __SSE2__
+  constexpr int kLane = kElem == 2 ? 2 : 1;
+  if (kElem == kLane) {
+    constexpr int n = 16 / kLane;
+    for (; x + n <= width; x += n) {
+      const __m128i v = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src + (width - n - x) * kElem));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * kElem),
+                       ReverseVector<kLane>(v));
+    }
+  }
+#endif
+  for (; x < width; x++) {
+    CopyElem<kElem>(dst + x * kElem, src + (width - 1 - x) * kElem);
+  }
+}
+
+/**
+ * @brief Rotate with elements of kElem bytes. 0 and 180 keep rows as rows
+ * and move them in bands, 90 and 270 transpose square tiles small enough
+ * that the source rows a tile reads stay in cache.
+ *
+ * @param src
+ * @param width
+ * @param height
+ * @param srcStride
+ * @param dst
+ * @param dstStride
+ * @param angle 0, 90, 180 or 270
+ * @param mirror
+ */
+template <int kElem>
+static void RotatePlaneT(const unsigned char* src, int width, int height,
+                         ptrdiff_t srcStride, unsigned char* dst,
+                         ptrdiff_t dstStride, int angle, bool mirror) {
+  if (angle == 0 || angle == 180) {
+    const bool flipX = (angle == 180) != mirror;
+    const bool flipY = angle == 180;
+    const int bands  = (height + ROTATE_TILE - 1) / ROTATE_TILE;
+    TileExecutor::GetInstance().Run(bands, [&](int index) {
+      const int end = std::min(height, (index + 1) * ROTATE_TILE);
+      for (int y = index * ROTATE_TILE; y < end; y++) {
+        const int row          = flipY ? height - 1 - y : y;
+        const unsigned char* s = src + row * srcStride;
+        unsigned char* d       = dst + y * dstStride;
+        if (flipX) {
+          ReverseRow<kElem>(s, width, d);
+        } else {
+          std::memcpy(d, s, static_cast<size_t>(width) * kElem);
+        }
+      }
+    });
+    return;
+  }
+
+  // Destination is height x width; mirroring first reverses the source x
+  const ptrdiff_t lastRow  = (height - 1) * srcStride;
+  const ptrdiff_t lastElem = static_cast<ptrdiff_t>(width - 1) * kElem;
+  RotateWalk walk;
+  if (angle == 90) {
+    walk.base = src + lastRow + (mirror ? lastElem : 0);
+    walk.a    = -srcStride;
+    walk.b    = mirror ? -kElem : kElem;
+  } else {
+    walk.base = src + (mirror ? 0 : lastElem);
+    walk.a    = srcStride;
+    walk.b    = mirror ? kElem : -kElem;
+  }
+  const int outWidth  = height;
+  const int outHeight = width;
+  const int tilesX    = (outWidth + ROTATE_TILE - 1) / ROTATE_TILE;
+  const int tilesY    = (outHeight + ROTATE_TILE - 1) / ROTATE_TILE;
+  TileExecutor::GetInstance().Run(tilesX * tilesY, [&](int index) {
+    const int x0 = index % tilesX * ROTATE_TILE;
+    const int y0 = index / tilesX * ROTATE_TILE;
+    TransposeTile<kElem>(walk, x0, y0, std::min(ROTATE_TILE, outWidth - x0),
+                         std::min(ROTATE_TILE, outHeight - y0), dst,
+                         dstStride);
+  });
+}
+
+/**
+ * @brief Mirror a plane left-right when mirror is set, then rotate it
+ * clockwise by a multiple of 90 degrees
+ *
+ * @param src
+ * @param width
+ * @param height
+ * @param srcStride bytes per source row
+ * @param elemSize bytes per element, 1, 2 or 3
+ * @param dst
+ * @param dstStride bytes per destination row
+ * @param degrees
+ * @param mirror
+ * @return int 0 on success, -1 on bad arguments
+ */
+int RotatePlane(const unsigned char* src, int width, int height,
+                int srcStride, int elemSize, unsigned char* dst,
+                int dstStride, int degrees, bool mirror) {
+  const int angle = NormalizeDegrees(degrees);
+  if (angle < 0 || !src || !dst || width <= 0 || height <= 0) {
+    return -1;
+  }
+  switch (elemSize) {
+    case 1:
+      RotatePlaneT<1>(src, width, height, srcStride, dst, dstStride, angle,
+                      mirror);
+      return 0;
+    case 2:
+      RotatePlaneT<2>(src, width, height, srcStride, dst, dstStride, angle,
+                      mirror);
+      return 0;
+    case 3:
+      RotatePlaneT<3>(src, width, height, srcStride, dst, dstStride, angle,
+                      mirror);
+      return 0;
+    default:
+      return -1;
+  }
+}
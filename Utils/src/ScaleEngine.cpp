@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "../include/ScaleEngine.h"
+#include <algorithm>
+#include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static constexpr double kPi   = 3.14159265358979323846;
+static constexpr int kCoefOne = 1 << SCALE_COEF_BITS;
+// Horizontal sums are Q(COEF), the intermediate rows Q(MID)
+static constexpr int kMidShift = SCALE_COEF_BITS - SCALE_MID_BITS;
+// Vertical sums are Q(COEF + MID)
+static constexpr int kOutShift = SCALE_COEF_BITS + SCALE_MID_BITS;
+
+/**
+ * @brief Lanczos kernel with 3 lobes
+ *
+ * @param x
+ * @return double
+ */
+static double Lanczos3(double x) {
+  if (std::fabs(x) < 1e-9) {
+    return 1.0;
+  }
+  if (std::fabs(x) >= 3.0) {
+    return 0.0;
+  }
+  const double px = kPi * x;
+  return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+}
+
+/**
+ * @brief Unquantised weights of one output sample, indexed from first
+ *
+ * @param i output sample
+ * @param srcSize
+ * @param scale source samples per output sample
+ * @param mode
+ * @param first first source sample, clamped inside the source
+ * @return std::vector<double>
+ */
+static std::vector<double> ScaleWeights(int i, int srcSize, double scale,
+                                        ScaleMode mode, int& first) {
+  if (mode == ScaleMode::AREA && scale <= 1.0) {
+    mode = ScaleMode::BILINEAR;
+  }
+  const double center = (i + 0.5) * scale - 0.5;
+  double lo, hi;
+  if (mode == ScaleMode::AREA) {
+    lo = i * scale;
+    hi = (i + 1) * scale - 1.0;
+  } else {
+    const double support =
+        mode == ScaleMode::LANCZOS ? 3.0 * std::max(scale, 1.0) : 1.0;
+    lo = center - support;
+    hi = center + support;
+  }
+  const int jFirst = static_cast<int>(std::floor(lo));
+  const int jLast  = static_cast<int>(std::ceil(hi));
+
+  first = std::max(0, std::min(jFirst, srcSize - 1));
+  const int last = std::max(0, std::min(jLast, srcSize - 1));
+  std::vector<double> weights(last - first + 1, 0.0);
+  for (int j = jFirst; j <= jLast; j++) {
+    double w;
+    if (mode == ScaleMode::AREA) {
+      // Overlap of source pixel [j, j + 1) with [i * scale, (i + 1) * scale)
+      w = std::min(j + 1.0, (i + 1) * scale) - std::max(double(j), i * scale);
+    } else if (mode == ScaleMode::LANCZOS) {
+      w = Lanczos3((j - center) / std::max(scale, 1.0));
+    } else {
+      w = 1.0 - std::fabs(j - center);
+    }
+    if (w > 0.0 || (w < 0.0 && mode == ScaleMode::LANCZOS)) {
+      const int index = std::max(0, std::min(j, srcSize - 1));
+      weights[index - first] += w;
+    }
+  }
+  return weights;
+}
+
+/**
+ * @brief Build the taps of one axis. Wide windows are padded to a multiple
+ * of 8 taps so the horizontal pass can take them 8 at a time.
+ *
+ * @param axis
+ * @param srcSize
+ * @param dstSize
+ * @param mode
+ */
+void ScaleInitAxis(ScaleAxis& axis, int srcSize, int dstSize, ScaleMode mode) {
+  axis.srcSize = srcSize;
+  axis.dstSize = dstSize;
+  axis.taps    = 0;
+  axis.start.assign(dstSize, 0);
+  axis.coef.clear();
+  if (srcSize <= 0 || dstSize <= 0) {
+    return;
+  }
+
+  const double scale = double(srcSize) / dstSize;
+  std::vector<int> firsts(dstSize);
+  std::vector<std::vector<int16_t>> quantised(dstSize);
+  for (int i = 0; i < dstSize; i++) {
+    int first                   = 0;
+    std::vector<double> weights = ScaleWeights(i, srcSize, scale, mode, first);
+    double sum                  = 0.0;
+    for (double w : weights) {
+      sum += w;
+    }
+    // Round to fixed point, the largest tap absorbs the rounding error
+    std::vector<int16_t>& q = quantised[i];
+    q.resize(weights.size());
+    int total   = 0;
+    int largest = 0;
+    for (size_t k = 0; k < weights.size(); k++) {
+      q[k] = static_cast<int16_t>(std::lround(weights[k] / sum * kCoefOne));
+      total += q[k];
+      if (q[k] > q[largest]) {
+        largest = static_cast<int>(k);
+      }
+    }
+    q[largest] = static_cast<int16_t>(q[largest] + kCoefOne - total);
+    // Drop zero taps at both ends
+    size_t begin = 0;
+    size_t end   = q.size();
+    while (begin + 1 < end && q[begin] == 0) {
+      begin++;
+    }
+    while (end - 1 > begin && q[end - 1] == 0) {
+      end--;
+    }
+    q         = std::vector<int16_t>(q.begin() + begin, q.begin() + end);
+    firsts[i] = first + static_cast<int>(begin);
+    axis.taps = std::max(axis.taps, static_cast<int>(q.size()));
+  }
+  if (axis.taps > 4 && (axis.taps + 7) / 8 * 8 <= srcSize) {
+    axis.taps = (axis.taps + 7) / 8 * 8;
+  }
+
+  axis.coef.assign(static_cast<size_t>(dstSize) * axis.taps, 0);
+  for (int i = 0; i < dstSize; i++) {
+    const int start = std::min(firsts[i], srcSize - axis.taps);
+    const int skip  = firsts[i] - start;
+    axis.start[i]   = start;
+    std::copy(quantised[i].begin(), quantised[i].end(),
+              axis.coef.begin() + static_cast<size_t>(i) * axis.taps + skip);
+  }
+}
+
+/**
+ * @brief Filter one source row along x into a Q(MID) row
+ *
+ * @param src
+ * @param axis
+ * @param cn
+ * @param dst dstSize * cn samples
+ */
+static void ScaleRowX(const unsigned char* src, const ScaleAxis& axis, int cn,
+                      int16_t* dst) {
+  const int taps      = axis.taps;
+  const int16_t* coef = axis.coef.data();
+  const int round     = 1 << (kMidShift - 1);
+#ifdef __SSE2__
+  if (cn == 1 && taps % 8 == 0) {
+    const __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < axis.dstSize; i++) {
+      const unsigned char* s = src + axis.start[i];
+      const int16_t* c       = coef + static_cast<size_t>(i) * taps;
+      __m128i acc            = _mm_setzero_si128();
+      for (int k = 0; k < taps; k += 8) {
+        const __m128i pix = _mm_unpacklo_epi8(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + k)), zero);
+        const __m128i w =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + k));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(pix, w));
+      }
+      acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+      acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+      dst[i] = static_cast<int16_t>((_mm_cvtsi128_si32(acc) + round) >>
+                                    kMidShift);
+    }
+    return;
+  }
+#endif
+  for (int i = 0; i < axis.dstSize; i++) {
+    const unsigned char* s = src + static_cast<size_t>(axis.start[i]) * cn;
+    const int16_t* c       = coef + static_cast<size_t>(i) * taps;
+    for (int ch = 0; ch < cn; ch++) {
+      int sum = 0;
+      for (int k = 0; k < taps; k++) {
+        sum += s[k * cn + ch] * c[k];
+      }
+      dst[i * cn + ch] = static_cast<int16_t>((sum + round) >> kMidShift);
+    }
+  }
+}
+
+/**
+ * @brief Filter taps Q(MID) rows along y into one output row
+ *
+ * @param rows taps row pointers, top first
+ * @param coef taps weights
+ * @param taps
+ * @param count samples per row
+ * @param dst
+ */
+static void ScaleRowY(const int16_t* const* rows, const int16_t* coef,
+                      int taps, int count, unsigned char* dst) {
+  const int round = 1 << (kOutShift - 1);
+  int x           = 0;
+#ifdef __SSE2__
+  const __m128i vround = _mm_set1_epi32(round);
+  for (; x + 8 <= count; x += 8) {
+    __m128i lo = vround;
+    __m128i hi = vround;
+    for (int k = 0; k < taps; k += 2) {
+      // Interleave two rows so one madd applies both of their weights
+      const __m128i a =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + x));
+      const __m128i b =
+          k + 1 < taps
+              ? _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(rows[k + 1] + x))
+              : _mm_setzero_si128();
+      const int16_t c1    = k + 1 < taps ? coef[k + 1] : 0;
+      const uint32_t pair = (static_cast<uint32_t>(static_cast<uint16_t>(c1))
+                             << 16) |
+                            static_cast<uint16_t>(coef[k]);
+      const __m128i w     = _mm_set1_epi32(static_cast<int>(pair));
+      lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), w));
+      hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), w));
+    }
+    lo = _mm_srai_epi32(lo, kOutShift);
+    hi = _mm_srai_epi32(hi, kOutShift);
+    const __m128i packed = _mm_packs_epi32(lo, hi);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x),
+                     _mm_packus_epi16(packed, packed));
+  }
+#endif
+  for (; x < count; x++) {
+    int sum = round;
+    for (int k = 0; k < taps; k++) {
+      sum += rows[k][x] * coef[k];
+    }
+    dst[x] = static_cast<unsigned char>(std::clamp(sum >> kOutShift, 0, 255));
+  }
+}
+
+/**
+ * @brief Rows of one target between source rows, a ring of yAxis.taps
+ * horizontally filtered rows
+ */
+struct ScaleTargetState {
+  std::vector<int16_t> ring;
+  std::vector<uint8_t> needed;  // Source rows some output row reads
+  int next = 0;                 // Next output row to write
+};
+
+/**
+ * @brief Resize a plane to every target in one pass over the source rows.
+ * Each row is filtered along x once per target into a ring, and every output
+ * row whose window is complete is filtered along y right away, so the
+ * source is read once while it is still in cache.
+ *
+ * @param src
+ * @param srcWidth
+ * @param srcHeight
+ * @param srcStride
+ * @param cn
+ * @param targets
+ */
+void ScalePlane(const unsigned char* src, int srcWidth, int srcHeight,
+                int srcStride, int cn,
+                const std::vector<ScaleTarget>& targets) {
+  std::vector<ScaleTargetState> states(targets.size());
+  for (size_t t = 0; t < targets.size(); t++) {
+    const ScaleAxis& xAxis = *targets[t].xAxis;
+    const ScaleAxis& yAxis = *targets[t].yAxis;
+    if (xAxis.srcSize != srcWidth || yAxis.srcSize != srcHeight) {
+      states[t].next = yAxis.dstSize;  // Mismatched axes, skip the target
+      continue;
+    }
+    states[t].ring.resize(static_cast<size_t>(yAxis.taps) * xAxis.dstSize *
+                          cn);
+    states[t].needed.assign(srcHeight, 0);
+    for (int j = 0; j < yAxis.dstSize; j++) {
+      for (int k = 0; k < yAxis.taps; k++) {
+        states[t].needed[yAxis.start[j] + k] = 1;
+      }
+    }
+  }
+
+  std::vector<const int16_t*> rows;
+  for (int r = 0; r < srcHeight; r++) {
+    const unsigned char* srcRow = src + static_cast<size_t>(r) * srcStride;
+    for (size_t t = 0; t < targets.size(); t++) {
+      const ScaleTarget& target = targets[t];
+      ScaleTargetState& state   = states[t];
+      const ScaleAxis& yAxis    = *target.yAxis;
+      if (state.next >= yAxis.dstSize || !state.needed[r]) {
+        continue;
+      }
+      const size_t rowSize = static_cast<size_t>(target.xAxis->dstSize) * cn;
+      const int taps       = yAxis.taps;
+      ScaleRowX(srcRow, *target.xAxis, cn,
+                state.ring.data() + (r % taps) * rowSize);
+
+      // Output rows whose last tap is this source row
+      while (state.next < yAxis.dstSize &&
+             yAxis.start[state.next] + taps - 1 <= r) {
+        const int j = state.next++;
+        rows.resize(taps);
+        for (int k = 0; k < taps; k++) {
+          rows[k] =
+              state.ring.data() + ((yAxis.start[j] + k) % taps) * rowSize;
+        }
+        const int16_t* coef = yAxis.coef.data() + static_cast<size_t>(j) * taps;
+        ScaleRowY(rows.data(), coef, taps, static_cast<int>(rowSize),
+                  target.dst + static_cast<size_t>(j) * target.dstStride);
+      }
+    }
+  }
+}
+
+/**
+ * @brief One row of a 2x2 box downscale
+ *
+ * @param row0
+ * @param row1 row below row0
+ * @param dst
+ * @param dstWidth samples, 2 * dstWidth are read from each row
+ */
+void ScaleHalfRow(const unsigned char* row0, const unsigned char* row1,
+                  unsigned char* dst, int dstWidth) {
+  int x = 0;
+#ifdef __SSE2__
+  const __m128i low   = _mm_set1_epi16(0x00FF);
+  const __m128i round = _mm_set1_epi16(2);
+  // Sum of the even and odd bytes of one row, per 16-bit pair
+  auto pairSum = [&](__m128i v) {
+    return _mm_add_epi16(_mm_and_si128(v, low), _mm_srli_epi16(v, 8));
+  };
+  for (; x + 16 <= dstWidth; x += 16) {
+    const __m128i* a = reinterpret_cast<const __m128i*>(row0 + 2 * x);
+    const __m128i* b = reinterpret_cast<const __m128i*>(row1 + 2 * x);
+    const __m128i lo = _mm_add_epi16(pairSum(_mm_loadu_si128(a)),
+                                     pairSum(_mm_loadu_si128(b)));
+    const __m128i hi = _mm_add_epi16(pairSum(_mm_loadu_si128(a + 1)),
+                                     pairSum(_mm_loadu_si128(b + 1)));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(dst + x),
+        _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(lo, round), 2),
+                         _mm_srli_epi16(_mm_add_epi16(hi, round), 2)));
+  }
+#endif
+  for (; x < dstWidth; x++) {
+    dst[x] = static_cast<unsigned char>(
+        (row0[2 * x] + row0[2 * x + 1] + row1[2 * x] + row1[2 * x + 1] + 2) >>
+        2);
+  }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "../include/TileExecutor.h"
+#include <algorithm>
+#include <thread>
+
+/**
+@brief Construct a new Tile Executor:: Tile Executor object
+ *
+ * @param threads
+ */
+TileExecutor::TileExecutor(int threads) {
+  for (int i = 0; i < threads; i++) {
+    auto worker = std::make_shared<ThreadWrapper>(
+        &TileExecutor::WorkerThreadFunction, this);
+    worker->ThreadSetname("TileExecutor");
+    mWorkers.push_back(worker);
+  }
+}
+
+/**
+@brief Destroy the Tile Executor:: Tile Executor object
+ *
+ */
+TileExecutor::~TileExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mJobMux);
+    bIsRunning = false;
+  }
+  mWorkCondVar.notify_all();
+  for (auto& worker : mWorkers) {
+    worker->join();
+  }
+}
+
+/**
+@brief Process wide instance, one worker per extra hardware thread
+ *
+ * @return TileExecutor&
+ */
+TileExecutor& TileExecutor::GetInstance() {
+  static TileExecutor instance(
+      std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1));
+  return instance;
+}
+
+/**
+@brief Threads taking part in a Run, caller included
+ *
+ * @return int
+ */
+int TileExecutor::GetConcurrency() const {
+  return static_cast<int>(mWorkers.size()) + 1;
+}
+
+/**
+@brief Claim tiles of the current job until none are left
+ *
+ */
+void TileExecutor::RunTiles() {
+  int tile = 0;
+  while ((tile = mNextTile.fetch_add(1)) < mTileCount) {
+    (*mJob)(tile);
+  }
+}
+
+/**
+@brief Run func over all tiles and wait for completion
+ *
+ * @param tileCount
+ * @param func
+ */
+void TileExecutor::Run(int tileCount, const std::function<void(int)>& func) {
+  if (tileCount <= 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> runLock(mRunMux, std::try_to_lock);
+  if (!runLock.owns_lock() || mWorkers.empty() || tileCount == 1) {
+    for (int tile = 0; tile < tileCount; tile++) {
+      func(tile);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mJobMux);
+    mJob           = &func;
+    mTileCount     = tileCount;
+    mNextTile      = 0;
+    mActiveWorkers = mWorkers.size();
+    mGeneration++;
+  }
+  mWorkCondVar.notify_all();
+  RunTiles();
+
+  std::unique_lock<std::mutex> lock(mJobMux);
+  mDoneCondVar.wait(lock, [this]() { return mActiveWorkers == 0; });
+  mJob = nullptr;
+}
+
+/***
+ * @brief Worker thread function, joins every job published by Run
+ */
+void* TileExecutor::WorkerThreadFunction(void* arg) {
+  TileExecutor* pExecutor = static_cast<TileExecutor*>(arg);
+  uint64_t generation     = 0;
+  while (true) {
+    std::unique_lock<std::mutex> lock(pExecutor->mJobMux);
+    pExecutor->mWorkCondVar.wait(lock, [&]() {
+      return !pExecutor->bIsRunning || pExecutor->mGeneration != generation;
+    });
+    if (!pExecutor->bIsRunning) {
+      break;
+    }
+    generation = pExecutor->mGeneration;
+    lock.unlock();
+
+    pExecutor->RunTiles();
+
+    lock.lock();
+    if (--pExecutor->mActiveWorkers == 0) {
+      pExecutor->mDoneCondVar.notify_one();
+    }
+  }
+  return nullptr;
+}
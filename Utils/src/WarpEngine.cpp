@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "../include/WarpEngine.h"
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include "../include/TileExecutor.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Bilinear weights (w00, w01, w10, w11) for every fraction pair
+ *
+ * @return const int16_t*
+ */
+static const int16_t* WarpWeightTable() {
+  static const std::vector<int16_t> table = []() {
+    std::vector<int16_t> tab(WARP_MAP_SCALE * WARP_MAP_SCALE * 4);
+    for (int fy = 0; fy < WARP_MAP_SCALE; fy++) {
+      for (int fx = 0; fx < WARP_MAP_SCALE; fx++) {
+        int16_t* w = &tab[(fy * WARP_MAP_SCALE + fx) * 4];
+        w[0]       = (WARP_MAP_SCALE - fx) * (WARP_MAP_SCALE - fy);
+        w[1]       = fx * (WARP_MAP_SCALE - fy);
+        w[2]       = (WARP_MAP_SCALE - fx) * fy;
+        w[3]       = fx * fy;
+      }
+    }
+    return tab;
+  }();
+  return table.data();
+}
+
+/**
+@brief L2 cache size, 256KB when the system does not say
+ *
+ * @return size_t
+ */
+size_t WarpGetL2CacheSize() {
+  static const size_t size = []() -> size_t {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (l2 > 0) {
+      return static_cast<size_t>(l2);
+    }
+#endif
+    return 256 * 1024;
+  }();
+  return size;
+}
+
+/**
+@brief Allocate a width x height map
+ *
+ * @param map
+ * @param width
+ * @param height
+ */
+void WarpInitMap(WarpMap& map, int width, int height) {
+  map.width  = width;
+  map.height = height;
+  map.xy.assign(static_cast<size_t>(width) * height * 2, 0);
+  map.frac.assign(static_cast<size_t>(width) * height, 0);
+  map.tiles.clear();
+}
+
+/**
+ * @brief Round a source position to fixed point. Positions beyond one pixel
+ * outside only ever read the border, so they are clamped there.
+ *
+ * @param sx
+ * @param sy
+ * @param width
+ * @param height
+ * @param xy
+ * @param frac
+ */
+static inline void WarpToFixed(double sx, double sy, int width, int height,
+                               int16_t* xy, uint16_t* frac) {
+  sx = std::max(-2.0, std::min(sx, double(width)));
+  sy = std::max(-2.0, std::min(sy, double(height)));
+  // Round half up; the bias keeps the value positive so truncation floors
+  const double bias = 2.0 * WARP_MAP_SCALE + 0.5;
+  const int isx     = static_cast<int>(sx * WARP_MAP_SCALE + bias) -
+                  2 * WARP_MAP_SCALE;
+  const int isy = static_cast<int>(sy * WARP_MAP_SCALE + bias) -
+                  2 * WARP_MAP_SCALE;
+  xy[0]         = static_cast<int16_t>(isx >> WARP_MAP_BITS);
+  xy[1]         = static_cast<int16_t>(isy >> WARP_MAP_BITS);
+  *frac         = static_cast<uint16_t>(
+      ((isy & (WARP_MAP_SCALE - 1)) << WARP_MAP_BITS) |
+      (isx & (WARP_MAP_SCALE - 1)));
+}
+
+/**
+@brief Store the source position of output pixel (x, y)
+ *
+ * @param map
+ * @param x
+ * @param y
+ * @param sx
+ * @param sy
+ */
+void WarpSetEntry(WarpMap& map, int x, int y, double sx, double sy) {
+  const size_t i = static_cast<size_t>(y) * map.width + x;
+  WarpToFixed(sx, sy, map.width, map.height, &map.xy[i * 2], &map.frac[i]);
+}
+
+/**
+ * @brief Split tiles until the bytes touched per tile fit the budget
+ *
+ * @param tile
+ * @param cost
+ * @param budget
+ * @param tiles
+ */
+static void WarpSplitTile(const WarpTile& tile,
+                          const std::function<size_t(const WarpTile&)>& cost,
+                          size_t budget, std::vector<WarpTile>& tiles) {
+  if ((tile.width <= WARP_MIN_TILE && tile.height <= WARP_MIN_TILE) ||
+      cost(tile) <= budget) {
+    tiles.push_back(tile);
+    return;
+  }
+  WarpTile first  = tile;
+  WarpTile second = tile;
+  if (tile.width >= tile.height) {
+    first.width  = tile.width / 2;
+    second.x     = tile.x + first.width;
+    second.width = tile.width - first.width;
+  } else {
+    first.height  = tile.height / 2;
+    second.y      = tile.y + first.height;
+    second.height = tile.height - first.height;
+  }
+  WarpSplitTile(first, cost, budget, tiles);
+  WarpSplitTile(second, cost, budget, tiles);
+}
+
+/**
+ * @brief Cover width x height with tiles, each fitting half of L2 with up to
+ * four bytes per source pixel plus the map and output
+ *
+ * @param width
+ * @param height
+ * @param footprint source pixels a tile reads
+ * @return std::vector<WarpTile>
+ */
+static std::vector<WarpTile> WarpMakeTiles(
+    int width, int height,
+    const std::function<size_t(const WarpTile&)>& footprint) {
+  const size_t budget = WarpGetL2CacheSize() / 2;
+  auto cost           = [&footprint](const WarpTile& tile) {
+    return footprint(tile) * 4 +
+           static_cast<size_t>(tile.width) * tile.height *
+               (sizeof(int16_t) * 2 + sizeof(uint16_t) + 4);
+  };
+  std::vector<WarpTile> tiles;
+  for (int y = 0; y < height; y += WARP_TILE_HEIGHT) {
+    for (int x = 0; x < width; x += WARP_TILE_WIDTH) {
+      WarpTile tile;
+      tile.x      = x;
+      tile.y      = y;
+      tile.width  = std::min(WARP_TILE_WIDTH, width - x);
+      tile.height = std::min(WARP_TILE_HEIGHT, height - y);
+      WarpSplitTile(tile, cost, budget, tiles);
+    }
+  }
+  return tiles;
+}
+
+/**
+@brief Split the map into tiles by scanning each tile's source bounds
+ *
+ * @param map
+ */
+void WarpBuildTiles(WarpMap& map) {
+  map.tiles = WarpMakeTiles(map.width, map.height, [&map](const WarpTile& t) {
+    const WarpTile bounds = WarpGetSourceBounds(map, t);
+    return static_cast<size_t>(bounds.width) * bounds.height;
+  });
+}
+
+/**
+@brief Scan the map entries of an output tile for the source pixels its
+ * bilinear taps read
+ *
+ * @param map
+ * @param tile
+ * @return WarpTile
+ */
+WarpTile WarpGetSourceBounds(const WarpMap& map, const WarpTile& tile) {
+  int minX = map.width, minY = map.height, maxX = -1, maxY = -1;
+  for (int y = tile.y; y < tile.y + tile.height; y++) {
+    const int16_t* xy =
+        &map.xy[(static_cast<size_t>(y) * map.width + tile.x) * 2];
+    for (int x = 0; x < tile.width; x++) {
+      if (xy[2 * x] < -1 || xy[2 * x + 1] < -1 || xy[2 * x] >= map.width ||
+          xy[2 * x + 1] >= map.height) {
+        continue;  // Reads only the border
+      }
+      minX = std::min<int>(minX, xy[2 * x]);
+      maxX = std::max<int>(maxX, xy[2 * x] + 1);
+      minY = std::min<int>(minY, xy[2 * x + 1]);
+      maxY = std::max<int>(maxY, xy[2 * x + 1] + 1);
+    }
+  }
+  minX = std::max(minX, 0);
+  minY = std::max(minY, 0);
+  maxX = std::min(maxX, map.width - 1);
+  maxY = std::min(maxY, map.height - 1);
+  WarpTile bounds;
+  if (maxX < minX || maxY < minY) {
+    return bounds;
+  }
+  bounds.x      = minX;
+  bounds.y      = minY;
+  bounds.width  = maxX - minX + 1;
+  bounds.height = maxY - minY + 1;
+  return bounds;
+}
+
+/**
+ * @brief One bilinear output pixel; taps outside the source read border
+ */
+static inline void WarpBilinearPixel(const unsigned char* src, int width,
+                                     int height, int cn, int sx, int sy,
+                                     const int16_t* w, unsigned char* dst,
+                                     unsigned char border) {
+  const int stride = width * cn;
+  const int round  = 1 << (WARP_COEF_BITS - 1);
+  if (sx >= 0 && sy >= 0 && sx < width - 1 && sy < height - 1) {
+    const unsigned char* s0 = src + sy * stride + sx * cn;
+    const unsigned char* s1 = s0 + stride;
+    for (int c = 0; c < cn; c++) {
+      dst[c] = static_cast<unsigned char>(
+          (s0[c] * w[0] + s0[c + cn] * w[1] + s1[c] * w[2] +
+           s1[c + cn] * w[3] + round) >>
+          WARP_COEF_BITS);
+    }
+    return;
+  }
+  const bool x0 = sx >= 0 && sx < width;
+  const bool x1 = sx + 1 >= 0 && sx + 1 < width;
+  const bool y0 = sy >= 0 && sy < height;
+  const bool y1 = sy + 1 >= 0 && sy + 1 < height;
+  for (int c = 0; c < cn; c++) {
+    auto tap = [&](bool valid, int tx, int ty) -> int {
+      return valid ? src[ty * stride + tx * cn + c] : border;
+    };
+    dst[c] = static_cast<unsigned char>(
+        (tap(x0 && y0, sx, sy) * w[0] + tap(x1 && y0, sx + 1, sy) * w[1] +
+         tap(x0 && y1, sx, sy + 1) * w[2] +
+         tap(x1 && y1, sx + 1, sy + 1) * w[3] + round) >>
+        WARP_COEF_BITS);
+  }
+}
+
+/**
+ * @brief Bilinear output row from fixed-point positions. Single channel rows
+ * go four pixels at a time: the 2x2 taps are gathered as byte pairs and
+ * weighted with one multiply-add per source row.
+ *
+ * @param src source plane, width x height x cn
+ * @param width
+ * @param height
+ * @param cn
+ * @param xy
+ * @param frac
+ * @param count
+ * @param dst
+ * @param border
+ */
+static void WarpBilinearRow(const unsigned char* src, int width, int height,
+                            int cn, const int16_t* xy, const uint16_t* frac,
+                            int count, unsigned char* dst,
+                            unsigned char border) {
+  const int16_t* weights = WarpWeightTable();
+  int x                  = 0;
+#ifdef __SSE2__
+  if (cn == 1) {
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << (WARP_COEF_BITS - 1));
+    const unsigned maxX = static_cast<unsigned>(width - 1);
+    const unsigned maxY = static_cast<unsigned>(height - 1);
+    for (; x + 4 <= count; x += 4) {
+      const int16_t* p = xy + 2 * x;
+      if (static_cast<unsigned>(p[0]) >= maxX ||
+          static_cast<unsigned>(p[1]) >= maxY ||
+          static_cast<unsigned>(p[2]) >= maxX ||
+          static_cast<unsigned>(p[3]) >= maxY ||
+          static_cast<unsigned>(p[4]) >= maxX ||
+          static_cast<unsigned>(p[5]) >= maxY ||
+          static_cast<unsigned>(p[6]) >= maxX ||
+          static_cast<unsigned>(p[7]) >= maxY) {
+        for (int i = 0; i < 4; i++) {
+          WarpBilinearPixel(src, width, height, 1, p[2 * i], p[2 * i + 1],
+                            weights + frac[x + i] * 4, dst + x + i, border);
+        }
+        continue;
+      }
+
+      uint64_t row0 = 0;
+      uint64_t row1 = 0;
+      int64_t w[4];
+      for (int i = 0; i < 4; i++) {
+        const unsigned char* s = src + p[2 * i + 1] * width + p[2 * i];
+        uint16_t top, bottom;
+        std::memcpy(&top, s, sizeof(top));
+        std::memcpy(&bottom, s + width, sizeof(bottom));
+        row0 |= static_cast<uint64_t>(top) << (16 * i);
+        row1 |= static_cast<uint64_t>(bottom) << (16 * i);
+        std::memcpy(&w[i], weights + frac[x + i] * 4, sizeof(w[i]));
+      }
+      // Regroup (w00, w01, w10, w11) per pixel into a top and a bottom row
+      const __m128i a   = _mm_set_epi64x(w[1], w[0]);
+      const __m128i b   = _mm_set_epi64x(w[3], w[2]);
+      const __m128i lo  = _mm_unpacklo_epi32(a, b);
+      const __m128i hi  = _mm_unpackhi_epi32(a, b);
+      const __m128i wt0 = _mm_unpacklo_epi32(lo, hi);
+      const __m128i wt1 = _mm_unpackhi_epi32(lo, hi);
+
+      const __m128i p0 = _mm_unpacklo_epi8(
+          _mm_set_epi64x(0, static_cast<int64_t>(row0)), zero);
+      const __m128i p1 = _mm_unpacklo_epi8(
+          _mm_set_epi64x(0, static_cast<int64_t>(row1)), zero);
+      __m128i sum = _mm_add_epi32(_mm_madd_epi16(p0, wt0),
+                                  _mm_madd_epi16(p1, wt1));
+      sum         = _mm_srli_epi32(_mm_add_epi32(sum, round), WARP_COEF_BITS);
+      sum         = _mm_packus_epi16(_mm_packs_epi32(sum, zero), zero);
+      const int out = _mm_cvtsi128_si32(sum);
+      std::memcpy(dst + x, &out, sizeof(out));
+    }
+  }
+#endif
+  for (; x < count; x++) {
+    WarpBilinearPixel(src, width, height, cn, xy[2 * x], xy[2 * x + 1],
+                      weights + frac[x] * 4, dst + x * cn, border);
+  }
+}
+
+/**
+@brief Remap planes sharing one map, tile by tile on the executor
+ *
+ * @param map
+ * @param src
+ * @param dst
+ * @param planes
+ * @param cn
+ * @param border
+ */
+void WarpRemap(const WarpMap& map, const unsigned char* const* src,
+               unsigned char* const* dst, int planes, int cn,
+               unsigned char border) {
+  if (map.tiles.empty()) {
+    WarpTile whole;
+    whole.width  = map.width;
+    whole.height = map.height;
+    WarpRemapTiles(map, {whole}, src, dst, planes, cn, border);
+    return;
+  }
+  WarpRemapTiles(map, map.tiles, src, dst, planes, cn, border);
+}
+
+/**
+@brief Remap the given output tiles on the executor, the rest of dst is
+ * left as it is
+ *
+ * @param map
+ * @param tiles
+ * @param src
+ * @param dst
+ * @param planes
+ * @param cn
+ * @param border
+ */
+void WarpRemapTiles(const WarpMap& map, const std::vector<WarpTile>& tiles,
+                    const unsigned char* const* src, unsigned char* const* dst,
+                    int planes, int cn, unsigned char border) {
+  TileExecutor::GetInstance().Run(
+      static_cast<int>(tiles.size()), [&](int index) {
+        const WarpTile& tile = tiles[index];
+        for (int y = tile.y; y < tile.y + tile.height; y++) {
+          const size_t offset = static_cast<size_t>(y) * map.width + tile.x;
+          for (int p = 0; p < planes; p++) {
+            WarpBilinearRow(src[p], map.width, map.height, cn,
+                            &map.xy[offset * 2], &map.frac[offset],
+                            tile.width, dst[p] + offset * cn, border);
+          }
+        }
+      });
+}
+
+/**
+@brief Perspective warp; positions are computed per tile row in the same
+ * fixed point as remap tables, so a map built from the matrix matches.
+ *
+ * @param src
+ * @param dst
+ * @param planes
+ * @param width
+ * @param height
+ * @param cn
+ * @param matrix row major 3x3, output to source
+ * @param border
+ */
+void WarpPerspective(const unsigned char* const* src,
+                     unsigned char* const* dst, int planes, int width,
+                     int height, int cn, const double matrix[9],
+                     unsigned char border) {
+  const double* m = matrix;
+  auto footprint  = [&](const WarpTile& t) -> size_t {
+    const double cx[4] = {double(t.x), double(t.x + t.width), double(t.x),
+                          double(t.x + t.width)};
+    const double cy[4] = {double(t.y), double(t.y), double(t.y + t.height),
+                          double(t.y + t.height)};
+    double minX = width, minY = height, maxX = -1, maxY = -1;
+    for (int i = 0; i < 4; i++) {
+      const double w = m[6] * cx[i] + m[7] * cy[i] + m[8];
+      if (w <= 0.0) {
+        // Horizon crosses the tile, bounds are not defined by the corners
+        return static_cast<size_t>(width) * height;
+      }
+      const double sx = (m[0] * cx[i] + m[1] * cy[i] + m[2]) / w;
+      const double sy = (m[3] * cx[i] + m[4] * cy[i] + m[5]) / w;
+      minX            = std::min(minX, sx);
+      maxX            = std::max(maxX, sx + 1);
+      minY            = std::min(minY, sy);
+      maxY            = std::max(maxY, sy + 1);
+    }
+    minX = std::max(minX, 0.0);
+    minY = std::max(minY, 0.0);
+    maxX = std::min(maxX, double(width - 1));
+    maxY = std::min(maxY, double(height - 1));
+    if (maxX < minX || maxY < minY) {
+      return 0;
+    }
+    return static_cast<size_t>((maxX - minX + 1) * (maxY - minY + 1));
+  };
+  const std::vector<WarpTile> tiles = WarpMakeTiles(width, height, footprint);
+
+  TileExecutor::GetInstance().Run(
+      static_cast<int>(tiles.size()), [&](int index) {
+        const WarpTile& tile = tiles[index];
+        int16_t xy[WARP_TILE_WIDTH * 2];
+        uint16_t frac[WARP_TILE_WIDTH];
+        for (int y = tile.y; y < tile.y + tile.height; y++) {
+          const double rowX = m[1] * y + m[2];
+          const double rowY = m[4] * y + m[5];
+          const double rowW = m[7] * y + m[8];
+          for (int x = 0; x < tile.width; x++) {
+            // w == 0 gives inf or NaN, both clamp to the border
+            const double ox   = tile.x + x;
+            const double invW = 1.0 / (m[6] * ox + rowW);
+            WarpToFixed((m[0] * ox + rowX) * invW, (m[3] * ox + rowY) * invW,
+                        width, height, &xy[2 * x], &frac[x]);
+          }
+          const size_t offset = static_cast<size_t>(y) * width + tile.x;
+          for (int p = 0; p < planes; p++) {
+            WarpBilinearRow(src[p], width, height, cn, xy, frac, tile.width,
+                            dst[p] + offset * cn, border);
+          }
+        }
+      });
+}
@@ -23,11 +23,16 @@
 #ifndef ALGO_BASE_H
 #define ALGO_BASE_H
 
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include "AlgoDefs.h"
 #include "AlgoRequest.h"
 #include "EventHandlerThread.h"
+#include "ImageStripe.h"
 #include "KpiMonitor.h"
 #include "TaskQueue.h"
 
@@ -72,6 +77,17 @@ class AlgoBase {
     std::string mAlgoName;
     void* pctx = nullptr;
   };
+
+  // Base of the state a node carries from one frame of a stream to the next
+  struct StreamState {
+    virtual ~StreamState() = default;
+  };
+
+  // Last output of a stream, for nodes that recompute only dirty blocks
+  struct BlockHistory {
+    std::shared_ptr<ImageData> output;
+    uint64_t frame = 0;  // Stream frame the output belongs to, 0 if none
+  };
   // Constructors
   AlgoBase();
   // Constructor
@@ -83,11 +99,40 @@ class AlgoBase {
   virtual AlgoStatus Process(std::shared_ptr<AlgoRequest> req) = 0;
   virtual AlgoStatus Close()                                   = 0;
   virtual int GetTimeout()                                     = 0;
+  // True if the output depends only on the input images and metadata
+  virtual bool IsCacheable() const { return false; }
+  // True if the node keeps the request's dirty block mask valid for its output
+  virtual bool SupportsDirtyBlocks() const { return false; }
+  // Luma rows above and below an output row the node reads, -1 if it cannot
+  // run on stripes of the format. Stripe nodes keep the format as it is.
+  virtual int GetStripeHalo(ImageFormat format) const {
+    (void)format;
+    return -1;
+  }
+  // Area of image 0 Process may change, leaving the other images as they are.
+  // False if the node cannot tell, which marks every image dirty.
+  virtual bool GetWrittenRect(ImageFormat format, int width, int height,
+                              DirtyRect& rect) const {
+    (void)format;
+    (void)width;
+    (void)height;
+    (void)rect;
+    return false;
+  }
+  // Produce the rows of out from in, which holds them and the halo clipped to
+  // the frame. Called concurrently for different stripes of a frame.
+  virtual AlgoStatus ProcessStripe(const ImageStripe& in, ImageStripe& out) {
+    (void)in;
+    (void)out;
+    return AlgoStatus::NOT_SUPPORTED;
+  }
   void StopAlgoThread();
   AlgoStatus GetAlgoStatus() const;
   std::string GetStatusString() const;
   std::string GetAlgorithmName() const;
   AlgoId GetAlgoId() const;
+  // Algorithms the node runs, in order; just its own for plugin nodes
+  virtual std::vector<AlgoId> GetAlgoIds() const { return {mAlgoId}; }
   void EnqueueRequest(std::shared_ptr<Task_t> request);
   void SetEventThread(
       std::shared_ptr<EventHandlerThread<AlgoBase::AlgoCallbackMessage>>
@@ -97,7 +142,27 @@ class AlgoBase {
   std::weak_ptr<AlgoBase> GetNextAlgo();
   void SetEvent(std::shared_ptr<AlgoCallbackMessage> msg);
   bool bIslastNode = false;
+  // Stamp FRAME_HASH of the output after every successful Process
+  std::atomic<bool> bHashOutput{false};
+  // Block edge of the FrameStats taken of each input before Process, 0 off
+  void SetFrameStatsBlock(int blockSize);
+  int GetFrameStatsBlock() const;
   bool CanProcessFormat(ImageFormat Iformat, ImageFormat Oformat);
+  const std::vector<std::pair<ImageFormat, ImageFormat>>& GetSupportedFormats()
+      const;
+  // Incoming formats converted before Process, and the format they become
+  void SetInputConversions(
+      const std::map<ImageFormat, ImageFormat>& conversions);
+  void ResetStreamState(int streamId);
+  size_t GetStreamCount() const;
+  // Nodes following this one that it runs per stripe, in pipeline order
+  void SetStripeGroup(const std::vector<std::shared_ptr<AlgoBase>>& members,
+                      int stripeRows);
+  std::vector<std::shared_ptr<AlgoBase>> GetStripeGroup() const;
+  // Nodes a request passes through on this node's thread, itself included
+  size_t GetChainLength() const;
+  // Timeout of this node and the stripe group it runs
+  int GetChainTimeout();
 
  protected:
   AlgorithmOperations mAlgoOperations;
@@ -112,10 +177,54 @@ class AlgoBase {
       pEventHandlerThread = nullptr;
   std::vector<std::pair<ImageFormat, ImageFormat>> SupportedFormatsMap;
 
+  int mStripeRows = 32;  // Luma rows a stripe produces, at least
+  bool ProcessStripes(const std::vector<AlgoBase*>& chain,
+                      const std::shared_ptr<AlgoRequest>& req,
+                      AlgoStatus& rc);
+  static std::shared_ptr<DirtyBlockMask> GetReusableBlocks(
+      const std::shared_ptr<AlgoRequest>& req, const BlockHistory& history);
+  static void UpdateBlockHistory(BlockHistory& history,
+                                 const std::shared_ptr<AlgoRequest>& req);
+
+  /**
+   * @brief Get the state slot of the stream the request belongs to, created
+   * on first use. The slot stays valid until ResetStreamState.
+   *
+   * @tparam T StreamState subclass, the same for every call of a node
+   * @param req
+   * @return T&
+   */
+  template <typename T>
+  T& GetStreamState(const std::shared_ptr<AlgoRequest>& req) {
+    std::lock_guard<std::mutex> lock(mStreamStateMutex);
+    auto& slot = mStreamStates[req ? req->mStreamId : 0];
+    if (!slot) {
+      slot = std::make_unique<T>();
+    }
+    return static_cast<T&>(*slot);
+  }
+
  private:
   static void ThreadFunction(void* Ctx, std::shared_ptr<Task_t> task);
   static void ThreadCallback(void* Ctx, std::shared_ptr<Task_t> task);
   static void ProcessTimeoutCallback(void* Ctx, std::shared_ptr<Task_t> task);
+  void ConvertInputImages(const std::shared_ptr<AlgoRequest>& req);
+  void ConvertOutputImages(const std::shared_ptr<AlgoRequest>& req);
+  void MarkWrittenArea(const std::vector<AlgoBase*>& chain, AlgoStatus rc,
+                       const std::shared_ptr<AlgoRequest>& req);
+  bool ConvertsFormat(ImageFormat format) const;
+  AlgoStatus RunProcess(const std::shared_ptr<AlgoRequest>& req);
+  AlgoStatus ProcessChain(const std::vector<AlgoBase*>& chain,
+                          const std::shared_ptr<AlgoRequest>& req);
+  bool EndsPipeline() const;
+  void StampFrameHash(const std::shared_ptr<AlgoRequest>& req) const;
+
+  mutable std::mutex mStreamStateMutex;
+  std::unordered_map<int, std::unique_ptr<StreamState>> mStreamStates;
+  mutable std::mutex mConversionMutex;
+  std::map<ImageFormat, ImageFormat> mInputConversions;
+  std::vector<std::weak_ptr<AlgoBase>> mStripeGroup;
+  std::atomic<int> mFrameStatsBlock{0};
 };
 
 #endif  // ALGO_BASE_H
@@ -37,14 +37,18 @@ typedef enum ALGOID {
   ALGO_LDC           = ALGO_BASE_ID + 5,
   ALGO_WATERMARK     = ALGO_BASE_ID + 6,
   ALGO_SWJPEG        = ALGO_BASE_ID + 7,
-  ALGO_MAX           = ALGO_BASE_ID + 8,
+  ALGO_SWJPEGDEC     = ALGO_BASE_ID + 8,
+  ALGO_SCALER        = ALGO_BASE_ID + 9,
+  ALGO_ROTATE        = ALGO_BASE_ID + 10,
+  ALGO_MAX           = ALGO_BASE_ID + 11,
 } AlgoId;
 
 #define ALGO_START (ALGO_OFFSET(ALGO_BASE_ID))
 #define ALGO_END (ALGO_OFFSET(ALGO_MAX))
 
 static std::string algoName[ALGO_OFFSET(ALGO_MAX) + 1] = {
-    "HDR", "BOKEH",     "NOP",  "FILTER", "MANDELBROTSET",
-    "LDC", "WATERMARK", "JPEG", "MAX"};
+    "HDR", "BOKEH",     "NOP",  "FILTER",  "MANDELBROTSET",
+    "LDC", "WATERMARK", "JPEG", "JPEGDEC", "SCALER",
+    "ROTATE", "MAX"};
 
 #endif  // ALGO_DEFS_H
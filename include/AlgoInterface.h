@@ -24,6 +24,7 @@
 
 #include <atomic>
 #include "AlgoSession.h"
+#include "FrameAssembler.h"
 
 #define MAX_HOLD_REQUESTS 20
 const size_t MAX_MEMORY_USAGE_KB =
@@ -34,6 +35,12 @@ class AlgoInterface {
   ~AlgoInterface();
   bool Process(std::shared_ptr<AlgoRequest> request,
                std::vector<AlgoId> algoList);
+  int ConfigureAssembler(const FrameAssemblerConfig& config);
+  int SubmitFrame(int streamId, int64_t timestampUs, int groupKey,
+                  std::shared_ptr<ImageData> frame,
+                  std::vector<AlgoId> algoList,
+                  std::shared_ptr<AlgoRequest> settings = nullptr);
+  int FlushFrames();
   int (*pIntfCallback)(std::shared_ptr<AlgoRequest> input) = nullptr;
 
   std::atomic<int> mRequestCnt{0};
@@ -44,5 +51,12 @@ class AlgoInterface {
   std::shared_ptr<AlgoSession> mSession;
   static void SessionCallbackHandler(void* pctx,
                                      std::shared_ptr<AlgoRequest> input);
+
+  std::shared_ptr<FrameAssembler> mAssembler;
+  std::shared_ptr<FrameAssembler> GetAssembler(bool create);
+  std::mutex mAssemblerMutex;
+  static void AssemblerCallbackHandler(void* pctx,
+                                       std::shared_ptr<AlgoRequest> request,
+                                       std::vector<AlgoId> algoList);
 };
 #endif  // ALGO_INTERFACE_H
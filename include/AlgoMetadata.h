@@ -22,15 +22,18 @@
 #ifndef ALGO_METADATA_H
 #define ALGO_METADATA_H
 #pragma once
+#include <cstdint>
 #include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 class AlgoRequest;
 enum class MetaId {
   IMAGE_WIDTH,             // Image width in pixels
   IMAGE_HEIGHT,            // Image height in pixels
   IMAGE_FORMAT,            // Image format (e.g., JPEG, PNG)
-  IMAGE_ORIENTATION,       // Orientation of the image (e.g., 0, 90, 180, 270)
+  IMAGE_ORIENTATION,       // Clockwise rotation to apply (0, 90, 180, 270)
   IMAGE_TIMESTAMP,         // Timestamp when the image was captured
   CAMERA_MAKE,             // Camera manufacturer
   CAMERA_MODEL,            // Camera model
@@ -65,6 +68,18 @@ enum class MetaId {
   ALGO_JPEG_ENABLE,            // JPEG quality setting
   ALGO_PROCESS_DONE,           // algo has done processing
   ALGO_REQUSET_NUMBER,         // Image frame Number
+  JPEG_DECODE_SCALE,           // DCT scale denominator for decode (1/2/4/8)
+  BOKEH_LATENCY_MS,            // Time the bokeh node spent on the request
+  FRAME_HASH,                  // int64 hash of the images after the last node
+  FRAME_HASH_INPUT,            // int64 hash of the images entering the pipeline
+  IMAGE_MIRROR,                // bool, mirrored before IMAGE_ORIENTATION
+  LUMA_HISTOGRAM,              // int32 list, 256 bins of the input luma
+  LUMA_MIN,                    // Smallest input luma sample
+  LUMA_MAX,                    // Largest input luma sample
+  LUMA_MEAN,                   // float, mean input luma
+  LUMA_BLOCK_SIZE,             // Block edge of LUMA_BLOCK_MEANS in pixels
+  LUMA_BLOCKS_X,               // Blocks per row of LUMA_BLOCK_MEANS
+  LUMA_BLOCK_MEANS,            // int32 list, rounded block means, row major
 
   // Additional ExifMetadata fields
   LENS_MAKE,
@@ -88,14 +103,25 @@ class AlgoMetadata {
   int GetMetadata(MetaId id, int& value);
   int GetMetadata(MetaId id, float& value);
   int GetMetadata(MetaId id, bool& value);
+  int GetMetadata(MetaId id, int64_t& value);
   int SetMetadata(MetaId id, int value);
   int SetMetadata(MetaId id, float value);
   int SetMetadata(MetaId id, bool value);
+  int SetMetadata(MetaId id, int64_t value);
+  int GetMetadata(MetaId id, std::vector<int32_t>& value);
+  int SetMetadata(MetaId id, std::vector<int32_t> value);
+
+  // Entries as bytes sorted by id, equal metadata gives equal bytes
+  std::string Serialize(const std::vector<MetaId>& skip = {});
+  // Set every entry of a Serialize() blob, others are kept
+  int Deserialize(const std::string& blob);
 
  private:
   std::unordered_map<MetaId, int> intMetadata;
   std::unordered_map<MetaId, float> floatMetadata;
   std::unordered_map<MetaId, bool> boolMetadata;
+  std::unordered_map<MetaId, int64_t> int64Metadata;
+  std::unordered_map<MetaId, std::vector<int32_t>> listMetadata;
   std::mutex mMutex;
 };
 
@@ -22,11 +22,16 @@
 #ifndef ALGO_PIPELINE_H
 #define ALGO_PIPELINE_H
 
+#include <atomic>
 #include <vector>
 #include "AlgoBase.h"
 #include "AlgoDefs.h"
 #include "AlgoNodeManager.h"
+#include "ChangeDetector.h"
 #include "EventHandlerThread.h"
+#include "FormatPlanner.h"
+#include "FrameStats.h"
+#include "TiledImage.h"
 
 enum class AlgoPipelineState {
   NotInitialised = 0,
@@ -39,6 +44,13 @@ enum class AlgoPipelineState {
   FailedToProcess
 };
 
+// Where FRAME_HASH is stamped, FRAME_HASH_INPUT is stamped unless Off
+enum class FrameHashMode {
+  Off = 0,    // No hashing
+  Output,     // After the last node
+  EveryNode,  // After every node, the metadata holds the latest
+};
+
 typedef void (*SESSIONCALLBACK)(void* cntx, std::shared_ptr<AlgoRequest> input);
 
 class AlgoPipeline {
@@ -49,6 +61,8 @@ class AlgoPipeline {
 
   AlgoPipelineState ConfigureAlgoPipeline(std::vector<AlgoId>& algoList);
   AlgoPipelineState ConfigureAlgoPipeline(std::vector<std::string>& algoList);
+  AlgoPipelineState ConfigureAlgoPipeline(
+      std::vector<std::shared_ptr<AlgoBase>>& nodes);
 
   void Process(std::shared_ptr<AlgoRequest> input);
   static void NodeEventHandler(void*,
@@ -60,6 +74,22 @@ class AlgoPipeline {
   AlgoPipelineState SetState(AlgoPipelineState state);
 
   std::vector<AlgoId> GetAlgoListId() const;
+  bool IsCacheable() const;
+  int ConfigureChangeDetector(const ChangeDetectorConfig& config);
+  std::shared_ptr<ChangeDetector> GetChangeDetector() const;
+  void SetFrameHashMode(FrameHashMode mode);
+  FrameHashMode GetFrameHashMode() const;
+  // Take FrameStats of every input on the first node's thread
+  int ConfigureFrameStats(const FrameStatsConfig& config);
+  FrameStatsConfig GetFrameStatsConfig() const;
+  const FormatPlanner& GetFormatPlan() const;
+  // Run consecutive stripe capable nodes per stripe, only while idle
+  void SetStripeStreaming(bool enabled, int stripeRows);
+  bool IsStripeStreaming() const;
+  size_t GetStripeGroupCount() const;
+  // Run every node per tile of input into output on the calling thread and
+  // the tile executor, all nodes must be stripe capable in the image format
+  int ProcessTiled(TiledImage& input, TiledImage& output);
 
   SESSIONCALLBACK pSesionCallBackHandler = nullptr;
   void* pSessionCtx                      = nullptr;
@@ -72,6 +102,10 @@ class AlgoPipeline {
   std::unordered_map<int, std::shared_ptr<AlgoRequest>> mRequesteMap;
 
  private:
+  void LinkAlgos(AlgoPipelineState configured);
+  void PlanFormats();
+  void PlanStripes();
+
   AlgoNodeManager* mAlgoNodeMgr = nullptr;
   std::vector<std::shared_ptr<AlgoBase>> mAlgos;
 
@@ -80,6 +114,17 @@ class AlgoPipeline {
   std::unordered_map<AlgoId, std::shared_ptr<AlgoBase>> mAlgoMap;
 
   AlgoPipelineState mState = AlgoPipelineState::NotInitialised;
+  std::shared_ptr<ChangeDetector> mChangeDetector;
+  mutable std::mutex mChangeDetectorMutex;
+  std::atomic<FrameHashMode> mFrameHashMode{FrameHashMode::Off};
+  FrameStatsConfig mFrameStatsConfig;
+  mutable std::mutex mFrameStatsMutex;
+  FormatPlanner mFormatPlanner;
+  // Format of the first image of the last input, the one Dump traces
+  std::atomic<ImageFormat> mInputFormat{ImageFormat::YUV420};
+  bool bStripeStreaming = true;
+  int mStripeRows       = 32;  // Luma rows a stripe produces, at least
+  size_t mStripeGroups  = 0;
   std::shared_ptr<EventHandlerThread<AlgoBase::AlgoCallbackMessage>>
       pEventHandlerThread;
 };
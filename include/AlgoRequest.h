@@ -22,7 +22,9 @@
 #ifndef ALGO_REQUEST_H
 #define ALGO_REQUEST_H
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include "AlgoMetadata.h"
@@ -36,35 +38,146 @@ enum class ImageFormat {
   GRAYSCALE,
   JPEG,
   PNG,
+  NV12,  // Y plane, then one plane of interleaved U,V at half resolution
+  NV21,  // As NV12 with V before U
+  RGBP,  // R, G and B planes at full resolution, internal to a pipeline
   UNKNOWN
 };
 
+class ImageData;
+
+/**
+ * @brief Representations derived from an image buffer, built on first use.
+ * Images sharing the buffer share them, a write to the buffer drops them.
+ * Node threads read shared images concurrently, every field is guarded by
+ * the mutex.
+ */
+struct ImageDerived {
+  std::mutex mutex;
+  uint64_t hash  = 0;
+  bool hashValid = false;
+  std::shared_ptr<const ImageData> rgb;
+  std::shared_ptr<const ImageData> luma;
+  std::vector<std::shared_ptr<const ImageData>> pyramid;  // From level 1 up
+};
+
 // Struct to represent an individual image
 class ImageData {
 
-  ImageFormat format;               // Format of the image (e.g., YUV, RGB)
-  std::vector<unsigned char> data;  // Raw image data
-  int width;                        // Width of the image
-  int height;                       // Height of the image
-  int fd;                           // File descriptor, -1 if not available
+  ImageFormat format;  // Format of the image (e.g., YUV, RGB)
+  // Raw image data, shared between images until one of them writes
+  std::shared_ptr<std::vector<unsigned char>> data;
+  int width;   // Width of the image
+  int height;  // Height of the image
+  int fd;      // File descriptor, -1 if not available
+  // Hash and views of data, valid until the next writable access
+  std::shared_ptr<ImageDerived> derived;
+
+  // Forget the derived representations of the old buffer contents
+  void DropDerived() {
+    if (derived.use_count() > 1) {
+      derived = std::make_shared<ImageDerived>();
+    } else {
+      derived->hashValid = false;
+      derived->rgb.reset();
+      derived->luma.reset();
+      derived->pyramid.clear();
+    }
+  }
+
  public:
   // Constructor
   ImageData(ImageFormat fmt, int w, int h, int fileDesc = -1)
-      : format(fmt), width(w), height(h), fd(fileDesc) {}
+      : format(fmt),
+        data(std::make_shared<std::vector<unsigned char>>()),
+        width(w),
+        height(h),
+        fd(fileDesc),
+        derived(std::make_shared<ImageDerived>()) {}
   ImageFormat GetFormat() const { return format; }
   int GetWidth() const { return width; }
   int GetHeight() const { return height; }
   int GetFd() const { return fd; }
   void SetData(std::vector<unsigned char>&& data) {
-    this->data = std::move(data);
+    this->data = std::make_shared<std::vector<unsigned char>>(std::move(data));
+    DropDerived();
+  }
+  // Writable data, a buffer still shared with another image is copied first.
+  // Drops the cached hash, so hash only after the writes are done.
+  std::vector<unsigned char>& GetData() {
+    if (data.use_count() > 1) {
+      data = std::make_shared<std::vector<unsigned char>>(*data);
+    }
+    DropDerived();
+    return *data;
+  }
+  const std::vector<unsigned char>& GetData() const { return *data; }
+  size_t GetDataSize() const { return data->size(); }
+  // New image sharing this buffer, copy-on-write
+  std::shared_ptr<ImageData> Share() const {
+    auto image     = std::make_shared<ImageData>(format, width, height, fd);
+    image->data    = data;
+    image->derived = derived;
+    return image;
   }
-  std::vector<unsigned char>& GetData() { return data; }
-  size_t GetDataSize() const { return data.size(); }
+  // 64-bit hash of the data, computed once and cached until it is written
+  uint64_t GetHash() const;
+  // Derived representations, computed once with the shared SIMD kernels and
+  // cached until the data is written, nullptr if the format has none
+  std::shared_ptr<const ImageData> AsRGB() const;
+  std::shared_ptr<const ImageData> Luma() const;
+  // GRAYSCALE 2x2 box downscale of Luma() applied level times
+  std::shared_ptr<const ImageData> Pyramid(int level) const;
 
   // Destructor
   ~ImageData() = default;
 };
 
+/**
+ * @brief Blocks of the first image that changed since the previous frame of
+ * the same stream. Nodes that recompute only dirty blocks grow the mask by
+ * their halo, so it describes their output for the next node.
+ */
+struct DirtyBlockMask {
+  int width          = 0;  // Luma size the mask was computed for
+  int height         = 0;
+  int blockSize      = 0;  // Block edge in luma pixels, even
+  int blocksX        = 0;
+  int blocksY        = 0;
+  uint64_t frame     = 0;  // Stream frame number of the request
+  uint64_t prevFrame = 0;  // Frame compared against, 0 if there was none
+  // blocksX * blocksY flags, row major
+  std::vector<uint8_t> dirty;
+
+  bool IsDirty(int bx, int by) const { return dirty[by * blocksX + bx] != 0; }
+  size_t GetDirtyCount() const;
+  // Grow dirty areas by halo pixels in every direction
+  void Dilate(int halo);
+};
+
+// Pixel rect, a plain aggregate so it can be brace initialised
+struct DirtyRect {
+  int x;
+  int y;
+  int width;
+  int height;
+};
+
+/**
+ * @brief Areas of an image the nodes wrote since the request entered the
+ * pipeline, in pixels of the image as it is now. Consumers limit their work
+ * to the rects unless all is set.
+ */
+struct DirtyRegion {
+  bool all = true;  // Anything may have changed, rects are not used
+  std::vector<DirtyRect> rects;
+
+  // Add a written area, merged into the bounding box past a few rects
+  void Add(const DirtyRect& rect);
+  // Box around every rect, empty if nothing changed
+  DirtyRect Bounds() const;
+};
+
 class AlgoRequest {
  private:
   std::vector<std::shared_ptr<ImageData>> images;  // Collection of images
@@ -77,6 +190,9 @@ class AlgoRequest {
   // Add an image to the collection
   int AddImage(ImageFormat format, int width, int height);
 
+  // Add an existing image to the collection, the data is shared not copied
+  int AddImage(std::shared_ptr<ImageData> image);
+
   // Get the total number of images
   size_t GetImageCount() const;
 
@@ -95,12 +211,29 @@ class AlgoRequest {
   size_t mProcessCnt = 0;
   int mRequestId;
   /*request id assoisiated*/  // make this conts in contruction  @todo
+  int mStreamId = 0;  // Camera stream, selects the per-stream node state
 
   AlgoMetadata mMetadata;
 
-  uint8_t FrameChecksum();
+  // 64-bit hash over format, size and data of every image
+  uint64_t FrameHash() const;
+
+  uint64_t mResultKey = 0;  // Result cache key of the input, 0 if uncached
+
+  // Changed blocks of image 0, nullptr recomputes every block
+  std::shared_ptr<DirtyBlockMask> mDirtyBlocks;
+
+  // Start tracking writes, every image counts as unchanged
+  void ResetDirtyRegions();
+  // Record a write to part of image index, clipped to the image
+  void MarkDirty(size_t index, const DirtyRect& rect);
+  // Record that image index may have changed anywhere
+  void MarkDirty(size_t index);
+  // Writes to image index since ResetDirtyRegions, all if untracked
+  DirtyRegion GetDirtyRegion(size_t index) const;
 
  private:
+  std::vector<DirtyRegion> mDirtyRegions;  // Per image index
 };
 
 #endif  // ALGO_REQUEST_H
\ No newline at end of file
@@ -26,6 +26,7 @@
 #include <mutex>
 #include <vector>
 #include "AlgoPipeline.h"
+#include "ResultCache.h"
 typedef void (*INTERFACECALLBACK)(void* pctx,
                                   std::shared_ptr<AlgoRequest> input);
 class AlgoSession {
@@ -35,6 +36,7 @@ class AlgoSession {
   ~AlgoSession();
   bool SessionStop();
   bool SessionAddPipeline(std::shared_ptr<AlgoPipeline>& pipeline);
+  bool SessionAddPipeline(std::vector<std::shared_ptr<AlgoBase>>& nodes);
   bool SessionRemovePipeline(size_t pipelineId);
   bool SessionProcess(std::shared_ptr<AlgoRequest> input,
                       std::vector<AlgoId> algoList);
@@ -44,6 +46,8 @@ class AlgoSession {
 
   int SessionGetpipelineId(std::vector<AlgoId> algoList);
   std::shared_ptr<AlgoPipeline> SessionGetPipeline(size_t pipelineId);
+  int SessionConfigureResultCache(const ResultCacheConfig& config);
+  std::shared_ptr<ResultCache> SessionGetResultCache() const;
   INTERFACECALLBACK pInterfaceCallBackHandler = nullptr;
   void* pInterfaceCtx                         = nullptr;
   mutable std::mutex mCallbackMutex;
@@ -56,6 +60,8 @@ class AlgoSession {
   std::vector<std::shared_ptr<AlgoPipeline>> mPipelines;
   size_t mNextPipelineId = 0;
   std::unordered_map<size_t, std::shared_ptr<AlgoPipeline>> mPipelineMap;
+  std::shared_ptr<ResultCache> mResultCache;
+  mutable std::mutex mCacheMutex;  // Also taken from pipeline callbacks
 
   static void PiplineCallBackHandler(void* pctx,
                                      std::shared_ptr<AlgoRequest> input);
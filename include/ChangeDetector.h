@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CHANGE_DETECTOR_H
+#define CHANGE_DETECTOR_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "AlgoRequest.h"
+
+struct ChangeDetectorConfig {
+  bool enabled  = false;
+  int blockSize = 32;  // Block edge in luma pixels, rounded up to even
+  int threshold = 0;   // Mean absolute difference per byte a block may have
+};
+
+/**
+ * @brief Compares the first image of each request with the previous frame of
+ * its stream and attaches the per-block result as the request's dirty mask.
+ * The first frame of a stream, or one whose size or format changed, is all
+ * dirty. Formats without a block layout get no mask.
+ */
+class ChangeDetector {
+ public:
+  explicit ChangeDetector(const ChangeDetectorConfig& config);
+  ~ChangeDetector();
+
+  int Detect(std::shared_ptr<AlgoRequest> req);
+  void ResetStream(int streamId);
+
+  const ChangeDetectorConfig& GetConfig() const;
+
+ private:
+  struct StreamHistory {
+    std::shared_ptr<ImageData> frame;  // Shares the buffer of the last input
+    uint64_t frameNumber = 0;
+  };
+
+  ChangeDetectorConfig mConfig;
+  std::mutex mMutex;
+  std::unordered_map<int, StreamHistory> mStreams;
+};
+
+#endif  // CHANGE_DETECTOR_H
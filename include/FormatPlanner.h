@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef FORMAT_PLANNER_H
+#define FORMAT_PLANNER_H
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "AlgoRequest.h"
+
+// Formats a node takes in and the format it produces from each
+typedef std::vector<std::pair<ImageFormat, ImageFormat>> FormatMap;
+
+// Relative cost per pixel of converting between two formats, 0 for the same
+// format and -1 when there is no direct conversion
+float FormatConversionCost(ImageFormat from, ImageFormat to);
+
+// Relative cost per pixel a node pays for the memory layout it is fed,
+// counted on top of its work on a planar layout
+float FormatAccessCost(ImageFormat format);
+
+// Format a pipeline hands back for images left in an internal format
+ImageFormat GetExternalFormat(ImageFormat format);
+
+// Copy of the image in another format, nullptr if that is not possible
+std::shared_ptr<ImageData> ConvertImage(const ImageData& image,
+                                        ImageFormat to);
+
+const char* GetFormatName(ImageFormat format);
+
+/**
+ * @brief What the plan does with one format arriving at a node
+ */
+struct FormatStep {
+  ImageFormat in;          // Format arriving at the node
+  ImageFormat fed;         // Format the node is given, converted if not in
+  ImageFormat out;         // Format the node produces
+  bool supported = false;  // False if the node takes no reachable format
+};
+
+/**
+ * @brief Picks, for every format that can enter a chain of nodes, the
+ * cheapest sequence of conversions that lets every node run. Nodes without
+ * a format map take any format unchanged. A format no node option can be
+ * reached from passes through unconverted and is left to the node. An
+ * internal format is only picked where it saves more layout cost than its
+ * conversions to and from the external format add.
+ */
+class FormatPlanner {
+ public:
+  int Plan(const std::vector<FormatMap>& nodes);
+
+  size_t GetNodeCount() const;
+  // Incoming format to the format the node must be fed, conversions only
+  std::map<ImageFormat, ImageFormat> GetConversions(size_t node) const;
+  FormatStep GetStep(size_t node, ImageFormat in) const;
+  // Steps of every node for a chain input
+  std::vector<FormatStep> Trace(ImageFormat input) const;
+  // Conversion and access cost of the chain for an input, unsupported nodes
+  // excluded
+  float GetCost(ImageFormat input) const;
+
+ private:
+  std::vector<std::vector<FormatStep>> mSteps;  // [node][incoming format]
+  std::vector<float> mInputCost;                // [chain input format]
+};
+
+#endif  // FORMAT_PLANNER_H
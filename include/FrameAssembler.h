@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef FRAME_ASSEMBLER_H
+#define FRAME_ASSEMBLER_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "AlgoDefs.h"
+#include "AlgoRequest.h"
+
+enum class AssemblyMode {
+  STEREO = 0,  // One frame per stream, matched by timestamp
+  BURST        // burstCount frames sharing a group key
+};
+
+enum class AssemblyDropPolicy {
+  DROP_INCOMPLETE = 0,  // Expired frames are released without processing
+  EMIT_PARTIAL          // Expired sets are processed with what arrived
+};
+
+struct FrameAssemblerConfig {
+  AssemblyMode mode             = AssemblyMode::STEREO;
+  int streamCount               = 2;       // Streams matched in stereo mode
+  int64_t toleranceUs           = 2000;    // Largest stereo timestamp skew
+  int burstCount                = 3;       // Frames per burst
+  int64_t maxWaitUs             = 100000;  // Age at which pending frames expire
+  size_t maxPending             = 8;       // Pending frames per stream/groups
+  AssemblyDropPolicy dropPolicy = AssemblyDropPolicy::DROP_INCOMPLETE;
+};
+
+typedef void (*ASSEMBLERCALLBACK)(void* pctx,
+                                  std::shared_ptr<AlgoRequest> request,
+                                  std::vector<AlgoId> algoList);
+
+/**
+ * @brief Builds multi-image requests out of single frames. Frames are held
+ * by pointer and moved into the request, pixel data is never copied. Age
+ * is measured on frame timestamps, so waiting is bounded by the capture
+ * clock rather than by delivery jitter.
+ */
+class FrameAssembler {
+ public:
+  FrameAssembler(const FrameAssemblerConfig& config,
+                 ASSEMBLERCALLBACK pCallBackHandler = nullptr,
+                 void* pCtx                         = nullptr);
+  ~FrameAssembler();
+
+  // settings carries the request id and metadata of the assembled request
+  int SubmitFrame(int streamId, int64_t timestampUs, int groupKey,
+                  std::shared_ptr<ImageData> frame,
+                  std::vector<AlgoId> algoList,
+                  std::shared_ptr<AlgoRequest> settings = nullptr);
+  void Flush();
+
+  const FrameAssemblerConfig& GetConfig() const;
+  size_t GetPendingFrames() const;
+  size_t GetAssembledCount() const;
+  size_t GetDroppedFrames() const;
+
+ private:
+  struct PendingFrame {
+    int streamId;
+    int64_t timestampUs;
+    std::shared_ptr<ImageData> image;
+    std::vector<AlgoId> algoList;
+    std::shared_ptr<AlgoRequest> settings;
+  };
+  struct Assembled {
+    std::shared_ptr<AlgoRequest> request;
+    std::vector<AlgoId> algoList;
+  };
+
+  void MatchStereo(std::vector<Assembled>& ready);
+  void ExpireStereo(int64_t nowUs, bool all, std::vector<Assembled>& ready);
+  void ExpireBursts(int64_t nowUs, bool all, std::vector<Assembled>& ready);
+  void Release(std::vector<PendingFrame>& frames,
+               std::vector<Assembled>& ready);
+
+  FrameAssemblerConfig mConfig;
+  ASSEMBLERCALLBACK pCallBackHandler = nullptr;
+  void* pCtx                         = nullptr;
+
+  mutable std::mutex mMutex;
+  std::vector<std::deque<PendingFrame>> mStreams;    // Stereo mode
+  std::map<int, std::vector<PendingFrame>> mBursts;  // Burst mode, by key
+  int64_t mNewestUs      = INT64_MIN;
+  size_t mAssembledCount = 0;
+  size_t mDroppedFrames  = 0;
+};
+
+#endif  // FRAME_ASSEMBLER_H
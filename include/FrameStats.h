@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <cstdint>
+#include <vector>
+#include "AlgoRequest.h"
+
+struct FrameStatsConfig {
+  bool enabled  = false;
+  int blockSize = 32;  // Block edge of the block means in luma pixels
+};
+
+/**
+ * @brief Luma statistics of a frame, gathered in a single pass over its luma
+ * plane so every consumer reads them instead of rescanning the frame
+ */
+struct FrameStats {
+  int blockSize = 0;
+  int blocksX   = 0;
+  int blocksY   = 0;
+  int min       = 0;
+  int max       = 0;
+  float mean    = 0.0f;
+  std::vector<int32_t> histogram;   // 256 bins
+  std::vector<int32_t> blockMeans;  // blocksX * blocksY, rounded, row major
+};
+
+// Statistics of the luma of an image, -1 if its format has no luma
+int ComputeFrameStats(const ImageData& image, int blockSize,
+                      FrameStats& stats);
+// Store stats as the LUMA_* metadata
+void SetFrameStats(const FrameStats& stats, AlgoMetadata& metadata);
+// Stats stored by SetFrameStats, -1 if there are none
+int GetFrameStats(AlgoMetadata& metadata, FrameStats& stats);
+
+#endif  // FRAME_STATS_H
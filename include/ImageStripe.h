@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef IMAGE_STRIPE_H
+#define IMAGE_STRIPE_H
+
+#include <cstddef>
+#include "AlgoRequest.h"
+
+/**
+ * @brief Luma rows [rowBegin, rowEnd) of a RGB, RGBP, YUV420, NV12 or NV21
+ * frame. Planes are addressed by frame row numbers, a chroma row being half a
+ * luma row, so a kernel indexes a stripe the way it indexes the whole frame.
+ * The stripe does not own its memory.
+ */
+struct ImageStripe {
+  ImageFormat format = ImageFormat::YUV420;
+  int width          = 0;  // Frame size
+  int height         = 0;
+  int rowBegin       = 0;  // Luma rows held
+  int rowEnd         = 0;
+  int planes         = 0;
+  unsigned char* data[3] = {nullptr, nullptr, nullptr};  // First row held
+  int stride[3]          = {0, 0, 0};  // Bytes per plane row
+  int shift[3]           = {0, 0, 0};  // Luma rows per plane row, log2
+
+  int PlaneBegin(int plane) const { return rowBegin >> shift[plane]; }
+  int PlaneEnd(int plane) const { return rowEnd >> shift[plane]; }
+  // Row of a plane, by its frame row number
+  unsigned char* Row(int plane, int row) const {
+    return data[plane] +
+           static_cast<size_t>(row - PlaneBegin(plane)) * stride[plane];
+  }
+};
+
+// Formats ImageStripe can describe
+bool IsStripeFormat(ImageFormat format);
+
+// Bytes of luma rows [rowBegin, rowEnd) of a frame, all planes
+size_t GetStripeSize(ImageFormat format, int width, int rowBegin, int rowEnd);
+
+// Rows of a whole frame laid out in format
+ImageStripe MapFrameStripe(ImageFormat format, int width, int height,
+                           unsigned char* frame, int rowBegin, int rowEnd);
+
+// Rows held in a buffer of GetStripeSize bytes, planes back to back
+ImageStripe MapBufferStripe(ImageFormat format, int width, int height,
+                            unsigned char* buffer, int rowBegin, int rowEnd);
+
+// Copy the rows of dst from src, which must hold them, planes from first on
+void CopyStripe(const ImageStripe& src, ImageStripe& dst, int first = 0);
+
+#endif  // IMAGE_STRIPE_H
@@ -60,4 +60,15 @@ SHARED_LIB_EXPORT int AlgoInterfaceProcess(void **libhandle,
 SHARED_LIB_EXPORT int
 RegisterCallback(void **libhandle,
                  int (*Callback)(std::shared_ptr<AlgoRequest> input));
+
+SHARED_LIB_EXPORT int
+AlgoInterfaceConfigureAssembler(void **libhandle,
+                                FrameAssemblerConfig config);
+
+SHARED_LIB_EXPORT int AlgoInterfaceSubmitFrame(
+    void **libhandle, int streamId, int64_t timestampUs, int groupKey,
+    std::shared_ptr<ImageData> frame, std::vector<AlgoId> algoList,
+    std::shared_ptr<AlgoRequest> settings);
+
+SHARED_LIB_EXPORT int AlgoInterfaceFlushFrames(void **libhandle);
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "AlgoDefs.h"
+#include "AlgoRequest.h"
+
+struct ResultCacheConfig {
+  bool enabled         = false;
+  size_t memoryBudget  = 64 << 20;   // Bytes of pixel data held in memory
+  std::string diskPath = "";         // Spill directory, empty disables disk
+  size_t diskBudget    = 256 << 20;  // Bytes of spilled entries on disk
+};
+
+/**
+ * @brief Outputs of cacheable pipelines keyed by a hash of their input.
+ * Hits hand out images sharing the cached buffers, a node or client that
+ * writes to one gets its own copy. Entries evicted from memory spill to the
+ * disk tier when one is configured and are promoted back on a hit. Files
+ * are read and written outside the lock, lookups never wait on the disk.
+ */
+class ResultCache {
+ public:
+  explicit ResultCache(const ResultCacheConfig& config);
+  ~ResultCache();
+
+  uint64_t GetKey(std::shared_ptr<AlgoRequest> req,
+                  const std::vector<AlgoId>& algoList) const;
+  bool Lookup(uint64_t key, std::shared_ptr<AlgoRequest> req);
+  void Store(uint64_t key, std::shared_ptr<AlgoRequest> output);
+  void Clear();
+
+  const ResultCacheConfig& GetConfig() const;
+  size_t GetMemoryUsage() const;
+  size_t GetDiskUsage() const;
+  size_t GetEntryCount() const;
+  size_t GetHitCount() const;
+  size_t GetMissCount() const;
+
+ private:
+  struct Entry {
+    uint64_t key;
+    std::vector<std::shared_ptr<ImageData>> images;
+    std::string metadata;
+    size_t bytes;
+  };
+  struct DiskEntry {
+    uint64_t key;
+    size_t bytes;
+  };
+
+  std::vector<std::shared_ptr<Entry>> Insert(std::shared_ptr<Entry> entry);
+  void Spill(const std::vector<std::shared_ptr<Entry>>& victims);
+  bool WriteToDisk(const Entry& entry) const;
+  std::shared_ptr<Entry> LoadFromDisk(uint64_t key) const;
+  std::string Unindex(std::list<DiskEntry>::iterator it);
+  static void RemoveFiles(const std::vector<std::string>& files);
+  std::string GetDiskFile(uint64_t key) const;
+
+  ResultCacheConfig mConfig;
+  mutable std::mutex mMutex;
+  // Most recently used first
+  std::list<std::shared_ptr<Entry>> mEntries;
+  std::unordered_map<uint64_t, std::list<std::shared_ptr<Entry>>::iterator>
+      mEntryMap;
+  std::list<DiskEntry> mDiskEntries;
+  std::unordered_map<uint64_t, std::list<DiskEntry>::iterator> mDiskMap;
+  // Keys whose file is being written or read outside the lock
+  std::unordered_set<uint64_t> mDiskBusy;
+  size_t mMemoryUsage = 0;
+  size_t mDiskUsage   = 0;
+  size_t mHits        = 0;
+  size_t mMisses      = 0;
+};
+
+#endif  // RESULT_CACHE_H
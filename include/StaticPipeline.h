@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef STATIC_PIPELINE_H
+#define STATIC_PIPELINE_H
+
+#include <array>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "AlgoBase.h"
+#include "Log.h"
+#include "StripeKernels.h"
+
+/**
+ * @brief Stage of the Filter node: Sobel on luma or RGB, chroma carried over
+ */
+struct FilterStage {
+  static constexpr AlgoId kAlgoId = ALGO_FILTER;
+  static constexpr bool kInPlace  = false;
+
+  int Halo(ImageFormat format) const {
+    return IsStripeFormat(format) ? 1 : -1;
+  }
+  void Run(const ImageStripe& in, ImageStripe& out) const {
+    SobelStripe(in, out);
+  }
+};
+
+/**
+ * @brief Stage of the WaterMark node, blending an overlay rendered for one
+ * frame size. Frames of other sizes pass as they are.
+ */
+struct WaterMarkStage {
+  static constexpr AlgoId kAlgoId = ALGO_WATERMARK;
+  static constexpr bool kInPlace  = true;
+
+  std::shared_ptr<const WaterMarkOverlay> overlay;
+  int frameWidth  = 0;  // Frame size the overlay was rendered for
+  int frameHeight = 0;
+
+  int Halo(ImageFormat format) const {
+    return IsStripeFormat(format) ? 0 : -1;
+  }
+  void Run(const ImageStripe& in, ImageStripe& out) const {
+    (void)in;  // The same stripe as out
+    if (overlay && out.width == frameWidth && out.height == frameHeight) {
+      BlendOverlay(*overlay, out);
+    }
+  }
+};
+
+/**
+ * @brief Node running a chain of stages fixed at compile time, for chains
+ * that never change: StaticPipeline<FilterStage, WaterMarkStage>. Each
+ * stripe of a frame passes through every stage with the stage calls
+ * inlined. A stage writes straight into the output stripe when only in
+ * place stages follow it, otherwise into one of two stripe buffers. The
+ * node runs in an AlgoPipeline like a plugin node and takes part in stripe
+ * groups. A stage provides
+ *   static constexpr AlgoId kAlgoId;  // Node it stands in for
+ *   static constexpr bool kInPlace;   // Rewrites its rows, halo 0
+ *   int Halo(ImageFormat) const;      // Rows read around, -1 if unsupported
+ *   void Run(const ImageStripe& in, ImageStripe& out) const;
+ * where in place stages are given the same stripe as in and out.
+ *
+ * @tparam Stages
+ */
+template <typename... Stages>
+class StaticPipeline : public AlgoBase {
+ public:
+  static constexpr size_t kStageCount = sizeof...(Stages);
+  static_assert(kStageCount > 0, "StaticPipeline needs a stage");
+  typedef std::tuple<Stages...> StageTuple;
+  typedef std::array<int, kStageCount + 1> StripeRows;
+
+  StaticPipeline() : AlgoBase("StaticPipeline") {
+    mAlgoId = std::tuple_element_t<0, StageTuple>::kAlgoId;
+    for (ImageFormat format :
+         {ImageFormat::RGB, ImageFormat::RGBP, ImageFormat::YUV420,
+          ImageFormat::NV12, ImageFormat::NV21}) {
+      if (GetStripeHalo(format) >= 0) {
+        SupportedFormatsMap.push_back({format, format});
+      }
+    }
+  }
+
+  ~StaticPipeline() override { StopAlgoThread(); }
+
+  AlgoStatus Open() override {
+    SetStatus(AlgoStatus::SUCCESS);
+    return GetAlgoStatus();
+  }
+
+  AlgoStatus Close() override {
+    SetStatus(AlgoStatus::SUCCESS);
+    return GetAlgoStatus();
+  }
+
+  int GetTimeout() override { return 1000 * static_cast<int>(kStageCount); }
+
+  std::vector<AlgoId> GetAlgoIds() const override {
+    return {Stages::kAlgoId...};
+  }
+
+  /**
+   * @brief Stage I, to set up while no request is in flight
+   */
+  template <size_t I>
+  std::tuple_element_t<I, StageTuple>& GetStage() {
+    return std::get<I>(mStages);
+  }
+
+  /**
+   * @brief Frame in stripes on the tile executor, one image of even size
+   */
+  AlgoStatus Process(std::shared_ptr<AlgoRequest> req) override {
+    AlgoStatus rc = AlgoStatus::FAILURE;
+    if (req) {
+      // Every row is produced, an incoming mask is of no use
+      req->mDirtyBlocks = nullptr;
+    }
+    if (!ProcessStripes({this}, req, rc)) {
+      LOG(ERROR, ALGOBASE, "StaticPipeline takes one even sized RGB, "
+                           "RGBP or 4:2:0 image");
+      rc = AlgoStatus::FAILURE;
+    }
+    SetStatus(rc);
+    return rc;
+  }
+
+  /**
+   * @brief Rows the chain reads around a row, each stage's halo rounded to
+   * even as the stripe rows of every stage start on an even row
+   */
+  int GetStripeHalo(ImageFormat format) const override {
+    int reach = 0;
+    for (int halo : GetHalos(format)) {
+      if (halo < 0) {
+        return -1;
+      }
+      reach += (halo + 1) & ~1;
+    }
+    return reach;
+  }
+
+  AlgoStatus ProcessStripe(const ImageStripe& in, ImageStripe& out) override {
+    const auto halos = GetHalos(out.format);
+    // Rows of the chain input [0] and of the output of every stage [i + 1]
+    StripeRows begin, end;
+    begin[kStageCount] = out.rowBegin;
+    end[kStageCount]   = out.rowEnd;
+    for (size_t i = kStageCount; i > 0; i--) {
+      begin[i - 1] = std::max(begin[i] - halos[i - 1], 0) & ~1;
+      end[i - 1]   = std::min((end[i] + halos[i - 1] + 1) & ~1, out.height);
+    }
+    std::vector<unsigned char> buffers[2];
+    RunStages<0>(in, -1, out, begin, end, buffers);
+    return AlgoStatus::SUCCESS;
+  }
+
+ private:
+  StageTuple mStages;
+
+  std::array<int, kStageCount> GetHalos(ImageFormat format) const {
+    return std::apply(
+        [format](const Stages&... stage) {
+          return std::array<int, kStageCount>{stage.Halo(format)...};
+        },
+        mStages);
+  }
+
+  // True if every stage from I on works in place
+  template <size_t I>
+  static constexpr bool InPlaceFrom() {
+    if constexpr (I >= kStageCount) {
+      return true;
+    } else {
+      return std::tuple_element_t<I, StageTuple>::kInPlace &&
+             InPlaceFrom<I + 1>();
+    }
+  }
+
+  /**
+   * @brief Run stage I and the ones after it
+   *
+   * @param in stage input
+   * @param slot buffer holding in, -1 for the chain input
+   * @param out chain output
+   * @param begin
+   * @param end
+   * @param buffers
+   */
+  template <size_t I>
+  void RunStages(ImageStripe in, int slot, ImageStripe& out,
+                 const StripeRows& begin, const StripeRows& end,
+                 std::vector<unsigned char> (&buffers)[2]) const {
+    if constexpr (I < kStageCount) {
+      typedef std::tuple_element_t<I, StageTuple> Stage;
+      const Stage& stage = std::get<I>(mStages);
+      if constexpr (InPlaceFrom<I + 1>()) {
+        // The rest of the chain rewrites the output stripe
+        if constexpr (Stage::kInPlace) {
+          if constexpr (I == 0) {
+            CopyStripe(in, out);
+          }
+          stage.Run(out, out);
+        } else {
+          stage.Run(in, out);
+        }
+        RunStages<I + 1>(out, slot, out, begin, end, buffers);
+      } else if (Stage::kInPlace && slot >= 0) {
+        // A buffer of the previous stage, holding exactly these rows
+        stage.Run(in, in);
+        RunStages<I + 1>(in, slot, out, begin, end, buffers);
+      } else {
+        const int next = slot == 0 ? 1 : 0;
+        buffers[next].resize(
+            GetStripeSize(out.format, out.width, begin[I + 1], end[I + 1]));
+        ImageStripe stripe =
+            MapBufferStripe(out.format, out.width, out.height,
+                            buffers[next].data(), begin[I + 1], end[I + 1]);
+        if (Stage::kInPlace) {
+          CopyStripe(in, stripe);
+          stage.Run(stripe, stripe);
+        } else {
+          stage.Run(in, stripe);
+        }
+        RunStages<I + 1>(stripe, next, out, begin, end, buffers);
+      }
+    }
+  }
+};
+
+#endif  // STATIC_PIPELINE_H
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef STRIPE_KERNELS_H
+#define STRIPE_KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "ImageStripe.h"
+#include "PixelKernels.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Row kernels of the Filter and WaterMark nodes, shared with the stages of
+// StaticPipeline so a composed chain produces the same pixels
+
+/**
+ * @brief Sobel gradient magnitude of a sample, clamped to 255
+ */
+struct SobelOp {
+  static constexpr int kRadius = 1;
+
+  template <typename Step>
+  unsigned char operator()(const unsigned char* const* rows, int i,
+                           Step step) const {
+    const unsigned char* top = rows[0];
+    const unsigned char* mid = rows[1];
+    const unsigned char* bot = rows[2];
+    const int gradientX      = (top[i + step] - top[i - step]) +
+                          2 * (mid[i + step] - mid[i - step]) +
+                          (bot[i + step] - bot[i - step]);
+    const int gradientY = (top[i - step] + 2 * top[i] + top[i + step]) -
+                          (bot[i - step] + 2 * bot[i] + bot[i + step]);
+    const int magnitude = static_cast<int>(
+        std::sqrt(gradientX * gradientX + gradientY * gradientY));
+    return static_cast<unsigned char>(std::min(magnitude, 255));
+  }
+};
+
+/**
+ * @brief Sobel gradient magnitude of pixels [x0, x1) of a row of Cn
+ * interleaved channels
+ *
+ * @param rows the row above, the row and the row below
+ * @param dst output row
+ * @param x0
+ * @param x1
+ */
+template <int Cn>
+inline void SobelRow(const unsigned char* const rows[3], unsigned char* dst,
+                     int x0, int x1) {
+  SobelOp op;
+  NeighbourhoodRow<Cn>(op, rows, dst, x0, x1);
+}
+
+/**
+ * @brief Sobel on the rows of a stripe, frame borders are 0 and chroma is
+ * carried over
+ *
+ * @param in holds the rows of out and one more above and below
+ * @param out
+ */
+inline void SobelStripe(const ImageStripe& in, ImageStripe& out) {
+  int colorPlanes = 1;
+  DispatchFormat(out.format, [&](auto layout) {
+    using Layout     = decltype(layout);
+    constexpr int cn = Layout::template Plane<0>::kChannels;
+    const int width  = out.width;
+    colorPlanes      = Layout::kColorPlanes;
+    for (int p = 0; p < Layout::kColorPlanes; p++) {
+      for (int y = out.rowBegin; y < out.rowEnd; ++y) {
+        unsigned char* dst = out.Row(p, y);
+        if (y == 0 || y == out.height - 1) {
+          std::fill(dst, dst + width * cn, 0);
+          continue;
+        }
+        const unsigned char* rows[3] = {in.Row(p, y - 1), in.Row(p, y),
+                                        in.Row(p, y + 1)};
+        std::fill(dst, dst + cn, 0);
+        std::fill(dst + (width - 1) * cn, dst + width * cn, 0);
+        SobelRow<cn>(rows, dst, 1, width - 1);
+      }
+    }
+  });
+  CopyStripe(in, out, colorPlanes);
+}
+
+/**
+ * @brief Logo and text pre-rendered for one frame resolution. Colour planes
+ * are premultiplied by alpha and alpha is stored inverted, so blending a frame
+ * is dst = color + dst * invAlpha / 255 over the ROI only.
+ */
+struct WaterMarkOverlay {
+  int roiX      = 0;  // ROI origin and size in luma pixels, even aligned
+  int roiY      = 0;
+  int roiWidth  = 0;
+  int roiHeight = 0;
+  std::vector<uint8_t> yColor;       // roiWidth x roiHeight
+  std::vector<uint8_t> yInvAlpha;    // roiWidth x roiHeight
+  std::vector<uint8_t> uColor;       // roiWidth/2 x roiHeight/2
+  std::vector<uint8_t> vColor;       // roiWidth/2 x roiHeight/2
+  std::vector<uint8_t> cInvAlpha;    // roiWidth/2 x roiHeight/2
+  std::vector<uint8_t> uvColor;      // NV12 U,V pairs, roiWidth x roiHeight/2
+  std::vector<uint8_t> vuColor;      // NV21 V,U pairs, roiWidth x roiHeight/2
+  std::vector<uint8_t> uvInvAlpha;   // chroma alpha repeated per pair
+  std::vector<uint8_t> rgbColor;     // roiWidth x roiHeight x 3
+  std::vector<uint8_t> rgbInvAlpha;  // alpha repeated per channel
+  std::vector<uint8_t> rgbPlanes;    // R, G, B planes of roiWidth x roiHeight
+
+  // Colour and inverted alpha blended into a plane of format
+  std::pair<const uint8_t*, const uint8_t*> Planes(ImageFormat format,
+                                                   int plane) const {
+    if (format == ImageFormat::RGB) {
+      return {rgbColor.data(), rgbInvAlpha.data()};
+    }
+    if (format == ImageFormat::RGBP) {
+      const size_t size = static_cast<size_t>(roiWidth) * roiHeight;
+      return {rgbPlanes.data() + plane * size, yInvAlpha.data()};
+    }
+    if (plane == 0) {
+      return {yColor.data(), yInvAlpha.data()};
+    }
+    if (format == ImageFormat::YUV420) {
+      return {plane == 1 ? uColor.data() : vColor.data(), cInvAlpha.data()};
+    }
+    return {format == ImageFormat::NV21 ? vuColor.data() : uvColor.data(),
+            uvInvAlpha.data()};
+  }
+};
+
+/**
+ * @brief dst = color + dst * invAlpha / 255, the divide exact
+ */
+struct BlendOp {
+  uint8_t operator()(uint8_t dst, uint8_t color, uint8_t invAlpha) const {
+    int v = dst * invAlpha + 128;
+    v     = ((v + (v >> 8)) >> 8) + color;
+    return static_cast<uint8_t>(v > 255 ? 255 : v);
+  }
+#ifdef __SSE2__
+  int Row(int count, uint8_t* out, const uint8_t* dst, const uint8_t* color,
+          const uint8_t* invAlpha) const {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    int x              = 0;
+    for (; x + 16 <= count; x += 16) {
+      const __m128i d =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + x));
+      const __m128i a =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(invAlpha + x));
+      const __m128i c =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(color + x));
+      __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero),
+                                                 _mm_unpacklo_epi8(a, zero)),
+                                 bias);
+      __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero),
+                                                 _mm_unpackhi_epi8(a, zero)),
+                                 bias);
+      // Exact divide by 255: (v + (v >> 8)) >> 8
+      lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+      hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x),
+                       _mm_adds_epu8(_mm_packus_epi16(lo, hi), c));
+    }
+    return x;
+  }
+#endif
+};
+
+/**
+ * @brief Blend the overlay rows falling in a stripe into it
+ *
+ * @param overlay rendered for the stripe's frame size
+ * @param stripe
+ */
+inline void BlendOverlay(const WaterMarkOverlay& overlay,
+                         const ImageStripe& stripe) {
+  if (!IsStripeFormat(stripe.format)) {
+    return;
+  }
+  DispatchFormat(stripe.format, [&](auto layout) {
+    using Layout = decltype(layout);
+    ForEachPlane<Layout>([&](auto plane) {
+      constexpr int p = decltype(plane)::value;
+      using Plane     = typename Layout::template Plane<p>;
+      // roiX, roiY and roiHeight are even, so they divide into every plane
+      const int x0      = Plane::RowSamples(overlay.roiX);
+      const int count   = Plane::RowSamples(overlay.roiWidth);
+      const int roiY    = Plane::Height(overlay.roiY);
+      const int roiEnd  = Plane::Height(overlay.roiY + overlay.roiHeight);
+      const int yBegin  = std::max(roiY, stripe.PlaneBegin(p));
+      const int yEnd    = std::min(roiEnd, stripe.PlaneEnd(p));
+      const auto planes = overlay.Planes(Layout::kFormat, p);
+      BlendOp op;
+      for (int y = yBegin; y < yEnd; y++) {
+        const size_t offset = static_cast<size_t>(y - roiY) * count;
+        uint8_t* dst        = stripe.Row(p, y) + x0;
+        PointwiseRow(op, count, dst, dst, planes.first + offset,
+                     planes.second + offset);
+      }
+    });
+  });
+}
+
+#endif  // STRIPE_KERNELS_H
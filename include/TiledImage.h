@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef TILED_IMAGE_H
+#define TILED_IMAGE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AlgoRequest.h"
+#include "ImageStripe.h"
+
+/**
+ * @brief An image kept in a file as full width tiles of tileRows luma rows,
+ * each tile holding its rows of every plane back to back. Tiles are mapped
+ * on demand and the least recently used ones are unmapped past the cache
+ * size, so images far larger than memory are processed in bounded memory.
+ */
+class TiledImage {
+ public:
+  // A mapped tile, unmapped once the cache and every user let go of it
+  struct Tile {
+    ImageStripe rows;  // Rows of the tile, in the mapping
+    void* address = nullptr;
+    size_t size   = 0;
+
+    Tile()                       = default;
+    Tile(const Tile&)            = delete;
+    Tile& operator=(const Tile&) = delete;
+    ~Tile();
+  };
+
+  // New file at path, replacing what is there, nullptr on failure
+  static std::shared_ptr<TiledImage> Create(const std::string& path,
+                                            ImageFormat format, int width,
+                                            int height, int tileRows = 64);
+  // File written by Create, nullptr if it is not one
+  static std::shared_ptr<TiledImage> Open(const std::string& path);
+  ~TiledImage();
+
+  ImageFormat GetFormat() const { return mFormat; }
+  int GetWidth() const { return mWidth; }
+  int GetHeight() const { return mHeight; }
+  int GetTileRows() const { return mTileRows; }
+  int GetTileCount() const;
+  // Tiles kept mapped after their users let go of them
+  void SetCacheTiles(size_t tiles);
+  size_t GetCacheTiles() const;
+
+  // Map a tile, nullptr if index is out of range or mapping fails
+  std::shared_ptr<Tile> AcquireTile(int index);
+  // Copy luma rows [rowBegin, rowEnd) into buffer, rows maps them there
+  int ReadRows(int rowBegin, int rowEnd, std::vector<unsigned char>& buffer,
+               ImageStripe& rows);
+  // Copy the rows held by rows into the tiles
+  int WriteRows(const ImageStripe& rows);
+  // Whole image in and out of memory, for images that fit
+  int WriteImage(const ImageData& image);
+  std::shared_ptr<ImageData> ReadImage();
+
+  // Tiles mapped by every TiledImage of the process
+  static int GetMappedTiles();
+
+ private:
+  TiledImage() = default;
+  static std::shared_ptr<TiledImage> Map(const std::string& path, int fd,
+                                         ImageFormat format, int width,
+                                         int height, int tileRows);
+
+  int mFd              = -1;
+  ImageFormat mFormat  = ImageFormat::YUV420;
+  int mWidth           = 0;
+  int mHeight          = 0;
+  int mTileRows        = 0;
+  size_t mTileBytes    = 0;  // Tile slot in the file, page aligned
+  size_t mHeaderBytes  = 0;
+  size_t mCacheTiles   = 4;
+  mutable std::mutex mMutex;
+  // Most recently used first
+  std::list<std::pair<int, std::shared_ptr<Tile>>> mTiles;
+  std::unordered_map<int, std::list<std::pair<int, std::shared_ptr<Tile>>>::
+                              iterator>
+      mTileMap;
+};
+
+#endif  // TILED_IMAGE_H
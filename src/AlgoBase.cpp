@@ -20,7 +20,12 @@
  * THE SOFTWARE.
  */
 #include "AlgoBase.h"
+#include "FormatPlanner.h"
+#include "FrameStats.h"
 #include "Log.h"
+#include "TileExecutor.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 /**
 @brief Thread Function object
@@ -32,7 +37,34 @@ void AlgoBase::ThreadFunction(void *Ctx, std::shared_ptr<Task_t> task) {
   assert(Ctx != nullptr);
   auto pCtx                        = static_cast<AlgoBase *>(Ctx);
   std::shared_ptr<AlgoRequest> req = task->request;
-  AlgoBase::AlgoStatus rc          = pCtx->Process(req);
+  const auto group                 = pCtx->GetStripeGroup();
+  std::vector<AlgoBase *> chain    = {pCtx};
+  for (const auto &member : group) {
+    chain.push_back(member.get());
+  }
+  const int statsBlock = pCtx->GetFrameStatsBlock();
+  if (req && statsBlock > 0 && req->GetImageCount() > 0 && req->GetImage(0)) {
+    // Convert first so the stats describe the frame the node reads, while
+    // it is hot for both. RunProcess then finds nothing left to convert.
+    pCtx->ConvertInputImages(req);
+    FrameStats stats;
+    if (ComputeFrameStats(*req->GetImage(0), statsBlock, stats) == 0) {
+      SetFrameStats(stats, req->mMetadata);
+    }
+  }
+  AlgoBase::AlgoStatus rc = chain.size() > 1 ? pCtx->ProcessChain(chain, req)
+                                             : pCtx->RunProcess(req);
+  if (req) {
+    pCtx->MarkWrittenArea(chain, rc, req);
+  }
+  if (req && (rc != AlgoStatus::SUCCESS || pCtx->EndsPipeline())) {
+    // The request leaves the pipeline here
+    pCtx->ConvertOutputImages(req);
+  }
+  // Nodes before the last one of a group stamped theirs in ProcessChain
+  if (req && rc == AlgoStatus::SUCCESS && chain.back()->bHashOutput) {
+    chain.back()->StampFrameHash(req);
+  }
   pCtx->SetStatus(rc);
 }
 
@@ -51,7 +83,7 @@ void AlgoBase::ThreadCallback(void *Ctx, std::shared_ptr<Task_t> task) {
     AlgoStatus algoStatus = pCtx->GetAlgoStatus();
     try {
       if (task->request) {
-        task->request->mProcessCnt++;
+        task->request->mProcessCnt += pCtx->GetChainLength();
       }
     } catch (const std::exception &e) {
       LOG(ERROR, ALGOBASE, "Exception while accessing mProcessCnt: %s",
@@ -60,7 +92,7 @@ void AlgoBase::ThreadCallback(void *Ctx, std::shared_ptr<Task_t> task) {
     }
     if (pCtx->GetAlgoStatus() == AlgoBase::AlgoStatus::SUCCESS) {
       msgType = AlgoMessageType::ProcessingCompleted;
-      if (pCtx->bIslastNode) {
+      if (pCtx->EndsPipeline()) {
         msgType = AlgoMessageType::ProcessDone;
       }
     } else if (pCtx->GetAlgoStatus() == AlgoBase::AlgoStatus::TIMEOUT) {
@@ -276,4 +308,460 @@ bool AlgoBase::CanProcessFormat(ImageFormat Iformat, ImageFormat Oformat) {
     }
   }
   return false;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Formats the node takes in and the format it produces from each
+ *
+ * @return const std::vector<std::pair<ImageFormat, ImageFormat>>&
+ */
+const std::vector<std::pair<ImageFormat, ImageFormat>>&
+AlgoBase::GetSupportedFormats() const {
+  return SupportedFormatsMap;
+}
+
+/**
+ * @brief Set the conversions run on the request images before Process,
+ * chosen by the pipeline's format plan
+ *
+ * @param conversions incoming format to the format the node is fed
+ */
+void AlgoBase::SetInputConversions(
+    const std::map<ImageFormat, ImageFormat>& conversions) {
+  std::lock_guard<std::mutex> lock(mConversionMutex);
+  mInputConversions = conversions;
+}
+
+/**
+ * @brief Convert the request images the node does not take as they are.
+ * Images that cannot be converted are left for Process to reject.
+ *
+ * @param req
+ */
+void AlgoBase::ConvertInputImages(const std::shared_ptr<AlgoRequest>& req) {
+  std::lock_guard<std::mutex> lock(mConversionMutex);
+  if (mInputConversions.empty()) {
+    return;
+  }
+  std::vector<std::shared_ptr<ImageData>> images;
+  std::vector<size_t> recoloured;
+  bool converted = false;
+  for (size_t i = 0; i < req->GetImageCount(); i++) {
+    auto image = req->GetImage(i);
+    auto it    = image ? mInputConversions.find(image->GetFormat())
+                       : mInputConversions.end();
+    if (it != mInputConversions.end()) {
+      auto output = ConvertImage(*image, it->second);
+      if (output) {
+        if (GetExternalFormat(image->GetFormat()) !=
+            GetExternalFormat(it->second)) {
+          recoloured.push_back(i);  // Lossy, every pixel may change
+        }
+        image     = output;
+        converted = true;
+      } else {
+        LOG(ERROR, ALGOBASE, "%s failed to convert %s to %s",
+            GetAlgorithmName().c_str(), GetFormatName(image->GetFormat()),
+            GetFormatName(it->second));
+      }
+    }
+    images.push_back(image);
+  }
+  if (converted) {
+    req->ClearImages();
+    for (auto& image : images) {
+      req->AddImage(image);
+    }
+    for (size_t index : recoloured) {
+      req->MarkDirty(index);
+    }
+  }
+}
+
+/**
+ * @brief Record on the request what the nodes of a chain wrote. Nodes that
+ * cannot say, and failed runs, leave every image dirty.
+ *
+ * @param chain
+ * @param rc
+ * @param req
+ */
+void AlgoBase::MarkWrittenArea(const std::vector<AlgoBase*>& chain,
+                               AlgoStatus rc,
+                               const std::shared_ptr<AlgoRequest>& req) {
+  auto image = req->GetImageCount() > 0 ? req->GetImage(0) : nullptr;
+  std::vector<DirtyRect> written;
+  bool known = rc == AlgoStatus::SUCCESS && image != nullptr;
+  for (size_t i = 0; known && i < chain.size(); i++) {
+    DirtyRect rect{};
+    known = chain[i]->GetWrittenRect(image->GetFormat(), image->GetWidth(),
+                                     image->GetHeight(), rect);
+    written.push_back(rect);
+  }
+  if (!known) {
+    for (size_t i = 0; i < req->GetImageCount(); i++) {
+      req->MarkDirty(i);
+    }
+    return;
+  }
+  for (const auto& rect : written) {
+    req->MarkDirty(0, rect);
+  }
+}
+
+/**
+ * @brief Drop the state a node keeps for a stream, the next frame of the
+ * stream starts from scratch
+ *
+ * @param streamId
+ */
+void AlgoBase::ResetStreamState(int streamId) {
+  std::lock_guard<std::mutex> lock(mStreamStateMutex);
+  mStreamStates.erase(streamId);
+}
+
+/**
+ * @brief Get the number of streams holding state on this node
+ *
+ * @return size_t
+ */
+size_t AlgoBase::GetStreamCount() const {
+  std::lock_guard<std::mutex> lock(mStreamStateMutex);
+  return mStreamStates.size();
+}
+
+/**
+ * @brief Dirty mask of a request if the history holds the node's output for
+ * the frame the mask was compared against, so clean blocks can be copied
+ *
+ * @param req
+ * @param history
+ * @return std::shared_ptr<DirtyBlockMask> nullptr if every block is needed
+ */
+std::shared_ptr<DirtyBlockMask> AlgoBase::GetReusableBlocks(
+    const std::shared_ptr<AlgoRequest>& req, const BlockHistory& history) {
+  if (!req || !req->mDirtyBlocks || !history.output) {
+    return nullptr;
+  }
+  auto mask  = req->mDirtyBlocks;
+  auto image = req->GetImage(0);
+  if (!image || mask->prevFrame == 0 || mask->prevFrame != history.frame ||
+      image->GetWidth() != mask->width || image->GetHeight() != mask->height ||
+      history.output->GetFormat() != image->GetFormat() ||
+      history.output->GetWidth() != mask->width ||
+      history.output->GetHeight() != mask->height ||
+      history.output->GetDataSize() != image->GetDataSize()) {
+    return nullptr;
+  }
+  return mask;
+}
+
+/**
+ * @brief Keep the first image of a processed request as the stream's last
+ * output, shared with the request until either side writes to it
+ *
+ * @param history
+ * @param req
+ */
+void AlgoBase::UpdateBlockHistory(BlockHistory& history,
+                                  const std::shared_ptr<AlgoRequest>& req) {
+  auto image = req ? req->GetImage(0) : nullptr;
+  if (!image || !req->mDirtyBlocks) {
+    history = BlockHistory();
+    return;
+  }
+  history.output = image->Share();
+  history.frame  = req->mDirtyBlocks->frame;
+}
+
+/**
+ * @brief Set the block edge of the FrameStats taken of each input
+ *
+ * @param blockSize 0 takes none
+ */
+void AlgoBase::SetFrameStatsBlock(int blockSize) {
+  mFrameStatsBlock = blockSize;
+}
+
+/**
+ * @brief Get the block edge of the FrameStats taken of each input
+ *
+ * @return int 0 if none are taken
+ */
+int AlgoBase::GetFrameStatsBlock() const {
+  return mFrameStatsBlock;
+}
+
+/**
+ * @brief Set the nodes following this one that it runs per stripe, an empty
+ * group runs this node alone. Only while no request is in flight.
+ *
+ * @param members
+ * @param stripeRows luma rows each stripe produces, raised to cover halos
+ */
+void AlgoBase::SetStripeGroup(
+    const std::vector<std::shared_ptr<AlgoBase>>& members, int stripeRows) {
+  mStripeGroup.assign(members.begin(), members.end());
+  mStripeRows = stripeRows;
+}
+
+/**
+ * @brief Get the nodes of the stripe group
+ *
+ * @return std::vector<std::shared_ptr<AlgoBase>>
+ */
+std::vector<std::shared_ptr<AlgoBase>> AlgoBase::GetStripeGroup() const {
+  std::vector<std::shared_ptr<AlgoBase>> members;
+  for (const auto& member : mStripeGroup) {
+    if (auto node = member.lock()) {
+      members.push_back(node);
+    }
+  }
+  return members;
+}
+
+/**
+ * @brief Nodes a request passes through on this node's thread
+ *
+ * @return size_t
+ */
+size_t AlgoBase::GetChainLength() const {
+  return 1 + mStripeGroup.size();
+}
+
+/**
+ * @brief Timeout of this node and the stripe group it runs
+ *
+ * @return int
+ */
+int AlgoBase::GetChainTimeout() {
+  int timeout = GetTimeout();
+  for (const auto& member : GetStripeGroup()) {
+    timeout += member->GetTimeout();
+  }
+  return timeout;
+}
+
+/**
+ * @brief True if the request is done once this node and its group are
+ *
+ * @return bool
+ */
+bool AlgoBase::EndsPipeline() const {
+  const auto members = GetStripeGroup();
+  return members.empty() ? bIslastNode : members.back()->bIslastNode;
+}
+
+/**
+ * @brief Convert images left in an internal format back to the format a
+ * pipeline delivers, once the request leaves it
+ *
+ * @param req
+ */
+void AlgoBase::ConvertOutputImages(const std::shared_ptr<AlgoRequest>& req) {
+  std::vector<std::shared_ptr<ImageData>> images;
+  bool converted = false;
+  for (size_t i = 0; i < req->GetImageCount(); i++) {
+    auto image = req->GetImage(i);
+    if (image && GetExternalFormat(image->GetFormat()) != image->GetFormat()) {
+      auto output = ConvertImage(*image, GetExternalFormat(image->GetFormat()));
+      if (output) {
+        image     = output;
+        converted = true;
+      } else {
+        LOG(ERROR, ALGOBASE, "%s failed to convert %s output",
+            GetAlgorithmName().c_str(), GetFormatName(image->GetFormat()));
+      }
+    }
+    images.push_back(image);
+  }
+  if (converted) {
+    req->ClearImages();
+    for (auto& image : images) {
+      req->AddImage(image);
+    }
+  }
+}
+
+/**
+ * @brief True if the node converts images of the format before Process
+ *
+ * @param format
+ * @return bool
+ */
+bool AlgoBase::ConvertsFormat(ImageFormat format) const {
+  std::lock_guard<std::mutex> lock(mConversionMutex);
+  return mInputConversions.find(format) != mInputConversions.end();
+}
+
+/**
+ * @brief Convert the input, run Process and drop a dirty mask the node does
+ * not keep valid
+ *
+ * @param req
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus AlgoBase::RunProcess(
+    const std::shared_ptr<AlgoRequest>& req) {
+  if (req) {
+    ConvertInputImages(req);
+  }
+  AlgoStatus rc = Process(req);
+  if (req && req->mDirtyBlocks && !SupportsDirtyBlocks()) {
+    // The output may differ anywhere, later nodes recompute every block
+    req->mDirtyBlocks = nullptr;
+  }
+  return rc;
+}
+
+/**
+ * @brief Run this node and its stripe group on a request, per stripe when
+ * the request allows it and node by node otherwise
+ *
+ * @param chain this node then the group
+ * @param req
+ * @return AlgoBase::AlgoStatus
+ */
+AlgoBase::AlgoStatus AlgoBase::ProcessChain(
+    const std::vector<AlgoBase*>& chain,
+    const std::shared_ptr<AlgoRequest>& req) {
+  AlgoStatus rc = AlgoStatus::SUCCESS;
+  if (ProcessStripes(chain, req, rc)) {
+    for (auto* node : chain) {
+      node->SetStatus(rc);
+    }
+    return rc;
+  }
+  for (auto* node : chain) {
+    rc = node->RunProcess(req);
+    node->SetStatus(rc);
+    if (rc != AlgoStatus::SUCCESS) {
+      break;
+    }
+    if (node != chain.back() && node->bHashOutput) {
+      node->StampFrameHash(req);
+    }
+  }
+  return rc;
+}
+
+/**
+ * @brief Stamp FRAME_HASH of the images the request holds now
+ *
+ * @param req
+ */
+void AlgoBase::StampFrameHash(const std::shared_ptr<AlgoRequest>& req) const {
+  const uint64_t hash = req->FrameHash();
+  req->mMetadata.SetMetadata(MetaId::FRAME_HASH, static_cast<int64_t>(hash));
+  LOG(VERBOSE, ALGOBASE, "%s output hash %016llx", GetAlgorithmName().c_str(),
+      static_cast<unsigned long long>(hash));
+}
+
+/**
+ * @brief Pass every stripe of the frame through all nodes of the chain
+ * before the next, so the rows stay in cache between nodes. A stripe is
+ * widened by the halo of each node back to the frame, stripes need nothing
+ * from each other and run on the tile executor. The input conversion of
+ * the first node runs on the whole frame up front; dirty masks, conversions
+ * further in, hashes of inner nodes and multi-image requests go node by
+ * node.
+ *
+ * @param chain
+ * @param req
+ * @param rc status of the chain when striped
+ * @return bool false if nothing was done and the chain has to run node by
+ * node
+ */
+bool AlgoBase::ProcessStripes(const std::vector<AlgoBase*>& chain,
+                              const std::shared_ptr<AlgoRequest>& req,
+                              AlgoStatus& rc) {
+  if (!req || req->mDirtyBlocks || req->GetImageCount() != 1 ||
+      !req->GetImage(0)) {
+    return false;
+  }
+  chain.front()->ConvertInputImages(req);
+  std::shared_ptr<const ImageData> image = req->GetImage(0);
+  const ImageFormat format               = image->GetFormat();
+  const int width                        = image->GetWidth();
+  const int height                       = image->GetHeight();
+  if (!IsStripeFormat(format) || width <= 0 || height <= 0 ||
+      ((width | height) & 1) ||
+      image->GetDataSize() < GetStripeSize(format, width, 0, height)) {
+    return false;
+  }
+  std::vector<int> halos;
+  int reach = 0;
+  for (auto* node : chain) {
+    const int halo = node->GetStripeHalo(format);
+    // A node hashing its output needs it whole, not only the last one
+    if (halo < 0 || node->ConvertsFormat(format) ||
+        (node != chain.back() && node->bHashOutput)) {
+      return false;
+    }
+    halos.push_back(halo);
+    reach += halo;
+  }
+  // Keep the rows recomputed for halos small against the rows produced
+  int rows        = std::max(mStripeRows, 4 * reach);
+  rows            = std::min((rows + 1) & ~1, height);
+  const int count = (height + rows - 1) / rows;
+  const size_t n  = chain.size();
+
+  std::vector<unsigned char> output(GetStripeSize(format, width, 0, height));
+  // Only read, the frame stays shared with whoever else holds it
+  auto* frame = const_cast<unsigned char*>(image->GetData().data());
+  std::atomic<int> status{static_cast<int>(AlgoStatus::SUCCESS)};
+  TileExecutor::GetInstance().Run(count, [&](int index) {
+    // Rows of the chain input [0] and of the output of every node [i + 1]
+    std::vector<int> begin(n + 1), end(n + 1);
+    begin[n] = index * rows;
+    end[n]   = std::min(begin[n] + rows, height);
+    for (size_t i = n; i > 0; i--) {
+      begin[i - 1] = std::max(begin[i] - halos[i - 1], 0) & ~1;
+      end[i - 1]   = std::min((end[i] + halos[i - 1] + 1) & ~1, height);
+    }
+    std::vector<unsigned char> buffers[2];
+    ImageStripe in =
+        MapFrameStripe(format, width, height, frame, begin[0], end[0]);
+    for (size_t i = 0; i < n; i++) {
+      ImageStripe out;
+      if (i + 1 == n) {
+        out = MapFrameStripe(format, width, height, output.data(), begin[n],
+                             end[n]);
+      } else {
+        auto& buffer = buffers[i % 2];
+        buffer.resize(GetStripeSize(format, width, begin[i + 1], end[i + 1]));
+        out = MapBufferStripe(format, width, height, buffer.data(),
+                              begin[i + 1], end[i + 1]);
+      }
+      const AlgoStatus result = chain[i]->ProcessStripe(in, out);
+      if (result != AlgoStatus::SUCCESS) {
+        status = static_cast<int>(result);
+        return;
+      }
+      in = out;
+    }
+  });
+  rc = static_cast<AlgoStatus>(status.load());
+  if (rc != AlgoStatus::SUCCESS) {
+    LOG(ERROR, ALGOBASE, "%s stripe group failed: %d",
+        GetAlgorithmName().c_str(), static_cast<int>(rc));
+    return true;
+  }
+  req->ClearImages();
+  if (req->AddImage(format, width, height, std::move(output))) {
+    LOG(ERROR, ALGOBASE, "Error Filling Output data");
+    rc = AlgoStatus::FAILURE;
+    return true;
+  }
+  int reqdone = 0x00;
+  if (0 == req->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone)) {
+    for (auto* node : chain) {
+      for (AlgoId id : node->GetAlgoIds()) {
+        reqdone |= ALGO_MASK(id);
+      }
+    }
+    req->mMetadata.SetMetadata(MetaId::ALGO_PROCESS_DONE, reqdone);
+  }
+  return true;
+}
@@ -94,6 +94,91 @@ bool AlgoInterface::Process(std::shared_ptr<AlgoRequest> request,
   return true;
 }
 
+/**
+ * @brief Replace the frame assembler, frames still pending in the previous
+ * one are flushed first
+ *
+ * @param config
+ * @return int
+ */
+int AlgoInterface::ConfigureAssembler(const FrameAssemblerConfig& config) {
+  auto assembler = std::make_shared<FrameAssembler>(
+      config, AlgoInterface::AssemblerCallbackHandler, this);
+  {
+    std::lock_guard<std::mutex> lock(mAssemblerMutex);
+    mAssembler.swap(assembler);
+  }
+  // Flushed unlocked, its callbacks may submit frames again
+  if (assembler) {
+    assembler->Flush();
+  }
+  return 0;
+}
+
+/**
+ * @brief Get the frame assembler. Callers use it without holding
+ * mAssemblerMutex, so callbacks run from it can come back in.
+ *
+ * @param create make one with the default config if there is none
+ * @return std::shared_ptr<FrameAssembler>
+ */
+std::shared_ptr<FrameAssembler> AlgoInterface::GetAssembler(bool create) {
+  std::lock_guard<std::mutex> lock(mAssemblerMutex);
+  if (!mAssembler && create) {
+    mAssembler = std::make_shared<FrameAssembler>(
+        FrameAssemblerConfig(), AlgoInterface::AssemblerCallbackHandler, this);
+  }
+  return mAssembler;
+}
+
+/**
+ * @brief Queue a single frame, completed sets are processed as one request
+ *
+ * @param streamId
+ * @param timestampUs
+ * @param groupKey
+ * @param frame
+ * @param algoList
+ * @param settings request id and metadata of the assembled request
+ * @return int
+ */
+int AlgoInterface::SubmitFrame(int streamId, int64_t timestampUs,
+                               int groupKey, std::shared_ptr<ImageData> frame,
+                               std::vector<AlgoId> algoList,
+                               std::shared_ptr<AlgoRequest> settings) {
+  return GetAssembler(true)->SubmitFrame(streamId, timestampUs, groupKey,
+                                         std::move(frame), std::move(algoList),
+                                         std::move(settings));
+}
+
+/**
+ * @brief Apply the drop policy to every pending frame
+ *
+ * @return int
+ */
+int AlgoInterface::FlushFrames() {
+  auto assembler = GetAssembler(false);
+  if (assembler) {
+    assembler->Flush();
+  }
+  return 0;
+}
+
+/**
+ * @brief Assembler Callback Handler
+ *
+ * @param pctx
+ * @param request
+ * @param algoList
+ */
+void AlgoInterface::AssemblerCallbackHandler(
+    void* pctx, std::shared_ptr<AlgoRequest> request,
+    std::vector<AlgoId> algoList) {
+  assert(pctx != nullptr);
+  AlgoInterface* algoInterface = static_cast<AlgoInterface*>(pctx);
+  algoInterface->Process(request, algoList);
+}
+
 /**
  * @brief Session Callback Handler
  *
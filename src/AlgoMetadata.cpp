@@ -20,6 +20,9 @@
  * THE SOFTWARE.
  */
 #include "AlgoMetadata.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 /**
  * @brief Construct a new Algo Metadata:: Algo Metadata object
@@ -31,6 +34,8 @@ AlgoMetadata::AlgoMetadata() {
     intMetadata.clear();
     floatMetadata.clear();
     boolMetadata.clear();
+    int64Metadata.clear();
+    listMetadata.clear();
   }
   // default metadata
   SetMetadata(MetaId::ALGO_PROCESS_DONE, 0x00);
@@ -79,6 +84,8 @@ AlgoMetadata::~AlgoMetadata() {
     intMetadata.clear();
     floatMetadata.clear();
     boolMetadata.clear();
+    int64Metadata.clear();
+    listMetadata.clear();
   }
 }
 
@@ -133,6 +140,23 @@ int AlgoMetadata::GetMetadata(MetaId id, bool& value) {
   return -1;  // Metadata not found
 }
 
+/**
+ * @brief Get the Metadata object
+ *
+ * @param id
+ * @param value
+ * @return int
+ */
+int AlgoMetadata::GetMetadata(MetaId id, int64_t& value) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = int64Metadata.find(id);
+  if (it != int64Metadata.end()) {
+    value = it->second;
+    return 0;  // Success
+  }
+  return -1;  // Metadata not found
+}
+
 /**
  * @brief Set the Metadata object
  *
@@ -170,4 +194,209 @@ int AlgoMetadata::SetMetadata(MetaId id, bool value) {
   std::lock_guard<std::mutex> lock(mMutex);
   boolMetadata[id] = value;
   return 0;  // Success
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Set the Metadata object
+ *
+ * @param id
+ * @param value
+ * @return int
+ */
+int AlgoMetadata::SetMetadata(MetaId id, int64_t value) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  int64Metadata[id] = value;
+  return 0;  // Success
+}
+/**
+ * @brief Get the Metadata object
+ *
+ * @param id
+ * @param value
+ * @return int
+ */
+int AlgoMetadata::GetMetadata(MetaId id, std::vector<int32_t>& value) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = listMetadata.find(id);
+  if (it != listMetadata.end()) {
+    value = it->second;
+    return 0;  // Success
+  }
+  return -1;  // Metadata not found
+}
+
+/**
+ * @brief Set the Metadata object
+ *
+ * @param id
+ * @param value
+ * @return int
+ */
+int AlgoMetadata::SetMetadata(MetaId id, std::vector<int32_t> value) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  listMetadata[id] = std::move(value);
+  return 0;  // Success
+}
+
+/**
+ * @brief Append the entries of one map, sorted by id
+ *
+ * @tparam T
+ * @param map
+ * @param skip
+ * @param blob
+ */
+template <typename T>
+static void SerializeMap(const std::unordered_map<MetaId, T>& map,
+                         const std::vector<MetaId>& skip, std::string& blob) {
+  std::vector<std::pair<int32_t, T>> entries;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    if (std::find(skip.begin(), skip.end(), it->first) == skip.end()) {
+      entries.emplace_back(static_cast<int32_t>(it->first), it->second);
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const std::pair<int32_t, T>& a, const std::pair<int32_t, T>& b) {
+              return a.first < b.first;
+            });
+  const uint32_t count = static_cast<uint32_t>(entries.size());
+  blob.append(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    blob.append(reinterpret_cast<const char*>(&it->first), sizeof(it->first));
+    blob.append(reinterpret_cast<const char*>(&it->second),
+                sizeof(it->second));
+  }
+}
+
+/**
+ * @brief Read the entries of one map written by SerializeMap
+ *
+ * @tparam T
+ * @param blob
+ * @param offset advanced past the entries
+ * @param map
+ * @return int
+ */
+template <typename T>
+static int DeserializeMap(const std::string& blob, size_t& offset,
+                          std::unordered_map<MetaId, T>& map) {
+  uint32_t count = 0;
+  if (offset + sizeof(count) > blob.size()) {
+    return -1;
+  }
+  std::memcpy(&count, blob.data() + offset, sizeof(count));
+  offset += sizeof(count);
+  const size_t entrySize = sizeof(int32_t) + sizeof(T);
+  if (count > (blob.size() - offset) / entrySize) {
+    return -1;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    int32_t id;
+    T value;
+    std::memcpy(&id, blob.data() + offset, sizeof(id));
+    std::memcpy(&value, blob.data() + offset + sizeof(id), sizeof(value));
+    map[static_cast<MetaId>(id)] = value;
+    offset += entrySize;
+  }
+  return 0;
+}
+
+/**
+ * @brief Append the list entries, each a length followed by its values
+ *
+ * @param map
+ * @param skip
+ * @param blob
+ */
+static void SerializeLists(
+    const std::unordered_map<MetaId, std::vector<int32_t>>& map,
+    const std::vector<MetaId>& skip, std::string& blob) {
+  std::unordered_map<MetaId, int32_t> lengths;
+  for (const auto& entry : map) {
+    lengths[entry.first] = static_cast<int32_t>(entry.second.size());
+  }
+  const size_t start = blob.size();
+  SerializeMap(lengths, skip, blob);
+  uint32_t count = 0;
+  std::memcpy(&count, blob.data() + start, sizeof(count));
+  for (uint32_t i = 0; i < count; i++) {
+    int32_t id;
+    const size_t entry = start + sizeof(count) + i * 2 * sizeof(int32_t);
+    std::memcpy(&id, blob.data() + entry, sizeof(id));
+    const auto& value = map.at(static_cast<MetaId>(id));
+    blob.append(reinterpret_cast<const char*>(value.data()),
+                value.size() * sizeof(int32_t));
+  }
+}
+
+/**
+ * @brief Read the list entries written by SerializeLists
+ *
+ * @param blob
+ * @param offset advanced past the entries
+ * @param map
+ * @return int
+ */
+static int DeserializeLists(
+    const std::string& blob, size_t& offset,
+    std::unordered_map<MetaId, std::vector<int32_t>>& map) {
+  std::unordered_map<MetaId, int32_t> lengths;
+  const size_t start = offset;
+  if (DeserializeMap(blob, offset, lengths)) {
+    return -1;
+  }
+  uint32_t count = 0;
+  std::memcpy(&count, blob.data() + start, sizeof(count));
+  for (uint32_t i = 0; i < count; i++) {
+    int32_t id;
+    int32_t length;
+    const size_t entry = start + sizeof(count) + i * 2 * sizeof(int32_t);
+    std::memcpy(&id, blob.data() + entry, sizeof(id));
+    std::memcpy(&length, blob.data() + entry + sizeof(id), sizeof(length));
+    const size_t room = (blob.size() - offset) / sizeof(int32_t);
+    if (length < 0 || static_cast<size_t>(length) > room) {
+      return -1;
+    }
+    std::vector<int32_t> value(length);
+    std::memcpy(value.data(), blob.data() + offset, length * sizeof(int32_t));
+    map[static_cast<MetaId>(id)] = std::move(value);
+    offset += length * sizeof(int32_t);
+  }
+  return 0;
+}
+
+/**
+ * @brief Serialize the metadata
+ *
+ * @param skip ids left out
+ * @return std::string
+ */
+std::string AlgoMetadata::Serialize(const std::vector<MetaId>& skip) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  std::string blob;
+  SerializeMap(intMetadata, skip, blob);
+  SerializeMap(floatMetadata, skip, blob);
+  SerializeMap(boolMetadata, skip, blob);
+  SerializeMap(int64Metadata, skip, blob);
+  SerializeLists(listMetadata, skip, blob);
+  return blob;
+}
+
+/**
+ * @brief Deserialize metadata written by Serialize
+ *
+ * @param blob
+ * @return int
+ */
+int AlgoMetadata::Deserialize(const std::string& blob) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  size_t offset = 0;
+  if (DeserializeMap(blob, offset, intMetadata) ||
+      DeserializeMap(blob, offset, floatMetadata) ||
+      DeserializeMap(blob, offset, boolMetadata) ||
+      DeserializeMap(blob, offset, int64Metadata) ||
+      DeserializeLists(blob, offset, listMetadata)) {
+    return -1;
+  }
+  return 0;
+}
@@ -21,7 +21,10 @@
  */
 #include "AlgoPipeline.h"
 #include <assert.h>
+#include <algorithm>
+#include "ConfigParser.h"
 #include "Log.h"
+#include "TileExecutor.h"
 /**
 @brief Constructs a new AlgoPipeline object with a list of algorithm IDs
  *
@@ -36,6 +39,60 @@ AlgoPipeline::AlgoPipeline(SESSIONCALLBACK pSesionCallBackHandler, void* pCtx) {
   pEventHandlerThread =
       std::make_shared<EventHandlerThread<AlgoBase::AlgoCallbackMessage>>(
           AlgoPipeline::NodeEventHandler, this);
+
+  ConfigParser parser;
+  ChangeDetectorConfig config;
+  parser.loadFile(CONFIGPATH + "ChangeDetector.config");
+  if (parser.getErrorCode() == 0) {
+    if (!parser.getValue("Enabled").empty()) {
+      config.enabled = parser.getIntValue("Enabled") != 0;
+    }
+    if (!parser.getValue("BlockSize").empty()) {
+      config.blockSize = parser.getIntValue("BlockSize");
+    }
+    if (!parser.getValue("Threshold").empty()) {
+      config.threshold = parser.getIntValue("Threshold");
+    }
+  }
+  ConfigureChangeDetector(config);
+
+  ConfigParser hashParser;
+  hashParser.loadFile(CONFIGPATH + "FrameHash.config");
+  if (hashParser.getErrorCode() == 0 &&
+      !hashParser.getValue("Mode").empty()) {
+    const int mode = hashParser.getIntValue("Mode");
+    if (mode >= static_cast<int>(FrameHashMode::Off) &&
+        mode <= static_cast<int>(FrameHashMode::EveryNode)) {
+      SetFrameHashMode(static_cast<FrameHashMode>(mode));
+    }
+  }
+
+  ConfigParser statsParser;
+  FrameStatsConfig statsConfig;
+  statsParser.loadFile(CONFIGPATH + "FrameStats.config");
+  if (statsParser.getErrorCode() == 0) {
+    if (!statsParser.getValue("Enabled").empty()) {
+      statsConfig.enabled = statsParser.getIntValue("Enabled") != 0;
+    }
+    if (!statsParser.getValue("BlockSize").empty()) {
+      statsConfig.blockSize = statsParser.getIntValue("BlockSize");
+    }
+  }
+  ConfigureFrameStats(statsConfig);
+
+  ConfigParser stripeParser;
+  stripeParser.loadFile(CONFIGPATH + "StripeStreaming.config");
+  if (stripeParser.getErrorCode() == 0) {
+    bool enabled   = bStripeStreaming;
+    int stripeRows = mStripeRows;
+    if (!stripeParser.getValue("Enabled").empty()) {
+      enabled = stripeParser.getIntValue("Enabled") != 0;
+    }
+    if (!stripeParser.getValue("StripeRows").empty()) {
+      stripeRows = stripeParser.getIntValue("StripeRows");
+    }
+    SetStripeStreaming(enabled, stripeRows);
+  }
   LOG(INFO, ALGOPIPELINE, "AlgoPipeline::AlgoPipeline X");
 }
 
@@ -84,6 +141,314 @@ std::vector<AlgoId> AlgoPipeline::GetAlgoListId() const {
   return mAlgoListId;
 }
 
+/**
+ * @brief Whether results of the pipeline can be reused for equal inputs
+ *
+ * @return true if every node is cacheable
+ */
+bool AlgoPipeline::IsCacheable() const {
+  if (mAlgos.empty()) {
+    return false;
+  }
+  for (const auto& algo : mAlgos) {
+    if (!algo->IsCacheable()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Replace the change detector, a disabled config removes it
+ *
+ * @param config
+ * @return int
+ */
+int AlgoPipeline::ConfigureChangeDetector(const ChangeDetectorConfig& config) {
+  std::lock_guard<std::mutex> lock(mChangeDetectorMutex);
+  if (config.enabled) {
+    mChangeDetector = std::make_shared<ChangeDetector>(config);
+  } else {
+    mChangeDetector = nullptr;
+  }
+  return 0;
+}
+
+/**
+ * @brief Get the change detector
+ *
+ * @return std::shared_ptr<ChangeDetector> nullptr when disabled
+ */
+std::shared_ptr<ChangeDetector> AlgoPipeline::GetChangeDetector() const {
+  std::lock_guard<std::mutex> lock(mChangeDetectorMutex);
+  return mChangeDetector;
+}
+
+/**
+ * @brief Select the nodes that stamp FRAME_HASH on their output
+ *
+ * @param mode
+ */
+void AlgoPipeline::SetFrameHashMode(FrameHashMode mode) {
+  mFrameHashMode = mode;
+  for (auto& algo : mAlgos) {
+    algo->bHashOutput = mode == FrameHashMode::EveryNode ||
+                        (mode == FrameHashMode::Output && algo->bIslastNode);
+  }
+}
+
+/**
+ * @brief Get the Frame Hash Mode object
+ *
+ * @return FrameHashMode
+ */
+FrameHashMode AlgoPipeline::GetFrameHashMode() const {
+  return mFrameHashMode;
+}
+
+/**
+ * @brief Replace the statistics config, the first node takes the stats of
+ * every input just before it processes it
+ *
+ * @param config
+ * @return int -1 for a block size below 1
+ */
+int AlgoPipeline::ConfigureFrameStats(const FrameStatsConfig& config) {
+  if (config.blockSize < 1) {
+    LOG(ERROR, ALGOPIPELINE, "Invalid FrameStats block size %d",
+        config.blockSize);
+    return -1;
+  }
+  std::lock_guard<std::mutex> lock(mFrameStatsMutex);
+  mFrameStatsConfig = config;
+  for (size_t i = 0; i < mAlgos.size(); i++) {
+    mAlgos[i]->SetFrameStatsBlock((i == 0 && config.enabled) ? config.blockSize
+                                                             : 0);
+  }
+  return 0;
+}
+
+/**
+ * @brief Get the statistics config
+ *
+ * @return FrameStatsConfig
+ */
+FrameStatsConfig AlgoPipeline::GetFrameStatsConfig() const {
+  std::lock_guard<std::mutex> lock(mFrameStatsMutex);
+  return mFrameStatsConfig;
+}
+
+/**
+ * @brief Format plan of the configured nodes
+ *
+ * @return const FormatPlanner&
+ */
+const FormatPlanner& AlgoPipeline::GetFormatPlan() const {
+  return mFormatPlanner;
+}
+
+/**
+ * @brief Enable or disable stripe streaming, regrouping configured nodes
+ *
+ * @param enabled
+ * @param stripeRows luma rows a stripe produces, raised to cover the halos
+ */
+void AlgoPipeline::SetStripeStreaming(bool enabled, int stripeRows) {
+  bStripeStreaming = enabled;
+  mStripeRows      = std::max(stripeRows, 2);
+  if (!mAlgos.empty()) {
+    PlanStripes();
+  }
+}
+
+/**
+ * @brief Whether consecutive stripe capable nodes run per stripe
+ *
+ * @return bool
+ */
+bool AlgoPipeline::IsStripeStreaming() const {
+  return bStripeStreaming;
+}
+
+/**
+ * @brief Stream a tiled image through the nodes a tile at a time. Each
+ * output tile reads its rows of the input widened by the halo of every node,
+ * runs the nodes back to back on them and writes the last node's rows
+ * straight into the mapped output tile, so memory stays a few tiles however
+ * large the image is. Requests queued on the nodes are not touched.
+ *
+ * @param input
+ * @param output same format and size as input
+ * @return int 0 on success, -1 if a node cannot run on tiles or one fails
+ */
+int AlgoPipeline::ProcessTiled(TiledImage& input, TiledImage& output) {
+  const ImageFormat format = input.GetFormat();
+  const int width          = input.GetWidth();
+  const int height         = input.GetHeight();
+  if (mAlgos.empty() || output.GetFormat() != format ||
+      output.GetWidth() != width || output.GetHeight() != height) {
+    LOG(ERROR, ALGOPIPELINE, "Tiled output does not match the input");
+    return -1;
+  }
+  std::vector<int> halos;
+  for (const auto& algo : mAlgos) {
+    const int halo = algo->GetStripeHalo(format);
+    if (halo < 0 || !algo->CanProcessFormat(format, format)) {
+      LOG(ERROR, ALGOPIPELINE, "%s cannot run on %s tiles",
+          algo->GetAlgorithmName().c_str(), GetFormatName(format));
+      return -1;
+    }
+    halos.push_back(halo);
+  }
+  const size_t n = mAlgos.size();
+  std::atomic<int> status{0};
+  TileExecutor::GetInstance().Run(output.GetTileCount(), [&](int index) {
+    auto tile = output.AcquireTile(index);
+    if (!tile) {
+      status = -1;
+      return;
+    }
+    // Rows of the chain input [0] and of the output of every node [i + 1]
+    std::vector<int> begin(n + 1), end(n + 1);
+    begin[n] = tile->rows.rowBegin;
+    end[n]   = tile->rows.rowEnd;
+    for (size_t i = n; i > 0; i--) {
+      begin[i - 1] = std::max(begin[i] - halos[i - 1], 0) & ~1;
+      end[i - 1]   = std::min((end[i] + halos[i - 1] + 1) & ~1, height);
+    }
+    std::vector<unsigned char> buffers[3];
+    ImageStripe in;
+    if (input.ReadRows(begin[0], end[0], buffers[2], in)) {
+      status = -1;
+      return;
+    }
+    for (size_t i = 0; i < n; i++) {
+      ImageStripe out = tile->rows;
+      if (i + 1 < n) {
+        auto& buffer = buffers[i % 2];
+        buffer.resize(GetStripeSize(format, width, begin[i + 1], end[i + 1]));
+        out = MapBufferStripe(format, width, height, buffer.data(),
+                              begin[i + 1], end[i + 1]);
+      }
+      if (mAlgos[i]->ProcessStripe(in, out) != AlgoBase::AlgoStatus::SUCCESS) {
+        status = -1;
+        return;
+      }
+      in = out;
+    }
+  });
+  if (status != 0) {
+    LOG(ERROR, ALGOPIPELINE, "Tiled processing failed");
+  }
+  return status;
+}
+
+/**
+ * @brief Number of node groups run per stripe
+ *
+ * @return size_t
+ */
+size_t AlgoPipeline::GetStripeGroupCount() const {
+  return mStripeGroups;
+}
+
+/**
+ * @brief True if the node can run on stripes of a format it takes
+ *
+ * @param algo
+ * @return bool
+ */
+static bool IsStripeNode(const std::shared_ptr<AlgoBase>& algo) {
+  for (const auto& [input, output] : algo->GetSupportedFormats()) {
+    if (input == output && algo->GetStripeHalo(input) >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Hand each run of consecutive stripe capable nodes to its first
+ * node, which runs the run per stripe and passes the request on past it
+ *
+ */
+void AlgoPipeline::PlanStripes() {
+  mStripeGroups = 0;
+  for (size_t i = 0; i < mAlgos.size(); i++) {
+    mAlgos[i]->SetStripeGroup({}, mStripeRows);
+    mAlgos[i]->SetNextAlgo(i + 1 < mAlgos.size() ? mAlgos[i + 1]
+                                                 : std::weak_ptr<AlgoBase>());
+  }
+  if (!bStripeStreaming) {
+    return;
+  }
+  size_t first = 0;
+  while (first < mAlgos.size()) {
+    size_t last = first + 1;
+    if (IsStripeNode(mAlgos[first])) {
+      while (last < mAlgos.size() && IsStripeNode(mAlgos[last])) {
+        last++;
+      }
+    }
+    if (last - first > 1) {
+      std::vector<std::shared_ptr<AlgoBase>> members(
+          mAlgos.begin() + first + 1, mAlgos.begin() + last);
+      mAlgos[first]->SetStripeGroup(members, mStripeRows);
+      mAlgos[first]->SetNextAlgo(last < mAlgos.size()
+                                     ? mAlgos[last]
+                                     : std::weak_ptr<AlgoBase>());
+      mStripeGroups++;
+    }
+    first = last;
+  }
+}
+
+/**
+ * @brief Plan the cheapest format path through the nodes and hand every
+ * node the conversions it has to run on its input
+ *
+ */
+void AlgoPipeline::PlanFormats() {
+  std::vector<FormatMap> nodes;
+  for (auto& algo : mAlgos) {
+    nodes.push_back(algo->GetSupportedFormats());
+  }
+  mFormatPlanner.Plan(nodes);
+  for (size_t i = 0; i < mAlgos.size(); i++) {
+    auto conversions = mFormatPlanner.GetConversions(i);
+    for (const auto& [from, to] : conversions) {
+      LOG(VERBOSE, ALGOPIPELINE, "%s converts %s input to %s",
+          mAlgos[i]->GetAlgorithmName().c_str(), GetFormatName(from),
+          GetFormatName(to));
+    }
+    mAlgos[i]->SetInputConversions(conversions);
+  }
+}
+
+/**
+ * @brief Chain the nodes in mAlgos, mark the last one and plan hashing,
+ * stats, formats and stripes for them. Shared by every way of configuring.
+ *
+ * @param configured state the pipeline ends up in
+ */
+void AlgoPipeline::LinkAlgos(AlgoPipelineState configured) {
+  std::shared_ptr<AlgoBase> previousAlgo = nullptr;
+  for (auto& algo : mAlgos) {
+    algo->SetEventThread(pEventHandlerThread);
+    if (previousAlgo) {
+      previousAlgo->SetNextAlgo(algo);
+    }
+    previousAlgo                = algo;
+    mAlgoMap[algo->GetAlgoId()] = algo;
+  }
+  previousAlgo->bIslastNode = true;  // lets mark last  node
+  SetFrameHashMode(GetFrameHashMode());
+  ConfigureFrameStats(GetFrameStatsConfig());
+  PlanFormats();
+  PlanStripes();
+  SetState(configured);
+}
+
 /**
  * @brief  Configure Pipeline with Provided algo List
  *
@@ -105,23 +470,15 @@ AlgoPipelineState AlgoPipeline::ConfigureAlgoPipeline(
     mAlgoNodeMgr     = &AlgoNodeManager::Getinstance();
     assert(mAlgoNodeMgr != nullptr);
 
-    std::shared_ptr<AlgoBase> previousAlgo = nullptr;
     for (auto algoId : mAlgoListId) {
       auto algo = mAlgoNodeMgr->CreateAlgo(algoId);
       if (algo == nullptr) {
         return SetState(AlgoPipelineState::FailedToConfigure);
       }
-      algo->SetEventThread(pEventHandlerThread);
       mAlgos.push_back(algo);
       mAlgoListName.push_back(std::string(algo->GetAlgorithmName()));
-      if (previousAlgo) {
-        previousAlgo->SetNextAlgo(algo);
-      }
-      previousAlgo     = algo;
-      mAlgoMap[algoId] = algo;
     }
-    previousAlgo->bIslastNode = true;  // lets mark last  node
-    SetState(AlgoPipelineState::ConfiguredWithId);
+    LinkAlgos(AlgoPipelineState::ConfiguredWithId);
   } else {
     LOG(ERROR, ALGOPIPELINE,
         "AlgoPipeline is not Currect State to Configure ::%d", (int)GetState());
@@ -151,23 +508,53 @@ AlgoPipelineState AlgoPipeline::ConfigureAlgoPipeline(
     mAlgoNodeMgr     = &AlgoNodeManager::Getinstance();
     assert(mAlgoNodeMgr != nullptr);
 
-    std::shared_ptr<AlgoBase> previousAlgo = nullptr;
     for (auto algoName : mAlgoListName) {
       auto algo = mAlgoNodeMgr->CreateAlgo(algoName);
       if (algo == nullptr) {
         return SetState(AlgoPipelineState::FailedToConfigure);
       }
-      algo->SetEventThread(pEventHandlerThread);
       mAlgos.push_back(algo);
       mAlgoListId.push_back(algo->GetAlgoId());
-      if (previousAlgo) {
-        previousAlgo->SetNextAlgo(algo);
+    }
+    LinkAlgos(AlgoPipelineState::ConfiguredWithName);
+  } else {
+    LOG(ERROR, ALGOPIPELINE, "AlgoPipeline is not Currect State to Configure");
+  }
+  LOG(VERBOSE, ALGOPIPELINE, "AlgoPipeline::ConfigureAlgoPipeline X");
+  return GetState();
+}
+
+/**
+ * @brief Configure Pipeline with nodes built by the caller, such as a
+ * StaticPipeline, instead of loading them
+ *
+ * @param nodes
+ * @return AlgoPipelineState
+ */
+AlgoPipelineState AlgoPipeline::ConfigureAlgoPipeline(
+    std::vector<std::shared_ptr<AlgoBase>>& nodes) {
+
+  LOG(VERBOSE, ALGOPIPELINE, "Configuring AlgoPipeline :: %ld ",
+      nodes.size());
+  if (GetState() == AlgoPipelineState::Initialised) {
+    if (nodes.size() == 0) {
+      LOG(ERROR, ALGOPIPELINE, "AlgoList is empty");
+      return SetState(AlgoPipelineState::FailedToConfigure);
+    }
+    mProcessedFrames = 0;
+
+    for (auto algo : nodes) {
+      if (algo == nullptr) {
+        return SetState(AlgoPipelineState::FailedToConfigure);
+      }
+      mAlgos.push_back(algo);
+      mAlgoListName.push_back(algo->GetAlgorithmName());
+      // A composed node stands in for every algorithm it runs
+      for (AlgoId id : algo->GetAlgoIds()) {
+        mAlgoListId.push_back(id);
       }
-      previousAlgo                = algo;
-      mAlgoMap[algo->GetAlgoId()] = algo;
     }
-    previousAlgo->bIslastNode = true;  // lets mark last  node
-    SetState(AlgoPipelineState::ConfiguredWithName);
+    LinkAlgos(AlgoPipelineState::ConfiguredWithId);
   } else {
     LOG(ERROR, ALGOPIPELINE, "AlgoPipeline is not Currect State to Configure");
   }
@@ -201,7 +588,23 @@ void AlgoPipeline::Process(std::shared_ptr<AlgoRequest> input) {
             input->mRequestId, (void*)input.get());
       }
     }
-    task->timeoutMs = mAlgos[0]->GetTimeout();
+    // A mask only helps if the first node can use it
+    auto detector = GetChangeDetector();
+    if (detector && mAlgos[0]->SupportsDirtyBlocks()) {
+      detector->Detect(input);
+    } else {
+      input->mDirtyBlocks = nullptr;
+    }
+    // Nodes mark what they write from here on
+    input->ResetDirtyRegions();
+    if (GetFrameHashMode() != FrameHashMode::Off) {
+      input->mMetadata.SetMetadata(MetaId::FRAME_HASH_INPUT,
+                                   static_cast<int64_t>(input->FrameHash()));
+    }
+    if (input->GetImageCount() > 0 && input->GetImage(0)) {
+      mInputFormat = input->GetImage(0)->GetFormat();
+    }
+    task->timeoutMs = mAlgos[0]->GetChainTimeout();
     mAlgos[0]->EnqueueRequest(task);
     LOG(INFO, ALGOPIPELINE, "Request Enqueded on ::%s",
         mAlgos[0]->GetAlgorithmName().c_str());
@@ -240,7 +643,7 @@ void AlgoPipeline::NodeEventHandler(
       std::shared_ptr<AlgoBase> NextAlgo = algo->GetNextAlgo().lock();
       if (NextAlgo) {
         /**fecth and update timeout for processing this request on Next algo */
-        msg->mRequest->timeoutMs = NextAlgo->GetTimeout();
+        msg->mRequest->timeoutMs = NextAlgo->GetChainTimeout();
         NextAlgo->EnqueueRequest(msg->mRequest);
       }
     } break;
@@ -362,6 +765,42 @@ void AlgoPipeline::Dump() {
     LOG(VERBOSE, ALGOPIPELINE, "Algo State: %s",
         algo->GetStatusString().c_str());
   }
+  const ImageFormat input = mInputFormat;
+  LOG(VERBOSE, ALGOPIPELINE, "Format Plan for %s, Cost: %.2f",
+      GetFormatName(input), mFormatPlanner.GetCost(input));
+  const auto steps = mFormatPlanner.Trace(input);
+  for (size_t i = 0; i < steps.size() && i < mAlgos.size(); i++) {
+    const auto& step       = steps[i];
+    const std::string name = mAlgos[i]->GetAlgorithmName();
+    if (!step.supported) {
+      LOG(VERBOSE, ALGOPIPELINE, "  %s: %s unsupported, passed as is",
+          name.c_str(), GetFormatName(step.in));
+    } else if (step.fed != step.in) {
+      LOG(VERBOSE, ALGOPIPELINE, "  %s: convert %s to %s, outputs %s",
+          name.c_str(), GetFormatName(step.in), GetFormatName(step.fed),
+          GetFormatName(step.out));
+    } else {
+      LOG(VERBOSE, ALGOPIPELINE, "  %s: %s, outputs %s", name.c_str(),
+          GetFormatName(step.in), GetFormatName(step.out));
+    }
+  }
+  const ImageFormat output = steps.empty() ? input : steps.back().out;
+  if (GetExternalFormat(output) != output) {
+    LOG(VERBOSE, ALGOPIPELINE, "  output: convert %s to %s",
+        GetFormatName(output), GetFormatName(GetExternalFormat(output)));
+  }
+  for (auto algo : mAlgos) {
+    const auto members = algo->GetStripeGroup();
+    if (members.empty()) {
+      continue;
+    }
+    std::string group = algo->GetAlgorithmName();
+    for (const auto& member : members) {
+      group += " + " + member->GetAlgorithmName();
+    }
+    LOG(VERBOSE, ALGOPIPELINE, "Stripe Group: %s, %d rows", group.c_str(),
+        mStripeRows);
+  }
   LOG(VERBOSE, ALGOPIPELINE, "Processed Frames: %ld", mProcessedFrames);
   LOG(VERBOSE, ALGOPIPELINE, "--------Pipeline State: %d--------",
       (int)GetState());
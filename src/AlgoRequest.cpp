@@ -20,8 +20,12 @@
  * THE SOFTWARE.
  */
 #include "AlgoRequest.h"
+#include <algorithm>
+#include "Hash.h"
 #include "Log.h"
 
+#define DIRTY_RECT_LIMIT 8  // Rects a region keeps before merging them
+
 /**
  * @brief Get the Size By Format object
  *
@@ -36,6 +40,8 @@ static size_t GetSizeByFormat(ImageFormat format, int width, int height) {
   }
   switch (format) {
     case ImageFormat::YUV420:
+    case ImageFormat::NV12:
+    case ImageFormat::NV21:
       return width * height * 3 / 2;
       break;
     case ImageFormat::YUV422:
@@ -45,6 +51,7 @@ static size_t GetSizeByFormat(ImageFormat format, int width, int height) {
       return width * height * 3;
       break;
     case ImageFormat::RGB:
+    case ImageFormat::RGBP:
       return width * height * 3;
       break;
     case ImageFormat::GRAYSCALE:
@@ -108,6 +115,28 @@ int AlgoRequest::AddImage(ImageFormat format, int width, int height) {
   return 0;
 }
 
+/**
+ * @brief Add an existing image to the collection
+ *
+ * @param image
+ * @return int
+ */
+int AlgoRequest::AddImage(std::shared_ptr<ImageData> image) {
+  if (!image || (image->GetWidth() <= 0) || (image->GetHeight() <= 0) ||
+      (image->GetDataSize() == 0)) {
+    return -1;
+  }
+  if (image->GetFormat() != ImageFormat::JPEG) {
+    if (image->GetDataSize() != GetSizeByFormat(image->GetFormat(),
+                                                 image->GetWidth(),
+                                                 image->GetHeight())) {
+      return -2;
+    }
+  }
+  images.push_back(std::move(image));
+  return 0;
+}
+
 /**
  * @brief Get the total number of images
  *
@@ -141,7 +170,9 @@ std::vector<std::shared_ptr<ImageData>> AlgoRequest::GetYUVImages() const {
   for (const auto& image : images) {
     if (image->GetFormat() == ImageFormat::YUV420 ||
         image->GetFormat() == ImageFormat::YUV422 ||
-        image->GetFormat() == ImageFormat::YUV444) {
+        image->GetFormat() == ImageFormat::YUV444 ||
+        image->GetFormat() == ImageFormat::NV12 ||
+        image->GetFormat() == ImageFormat::NV21) {
       yuvImages.push_back(image);
     }
   }
@@ -157,17 +188,169 @@ void AlgoRequest::ClearImages() {
 }
 
 /**
- * @brief Compute CheckSum of Frame
+ * @brief Hash of the image data, cached until the next writable access
+ *
+ * @return uint64_t
+ */
+uint64_t ImageData::GetHash() const {
+  // Images sharing the buffer may hash it from several node threads
+  std::lock_guard<std::mutex> lock(derived->mutex);
+  if (!derived->hashValid) {
+    derived->hash      = Hash64(data->data(), data->size());
+    derived->hashValid = true;
+  }
+  return derived->hash;
+}
+
+/**
+ * @brief Hash of the frame, all planes of all images. Images that were not
+ * written since their last hash cost nothing.
  *
- * @return uint8_t
+ * @return uint64_t
  */
-uint8_t AlgoRequest::FrameChecksum() {
-  unsigned int checksum = 0;
+uint64_t AlgoRequest::FrameHash() const {
+  uint64_t hash = HashCombine(0, images.size());
   for (const auto& image : images) {
-    for (size_t i = 0; i < image->GetDataSize(); i++) {
-      checksum += image->GetData()[i];
-      checksum %= 256;
+    hash = HashCombine(hash, static_cast<uint64_t>(image->GetFormat()));
+    hash = HashCombine(hash, static_cast<uint64_t>(image->GetWidth()));
+    hash = HashCombine(hash, static_cast<uint64_t>(image->GetHeight()));
+    hash = HashCombine(hash, image->GetHash());
+  }
+  return hash;
+}
+
+/**
+ * @brief Number of dirty blocks
+ *
+ * @return size_t
+ */
+size_t DirtyBlockMask::GetDirtyCount() const {
+  return static_cast<size_t>(
+      std::count_if(dirty.begin(), dirty.end(), [](uint8_t d) { return d; }));
+}
+
+/**
+ * @brief Mark every block within halo pixels of a dirty block dirty
+ *
+ * @param halo
+ */
+void DirtyBlockMask::Dilate(int halo) {
+  if (halo <= 0 || blockSize <= 0) {
+    return;
+  }
+  const int reach = (halo + blockSize - 1) / blockSize;
+  std::vector<uint8_t> grown(dirty.size(), 0);
+  for (int by = 0; by < blocksY; by++) {
+    for (int bx = 0; bx < blocksX; bx++) {
+      if (!IsDirty(bx, by)) {
+        continue;
+      }
+      for (int y = std::max(by - reach, 0);
+           y <= std::min(by + reach, blocksY - 1); y++) {
+        for (int x = std::max(bx - reach, 0);
+             x <= std::min(bx + reach, blocksX - 1); x++) {
+          grown[y * blocksX + x] = 1;
+        }
+      }
+    }
+  }
+  dirty.swap(grown);
+}
+
+/**
+ * @brief Add a written area. Areas inside a kept rect are dropped, and once
+ * DIRTY_RECT_LIMIT rects are kept they collapse into their bounding box.
+ *
+ * @param rect
+ */
+void DirtyRegion::Add(const DirtyRect& rect) {
+  if (all || rect.width <= 0 || rect.height <= 0) {
+    return;
+  }
+  for (const auto& kept : rects) {
+    if (rect.x >= kept.x && rect.y >= kept.y &&
+        rect.x + rect.width <= kept.x + kept.width &&
+        rect.y + rect.height <= kept.y + kept.height) {
+      return;
     }
   }
-  return (uint8_t)(checksum % 256);
+  rects.push_back(rect);
+  if (rects.size() > DIRTY_RECT_LIMIT) {
+    rects = {Bounds()};
+  }
+}
+
+/**
+ * @brief Bounding box of the rects
+ *
+ * @return DirtyRect width 0 if there are none
+ */
+DirtyRect DirtyRegion::Bounds() const {
+  if (rects.empty()) {
+    return DirtyRect{};
+  }
+  int x0 = rects[0].x;
+  int y0 = rects[0].y;
+  int x1 = x0 + rects[0].width;
+  int y1 = y0 + rects[0].height;
+  for (const auto& rect : rects) {
+    x0 = std::min(x0, rect.x);
+    y0 = std::min(y0, rect.y);
+    x1 = std::max(x1, rect.x + rect.width);
+    y1 = std::max(y1, rect.y + rect.height);
+  }
+  return DirtyRect{x0, y0, x1 - x0, y1 - y0};
+}
+
+/**
+ * @brief Start tracking writes from the current images, called as the
+ * request enters a pipeline
+ *
+ */
+void AlgoRequest::ResetDirtyRegions() {
+  DirtyRegion clean;
+  clean.all = false;
+  mDirtyRegions.assign(images.size(), clean);
+}
+
+/**
+ * @brief Record a write to part of an image
+ *
+ * @param index
+ * @param rect
+ */
+void AlgoRequest::MarkDirty(size_t index, const DirtyRect& rect) {
+  if (index >= mDirtyRegions.size() || !images[index]) {
+    return;  // Untracked, counts as all dirty already
+  }
+  const int x0 = std::max(rect.x, 0);
+  const int y0 = std::max(rect.y, 0);
+  const int x1 = std::min(rect.x + rect.width, images[index]->GetWidth());
+  const int y1 = std::min(rect.y + rect.height, images[index]->GetHeight());
+  mDirtyRegions[index].Add(DirtyRect{x0, y0, x1 - x0, y1 - y0});
+}
+
+/**
+ * @brief Record that an image may have changed anywhere
+ *
+ * @param index
+ */
+void AlgoRequest::MarkDirty(size_t index) {
+  if (index < mDirtyRegions.size()) {
+    mDirtyRegions[index].all = true;
+    mDirtyRegions[index].rects.clear();
+  }
+}
+
+/**
+ * @brief Writes to an image since ResetDirtyRegions
+ *
+ * @param index
+ * @return DirtyRegion all if the image is not tracked
+ */
+DirtyRegion AlgoRequest::GetDirtyRegion(size_t index) const {
+  if (index >= mDirtyRegions.size() || index >= images.size()) {
+    return DirtyRegion{};
+  }
+  return mDirtyRegions[index];
 }
@@ -21,6 +21,7 @@
  */
 #include "AlgoSession.h"
 #include <cassert>
+#include "ConfigParser.h"
 #include "Log.h"
 
 /**
@@ -31,6 +32,25 @@ AlgoSession::AlgoSession(INTERFACECALLBACK pInterfaceCallBackHandler,
                          void* pCtx) {
   this->pInterfaceCallBackHandler = pInterfaceCallBackHandler;
   this->pInterfaceCtx             = pCtx;
+
+  ConfigParser parser;
+  ResultCacheConfig config;
+  parser.loadFile(CONFIGPATH + "ResultCache.config");
+  if (parser.getErrorCode() == 0) {
+    if (!parser.getValue("Enabled").empty()) {
+      config.enabled = parser.getIntValue("Enabled") != 0;
+    }
+    if (!parser.getValue("MemoryBudgetMB").empty()) {
+      config.memoryBudget =
+          static_cast<size_t>(parser.getIntValue("MemoryBudgetMB")) << 20;
+    }
+    config.diskPath = parser.getValue("DiskPath");
+    if (!parser.getValue("DiskBudgetMB").empty()) {
+      config.diskBudget =
+          static_cast<size_t>(parser.getIntValue("DiskBudgetMB")) << 20;
+    }
+  }
+  SessionConfigureResultCache(config);
 }
 
 /**
@@ -80,6 +100,28 @@ bool AlgoSession::SessionAddPipeline(std::shared_ptr<AlgoPipeline>& pipeline) {
   return true;
 }
 
+/**
+ * @brief Add a pipeline of nodes built by the caller, such as a
+ * StaticPipeline. Its results reach the session callback, and
+ * SessionProcess picks it for the algorithm list the nodes run.
+ *
+ * @param nodes
+ * @return true
+ * @return false
+ */
+bool AlgoSession::SessionAddPipeline(
+    std::vector<std::shared_ptr<AlgoBase>>& nodes) {
+  std::lock_guard<std::mutex> lock(mSessionMutex);
+  auto pipeline = std::make_shared<AlgoPipeline>(
+      &AlgoSession::PiplineCallBackHandler, this);
+  pipeline->ConfigureAlgoPipeline(nodes);
+  if (pipeline->GetState() != AlgoPipelineState::ConfiguredWithId) {
+    LOG(ERROR, ALGOSESSION, "Failed to Configure Pipeline");
+    return false;
+  }
+  return SessionAddPipeline(pipeline);
+}
+
 /**
  * @brief Remove Pipeline
  *
@@ -113,7 +155,7 @@ bool AlgoSession::SessionRemovePipeline(size_t pipelineId) {
 bool AlgoSession::SessionProcess(std::shared_ptr<AlgoRequest> input,
                                  std::vector<AlgoId> algoList) {
   LOG(INFO, ALGOSESSION, "AlgoSession::SessionProcess E");
-  std::lock_guard<std::mutex> lock(mSessionMutex);
+  std::unique_lock<std::mutex> lock(mSessionMutex);
   int pipelineId = SessionGetpipelineId(algoList);
   LOG(INFO, ALGOSESSION, "AlgoSession::SessionProcess pipelineId = %d",
       pipelineId);
@@ -144,6 +186,22 @@ bool AlgoSession::SessionProcess(std::shared_ptr<AlgoRequest> input,
         algosConfigured.c_str());
   }
 
+  input->mResultKey = 0;
+  auto cache        = SessionGetResultCache();
+  auto pipeline     = SessionGetPipeline(pipelineId);
+  if (cache && pipeline && pipeline->IsCacheable()) {
+    uint64_t key = cache->GetKey(input, algoList);
+    if (cache->Lookup(key, input)) {
+      // Complete at once, the callback may run ahead of queued requests
+      lock.unlock();
+      LOG(VERBOSE, ALGOSESSION, "Result cache hit for request %d",
+          input->mRequestId);
+      PiplineCallBackHandler(this, input);
+      return true;
+    }
+    input->mResultKey = key;
+  }
+
   bool rc = SessionProcess(pipelineId, input);
   LOG(INFO, ALGOSESSION, "AlgoSession::SessionProcess X rc = %d Id = %d",
       (int)rc, pipelineId);
@@ -231,6 +289,32 @@ std::shared_ptr<AlgoPipeline> AlgoSession::SessionGetPipeline(
   return it->second;
 }
 
+/**
+ * @brief Replace the result cache, a disabled config removes it
+ *
+ * @param config
+ * @return int
+ */
+int AlgoSession::SessionConfigureResultCache(const ResultCacheConfig& config) {
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+  if (config.enabled) {
+    mResultCache = std::make_shared<ResultCache>(config);
+  } else {
+    mResultCache = nullptr;
+  }
+  return 0;
+}
+
+/**
+ * @brief Get the result cache
+ *
+ * @return std::shared_ptr<ResultCache> nullptr when disabled
+ */
+std::shared_ptr<ResultCache> AlgoSession::SessionGetResultCache() const {
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+  return mResultCache;
+}
+
 /**
  * @brief Pipline CallBack handler
  *
@@ -240,6 +324,13 @@ void AlgoSession::PiplineCallBackHandler(void* pctx,
                                          std::shared_ptr<AlgoRequest> input) {
   AlgoSession* pSession = static_cast<AlgoSession*>(pctx);
   if (pSession) {
+    if (input && input->mResultKey != 0) {
+      auto cache = pSession->SessionGetResultCache();
+      if (cache) {
+        cache->Store(input->mResultKey, input);
+      }
+      input->mResultKey = 0;
+    }
     if (pSession->pInterfaceCallBackHandler) {
       std::lock_guard<std::mutex> lock(pSession->mCallbackMutex);
       pSession->pInterfaceCallBackHandler(pSession->pInterfaceCtx, input);
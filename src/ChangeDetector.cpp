@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "ChangeDetector.h"
+#include <algorithm>
+#include <cstdlib>
+#include "Log.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Sum of absolute differences of two rows
+ *
+ * @param a
+ * @param b
+ * @param len
+ * @return uint64_t
+ */
+static uint64_t RowSad(const uint8_t* a, const uint8_t* b, int len) {
+  uint64_t sad = 0;
+  int i        = 0;
+#ifdef __SSE2__
+  __m128i acc = _mm_setzero_si128();
+  for (; i + 16 <= len; i += 16) {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    acc              = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+  }
+  uint64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  sad = lanes[0] + lanes[1];
+#endif
+  for (; i < len; i++) {
+    sad += std::abs(a[i] - b[i]);
+  }
+  return sad;
+}
+
+/**
+ * @brief Accumulate the SAD of one plane into the blocks it belongs to
+ *
+ * @param a
+ * @param b
+ * @param rowBytes
+ * @param rows
+ * @param blockBytes bytes of a block row
+ * @param blockRows
+ * @param blocksX
+ * @param sad per block
+ * @param bytes per block
+ */
+static void PlaneBlockSad(const uint8_t* a, const uint8_t* b, int rowBytes,
+                          int rows, int blockBytes, int blockRows,
+                          int blocksX, std::vector<uint64_t>& sad,
+                          std::vector<uint64_t>& bytes) {
+  for (int y = 0; y < rows; y++) {
+    const size_t row = static_cast<size_t>(y) * rowBytes;
+    const int by     = y / blockRows;
+    for (int x = 0, bx = 0; x < rowBytes; x += blockBytes, bx++) {
+      const int len = std::min(blockBytes, rowBytes - x);
+      sad[by * blocksX + bx] += RowSad(a + row + x, b + row + x, len);
+      bytes[by * blocksX + bx] += len;
+    }
+  }
+}
+
+/**
+ * @brief Construct a new Change Detector:: Change Detector object
+ *
+ * @param config
+ */
+ChangeDetector::ChangeDetector(const ChangeDetectorConfig& config)
+    : mConfig(config) {
+  mConfig.blockSize = std::max(8, (mConfig.blockSize + 1) & ~1);
+  mConfig.threshold = std::max(0, mConfig.threshold);
+}
+
+/**
+ * @brief Destroy the Change Detector:: Change Detector object
+ *
+ */
+ChangeDetector::~ChangeDetector() {}
+
+/**
+ * @brief Attach the dirty mask of a request and keep its first image for
+ * the next frame of the stream
+ *
+ * @param req
+ * @return int 0 if a mask was attached
+ */
+int ChangeDetector::Detect(std::shared_ptr<AlgoRequest> req) {
+  if (!req) {
+    return -1;
+  }
+  req->mDirtyBlocks = nullptr;
+  auto image        = req->GetImage(0);
+  if (!image) {
+    return -1;
+  }
+
+  // Read through a const image, the writable accessor would unshare it
+  const ImageData& cur = *image;
+  const int width      = cur.GetWidth();
+  const int height     = cur.GetHeight();
+  int cn               = 1;
+  size_t expected      = static_cast<size_t>(width) * height;
+  switch (cur.GetFormat()) {
+    case ImageFormat::YUV420:
+    case ImageFormat::NV12:
+    case ImageFormat::NV21:
+      expected = expected * 3 / 2;
+      break;
+    case ImageFormat::RGB:
+      cn       = 3;
+      expected = expected * 3;
+      break;
+    case ImageFormat::GRAYSCALE:
+      break;
+    default:
+      ResetStream(req->mStreamId);
+      return -2;
+  }
+  if (cur.GetDataSize() != expected) {
+    ResetStream(req->mStreamId);
+    return -2;
+  }
+
+  auto mask       = std::make_shared<DirtyBlockMask>();
+  const int block = mConfig.blockSize;
+  mask->width     = width;
+  mask->height    = height;
+  mask->blockSize = block;
+  mask->blocksX   = (width + block - 1) / block;
+  mask->blocksY   = (height + block - 1) / block;
+  mask->dirty.assign(static_cast<size_t>(mask->blocksX) * mask->blocksY, 1);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  StreamHistory& history = mStreams[req->mStreamId];
+  mask->frame            = ++history.frameNumber;
+  if (history.frame && history.frame->GetFormat() == cur.GetFormat() &&
+      history.frame->GetWidth() == width &&
+      history.frame->GetHeight() == height) {
+    const ImageData& prev = *history.frame;
+    const uint8_t* a      = prev.GetData().data();
+    const uint8_t* b      = cur.GetData().data();
+    std::vector<uint64_t> sad(mask->dirty.size(), 0);
+    std::vector<uint64_t> bytes(mask->dirty.size(), 0);
+    PlaneBlockSad(a, b, width * cn, height, block * cn, block, mask->blocksX,
+                  sad, bytes);
+    // Chroma blocks cover the same area at half resolution
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    if (cur.GetFormat() == ImageFormat::YUV420) {
+      const size_t chromaSize = static_cast<size_t>(width / 2) * (height / 2);
+      for (size_t offset : {lumaSize, lumaSize + chromaSize}) {
+        PlaneBlockSad(a + offset, b + offset, width / 2, height / 2, block / 2,
+                      block / 2, mask->blocksX, sad, bytes);
+      }
+    } else if (cur.GetFormat() == ImageFormat::NV12 ||
+               cur.GetFormat() == ImageFormat::NV21) {
+      // Interleaved U,V pairs, both compared in one pass
+      PlaneBlockSad(a + lumaSize, b + lumaSize, width / 2 * 2, height / 2,
+                    block, block / 2, mask->blocksX, sad, bytes);
+    }
+    for (size_t i = 0; i < sad.size(); i++) {
+      mask->dirty[i] = sad[i] > bytes[i] * mConfig.threshold ? 1 : 0;
+    }
+    mask->prevFrame = mask->frame - 1;
+  }
+  history.frame     = image->Share();
+  req->mDirtyBlocks = mask;
+  return 0;
+}
+
+/**
+ * @brief Forget the previous frame of a stream, its next frame is all dirty
+ *
+ * @param streamId
+ */
+void ChangeDetector::ResetStream(int streamId) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = mStreams.find(streamId);
+  if (it != mStreams.end()) {
+    // Frame numbers keep counting so stale node history never matches
+    it->second.frame = nullptr;
+  }
+}
+
+/**
+ * @brief Get the configuration
+ *
+ * @return const ChangeDetectorConfig&
+ */
+const ChangeDetectorConfig& ChangeDetector::GetConfig() const {
+  return mConfig;
+}
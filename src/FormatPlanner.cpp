@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "FormatPlanner.h"
+#include <algorithm>
+#include <cstring>
+#include "ColorConvert.h"
+#include "TileExecutor.h"
+
+#define FORMAT_COUNT static_cast<int>(ImageFormat::UNKNOWN)
+#define CONVERT_BAND_ROWS 64  // Rows per TileExecutor tile, even
+#define RGB_SHUFFLE_COST 4.0f  // Packed to planar RGB or back, per pixel
+#define RGB_ACCESS_COST 3.0f   // Extra per node for interleaved RGB
+
+/**
+ * @brief True for the 4:2:0 layouts sharing a full resolution luma plane
+ *
+ * @param format
+ * @return bool
+ */
+static bool IsYuv420(ImageFormat format) {
+  return format == ImageFormat::YUV420 || format == ImageFormat::NV12 ||
+         format == ImageFormat::NV21;
+}
+
+/**
+ * @brief Relative cost per pixel of a direct conversion, measured against
+ * a luma copy. Chroma repacking touches half a pixel of data, colour space
+ * changes do the arithmetic for every pixel.
+ *
+ * @param from
+ * @param to
+ * @return float -1 if there is no direct conversion
+ */
+float FormatConversionCost(ImageFormat from, ImageFormat to) {
+  if (from == to) {
+    return 0.0f;
+  }
+  // Planar RGB converts through packed rows
+  if (from == ImageFormat::RGBP || to == ImageFormat::RGBP) {
+    const float cost = FormatConversionCost(
+        from == ImageFormat::RGBP ? ImageFormat::RGB : from,
+        to == ImageFormat::RGBP ? ImageFormat::RGB : to);
+    return cost < 0 ? cost : cost + RGB_SHUFFLE_COST;
+  }
+  const bool yuvFrom = IsYuv420(from);
+  const bool yuvTo   = IsYuv420(to);
+  if (yuvFrom && yuvTo) {
+    return 1.5f;
+  }
+  if (yuvFrom && to == ImageFormat::RGB) {
+    return 6.0f;
+  }
+  if (from == ImageFormat::RGB && yuvTo) {
+    return 7.0f;
+  }
+  if (yuvFrom && to == ImageFormat::GRAYSCALE) {
+    return 1.0f;
+  }
+  if (from == ImageFormat::GRAYSCALE && yuvTo) {
+    return 1.5f;
+  }
+  if (from == ImageFormat::RGB && to == ImageFormat::GRAYSCALE) {
+    return 3.0f;
+  }
+  return -1.0f;
+}
+
+/**
+ * @brief Per node cost of the layout. Kernels on interleaved RGB step by
+ * three samples, which costs them a vector path that planar rows keep.
+ *
+ * @param format
+ * @return float
+ */
+float FormatAccessCost(ImageFormat format) {
+  return format == ImageFormat::RGB ? RGB_ACCESS_COST : 0.0f;
+}
+
+/**
+ * @brief RGBP only exists between nodes, a pipeline delivers it as RGB
+ *
+ * @param format
+ * @return ImageFormat
+ */
+ImageFormat GetExternalFormat(ImageFormat format) {
+  return format == ImageFormat::RGBP ? ImageFormat::RGB : format;
+}
+
+/**
+ * @brief Name of a format for logs
+ *
+ * @param format
+ * @return const char*
+ */
+const char* GetFormatName(ImageFormat format) {
+  switch (format) {
+    case ImageFormat::YUV420:
+      return "YUV420";
+    case ImageFormat::YUV422:
+      return "YUV422";
+    case ImageFormat::YUV444:
+      return "YUV444";
+    case ImageFormat::RGB:
+      return "RGB";
+    case ImageFormat::GRAYSCALE:
+      return "GRAYSCALE";
+    case ImageFormat::JPEG:
+      return "JPEG";
+    case ImageFormat::PNG:
+      return "PNG";
+    case ImageFormat::NV12:
+      return "NV12";
+    case ImageFormat::NV21:
+      return "NV21";
+    case ImageFormat::RGBP:
+      return "RGBP";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+/**
+ * @brief Bytes of an image the converter reads or writes
+ *
+ * @param format
+ * @param lumaSize
+ * @return size_t
+ */
+static size_t GetConvertSize(ImageFormat format, size_t lumaSize) {
+  if (IsYuv420(format)) {
+    return lumaSize * 3 / 2;
+  }
+  return format == ImageFormat::RGB || format == ImageFormat::RGBP
+             ? lumaSize * 3
+             : lumaSize;
+}
+
+/**
+ * @brief Rewrite the chroma plane of one 4:2:0 layout in another
+ *
+ * @param from
+ * @param src chroma of from
+ * @param to
+ * @param dst chroma of to
+ * @param count samples of each chroma channel
+ */
+static void RepackChroma(ImageFormat from, const unsigned char* src,
+                         ImageFormat to, unsigned char* dst, size_t count) {
+  if (from == ImageFormat::YUV420) {
+    const unsigned char* u = src;
+    const unsigned char* v = src + count;
+    if (to == ImageFormat::NV12) {
+      InterleavePlanes(u, v, dst, count);
+    } else {
+      InterleavePlanes(v, u, dst, count);
+    }
+  } else if (to == ImageFormat::YUV420) {
+    unsigned char* u = dst;
+    unsigned char* v = dst + count;
+    if (from == ImageFormat::NV12) {
+      DeinterleavePlanes(src, u, v, count);
+    } else {
+      DeinterleavePlanes(src, v, u, count);
+    }
+  } else {
+    SwapPairs(src, dst, count);
+  }
+}
+
+/**
+ * @brief 4:2:0 rows [row, row + rows) to RGB24
+ *
+ * @param format
+ * @param src
+ * @param width
+ * @param height
+ * @param dst RGB24 of row
+ * @param row even
+ * @param rows even
+ */
+static void Yuv420ToRgbRows(ImageFormat format, const unsigned char* src,
+                            int width, int height, unsigned char* dst, int row,
+                            int rows) {
+  const size_t lumaSize   = static_cast<size_t>(width) * height;
+  const int chromaWidth   = width / 2;
+  const size_t chromaSize = lumaSize / 4;
+  std::vector<unsigned char> u(chromaWidth);
+  std::vector<unsigned char> v(chromaWidth);
+  for (int y = row; y < row + rows; y += 2) {
+    const size_t chromaRow = static_cast<size_t>(y / 2) * chromaWidth;
+    const unsigned char* uRow;
+    const unsigned char* vRow;
+    if (format == ImageFormat::YUV420) {
+      uRow = src + lumaSize + chromaRow;
+      vRow = src + lumaSize + chromaSize + chromaRow;
+    } else {
+      const unsigned char* pairs = src + lumaSize + 2 * chromaRow;
+      if (format == ImageFormat::NV12) {
+        DeinterleavePlanes(pairs, u.data(), v.data(), chromaWidth);
+      } else {
+        DeinterleavePlanes(pairs, v.data(), u.data(), chromaWidth);
+      }
+      uRow = u.data();
+      vRow = v.data();
+    }
+    for (int dy = 0; dy < 2; dy++) {
+      const size_t offset = static_cast<size_t>(y + dy) * width;
+      const size_t out    = static_cast<size_t>(y + dy - row) * width;
+      YuvToRgbRow(src + offset, uRow, vRow, dst + 3 * out, width);
+    }
+  }
+}
+
+/**
+ * @brief RGB24 rows [row, row + rows) to a 4:2:0 layout
+ *
+ * @param src RGB24 of row
+ * @param width
+ * @param height
+ * @param format
+ * @param dst
+ * @param row even
+ * @param rows even
+ */
+static void RgbToYuv420Rows(const unsigned char* src, int width, int height,
+                            ImageFormat format, unsigned char* dst, int row,
+                            int rows) {
+  const size_t lumaSize   = static_cast<size_t>(width) * height;
+  const int chromaWidth   = width / 2;
+  const size_t chromaSize = lumaSize / 4;
+  std::vector<unsigned char> u(chromaWidth);
+  std::vector<unsigned char> v(chromaWidth);
+  for (int y = row; y < row + rows; y += 2) {
+    const size_t offset     = static_cast<size_t>(y) * width;
+    const size_t chromaRow  = static_cast<size_t>(y / 2) * chromaWidth;
+    const unsigned char* in = src + 3 * static_cast<size_t>(y - row) * width;
+    unsigned char* luma     = dst + offset;
+    if (format == ImageFormat::YUV420) {
+      RgbToYuvRows(in, in + 3 * width, luma, luma + width,
+                   dst + lumaSize + chromaRow,
+                   dst + lumaSize + chromaSize + chromaRow, width);
+      continue;
+    }
+    RgbToYuvRows(in, in + 3 * width, luma, luma + width, u.data(), v.data(),
+                 width);
+    unsigned char* pairs = dst + lumaSize + 2 * chromaRow;
+    if (format == ImageFormat::NV12) {
+      InterleavePlanes(u.data(), v.data(), pairs, chromaWidth);
+    } else {
+      InterleavePlanes(v.data(), u.data(), pairs, chromaWidth);
+    }
+  }
+}
+
+/**
+ * @brief Copy of the image in another format. Conversions run in bands of
+ * rows on the TileExecutor, the source is only read.
+ *
+ * @param image
+ * @param to
+ * @return std::shared_ptr<ImageData> nullptr if there is no direct
+ * conversion, the size is odd or the data is short
+ */
+std::shared_ptr<ImageData> ConvertImage(const ImageData& image,
+                                        ImageFormat to) {
+  const ImageFormat from = image.GetFormat();
+  if (from == to) {
+    return image.Share();
+  }
+  const int width  = image.GetWidth();
+  const int height = image.GetHeight();
+  if (FormatConversionCost(from, to) < 0 || width <= 0 || height <= 0 ||
+      width % 2 != 0 || height % 2 != 0) {
+    return nullptr;
+  }
+  const size_t lumaSize = static_cast<size_t>(width) * height;
+  if (image.GetDataSize() < GetConvertSize(from, lumaSize)) {
+    return nullptr;
+  }
+
+  const unsigned char* src = image.GetData().data();
+  std::vector<unsigned char> out(GetConvertSize(to, lumaSize));
+  unsigned char* dst = out.data();
+  const bool rgbFrom = from == ImageFormat::RGB || from == ImageFormat::RGBP;
+  const bool rgbTo   = to == ImageFormat::RGB || to == ImageFormat::RGBP;
+  if (rgbFrom || rgbTo) {
+    const int bands = (height + CONVERT_BAND_ROWS - 1) / CONVERT_BAND_ROWS;
+    TileExecutor::GetInstance().Run(bands, [&](int band) {
+      const int row      = band * CONVERT_BAND_ROWS;
+      const int rows     = std::min(CONVERT_BAND_ROWS, height - row);
+      const size_t first = static_cast<size_t>(row) * width;
+      const size_t count = static_cast<size_t>(rows) * width;
+      if (rgbFrom && rgbTo) {
+        if (from == ImageFormat::RGB) {
+          DeinterleaveRgb(src + 3 * first, dst + first, dst + lumaSize + first,
+                          dst + 2 * lumaSize + first, count);
+        } else {
+          InterleaveRgb(src + first, src + lumaSize + first,
+                        src + 2 * lumaSize + first, dst + 3 * first, count);
+        }
+        return;
+      }
+
+      // Planar RGB goes through packed rows of the band
+      std::vector<unsigned char> packed;
+      const unsigned char* rgbIn = src + 3 * first;
+      unsigned char* rgbOut      = dst + 3 * first;
+      if (from == ImageFormat::RGBP || to == ImageFormat::RGBP) {
+        packed.resize(3 * count);
+        rgbIn  = packed.data();
+        rgbOut = packed.data();
+      }
+      if (from == ImageFormat::RGBP) {
+        InterleaveRgb(src + first, src + lumaSize + first,
+                      src + 2 * lumaSize + first, packed.data(), count);
+      }
+      if (rgbTo) {
+        Yuv420ToRgbRows(from, src, width, height, rgbOut, row, rows);
+      } else if (to == ImageFormat::GRAYSCALE) {
+        for (int y = 0; y < rows; y++) {
+          const size_t offset = static_cast<size_t>(y) * width;
+          RgbToLumaRow(rgbIn + 3 * offset, dst + first + offset, width);
+        }
+      } else {
+        RgbToYuv420Rows(rgbIn, width, height, to, dst, row, rows);
+      }
+      if (to == ImageFormat::RGBP) {
+        DeinterleaveRgb(packed.data(), dst + first, dst + lumaSize + first,
+                        dst + 2 * lumaSize + first, count);
+      }
+    });
+  } else {
+    // The luma plane is shared by all of them
+    std::memcpy(dst, src, lumaSize);
+    if (IsYuv420(from) && IsYuv420(to)) {
+      RepackChroma(from, src + lumaSize, to, dst + lumaSize, lumaSize / 4);
+    } else if (IsYuv420(to)) {
+      std::memset(dst + lumaSize, 128, lumaSize / 2);
+    }
+  }
+
+  auto converted = std::make_shared<ImageData>(to, width, height);
+  converted->SetData(std::move(out));
+  return converted;
+}
+
+/**
+ * @brief Plan every format through a chain, walking it backwards: the best
+ * choice at a node is the option whose conversion plus the rest of the
+ * chain from its output is cheapest. Fewer unsupported nodes always win
+ * over a lower cost, then conversions between external formats, then the
+ * layout cost: shuffles into and out of an internal format plus the access
+ * cost of every format fed. Keeping the incoming format wins ties.
+ *
+ * @param nodes format map of every node in chain order
+ * @return int 0
+ */
+int FormatPlanner::Plan(const std::vector<FormatMap>& nodes) {
+  struct Score {
+    int unsupported = 0;
+    float cost      = 0.0f;
+    float layout    = 0.0f;
+    bool operator<(const Score& other) const {
+      if (unsupported != other.unsupported) {
+        return unsupported < other.unsupported;
+      }
+      if (cost != other.cost) {
+        return cost < other.cost;
+      }
+      return layout < other.layout;
+    }
+  };
+
+  mSteps.assign(nodes.size(), std::vector<FormatStep>(FORMAT_COUNT));
+  std::vector<Score> next(FORMAT_COUNT);
+  for (int f = 0; f < FORMAT_COUNT; f++) {
+    const ImageFormat out = static_cast<ImageFormat>(f);
+    next[f].layout = FormatConversionCost(out, GetExternalFormat(out));
+  }
+  for (size_t i = nodes.size(); i-- > 0;) {
+    std::vector<Score> current(FORMAT_COUNT);
+    for (int f = 0; f < FORMAT_COUNT; f++) {
+      const ImageFormat in = static_cast<ImageFormat>(f);
+      FormatStep step{in, in, in, true};
+      Score best = next[f];
+      bool found = nodes[i].empty();
+      // Options taking the format as is first, so they win ties
+      for (int pass = 0; pass < 2; pass++) {
+        for (const auto& [fed, out] : nodes[i]) {
+          if ((fed == in) != (pass == 0)) {
+            continue;
+          }
+          const float cost = FormatConversionCost(in, fed);
+          if (cost < 0) {
+            continue;
+          }
+          // Layout changes only decide between paths doing the same
+          // conversions, so an internal format never changes the output
+          const float convert = FormatConversionCost(
+              GetExternalFormat(in), GetExternalFormat(fed));
+          const Score& rest = next[static_cast<int>(out)];
+          Score score{rest.unsupported, convert + rest.cost,
+                      cost - convert + FormatAccessCost(fed) + rest.layout};
+          if (!found || score < best) {
+            best  = score;
+            step  = FormatStep{in, fed, out, true};
+            found = true;
+          }
+        }
+      }
+      if (!found) {
+        step.supported = false;
+        best.unsupported++;
+      }
+      current[f]   = best;
+      mSteps[i][f] = step;
+    }
+    next = current;
+  }
+  mInputCost.resize(FORMAT_COUNT);
+  for (int f = 0; f < FORMAT_COUNT; f++) {
+    mInputCost[f] = next[f].cost + next[f].layout;
+  }
+  return 0;
+}
+
+/**
+ * @brief Number of nodes of the last plan
+ *
+ * @return size_t
+ */
+size_t FormatPlanner::GetNodeCount() const {
+  return mSteps.size();
+}
+
+/**
+ * @brief Formats the plan converts before a node, and what to
+ *
+ * @param node
+ * @return std::map<ImageFormat, ImageFormat>
+ */
+std::map<ImageFormat, ImageFormat> FormatPlanner::GetConversions(
+    size_t node) const {
+  std::map<ImageFormat, ImageFormat> conversions;
+  if (node < mSteps.size()) {
+    for (const auto& step : mSteps[node]) {
+      if (step.fed != step.in) {
+        conversions[step.in] = step.fed;
+      }
+    }
+  }
+  return conversions;
+}
+
+/**
+ * @brief What the plan does with a format arriving at a node
+ *
+ * @param node
+ * @param in
+ * @return FormatStep unsupported pass through if out of range
+ */
+FormatStep FormatPlanner::GetStep(size_t node, ImageFormat in) const {
+  const int f = static_cast<int>(in);
+  if (node >= mSteps.size() || f < 0 || f >= FORMAT_COUNT) {
+    return FormatStep{in, in, in, false};
+  }
+  return mSteps[node][f];
+}
+
+/**
+ * @brief Follow a chain input through every node
+ *
+ * @param input
+ * @return std::vector<FormatStep>
+ */
+std::vector<FormatStep> FormatPlanner::Trace(ImageFormat input) const {
+  std::vector<FormatStep> steps;
+  ImageFormat format = input;
+  for (size_t i = 0; i < mSteps.size(); i++) {
+    steps.push_back(GetStep(i, format));
+    format = steps.back().out;
+  }
+  return steps;
+}
+
+/**
+ * @brief Conversion and access cost per pixel the plan spends on a chain
+ * input
+ *
+ * @param input
+ * @return float -1 if the format is out of range
+ */
+float FormatPlanner::GetCost(ImageFormat input) const {
+  const int f = static_cast<int>(input);
+  if (f < 0 || f >= static_cast<int>(mInputCost.size())) {
+    return -1.0f;
+  }
+  return mInputCost[f];
+}
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "FrameAssembler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include "Log.h"
+
+// Ids of requests assembled without settings, shared by every assembler so
+// replacing one does not hand out the same ids again
+static std::atomic<int> gNextRequestId{0};
+
+/**
+ * @brief Construct a new Frame Assembler:: Frame Assembler object
+ *
+ * @param config
+ * @param pCallBackHandler called with every assembled request
+ * @param pCtx
+ */
+FrameAssembler::FrameAssembler(const FrameAssemblerConfig& config,
+                               ASSEMBLERCALLBACK pCallBackHandler, void* pCtx)
+    : mConfig(config), pCallBackHandler(pCallBackHandler), pCtx(pCtx) {
+  mConfig.streamCount = std::max(1, mConfig.streamCount);
+  mConfig.burstCount  = std::max(1, mConfig.burstCount);
+  mConfig.maxPending  = std::max<size_t>(1, mConfig.maxPending);
+  mStreams.resize(mConfig.streamCount);
+}
+
+/**
+ * @brief Destroy the Frame Assembler:: Frame Assembler object, pending
+ * frames are released without processing
+ *
+ */
+FrameAssembler::~FrameAssembler() {
+  const size_t pending = GetPendingFrames();
+  if (pending > 0) {
+    LOG(WARNING, FRAMEASSEMBLER, "Releasing %zu pending frames", pending);
+  }
+}
+
+/**
+ * @brief Queue a frame, completed sets are handed to the callback before
+ * returning
+ *
+ * @param streamId camera stream, 0 .. streamCount-1 in stereo mode
+ * @param timestampUs capture time
+ * @param groupKey burst the frame belongs to
+ * @param frame
+ * @param algoList algos run on the request the frame completes
+ * @param settings request without images whose id and metadata the
+ * assembled request takes, from the first frame of the set that has one
+ * @return int 0 on success, negative if the frame is rejected
+ */
+int FrameAssembler::SubmitFrame(int streamId, int64_t timestampUs,
+                                int groupKey, std::shared_ptr<ImageData> frame,
+                                std::vector<AlgoId> algoList,
+                                std::shared_ptr<AlgoRequest> settings) {
+  if (!frame || frame->GetDataSize() == 0) {
+    return -1;
+  }
+  if (mConfig.mode == AssemblyMode::STEREO &&
+      (streamId < 0 || streamId >= mConfig.streamCount)) {
+    LOG(ERROR, FRAMEASSEMBLER, "Invalid stream id %d", streamId);
+    return -2;
+  }
+
+  std::vector<Assembled> ready;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mNewestUs = std::max(mNewestUs, timestampUs);
+    PendingFrame pending{streamId, timestampUs, std::move(frame),
+                         std::move(algoList), std::move(settings)};
+
+    if (mConfig.mode == AssemblyMode::STEREO) {
+      // Keep each stream in capture order, late frames slot in behind
+      auto& stream = mStreams[streamId];
+      auto pos     = std::upper_bound(
+          stream.begin(), stream.end(), timestampUs,
+          [](int64_t ts, const PendingFrame& f) { return ts < f.timestampUs; });
+      stream.insert(pos, std::move(pending));
+      MatchStereo(ready);
+      ExpireStereo(mNewestUs, false, ready);
+    } else {
+      auto& burst = mBursts[groupKey];
+      burst.push_back(std::move(pending));
+      if (burst.size() >= static_cast<size_t>(mConfig.burstCount)) {
+        std::vector<PendingFrame> frames = std::move(burst);
+        mBursts.erase(groupKey);
+        Release(frames, ready);
+      }
+      ExpireBursts(mNewestUs, false, ready);
+    }
+  }
+
+  for (auto& assembled : ready) {
+    if (pCallBackHandler) {
+      pCallBackHandler(pCtx, assembled.request, std::move(assembled.algoList));
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Apply the drop policy to every pending frame
+ *
+ */
+void FrameAssembler::Flush() {
+  std::vector<Assembled> ready;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mConfig.mode == AssemblyMode::STEREO) {
+      ExpireStereo(mNewestUs, true, ready);
+    } else {
+      ExpireBursts(mNewestUs, true, ready);
+    }
+  }
+  for (auto& assembled : ready) {
+    if (pCallBackHandler) {
+      pCallBackHandler(pCtx, assembled.request, std::move(assembled.algoList));
+    }
+  }
+}
+
+/**
+ * @brief Emit sets with one frame per stream, all within toleranceUs of the
+ * oldest unmatched frame of stream 0
+ *
+ * @param ready
+ */
+void FrameAssembler::MatchStereo(std::vector<Assembled>& ready) {
+  auto& anchors = mStreams[0];
+  for (size_t a = 0; a < anchors.size();) {
+    const int64_t anchorUs = anchors[a].timestampUs;
+    std::vector<size_t> match(mConfig.streamCount, 0);
+    match[0]      = a;
+    bool complete = true;
+    for (int s = 1; s < mConfig.streamCount && complete; s++) {
+      // Closest frame of the stream, the queue is sorted by timestamp
+      int64_t best = mConfig.toleranceUs + 1;
+      for (size_t i = 0; i < mStreams[s].size(); i++) {
+        const int64_t frameUs = mStreams[s][i].timestampUs;
+        const int64_t skew    = std::abs(frameUs - anchorUs);
+        if (skew < best) {
+          best     = skew;
+          match[s] = i;
+        } else if (frameUs > anchorUs) {
+          break;
+        }
+      }
+      complete = best <= mConfig.toleranceUs;
+    }
+    if (!complete) {
+      a++;
+      continue;
+    }
+
+    std::vector<PendingFrame> frames;
+    frames.reserve(mConfig.streamCount);
+    for (int s = 0; s < mConfig.streamCount; s++) {
+      frames.push_back(std::move(mStreams[s][match[s]]));
+      mStreams[s].erase(mStreams[s].begin() + match[s]);
+    }
+    Release(frames, ready);
+  }
+}
+
+/**
+ * @brief Give up on frames older than maxWaitUs, or over the per stream
+ * limit. Partial sets are emitted one frame per request.
+ *
+ * @param nowUs newest timestamp seen
+ * @param all expire everything
+ * @param ready
+ */
+void FrameAssembler::ExpireStereo(int64_t nowUs, bool all,
+                                  std::vector<Assembled>& ready) {
+  for (auto& stream : mStreams) {
+    while (!stream.empty() &&
+           (all || stream.size() > mConfig.maxPending ||
+            stream.front().timestampUs < nowUs - mConfig.maxWaitUs)) {
+      std::vector<PendingFrame> frames;
+      frames.push_back(std::move(stream.front()));
+      stream.pop_front();
+      if (mConfig.dropPolicy == AssemblyDropPolicy::EMIT_PARTIAL) {
+        Release(frames, ready);
+      } else {
+        LOG(WARNING, FRAMEASSEMBLER, "Dropping unmatched frame of stream %d",
+            frames[0].streamId);
+        mDroppedFrames++;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Give up on bursts whose first frame is older than maxWaitUs, or the
+ * oldest bursts once more than maxPending are open
+ *
+ * @param nowUs newest timestamp seen
+ * @param all expire everything
+ * @param ready
+ */
+void FrameAssembler::ExpireBursts(int64_t nowUs, bool all,
+                                  std::vector<Assembled>& ready) {
+  while (!mBursts.empty()) {
+    auto oldest = mBursts.begin();
+    for (auto it = mBursts.begin(); it != mBursts.end(); ++it) {
+      if (it->second.front().timestampUs <
+          oldest->second.front().timestampUs) {
+        oldest = it;
+      }
+    }
+    if (!all && mBursts.size() <= mConfig.maxPending &&
+        oldest->second.front().timestampUs >= nowUs - mConfig.maxWaitUs) {
+      break;
+    }
+
+    std::vector<PendingFrame> frames = std::move(oldest->second);
+    const int groupKey               = oldest->first;
+    mBursts.erase(oldest);
+    if (mConfig.dropPolicy == AssemblyDropPolicy::EMIT_PARTIAL) {
+      Release(frames, ready);
+    } else {
+      LOG(WARNING, FRAMEASSEMBLER, "Dropping burst %d with %zu/%d frames",
+          groupKey, frames.size(), mConfig.burstCount);
+      mDroppedFrames += frames.size();
+    }
+  }
+}
+
+/**
+ * @brief Move frames into a request, in capture order. The request is the
+ * settings of the first frame that has them, a new one otherwise.
+ *
+ * @param frames
+ * @param ready
+ */
+void FrameAssembler::Release(std::vector<PendingFrame>& frames,
+                             std::vector<Assembled>& ready) {
+  if (frames.empty()) {
+    return;
+  }
+  if (mConfig.mode == AssemblyMode::BURST) {
+    std::stable_sort(frames.begin(), frames.end(),
+                     [](const PendingFrame& a, const PendingFrame& b) {
+                       return a.timestampUs < b.timestampUs;
+                     });
+  }
+
+  Assembled assembled;
+  for (auto& frame : frames) {
+    if (frame.settings) {
+      assembled.request = std::move(frame.settings);
+      break;
+    }
+  }
+  if (assembled.request) {
+    assembled.request->ClearImages();
+  } else {
+    assembled.request             = std::make_shared<AlgoRequest>();
+    assembled.request->mRequestId = gNextRequestId++;
+  }
+  assembled.request->mStreamId = frames.front().streamId;
+  for (auto& frame : frames) {
+    if (assembled.request->AddImage(std::move(frame.image)) != 0) {
+      LOG(ERROR, FRAMEASSEMBLER, "Dropping malformed frame of stream %d",
+          frame.streamId);
+      mDroppedFrames++;
+    }
+  }
+  auto first = assembled.request->GetImage(0);
+  if (!first) {
+    return;
+  }
+  assembled.request->mMetadata.SetMetadata(MetaId::IMAGE_WIDTH,
+                                           first->GetWidth());
+  assembled.request->mMetadata.SetMetadata(MetaId::IMAGE_HEIGHT,
+                                           first->GetHeight());
+  assembled.algoList = std::move(frames.back().algoList);
+  ready.push_back(std::move(assembled));
+  mAssembledCount++;
+}
+
+/**
+ * @brief Get the Config object
+ *
+ * @return const FrameAssemblerConfig&
+ */
+const FrameAssemblerConfig& FrameAssembler::GetConfig() const {
+  return mConfig;
+}
+
+/**
+ * @brief Get the number of frames waiting for a set
+ *
+ * @return size_t
+ */
+size_t FrameAssembler::GetPendingFrames() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  size_t pending = 0;
+  for (const auto& stream : mStreams) {
+    pending += stream.size();
+  }
+  for (const auto& burst : mBursts) {
+    pending += burst.second.size();
+  }
+  return pending;
+}
+
+/**
+ * @brief Get the number of requests emitted
+ *
+ * @return size_t
+ */
+size_t FrameAssembler::GetAssembledCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mAssembledCount;
+}
+
+/**
+ * @brief Get the number of frames released without processing
+ *
+ * @return size_t
+ */
+size_t FrameAssembler::GetDroppedFrames() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mDroppedFrames;
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "FrameStats.h"
+#include <algorithm>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define HISTOGRAM_BINS 256
+
+/**
+ * @brief Add one row to the histogram. Four interleaved copies of the bins
+ * keep runs of equal samples from stalling on the same counter.
+ *
+ * @param row
+ * @param width
+ * @param bins 4 * HISTOGRAM_BINS counters
+ */
+static void HistogramRow(const uint8_t* row, int width, uint32_t* bins) {
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    bins[row[x]]++;
+    bins[HISTOGRAM_BINS + row[x + 1]]++;
+    bins[2 * HISTOGRAM_BINS + row[x + 2]]++;
+    bins[3 * HISTOGRAM_BINS + row[x + 3]]++;
+  }
+  for (; x < width; x++) {
+    bins[row[x]]++;
+  }
+}
+
+/**
+ * @brief Sum of a run of samples, folding them into the running minimum
+ * and maximum
+ *
+ * @param src
+ * @param len
+ * @param lo
+ * @param hi
+ * @return uint64_t
+ */
+static uint64_t SumMinMax(const uint8_t* src, int len, uint8_t& lo,
+                          uint8_t& hi) {
+  uint64_t sum = 0;
+  int i        = 0;
+#ifdef __SSE2__
+  if (len >= 16) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc        = zero;
+    __m128i vmin       = _mm_set1_epi8(static_cast<char>(lo));
+    __m128i vmax       = _mm_set1_epi8(static_cast<char>(hi));
+    for (; i + 16 <= len; i += 16) {
+      const __m128i v =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      acc  = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+      vmin = _mm_min_epu8(vmin, v);
+      vmax = _mm_max_epu8(vmax, v);
+    }
+    uint64_t lanes[2];
+    uint8_t mins[16];
+    uint8_t maxs[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), vmin);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), vmax);
+    sum = lanes[0] + lanes[1];
+    lo  = *std::min_element(mins, mins + 16);
+    hi  = *std::max_element(maxs, maxs + 16);
+  }
+#endif
+  for (; i < len; i++) {
+    sum += src[i];
+    lo = std::min(lo, src[i]);
+    hi = std::max(hi, src[i]);
+  }
+  return sum;
+}
+
+/**
+ * @brief Histogram, range, mean and block means of the luma plane. Each row
+ * is read once while it is in cache for all of them. YUV and GRAYSCALE
+ * images are read in place, other formats through their cached Luma().
+ *
+ * @param image
+ * @param blockSize block edge in luma pixels
+ * @param stats
+ * @return int
+ */
+int ComputeFrameStats(const ImageData& image, int blockSize,
+                      FrameStats& stats) {
+  const int width  = image.GetWidth();
+  const int height = image.GetHeight();
+  if (width <= 0 || height <= 0 || blockSize <= 0) {
+    return -1;
+  }
+  const ImageFormat format = image.GetFormat();
+  const bool hasPlane =
+      format == ImageFormat::YUV420 || format == ImageFormat::NV12 ||
+      format == ImageFormat::NV21 || format == ImageFormat::GRAYSCALE;
+  const size_t lumaSize = static_cast<size_t>(width) * height;
+
+  std::shared_ptr<const ImageData> luma;
+  const uint8_t* plane = nullptr;
+  if (hasPlane && image.GetDataSize() >= lumaSize) {
+    plane = image.GetData().data();
+  } else {
+    luma = image.Luma();
+    if (!luma || luma->GetDataSize() < lumaSize) {
+      return -1;
+    }
+    plane = luma->GetData().data();
+  }
+
+  stats.blockSize = blockSize;
+  stats.blocksX   = (width + blockSize - 1) / blockSize;
+  stats.blocksY   = (height + blockSize - 1) / blockSize;
+  std::vector<uint32_t> bins(4 * HISTOGRAM_BINS, 0);
+  std::vector<uint64_t> sums(
+      static_cast<size_t>(stats.blocksX) * stats.blocksY, 0);
+  uint8_t lo     = 255;
+  uint8_t hi     = 0;
+  uint64_t total = 0;
+  for (int y = 0; y < height; y++) {
+    const uint8_t* row = plane + static_cast<size_t>(y) * width;
+    uint64_t* blocks =
+        &sums[static_cast<size_t>(y / blockSize) * stats.blocksX];
+    for (int x = 0, bx = 0; x < width; x += blockSize, bx++) {
+      const uint64_t sum =
+          SumMinMax(row + x, std::min(blockSize, width - x), lo, hi);
+      blocks[bx] += sum;
+      total += sum;
+    }
+    HistogramRow(row, width, bins.data());
+  }
+
+  stats.min  = lo;
+  stats.max  = hi;
+  stats.mean = static_cast<float>(static_cast<double>(total) / lumaSize);
+  stats.histogram.assign(HISTOGRAM_BINS, 0);
+  for (int i = 0; i < HISTOGRAM_BINS; i++) {
+    stats.histogram[i] = static_cast<int32_t>(
+        bins[i] + bins[HISTOGRAM_BINS + i] + bins[2 * HISTOGRAM_BINS + i] +
+        bins[3 * HISTOGRAM_BINS + i]);
+  }
+  stats.blockMeans.resize(sums.size());
+  for (int by = 0; by < stats.blocksY; by++) {
+    const uint64_t rows = std::min(blockSize, height - by * blockSize);
+    for (int bx = 0; bx < stats.blocksX; bx++) {
+      const uint64_t count = rows * std::min(blockSize, width - bx * blockSize);
+      const size_t i       = static_cast<size_t>(by) * stats.blocksX + bx;
+      stats.blockMeans[i] = static_cast<int32_t>((sums[i] + count / 2) / count);
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Store the stats as metadata for later nodes and the client
+ *
+ * @param stats
+ * @param metadata
+ */
+void SetFrameStats(const FrameStats& stats, AlgoMetadata& metadata) {
+  metadata.SetMetadata(MetaId::LUMA_HISTOGRAM, stats.histogram);
+  metadata.SetMetadata(MetaId::LUMA_MIN, stats.min);
+  metadata.SetMetadata(MetaId::LUMA_MAX, stats.max);
+  metadata.SetMetadata(MetaId::LUMA_MEAN, stats.mean);
+  metadata.SetMetadata(MetaId::LUMA_BLOCK_SIZE, stats.blockSize);
+  metadata.SetMetadata(MetaId::LUMA_BLOCKS_X, stats.blocksX);
+  metadata.SetMetadata(MetaId::LUMA_BLOCK_MEANS, stats.blockMeans);
+}
+
+/**
+ * @brief Read back the stats stored by SetFrameStats
+ *
+ * @param metadata
+ * @param stats
+ * @return int
+ */
+int GetFrameStats(AlgoMetadata& metadata, FrameStats& stats) {
+  if (metadata.GetMetadata(MetaId::LUMA_HISTOGRAM, stats.histogram) ||
+      metadata.GetMetadata(MetaId::LUMA_MIN, stats.min) ||
+      metadata.GetMetadata(MetaId::LUMA_MAX, stats.max) ||
+      metadata.GetMetadata(MetaId::LUMA_MEAN, stats.mean) ||
+      metadata.GetMetadata(MetaId::LUMA_BLOCK_SIZE, stats.blockSize) ||
+      metadata.GetMetadata(MetaId::LUMA_BLOCKS_X, stats.blocksX) ||
+      metadata.GetMetadata(MetaId::LUMA_BLOCK_MEANS, stats.blockMeans) ||
+      stats.blocksX <= 0) {
+    return -1;
+  }
+  stats.blocksY = static_cast<int>(stats.blockMeans.size()) / stats.blocksX;
+  return 0;
+}
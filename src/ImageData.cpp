@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "AlgoRequest.h"
+#include "FormatPlanner.h"
+#include "ScaleEngine.h"
+
+/**
+ * @brief The image as RGB24, converted on the first call
+ *
+ * @return std::shared_ptr<const ImageData> nullptr if it cannot be converted
+ */
+std::shared_ptr<const ImageData> ImageData::AsRGB() const {
+  if (format == ImageFormat::RGB) {
+    return Share();
+  }
+  std::lock_guard<std::mutex> lock(derived->mutex);
+  if (!derived->rgb) {
+    derived->rgb = ConvertImage(*this, ImageFormat::RGB);
+  }
+  return derived->rgb;
+}
+
+/**
+ * @brief The luma of the image as a GRAYSCALE image, extracted on the first
+ * call
+ *
+ * @return std::shared_ptr<const ImageData> nullptr if it has no luma
+ */
+std::shared_ptr<const ImageData> ImageData::Luma() const {
+  if (format == ImageFormat::GRAYSCALE) {
+    return Share();
+  }
+  std::lock_guard<std::mutex> lock(derived->mutex);
+  if (!derived->luma) {
+    derived->luma = ConvertImage(*this, ImageFormat::GRAYSCALE);
+  }
+  return derived->luma;
+}
+
+/**
+ * @brief Level of the luma pyramid, each level halving the one above with
+ * a 2x2 box. Missing levels are built down to the one asked for, YUV and
+ * GRAYSCALE images build level 1 straight from their luma plane.
+ *
+ * @param level 0 is Luma()
+ * @return std::shared_ptr<const ImageData> nullptr if the level would be
+ * empty or the image has no luma
+ */
+std::shared_ptr<const ImageData> ImageData::Pyramid(int level) const {
+  if (level <= 0) {
+    return level == 0 ? Luma() : nullptr;
+  }
+  // Luma is taken before the lock, it locks the same mutex
+  const bool hasPlane =
+      format == ImageFormat::YUV420 || format == ImageFormat::NV12 ||
+      format == ImageFormat::NV21 || format == ImageFormat::GRAYSCALE;
+
+  std::shared_ptr<const ImageData> base;
+  const unsigned char* plane = nullptr;
+  if (hasPlane && data->size() >= static_cast<size_t>(width) * height) {
+    plane = data->data();
+  } else {
+    base = Luma();
+    if (!base) {
+      return nullptr;
+    }
+    plane = base->GetData().data();
+  }
+
+  std::lock_guard<std::mutex> lock(derived->mutex);
+  auto& levels = derived->pyramid;
+  while (levels.size() < static_cast<size_t>(level)) {
+    const ImageData* above   = levels.empty() ? nullptr : levels.back().get();
+    const unsigned char* src = above ? above->GetData().data() : plane;
+    const int srcWidth       = above ? above->GetWidth() : width;
+    const int outWidth       = srcWidth / 2;
+    const int outHeight      = (above ? above->GetHeight() : height) / 2;
+    if (outWidth == 0 || outHeight == 0) {
+      return nullptr;
+    }
+    std::vector<unsigned char> out(static_cast<size_t>(outWidth) * outHeight);
+    for (int y = 0; y < outHeight; y++) {
+      const unsigned char* row = src + static_cast<size_t>(2 * y) * srcWidth;
+      ScaleHalfRow(row, row + srcWidth, &out[static_cast<size_t>(y) * outWidth],
+                   outWidth);
+    }
+    auto next = std::make_shared<ImageData>(ImageFormat::GRAYSCALE, outWidth,
+                                            outHeight);
+    next->SetData(std::move(out));
+    levels.push_back(next);
+  }
+  return levels[level - 1];
+}
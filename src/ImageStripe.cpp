@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "ImageStripe.h"
+#include <cstring>
+
+/**
+ * @brief Formats ImageStripe can describe
+ *
+ * @param format
+ * @return bool
+ */
+bool IsStripeFormat(ImageFormat format) {
+  return format == ImageFormat::RGB || format == ImageFormat::RGBP ||
+         format == ImageFormat::YUV420 || format == ImageFormat::NV12 ||
+         format == ImageFormat::NV21;
+}
+
+/**
+ * @brief Plane count, row bytes and row shift of a format, the layout the
+ * nodes use for whole frames
+ *
+ * @param format
+ * @param width
+ * @param stripe
+ */
+static void SetPlaneLayout(ImageFormat format, int width,
+                           ImageStripe& stripe) {
+  switch (format) {
+    case ImageFormat::RGB:
+      stripe.planes    = 1;
+      stripe.stride[0] = width * 3;
+      break;
+    case ImageFormat::RGBP:
+      stripe.planes    = 3;
+      stripe.stride[0] = width;
+      stripe.stride[1] = width;
+      stripe.stride[2] = width;
+      break;
+    case ImageFormat::YUV420:
+      stripe.planes    = 3;
+      stripe.stride[0] = width;
+      stripe.stride[1] = width / 2;
+      stripe.stride[2] = width / 2;
+      stripe.shift[1]  = 1;
+      stripe.shift[2]  = 1;
+      break;
+    case ImageFormat::NV12:
+    case ImageFormat::NV21:
+      stripe.planes    = 2;
+      stripe.stride[0] = width;
+      stripe.stride[1] = width;
+      stripe.shift[1]  = 1;
+      break;
+    default:
+      stripe.planes = 0;
+      break;
+  }
+}
+
+/**
+ * @brief Bytes of luma rows [rowBegin, rowEnd) of a frame, all planes
+ *
+ * @param format
+ * @param width
+ * @param rowBegin
+ * @param rowEnd
+ * @return size_t 0 for formats stripes cannot describe
+ */
+size_t GetStripeSize(ImageFormat format, int width, int rowBegin,
+                     int rowEnd) {
+  ImageStripe stripe;
+  SetPlaneLayout(format, width, stripe);
+  stripe.rowBegin = rowBegin;
+  stripe.rowEnd   = rowEnd;
+  size_t size     = 0;
+  for (int p = 0; p < stripe.planes; p++) {
+    size += static_cast<size_t>(stripe.PlaneEnd(p) - stripe.PlaneBegin(p)) *
+            stripe.stride[p];
+  }
+  return size;
+}
+
+/**
+ * @brief Rows of a whole frame laid out in format
+ *
+ * @param format
+ * @param width
+ * @param height
+ * @param frame
+ * @param rowBegin
+ * @param rowEnd
+ * @return ImageStripe
+ */
+ImageStripe MapFrameStripe(ImageFormat format, int width, int height,
+                           unsigned char* frame, int rowBegin, int rowEnd) {
+  ImageStripe stripe;
+  stripe.format   = format;
+  stripe.width    = width;
+  stripe.height   = height;
+  stripe.rowBegin = rowBegin;
+  stripe.rowEnd   = rowEnd;
+  SetPlaneLayout(format, width, stripe);
+  unsigned char* plane = frame;
+  for (int p = 0; p < stripe.planes; p++) {
+    stripe.data[p] = plane + static_cast<size_t>(stripe.PlaneBegin(p)) *
+                                 stripe.stride[p];
+    plane += static_cast<size_t>(height >> stripe.shift[p]) * stripe.stride[p];
+  }
+  return stripe;
+}
+
+/**
+ * @brief Rows held in a buffer of GetStripeSize bytes, planes back to back
+ *
+ * @param format
+ * @param width
+ * @param height
+ * @param buffer
+ * @param rowBegin
+ * @param rowEnd
+ * @return ImageStripe
+ */
+ImageStripe MapBufferStripe(ImageFormat format, int width, int height,
+                            unsigned char* buffer, int rowBegin, int rowEnd) {
+  ImageStripe stripe;
+  stripe.format   = format;
+  stripe.width    = width;
+  stripe.height   = height;
+  stripe.rowBegin = rowBegin;
+  stripe.rowEnd   = rowEnd;
+  SetPlaneLayout(format, width, stripe);
+  for (int p = 0; p < stripe.planes; p++) {
+    stripe.data[p] = buffer;
+    buffer += static_cast<size_t>(stripe.PlaneEnd(p) - stripe.PlaneBegin(p)) *
+              stripe.stride[p];
+  }
+  return stripe;
+}
+
+/**
+ * @brief Copy the rows of dst from src, which must hold them
+ *
+ * @param src
+ * @param dst
+ * @param first first plane copied
+ */
+void CopyStripe(const ImageStripe& src, ImageStripe& dst, int first) {
+  for (int p = first; p < dst.planes; p++) {
+    const int rows = dst.PlaneEnd(p) - dst.PlaneBegin(p);
+    if (rows > 0) {
+      std::memcpy(dst.data[p], src.Row(p, dst.PlaneBegin(p)),
+                  static_cast<size_t>(rows) * dst.stride[p]);
+    }
+  }
+}
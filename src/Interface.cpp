@@ -99,3 +99,41 @@ RegisterCallback(void **libhandle,
   algoInterface->pIntfCallback = Callback;
   return 0;
 }
+
+SHARED_LIB_EXPORT int
+AlgoInterfaceConfigureAssembler(void **libhandle,
+                                FrameAssemblerConfig config) {
+  if (*libhandle == nullptr) {
+    return -1;
+  }
+  LOG(INFO, ALGOINTERFACE, "AlgoInterfaceConfigureAssembler");
+  AlgoInterface *algoInterface = static_cast<AlgoInterface *>(*libhandle);
+  return algoInterface->ConfigureAssembler(config);
+}
+
+SHARED_LIB_EXPORT int AlgoInterfaceSubmitFrame(
+    void **libhandle, int streamId, int64_t timestampUs, int groupKey,
+    std::shared_ptr<ImageData> frame, std::vector<AlgoId> algoList,
+    std::shared_ptr<AlgoRequest> settings) {
+  if (*libhandle == nullptr) {
+    return -1;
+  }
+  if (algoList.size() == 0) {
+    return -2;
+  }
+  AlgoInterface *algoInterface = static_cast<AlgoInterface *>(*libhandle);
+  if (algoInterface->SubmitFrame(streamId, timestampUs, groupKey,
+                                 std::move(frame), std::move(algoList),
+                                 std::move(settings))) {
+    return -3;
+  }
+  return 0;
+}
+
+SHARED_LIB_EXPORT int AlgoInterfaceFlushFrames(void **libhandle) {
+  if (*libhandle == nullptr) {
+    return -1;
+  }
+  AlgoInterface *algoInterface = static_cast<AlgoInterface *>(*libhandle);
+  return algoInterface->FlushFrames();
+}
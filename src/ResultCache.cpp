@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "ResultCache.h"
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include "Hash.h"
+#include "Log.h"
+
+// Ids that differ between otherwise identical requests
+static const std::vector<MetaId> kVolatileIds = {
+    MetaId::ALGO_PROCESS_DONE, MetaId::ALGO_REQUSET_NUMBER,
+    MetaId::IMAGE_TIMESTAMP,   MetaId::BOKEH_LATENCY_MS,
+    MetaId::FRAME_HASH,        MetaId::FRAME_HASH_INPUT};
+
+// Output ids that stay with the request served from the cache
+static const std::vector<MetaId> kRequestIds = {MetaId::ALGO_REQUSET_NUMBER,
+                                                MetaId::IMAGE_TIMESTAMP,
+                                                MetaId::BOKEH_LATENCY_MS};
+
+static const uint32_t kDiskMagic = 0x43525a47;  // "GZRC"
+
+/**
+ * @brief Construct a new Result Cache:: Result Cache object
+ *
+ * @param config
+ */
+ResultCache::ResultCache(const ResultCacheConfig& config) : mConfig(config) {}
+
+/**
+ * @brief Destroy the Result Cache:: Result Cache object, spilled entries
+ * are not indexed across runs so their files are removed
+ *
+ */
+ResultCache::~ResultCache() {
+  Clear();
+}
+
+/**
+ * @brief Key of a request on a pipeline, 0 is never returned
+ *
+ * @param req
+ * @param algoList
+ * @return uint64_t
+ */
+uint64_t ResultCache::GetKey(std::shared_ptr<AlgoRequest> req,
+                             const std::vector<AlgoId>& algoList) const {
+  uint64_t key = HashCombine(0, algoList.size());
+  for (auto id : algoList) {
+    key = HashCombine(key, static_cast<uint64_t>(id));
+  }
+  key = HashCombine(key, req->FrameHash());
+  const std::string metadata = req->mMetadata.Serialize(kVolatileIds);
+
+  key = HashCombine(key, Hash64(metadata.data(), metadata.size(), key));
+  return key == 0 ? 1 : key;
+}
+
+/**
+ * @brief Complete a request from the cache, its images are replaced by
+ * shared copies of the cached output and the output metadata is merged in.
+ * A spilled entry is claimed under the lock and read after releasing it.
+ *
+ * @param key
+ * @param req
+ * @return true on a hit
+ */
+bool ResultCache::Lookup(uint64_t key, std::shared_ptr<AlgoRequest> req) {
+  std::shared_ptr<Entry> entry;
+  std::string file;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mEntryMap.find(key);
+    if (it != mEntryMap.end()) {
+      entry = *it->second;
+      mEntries.splice(mEntries.begin(), mEntries, it->second);
+      mHits++;
+    } else {
+      auto diskIt = mDiskMap.find(key);
+      if (diskIt == mDiskMap.end()) {
+        mMisses++;
+        return false;
+      }
+      mDiskBusy.insert(key);
+      file = Unindex(diskIt->second);
+    }
+  }
+
+  if (!entry) {
+    entry = LoadFromDisk(key);
+    RemoveFiles({file});
+    std::vector<std::shared_ptr<Entry>> victims;
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mDiskBusy.erase(key);
+      if (!entry) {
+        mMisses++;
+        return false;
+      }
+      mHits++;
+      if (mEntryMap.find(key) == mEntryMap.end()) {
+        victims = Insert(entry);
+      }
+    }
+    Spill(victims);
+  }
+
+  req->ClearImages();
+  for (const auto& image : entry->images) {
+    req->AddImage(image->Share());
+  }
+  req->mMetadata.Deserialize(entry->metadata);
+  return true;
+}
+
+/**
+ * @brief Store the output of a request processed under key
+ *
+ * @param key
+ * @param output
+ */
+void ResultCache::Store(uint64_t key, std::shared_ptr<AlgoRequest> output) {
+  if (key == 0 || output == nullptr) {
+    return;
+  }
+  auto entry   = std::make_shared<Entry>();
+  entry->key   = key;
+  entry->bytes = 0;
+  for (size_t i = 0; i < output->GetImageCount(); i++) {
+    auto image = output->GetImage(i);
+    entry->images.push_back(image->Share());
+    entry->bytes += image->GetDataSize();
+  }
+  entry->metadata = output->mMetadata.Serialize(kRequestIds);
+
+  entry->bytes += entry->metadata.size();
+
+  std::vector<std::string> stale;
+  std::vector<std::shared_ptr<Entry>> victims;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mEntryMap.find(key) != mEntryMap.end()) {
+      return;
+    }
+    auto diskIt = mDiskMap.find(key);
+    if (diskIt != mDiskMap.end()) {
+      stale.push_back(Unindex(diskIt->second));
+    }
+    victims = Insert(entry);
+  }
+  RemoveFiles(stale);
+  Spill(victims);
+}
+
+/**
+ * @brief Drop every entry and remove the spilled files
+ *
+ */
+void ResultCache::Clear() {
+  std::vector<std::string> stale;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mEntryMap.clear();
+    mMemoryUsage = 0;
+    while (!mDiskEntries.empty()) {
+      stale.push_back(Unindex(mDiskEntries.begin()));
+    }
+  }
+  RemoveFiles(stale);
+}
+
+/**
+ * @brief Add an entry as most recently used, least recently used entries
+ * over the memory budget leave memory. Called with the lock held.
+ *
+ * @param entry
+ * @return std::vector<std::shared_ptr<ResultCache::Entry>> entries to spill
+ * once the lock is released, marked busy
+ */
+std::vector<std::shared_ptr<ResultCache::Entry>> ResultCache::Insert(
+    std::shared_ptr<Entry> entry) {
+  std::vector<std::shared_ptr<Entry>> evicted;
+  if (entry->bytes > mConfig.memoryBudget) {
+    evicted.push_back(entry);
+  } else {
+    mEntries.push_front(entry);
+    mEntryMap[entry->key] = mEntries.begin();
+    mMemoryUsage += entry->bytes;
+    while (mMemoryUsage > mConfig.memoryBudget) {
+      evicted.push_back(mEntries.back());
+      mMemoryUsage -= evicted.back()->bytes;
+      mEntryMap.erase(evicted.back()->key);
+      mEntries.pop_back();
+    }
+  }
+  // Without a disk tier, or with its file in use, an entry is dropped
+  std::vector<std::shared_ptr<Entry>> victims;
+  for (auto& victim : evicted) {
+    if (!mConfig.diskPath.empty() && victim->bytes <= mConfig.diskBudget &&
+        mDiskBusy.insert(victim->key).second) {
+      victims.push_back(victim);
+    }
+  }
+  return victims;
+}
+
+/**
+ * @brief Write entries Insert evicted to the disk tier and index them,
+ * called without the lock
+ *
+ * @param victims
+ */
+void ResultCache::Spill(const std::vector<std::shared_ptr<Entry>>& victims) {
+  for (const auto& entry : victims) {
+    const bool written = WriteToDisk(*entry);
+    std::vector<std::string> stale;
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mDiskBusy.erase(entry->key);
+      if (!written) {
+        continue;
+      }
+      if (mEntryMap.find(entry->key) != mEntryMap.end()) {
+        // Stored again while it was written, memory has it
+        stale.push_back(GetDiskFile(entry->key));
+      } else {
+        mDiskEntries.push_front({entry->key, entry->bytes});
+        mDiskMap[entry->key] = mDiskEntries.begin();
+        mDiskUsage += entry->bytes;
+        while (mDiskUsage > mConfig.diskBudget) {
+          stale.push_back(Unindex(std::prev(mDiskEntries.end())));
+        }
+      }
+    }
+    RemoveFiles(stale);
+  }
+}
+
+/**
+ * @brief Write an entry to its file in the disk tier
+ *
+ * @param entry
+ * @return bool false if nothing was written
+ */
+bool ResultCache::WriteToDisk(const Entry& entry) const {
+  std::ofstream file(GetDiskFile(entry.key), std::ios::binary);
+  if (!file) {
+    LOG(ERROR, RESULTCACHE, "Failed to open %s",
+        GetDiskFile(entry.key).c_str());
+    return false;
+  }
+  const uint32_t count = static_cast<uint32_t>(entry.images.size());
+  file.write(reinterpret_cast<const char*>(&kDiskMagic), sizeof(kDiskMagic));
+  file.write(reinterpret_cast<const char*>(&entry.key), sizeof(entry.key));
+  file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (const auto& pImage : entry.images) {
+    const ImageData& image = *pImage;
+    const int32_t header[3] = {static_cast<int32_t>(image.GetFormat()),
+                               image.GetWidth(), image.GetHeight()};
+    const uint64_t size     = image.GetDataSize();
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(image.GetData().data()), size);
+  }
+  const uint64_t metaSize = entry.metadata.size();
+  file.write(reinterpret_cast<const char*>(&metaSize), sizeof(metaSize));
+  file.write(entry.metadata.data(), metaSize);
+  if (!file) {
+    LOG(ERROR, RESULTCACHE, "Failed to write %s",
+        GetDiskFile(entry.key).c_str());
+    file.close();
+    std::remove(GetDiskFile(entry.key).c_str());
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Read a spilled entry back
+ *
+ * @param key
+ * @return std::shared_ptr<ResultCache::Entry> nullptr if unreadable
+ */
+std::shared_ptr<ResultCache::Entry> ResultCache::LoadFromDisk(
+    uint64_t key) const {
+  std::ifstream file(GetDiskFile(key), std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  uint32_t magic  = 0;
+  uint64_t stored = 0;
+  uint32_t count  = 0;
+  file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  file.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+  file.read(reinterpret_cast<char*>(&count), sizeof(count));
+  if (!file || magic != kDiskMagic || stored != key) {
+    LOG(ERROR, RESULTCACHE, "Corrupt cache file %s", GetDiskFile(key).c_str());
+    return nullptr;
+  }
+
+  auto entry   = std::make_shared<Entry>();
+  entry->key   = key;
+  entry->bytes = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    int32_t header[3] = {0, 0, 0};
+    uint64_t size     = 0;
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!file || size > mConfig.diskBudget) {
+      return nullptr;
+    }
+    std::vector<unsigned char> data(size);
+    file.read(reinterpret_cast<char*>(data.data()), size);
+    auto image = std::make_shared<ImageData>(
+        static_cast<ImageFormat>(header[0]), header[1], header[2]);
+    image->SetData(std::move(data));
+    entry->images.push_back(image);
+    entry->bytes += size;
+  }
+  uint64_t metaSize = 0;
+  file.read(reinterpret_cast<char*>(&metaSize), sizeof(metaSize));
+  if (!file || metaSize > mConfig.diskBudget) {
+    return nullptr;
+  }
+  entry->metadata.resize(metaSize);
+  file.read(&entry->metadata[0], metaSize);
+  if (!file) {
+    return nullptr;
+  }
+  entry->bytes += metaSize;
+  return entry;
+}
+
+/**
+ * @brief Forget a spilled entry, called with the lock held
+ *
+ * @param it
+ * @return std::string its file, for RemoveFiles once the lock is released
+ */
+std::string ResultCache::Unindex(std::list<DiskEntry>::iterator it) {
+  std::string file = GetDiskFile(it->key);
+  mDiskUsage -= it->bytes;
+  mDiskMap.erase(it->key);
+  mDiskEntries.erase(it);
+  return file;
+}
+
+/**
+ * @brief Remove files of the disk tier
+ *
+ * @param files
+ */
+void ResultCache::RemoveFiles(const std::vector<std::string>& files) {
+  for (const auto& file : files) {
+    std::remove(file.c_str());
+  }
+}
+
+/**
+ * @brief Path of the file holding a spilled entry
+ *
+ * @param key
+ * @return std::string
+ */
+std::string ResultCache::GetDiskFile(uint64_t key) const {
+  char name[32];
+  snprintf(name, sizeof(name), "%016" PRIx64 ".res", key);
+  return mConfig.diskPath + "/" + name;
+}
+
+/**
+ * @brief Get the configuration
+ *
+ * @return const ResultCacheConfig&
+ */
+const ResultCacheConfig& ResultCache::GetConfig() const {
+  return mConfig;
+}
+
+/**
+ * @brief Bytes held in memory
+ *
+ * @return size_t
+ */
+size_t ResultCache::GetMemoryUsage() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mMemoryUsage;
+}
+
+/**
+ * @brief Bytes spilled to disk
+ *
+ * @return size_t
+ */
+size_t ResultCache::GetDiskUsage() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mDiskUsage;
+}
+
+/**
+ * @brief Entries in both tiers
+ *
+ * @return size_t
+ */
+size_t ResultCache::GetEntryCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size() + mDiskEntries.size();
+}
+
+/**
+ * @brief Lookups answered from the cache
+ *
+ * @return size_t
+ */
+size_t ResultCache::GetHitCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mHits;
+}
+
+/**
+ * @brief Lookups that missed
+ *
+ * @return size_t
+ */
+size_t ResultCache::GetMissCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mMisses;
+}
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "TiledImage.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "FormatPlanner.h"
+#include "Log.h"
+
+#define TILED_IMAGE_MAGIC "GZTILED1"
+
+struct TiledImageHeader {
+  char magic[8];
+  int32_t format;
+  int32_t width;
+  int32_t height;
+  int32_t tileRows;
+};
+
+static std::atomic<int> gMappedTiles{0};
+
+/**
+ * @brief Rows [rowBegin, rowEnd) of a stripe holding them, rowBegin even
+ *
+ * @param stripe
+ * @param rowBegin
+ * @param rowEnd
+ * @return ImageStripe
+ */
+static ImageStripe SubStripe(const ImageStripe& stripe, int rowBegin,
+                             int rowEnd) {
+  ImageStripe sub = stripe;
+  sub.rowBegin    = rowBegin;
+  sub.rowEnd      = rowEnd;
+  for (int p = 0; p < stripe.planes; p++) {
+    sub.data[p] = stripe.Row(p, rowBegin >> stripe.shift[p]);
+  }
+  return sub;
+}
+
+/**
+ * @brief Unmap the tile, writes stay in the file
+ *
+ */
+TiledImage::Tile::~Tile() {
+  if (address) {
+    munmap(address, size);
+    gMappedTiles--;
+  }
+}
+
+/**
+ * @brief Create a tiled image file, replacing what is at path. Width, height
+ * and tileRows must be even so chroma rows never straddle tiles.
+ *
+ * @param path
+ * @param format
+ * @param width
+ * @param height
+ * @param tileRows
+ * @return std::shared_ptr<TiledImage> nullptr on failure
+ */
+std::shared_ptr<TiledImage> TiledImage::Create(const std::string& path,
+                                               ImageFormat format, int width,
+                                               int height, int tileRows) {
+  if (!IsStripeFormat(format) || width <= 0 || height <= 0 || tileRows <= 0 ||
+      ((width | height | tileRows) & 1)) {
+    LOG(ERROR, TILEDIMAGE, "Invalid %s %dx%d tiles of %d rows",
+        GetFormatName(format), width, height, tileRows);
+    return nullptr;
+  }
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG(ERROR, TILEDIMAGE, "Failed to create %s", path.c_str());
+    return nullptr;
+  }
+  TiledImageHeader header;
+  std::memcpy(header.magic, TILED_IMAGE_MAGIC, sizeof(header.magic));
+  header.format   = static_cast<int32_t>(format);
+  header.width    = width;
+  header.height   = height;
+  header.tileRows = tileRows;
+  if (write(fd, &header, sizeof(header)) !=
+      static_cast<ssize_t>(sizeof(header))) {
+    LOG(ERROR, TILEDIMAGE, "Failed to write %s", path.c_str());
+    close(fd);
+    return nullptr;
+  }
+  auto image = Map(path, fd, format, width, height, tileRows);
+  if (image &&
+      ftruncate(fd, static_cast<off_t>(image->mHeaderBytes +
+                                       image->mTileBytes *
+                                           image->GetTileCount())) != 0) {
+    LOG(ERROR, TILEDIMAGE, "Failed to size %s", path.c_str());
+    return nullptr;
+  }
+  return image;
+}
+
+/**
+ * @brief Open a file written by Create
+ *
+ * @param path
+ * @return std::shared_ptr<TiledImage> nullptr if it is not one
+ */
+std::shared_ptr<TiledImage> TiledImage::Open(const std::string& path) {
+  int fd = open(path.c_str(), O_RDWR);
+  if (fd < 0) {
+    LOG(ERROR, TILEDIMAGE, "Failed to open %s", path.c_str());
+    return nullptr;
+  }
+  TiledImageHeader header;
+  if (read(fd, &header, sizeof(header)) !=
+          static_cast<ssize_t>(sizeof(header)) ||
+      std::memcmp(header.magic, TILED_IMAGE_MAGIC, sizeof(header.magic))) {
+    LOG(ERROR, TILEDIMAGE, "%s is not a tiled image", path.c_str());
+    close(fd);
+    return nullptr;
+  }
+  auto image = Map(path, fd, static_cast<ImageFormat>(header.format),
+                   header.width, header.height, header.tileRows);
+  struct stat info;
+  if (image && (fstat(fd, &info) != 0 ||
+                static_cast<size_t>(info.st_size) <
+                    image->mHeaderBytes +
+                        image->mTileBytes * image->GetTileCount())) {
+    LOG(ERROR, TILEDIMAGE, "%s is truncated", path.c_str());
+    return nullptr;
+  }
+  return image;
+}
+
+/**
+ * @brief Take ownership of an open file and work out its tile layout
+ *
+ * @param path
+ * @param fd
+ * @param format
+ * @param width
+ * @param height
+ * @param tileRows
+ * @return std::shared_ptr<TiledImage>
+ */
+std::shared_ptr<TiledImage> TiledImage::Map(const std::string& path, int fd,
+                                            ImageFormat format, int width,
+                                            int height, int tileRows) {
+  std::shared_ptr<TiledImage> image(new TiledImage());
+  image->mFd = fd;
+  if (!IsStripeFormat(format) || width <= 0 || height <= 0 || tileRows <= 0 ||
+      ((width | height | tileRows) & 1)) {
+    LOG(ERROR, TILEDIMAGE, "%s has an invalid layout", path.c_str());
+    return nullptr;
+  }
+  // Tiles are mapped one by one, their offsets have to be page aligned
+  const size_t page   = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t bytes  = GetStripeSize(format, width, 0, tileRows);
+  image->mFormat      = format;
+  image->mWidth       = width;
+  image->mHeight      = height;
+  image->mTileRows    = tileRows;
+  image->mHeaderBytes = page;
+  image->mTileBytes   = (bytes + page - 1) / page * page;
+  return image;
+}
+
+/**
+ * @brief Drop the cached tiles and close the file
+ *
+ */
+TiledImage::~TiledImage() {
+  mTileMap.clear();
+  mTiles.clear();
+  if (mFd >= 0) {
+    close(mFd);
+  }
+}
+
+/**
+ * @brief Number of tiles, the last one may hold fewer rows
+ *
+ * @return int
+ */
+int TiledImage::GetTileCount() const {
+  return (mHeight + mTileRows - 1) / mTileRows;
+}
+
+/**
+ * @brief Set how many tiles stay mapped once their users let go of them
+ *
+ * @param tiles
+ */
+void TiledImage::SetCacheTiles(size_t tiles) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mCacheTiles = tiles;
+  while (mTiles.size() > mCacheTiles) {
+    mTileMap.erase(mTiles.back().first);
+    mTiles.pop_back();
+  }
+}
+
+/**
+ * @brief Tiles kept mapped once their users let go of them
+ *
+ * @return size_t
+ */
+size_t TiledImage::GetCacheTiles() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mCacheTiles;
+}
+
+/**
+ * @brief Map a tile or take it from the cache. Tiles pushed out of the cache
+ * stay mapped while a user holds them.
+ *
+ * @param index
+ * @return std::shared_ptr<TiledImage::Tile> nullptr on failure
+ */
+std::shared_ptr<TiledImage::Tile> TiledImage::AcquireTile(int index) {
+  if (index < 0 || index >= GetTileCount()) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = mTileMap.find(index);
+  if (it != mTileMap.end()) {
+    mTiles.splice(mTiles.begin(), mTiles, it->second);
+    return it->second->second;
+  }
+  const size_t offset = mHeaderBytes + mTileBytes * static_cast<size_t>(index);
+  void* address = mmap(nullptr, mTileBytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, mFd, static_cast<off_t>(offset));
+  if (address == MAP_FAILED) {
+    LOG(ERROR, TILEDIMAGE, "Failed to map tile %d", index);
+    return nullptr;
+  }
+  gMappedTiles++;
+  auto tile     = std::make_shared<Tile>();
+  tile->address = address;
+  tile->size    = mTileBytes;
+  tile->rows    = MapBufferStripe(mFormat, mWidth, mHeight,
+                                  static_cast<unsigned char*>(address),
+                                  index * mTileRows,
+                                  std::min((index + 1) * mTileRows, mHeight));
+  if (mCacheTiles > 0) {
+    mTiles.emplace_front(index, tile);
+    mTileMap[index] = mTiles.begin();
+    while (mTiles.size() > mCacheTiles) {
+      mTileMap.erase(mTiles.back().first);
+      mTiles.pop_back();
+    }
+  }
+  return tile;
+}
+
+/**
+ * @brief Gather luma rows [rowBegin, rowEnd) from the tiles they fall in
+ *
+ * @param rowBegin even
+ * @param rowEnd
+ * @param buffer resized to GetStripeSize of the rows
+ * @param rows the rows mapped in buffer
+ * @return int 0 on success
+ */
+int TiledImage::ReadRows(int rowBegin, int rowEnd,
+                         std::vector<unsigned char>& buffer,
+                         ImageStripe& rows) {
+  if (rowBegin < 0 || rowEnd > mHeight || rowBegin >= rowEnd ||
+      (rowBegin & 1)) {
+    return -1;
+  }
+  buffer.resize(GetStripeSize(mFormat, mWidth, rowBegin, rowEnd));
+  rows = MapBufferStripe(mFormat, mWidth, mHeight, buffer.data(), rowBegin,
+                         rowEnd);
+  for (int index = rowBegin / mTileRows; index * mTileRows < rowEnd;
+       index++) {
+    auto tile = AcquireTile(index);
+    if (!tile) {
+      return -1;
+    }
+    ImageStripe part =
+        SubStripe(rows, std::max(rowBegin, tile->rows.rowBegin),
+                  std::min(rowEnd, tile->rows.rowEnd));
+    CopyStripe(tile->rows, part);
+  }
+  return 0;
+}
+
+/**
+ * @brief Scatter the rows held by a stripe into the tiles they fall in
+ *
+ * @param rows rowBegin even, the layout of the image
+ * @return int 0 on success
+ */
+int TiledImage::WriteRows(const ImageStripe& rows) {
+  if (rows.format != mFormat || rows.width != mWidth ||
+      rows.rowBegin < 0 || rows.rowEnd > mHeight ||
+      rows.rowBegin >= rows.rowEnd || (rows.rowBegin & 1)) {
+    return -1;
+  }
+  for (int index = rows.rowBegin / mTileRows; index * mTileRows < rows.rowEnd;
+       index++) {
+    auto tile = AcquireTile(index);
+    if (!tile) {
+      return -1;
+    }
+    ImageStripe part =
+        SubStripe(tile->rows, std::max(rows.rowBegin, tile->rows.rowBegin),
+                  std::min(rows.rowEnd, tile->rows.rowEnd));
+    CopyStripe(rows, part);
+  }
+  return 0;
+}
+
+/**
+ * @brief Copy a whole image in, it must match the format and size
+ *
+ * @param image
+ * @return int 0 on success
+ */
+int TiledImage::WriteImage(const ImageData& image) {
+  if (image.GetFormat() != mFormat || image.GetWidth() != mWidth ||
+      image.GetHeight() != mHeight ||
+      image.GetDataSize() < GetStripeSize(mFormat, mWidth, 0, mHeight)) {
+    LOG(ERROR, TILEDIMAGE, "Image does not match %s %dx%d",
+        GetFormatName(mFormat), mWidth, mHeight);
+    return -1;
+  }
+  // Only read
+  auto* frame = const_cast<unsigned char*>(image.GetData().data());
+  return WriteRows(MapFrameStripe(mFormat, mWidth, mHeight, frame, 0, mHeight));
+}
+
+/**
+ * @brief Copy the whole image out
+ *
+ * @return std::shared_ptr<ImageData> nullptr on failure
+ */
+std::shared_ptr<ImageData> TiledImage::ReadImage() {
+  std::vector<unsigned char> frame(
+      GetStripeSize(mFormat, mWidth, 0, mHeight));
+  for (int index = 0; index < GetTileCount(); index++) {
+    auto tile = AcquireTile(index);
+    if (!tile) {
+      return nullptr;
+    }
+    ImageStripe rows =
+        MapFrameStripe(mFormat, mWidth, mHeight, frame.data(),
+                       tile->rows.rowBegin, tile->rows.rowEnd);
+    CopyStripe(tile->rows, rows);
+  }
+  auto image = std::make_shared<ImageData>(mFormat, mWidth, mHeight);
+  image->SetData(std::move(frame));
+  return image;
+}
+
+/**
+ * @brief Tiles mapped by every TiledImage of the process
+ *
+ * @return int
+ */
+int TiledImage::GetMappedTiles() {
+  return gMappedTiles;
+}
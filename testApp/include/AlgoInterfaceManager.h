@@ -42,17 +42,22 @@ using AlgoInterfaceProcessFunc = int (*)(void**, std::shared_ptr<AlgoRequest>,
                                          std::vector<AlgoId>);
 using RegisterCallbackFunc     = int (*)(void**,
                                      int (*)(std::shared_ptr<AlgoRequest>));
+using AlgoInterfaceSubmitFrameFunc = int (*)(void**, int, int64_t, int,
+                                             std::shared_ptr<ImageData>,
+                                             std::vector<AlgoId>,
+                                             std::shared_ptr<AlgoRequest>);
 
 class AlgoInterfaceptr {
  public:
   AlgoInterfaceptr(const std::string& path);
   ~AlgoInterfaceptr();
   void* getSymbol(const char* symbolName);
-  InitAlgoInterfaceFunc initFunc            = nullptr;
-  DeInitAlgoInterfaceFunc deinitFunc        = nullptr;
-  AlgoInterfaceProcessFunc processFunc      = nullptr;
-  RegisterCallbackFunc registerCallbackFunc = nullptr;
-  void* libraryHandle                       = nullptr;
+  InitAlgoInterfaceFunc initFunc               = nullptr;
+  DeInitAlgoInterfaceFunc deinitFunc           = nullptr;
+  AlgoInterfaceProcessFunc processFunc         = nullptr;
+  RegisterCallbackFunc registerCallbackFunc    = nullptr;
+  AlgoInterfaceSubmitFrameFunc submitFrameFunc = nullptr;
+  void* libraryHandle                          = nullptr;
 };
 
 struct AlgoMetadataList {
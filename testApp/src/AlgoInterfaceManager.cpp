@@ -81,8 +81,10 @@ AlgoInterfaceptr::AlgoInterfaceptr(const std::string& path) {
   deinitFunc           = LOAD_SYM(DeInitAlgoInterface);
   processFunc          = LOAD_SYM(AlgoInterfaceProcess);
   registerCallbackFunc = LOAD_SYM(RegisterCallback);
+  submitFrameFunc      = LOAD_SYM(AlgoInterfaceSubmitFrame);
 
-  if (!initFunc || !deinitFunc || !processFunc || !registerCallbackFunc) {
+  if (!initFunc || !deinitFunc || !processFunc || !registerCallbackFunc ||
+      !submitFrameFunc) {
     std::cerr << "Failed to load one or more functions from the library."
               << std::endl;
 
@@ -315,33 +317,25 @@ int AlgoInterfaceManager::SubmitStereoRequest() {
       }
     }
 
-    // prepare and submit request
-    auto request                            = std::make_shared<AlgoRequest>();
-    request->mRequestId                     = mRequestId++;
-    std::vector<unsigned char> Inputyuvbuf1 = yuvStereoBufferp[0];
-    std::vector<unsigned char> Inputyuvbuf2 = yuvStereoBufferp[1];
-    rc = request->AddImage(ImageFormat::YUV420, mWidth, mHeight,
-                           std::move(Inputyuvbuf1));
-    if (rc != 0) {
-      std::cerr << "Failed to add image to request 1 rc=" << rc << std::endl;
-      return -1;
-    }
-    rc = request->AddImage(ImageFormat::YUV420, mWidth, mHeight,
-                           std::move(Inputyuvbuf2));
-    if (rc != 0) {
-      std::cerr << "Failed to add image to request 2 rc=" << rc << std::endl;
-      return -2;
-    }
-    request->mMetadata.SetMetadata(MetaId::IMAGE_WIDTH, mWidth);
-    request->mMetadata.SetMetadata(MetaId::IMAGE_HEIGHT, mHeight);
-    SetMetadata(request);
+    // Algos are picked once per pair, the library pairs the two views into
+    // the settings request, which keeps its id and metadata
+    auto settings        = std::make_shared<AlgoRequest>();
+    settings->mRequestId = mRequestId;
+    SetMetadata(settings);
     std::vector<AlgoId> algoSuggested =
-        m_algoDecisionManager.ParseMetadata(request);
-    rc = phandle->processFunc(&phandle->libraryHandle, request, algoSuggested);
-    if (rc != 0) {
-      std::cerr << "Failed to process algorithm request rc = " << rc
-                << std::endl;
-      return -3;
+        m_algoDecisionManager.ParseMetadata(settings);
+    const int64_t timestampUs = static_cast<int64_t>(mRequestId++) * 33333;
+    for (int i = 0; i < 2; ++i) {
+      auto frame =
+          std::make_shared<ImageData>(ImageFormat::YUV420, mWidth, mHeight);
+      frame->SetData(std::vector<unsigned char>(yuvStereoBufferp[i]));
+      rc = phandle->submitFrameFunc(&phandle->libraryHandle, i, timestampUs, 0,
+                                    frame, algoSuggested, settings);
+      if (rc != 0) {
+        std::cerr << "Failed to submit stereo frame " << i << " rc = " << rc
+                  << std::endl;
+        return -1;
+      }
     }
     ++g_SubmittedCount;
   } else {
@@ -395,5 +389,6 @@ void AlgoInterfaceManager::Cleanup() {
   phandle->initFunc             = nullptr;
   phandle->deinitFunc           = nullptr;
   phandle->processFunc          = nullptr;
+  phandle->submitFrameFunc      = nullptr;
   phandle->registerCallbackFunc = nullptr;
 }
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "../Utils/include/BilateralGrid.h"
+
+// Step from 60 to 180 at the middle column with +-8 noise
+static std::vector<unsigned char> NoisyStep(int width, int height) {
+  std::vector<unsigned char> plane(static_cast<size_t>(width) * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const int base = x < width / 2 ? 60 : 180;
+      plane[static_cast<size_t>(y) * width + x] =
+          static_cast<unsigned char>(base + (rand() % 17) - 8);
+    }
+  }
+  return plane;
+}
+
+TEST(BilateralGridBench, FullHdLuma) {
+  const int width  = 1920;
+  const int height = 1080;
+  const auto src   = NoisyStep(width, height);
+  std::vector<unsigned char> dst(src.size());
+  // Warm up the tile executor and the caches
+  BilateralFilterPlane(src.data(), dst.data(), width, height, width, 1, 8.0f,
+                       16.0f);
+  const int iterations = 5;
+  const auto start     = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    BilateralFilterPlane(src.data(), dst.data(), width, height, width, 1,
+                         8.0f, 16.0f);
+  }
+  const double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count() /
+                    iterations;
+  std::cout << "BilateralGrid " << width << "x" << height << " luma " << ms
+            << " ms" << std::endl;
+}
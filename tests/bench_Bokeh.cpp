@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "test_common.h"
+
+std::atomic<int> g_BenchCallbacks{0};
+std::shared_ptr<AlgoRequest> g_BenchOutput = nullptr;
+int BenchCallback(std::shared_ptr<AlgoRequest> input) {
+  g_BenchOutput = input;
+  g_BenchCallbacks++;
+  return 0;
+}
+
+// The interface library loaded the way clients load it
+class BokehBench : public ::testing::Test {
+ protected:
+  void* libhandle              = nullptr;
+  void* algoHandle             = nullptr;
+  Init InitAlgoInterface       = nullptr;
+  DeInit DeInitAlgoInterface   = nullptr;
+  Process AlgoInterfaceProcess = nullptr;
+  Callback RegisterCallback    = nullptr;
+
+  void SetUp() override {
+    libhandle = dlopen(FULLALGOLIBPATH.c_str(), RTLD_LAZY);
+    ASSERT_NE(libhandle, nullptr) << dlerror();
+    InitAlgoInterface =
+        reinterpret_cast<Init>(dlsym(libhandle, "InitAlgoInterface"));
+    DeInitAlgoInterface =
+        reinterpret_cast<DeInit>(dlsym(libhandle, "DeInitAlgoInterface"));
+    AlgoInterfaceProcess =
+        reinterpret_cast<Process>(dlsym(libhandle, "AlgoInterfaceProcess"));
+    RegisterCallback =
+        reinterpret_cast<Callback>(dlsym(libhandle, "RegisterCallback"));
+    ASSERT_NE(InitAlgoInterface, nullptr);
+    ASSERT_NE(DeInitAlgoInterface, nullptr);
+    ASSERT_NE(AlgoInterfaceProcess, nullptr);
+    ASSERT_NE(RegisterCallback, nullptr);
+    ASSERT_EQ(InitAlgoInterface(&algoHandle), 0);
+  }
+
+  void TearDown() override {
+    g_BenchOutput = nullptr;
+    if (algoHandle) {
+      EXPECT_EQ(DeInitAlgoInterface(&algoHandle), 0);
+    }
+    if (libhandle) {
+      dlclose(libhandle);
+    }
+  }
+};
+
+TEST_F(BokehBench, LatencyBudgetAt1080p) {
+  const int width  = 1920;
+  const int height = 1080;
+  ConfigParser parser;
+  parser.loadFile((CONFIGPATH + std::string("BokehAlgorithm.config")).c_str());
+  const int budgetMs = parser.getIntValue("LatencyBudgetMs");
+  ASSERT_GT(budgetMs, 0);
+  int status = RegisterCallback(&algoHandle, BenchCallback);
+  ASSERT_EQ(status, 0);
+
+  // Random texture, a near box over a far background
+  std::vector<unsigned char> left(width * height * 3 / 2, 128);
+  std::vector<unsigned char> right(left.size(), 128);
+  unsigned int seed = 1;
+  for (int i = 0; i < width * height; i++) {
+    seed    = seed * 1103515245 + 12345;
+    left[i] = static_cast<unsigned char>(seed >> 16);
+  }
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const bool near = x > width / 3 && x < width * 2 / 3 &&
+                        y > height / 4 && y < height * 3 / 4;
+      const int xr    = std::max(0, x - (near ? 16 : 4));
+      right[y * width + xr] = left[y * width + x];
+    }
+  }
+
+  // Steady state latency, the first frame also seeds the search range
+  int bestMs = -1;
+  for (int iter = 0; iter < 3; iter++) {
+    auto request        = std::make_shared<AlgoRequest>();
+    request->mRequestId = 600 + iter;
+    ASSERT_EQ(request->AddImage(ImageFormat::YUV420, width, height,
+                                std::vector<unsigned char>(left)),
+              0);
+    ASSERT_EQ(request->AddImage(ImageFormat::YUV420, width, height,
+                                std::vector<unsigned char>(right)),
+              0);
+    g_BenchCallbacks = 0;
+    g_BenchOutput     = nullptr;
+    status = AlgoInterfaceProcess(&algoHandle, request, {ALGO_BOKEH});
+    ASSERT_EQ(status, 0);
+    while (g_BenchCallbacks == 0) {
+      usleep(50);
+    }
+    ASSERT_NE(g_BenchOutput, nullptr);
+    ASSERT_EQ(g_BenchOutput->GetImage(0)->GetDataSize(), left.size());
+    int latencyMs = -1;
+    ASSERT_EQ(g_BenchOutput->mMetadata.GetMetadata(
+                  MetaId::BOKEH_LATENCY_MS, latencyMs),
+              0);
+    bestMs = bestMs < 0 ? latencyMs : std::min(bestMs, latencyMs);
+  }
+  std::cout << "Bokeh 1920x1080 " << bestMs << " ms, budget " << budgetMs
+            << " ms" << std::endl;
+  EXPECT_LE(bestMs, budgetMs);
+}
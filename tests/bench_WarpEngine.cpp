@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "../Utils/include/WarpEngine.h"
+#ifdef __OPENCV_ENABLE__
+#include <opencv2/opencv.hpp>
+#endif
+
+static std::vector<unsigned char> RandomPlane(int width, int height) {
+  std::vector<unsigned char> plane(static_cast<size_t>(width) * height);
+  for (auto& value : plane) {
+    value = static_cast<unsigned char>(rand() & 0xff);
+  }
+  return plane;
+}
+
+static void ZoomMatrix(double matrix[9], int width, int height, double scale,
+                       double angle) {
+  // Output to source: rotate and scale about the image centre
+  const double c  = std::cos(angle) / scale;
+  const double s  = std::sin(angle) / scale;
+  const double cx = width * 0.5;
+  const double cy = height * 0.5;
+  matrix[0]       = c;
+  matrix[1]       = s;
+  matrix[2]       = cx - c * cx - s * cy;
+  matrix[3]       = -s;
+  matrix[4]       = c;
+  matrix[5]       = cy + s * cx - c * cy;
+  matrix[6]       = 1e-5;
+  matrix[7]       = -2e-5;
+  matrix[8]       = 1.0;
+}
+
+TEST(WarpEngineBench, AgainstWarpPerspective) {
+  struct Size {
+    int width;
+    int height;
+  };
+  for (const Size& size : {Size{1920, 1080}, Size{3840, 2160}}) {
+    const auto input = RandomPlane(size.width, size.height);
+    std::vector<unsigned char> output(input.size());
+    const unsigned char* src = input.data();
+    unsigned char* dst       = output.data();
+    double matrix[9];
+    ZoomMatrix(matrix, size.width, size.height, 1.2, 0.1);
+
+    const int iterations = 3;
+    auto start           = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      WarpPerspective(&src, &dst, 1, size.width, size.height, 1, matrix, 0);
+    }
+    const double nativeMs = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count() /
+                            iterations;
+    std::cout << "WarpPerspective " << size.width << "x" << size.height
+              << " native " << nativeMs << " ms";
+#ifdef __OPENCV_ENABLE__
+    cv::Mat srcMat(size.height, size.width, CV_8UC1,
+                   const_cast<unsigned char*>(input.data()));
+    cv::Mat M(3, 3, CV_64F, matrix);
+    cv::Mat dstMat;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      cv::warpPerspective(srcMat, dstMat, M, srcMat.size(),
+                          cv::INTER_LINEAR | cv::WARP_INVERSE_MAP);
+    }
+    const double cvMs = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count() /
+                        iterations;
+    int maxDiff = 0;
+    for (size_t i = 0; i < output.size(); i++) {
+      maxDiff = std::max(maxDiff, std::abs(output[i] - dstMat.data[i]));
+    }
+    std::cout << ", OpenCV " << cvMs << " ms, max diff " << maxDiff;
+#endif
+    std::cout << std::endl;
+  }
+}
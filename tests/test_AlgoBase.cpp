@@ -327,3 +327,44 @@ TEST(AlgoBaseTest, AlgoTimeOutCallback) {
   }
   EXPECT_EQ(g_Timeoutcallbacks, 100);
 }
+
+struct FrameCountState : AlgoBase::StreamState {
+  int frames = 0;
+};
+
+/**
+ * @brief Mock node counting the frames of every stream it sees
+ */
+class MockStreamAlgo : public MockDerivedAlgo {
+ public:
+  explicit MockStreamAlgo(const char* name) : MockDerivedAlgo(name) {}
+  AlgoStatus Process(std::shared_ptr<AlgoRequest> req) override {
+    GetStreamState<FrameCountState>(req).frames++;
+    return MockDerivedAlgo::Process(req);
+  }
+  int GetFrames(std::shared_ptr<AlgoRequest> req) {
+    return GetStreamState<FrameCountState>(req).frames;
+  }
+};
+
+TEST(AlgoBaseTest, StreamStateIsPerStream) {
+  MockStreamAlgo node("StreamAlgorithm");
+  auto left        = std::make_shared<AlgoRequest>();
+  auto right       = std::make_shared<AlgoRequest>();
+  left->mStreamId  = 0;
+  right->mStreamId = 1;
+
+  // Interleaved streams keep separate counts
+  for (int i = 0; i < 3; i++) {
+    node.Process(left);
+    node.Process(right);
+  }
+  node.Process(right);
+  EXPECT_EQ(node.GetFrames(left), 3);
+  EXPECT_EQ(node.GetFrames(right), 4);
+  EXPECT_EQ(node.GetStreamCount(), 2u);
+
+  node.ResetStreamState(1);
+  EXPECT_EQ(node.GetStreamCount(), 1u);
+  EXPECT_EQ(node.GetFrames(right), 0);
+}
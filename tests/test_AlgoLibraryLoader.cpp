@@ -37,6 +37,9 @@ class AlgoLibraryLoaderTest : public ::testing::Test {
       {ALGO_FILTER, "com.Algo.Filter.so"},
       {ALGO_MANDELBROTSET, "com.Algo.MandelbrotSet.so"},
       {ALGO_LDC, "com.Algo.Ldc.so"},
+      {ALGO_SWJPEGDEC, "com.Algo.SwJpegDec.so"},
+      {ALGO_SCALER, "com.Algo.Scaler.so"},
+      {ALGO_ROTATE, "com.Algo.Rotate.so"},
   };
 };
 
@@ -53,4 +53,47 @@ TEST(AlgoMetadataTest, GetSetMetadataFloat) {
 
   // Get non-existent metadata
   ASSERT_EQ(metadata.GetMetadata(MetaId::MODIFICATION_HISTORY, value), -1);
-}
\ No newline at end of file
+}
+TEST(AlgoMetadataTest, SerializeRoundTrip) {
+  AlgoMetadata a, b;
+  ASSERT_EQ(a.SetMetadata(MetaId::IMAGE_WIDTH, 640), 0);
+  ASSERT_EQ(a.SetMetadata(MetaId::EXPOSURE_TIME, 8.5f), 0);
+  ASSERT_EQ(a.SetMetadata(MetaId::FLASH_STATE, true), 0);
+  ASSERT_EQ(a.SetMetadata(MetaId::ALGO_REQUSET_NUMBER, 7), 0);
+  ASSERT_EQ(a.SetMetadata(MetaId::FRAME_HASH, INT64_C(-0x123456789)), 0);
+  // Insertion order does not change the bytes
+  ASSERT_EQ(b.SetMetadata(MetaId::FLASH_STATE, true), 0);
+  ASSERT_EQ(b.SetMetadata(MetaId::EXPOSURE_TIME, 8.5f), 0);
+  ASSERT_EQ(b.SetMetadata(MetaId::IMAGE_WIDTH, 640), 0);
+  ASSERT_EQ(b.SetMetadata(MetaId::FRAME_HASH, INT64_C(-0x123456789)), 0);
+  ASSERT_EQ(a.SetMetadata(MetaId::LUMA_HISTOGRAM, {3, -1, 0, 7}), 0);
+  ASSERT_EQ(a.SetMetadata(MetaId::LUMA_BLOCK_MEANS, std::vector<int32_t>()), 0);
+  ASSERT_EQ(b.SetMetadata(MetaId::LUMA_BLOCK_MEANS, std::vector<int32_t>()), 0);
+  ASSERT_EQ(b.SetMetadata(MetaId::LUMA_HISTOGRAM, {3, -1, 0, 7}), 0);
+  ASSERT_NE(a.Serialize(), b.Serialize());
+  ASSERT_EQ(a.Serialize({MetaId::ALGO_REQUSET_NUMBER}),
+            b.Serialize({MetaId::ALGO_REQUSET_NUMBER}));
+
+  AlgoMetadata c;
+  int width    = 0;
+  float time   = 0.0f;
+  bool flash   = false;
+  int64_t hash = 0;
+  ASSERT_EQ(c.Deserialize(a.Serialize()), 0);
+  ASSERT_EQ(c.GetMetadata(MetaId::IMAGE_WIDTH, width), 0);
+  ASSERT_EQ(width, 640);
+  ASSERT_EQ(c.GetMetadata(MetaId::EXPOSURE_TIME, time), 0);
+  ASSERT_EQ(time, 8.5f);
+  ASSERT_EQ(c.GetMetadata(MetaId::FLASH_STATE, flash), 0);
+  ASSERT_TRUE(flash);
+  ASSERT_EQ(c.GetMetadata(MetaId::FRAME_HASH, hash), 0);
+  ASSERT_EQ(hash, INT64_C(-0x123456789));
+  std::vector<int32_t> list;
+  ASSERT_EQ(c.GetMetadata(MetaId::LUMA_HISTOGRAM, list), 0);
+  ASSERT_EQ(list, std::vector<int32_t>({3, -1, 0, 7}));
+  ASSERT_EQ(c.GetMetadata(MetaId::LUMA_BLOCK_MEANS, list), 0);
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(c.Deserialize("bad"), -1);
+  const std::string blob = a.Serialize();
+  ASSERT_EQ(c.Deserialize(blob.substr(0, blob.size() - 4)), -1);
+}
@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include "test_common.h"
 
@@ -193,4 +195,537 @@ TEST_F(AlgoProcessTest, TestComboNodes) {
     }
     ASSERT_EQ(g_ProcessedFlagAlgoProcessTest, ExpectedFlag);
   }
-}
\ No newline at end of file
+}
+
+std::shared_ptr<AlgoRequest> g_JpegRoundTripOutput = nullptr;
+int JpegRoundTripCallback(std::shared_ptr<AlgoRequest> input) {
+  g_JpegRoundTripOutput = input;
+  g_AlgoProcessTestCallback++;
+  return 0;
+}
+
+TEST_F(AlgoProcessTest, JpegEncodeDecodeScaled) {
+  int status = RegisterCallback(&algoHandle, JpegRoundTripCallback);
+  ASSERT_EQ(status, 0);
+
+  for (int scaleDenom : {1, 2, 4, 8}) {
+    g_AlgoProcessTestCallback = 0;
+    g_JpegRoundTripOutput     = nullptr;
+    std::vector<unsigned char> yuvData(WIDTH * HEIGHT * 3 / 2, 128);
+    auto request        = std::make_shared<AlgoRequest>();
+    request->mRequestId = 200 + scaleDenom;
+    int rc              = request->AddImage(ImageFormat::YUV420, WIDTH, HEIGHT,
+                                            std::move(yuvData));
+    ASSERT_EQ(rc, 0);
+    rc = request->mMetadata.SetMetadata(MetaId::JPEG_DECODE_SCALE, scaleDenom);
+    ASSERT_EQ(rc, 0);
+
+    status =
+        AlgoInterfaceProcess(&algoHandle, request, {ALGO_SWJPEG, ALGO_SWJPEGDEC});
+    ASSERT_EQ(status, 0);
+    while (g_AlgoProcessTestCallback == 0) {
+      usleep(50);
+    }
+
+    ASSERT_NE(g_JpegRoundTripOutput, nullptr);
+    auto image = g_JpegRoundTripOutput->GetImage(0);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->GetFormat(), ImageFormat::YUV420);
+    EXPECT_EQ(image->GetWidth(), WIDTH / scaleDenom);
+    EXPECT_EQ(image->GetHeight(), HEIGHT / scaleDenom);
+    EXPECT_EQ(image->GetDataSize(),
+              (size_t)(WIDTH / scaleDenom) * (HEIGHT / scaleDenom) * 3 / 2);
+  }
+}
+
+TEST_F(AlgoProcessTest, WaterMarkBlendsOnlyCorner) {
+  int status = RegisterCallback(&algoHandle, JpegRoundTripCallback);
+  ASSERT_EQ(status, 0);
+
+  std::vector<unsigned char> firstOutput;
+  for (int iter = 0; iter < 2; iter++) {
+    g_AlgoProcessTestCallback = 0;
+    g_JpegRoundTripOutput     = nullptr;
+    std::vector<unsigned char> yuvData(WIDTH * HEIGHT * 3 / 2, 128);
+    auto request        = std::make_shared<AlgoRequest>();
+    request->mRequestId = 300 + iter;
+    int rc              = request->AddImage(ImageFormat::YUV420, WIDTH, HEIGHT,
+                                            std::move(yuvData));
+    ASSERT_EQ(rc, 0);
+
+    status = AlgoInterfaceProcess(&algoHandle, request, {ALGO_WATERMARK});
+    ASSERT_EQ(status, 0);
+    while (g_AlgoProcessTestCallback == 0) {
+      usleep(50);
+    }
+
+    ASSERT_NE(g_JpegRoundTripOutput, nullptr);
+    auto image = g_JpegRoundTripOutput->GetImage(0);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->GetFormat(), ImageFormat::YUV420);
+    ASSERT_EQ(image->GetDataSize(), (size_t)WIDTH * HEIGHT * 3 / 2);
+
+    // Watermark sits bottom right, top left quadrant must be untouched
+    const auto& data = image->GetData();
+    for (int y = 0; y < HEIGHT / 2; y++) {
+      for (int x = 0; x < WIDTH / 2; x++) {
+        ASSERT_EQ(data[y * WIDTH + x], 128) << "x=" << x << " y=" << y;
+      }
+    }
+
+    // Cached overlay gives the same result on the next frame
+    if (iter == 0) {
+      firstOutput = data;
+    } else {
+      EXPECT_EQ(firstOutput, data);
+    }
+  }
+}
+
+TEST_F(AlgoProcessTest, LdcKeepsCentreAndMovesCorners) {
+  int status = RegisterCallback(&algoHandle, JpegRoundTripCallback);
+  ASSERT_EQ(status, 0);
+
+  std::vector<unsigned char> yuvData(WIDTH * HEIGHT * 3 / 2, 128);
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      yuvData[y * WIDTH + x] = static_cast<unsigned char>((x * 7 + y * 3) & 0xff);
+    }
+  }
+  const std::vector<unsigned char> input = yuvData;
+
+  g_AlgoProcessTestCallback = 0;
+  g_JpegRoundTripOutput     = nullptr;
+  auto request              = std::make_shared<AlgoRequest>();
+  request->mRequestId       = 400;
+  int rc = request->AddImage(ImageFormat::YUV420, WIDTH, HEIGHT,
+                             std::move(yuvData));
+  ASSERT_EQ(rc, 0);
+
+  status = AlgoInterfaceProcess(&algoHandle, request, {ALGO_LDC});
+  ASSERT_EQ(status, 0);
+  while (g_AlgoProcessTestCallback == 0) {
+    usleep(50);
+  }
+
+  ASSERT_NE(g_JpegRoundTripOutput, nullptr);
+  auto image = g_JpegRoundTripOutput->GetImage(0);
+  ASSERT_NE(image, nullptr);
+  EXPECT_EQ(image->GetFormat(), ImageFormat::YUV420);
+  ASSERT_EQ(image->GetDataSize(), input.size());
+
+  // Principal point maps onto itself, the lens model bends the corners
+  const auto& data  = image->GetData();
+  const int centre  = (HEIGHT / 2) * WIDTH + WIDTH / 2;
+  EXPECT_EQ(data[centre], input[centre]);
+  EXPECT_NE(std::vector<unsigned char>(data.begin(), data.begin() + WIDTH),
+            std::vector<unsigned char>(input.begin(), input.begin() + WIDTH));
+}
+
+// Sum of horizontal luma differences, lower once the frame is blurred
+static size_t LumaVariation(const std::vector<unsigned char>& data, int width,
+                            int height) {
+  size_t variation = 0;
+  for (int y = 0; y < height; y++) {
+    for (int x = 1; x < width; x++) {
+      variation += std::abs(data[y * width + x] - data[y * width + x - 1]);
+    }
+  }
+  return variation;
+}
+
+TEST_F(AlgoProcessTest, BokehBlursAwayFromFocus) {
+  const int width  = 384;
+  const int height = 288;
+  int status       = RegisterCallback(&algoHandle, JpegRoundTripCallback);
+  ASSERT_EQ(status, 0);
+
+  auto request        = std::make_shared<AlgoRequest>();
+  request->mRequestId = 500;
+  std::vector<unsigned char> left;
+  for (const char* name : {"tsukuba_l.yuv", "tsukuba_r.yuv"}) {
+    std::ifstream file(RESPATH + name, std::ios::binary);
+    ASSERT_TRUE(file.is_open()) << name;
+    std::vector<unsigned char> yuvData(width * height * 3 / 2);
+    file.read(reinterpret_cast<char*>(yuvData.data()), yuvData.size());
+    ASSERT_EQ(file.gcount(), (std::streamsize)yuvData.size());
+    if (left.empty()) {
+      left = yuvData;
+    }
+    ASSERT_EQ(request->AddImage(ImageFormat::YUV420, width, height,
+                                std::move(yuvData)),
+              0);
+  }
+
+  g_AlgoProcessTestCallback = 0;
+  g_JpegRoundTripOutput     = nullptr;
+  status = AlgoInterfaceProcess(&algoHandle, request, {ALGO_BOKEH});
+  ASSERT_EQ(status, 0);
+  while (g_AlgoProcessTestCallback == 0) {
+    usleep(50);
+  }
+
+  ASSERT_NE(g_JpegRoundTripOutput, nullptr);
+  int done = 0;
+  g_JpegRoundTripOutput->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE,
+                                               done);
+  EXPECT_TRUE(done & ALGO_MASK(ALGO_BOKEH));
+  ASSERT_EQ(g_JpegRoundTripOutput->GetImageCount(), 1u);
+  auto image = g_JpegRoundTripOutput->GetImage(0);
+  EXPECT_EQ(image->GetFormat(), ImageFormat::YUV420);
+  EXPECT_EQ(image->GetWidth(), width);
+  ASSERT_EQ(image->GetDataSize(), left.size());
+
+  // The focus plane stays sharp, the rest of the scene is blurred
+  const auto& data = image->GetData();
+  size_t unchanged = 0;
+  for (int i = 0; i < width * height; i++) {
+    unchanged += data[i] == left[i];
+  }
+  EXPECT_GT(unchanged, (size_t)width * height / 20);
+  EXPECT_LT(LumaVariation(data, width, height),
+            LumaVariation(left, width, height) * 9 / 10);
+}
+
+TEST_F(AlgoProcessTest, HdrFusesExposures) {
+  int status = RegisterCallback(&algoHandle, JpegRoundTripCallback);
+  ASSERT_EQ(status, 0);
+
+  // Textured ramp seen at three exposures, clipped at both ends
+  std::vector<float> scene(WIDTH * HEIGHT);
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      scene[y * WIDTH + x] = (8.0f + 240.0f * x / WIDTH) *
+                             (((x / 4 + y / 4) & 1) ? 1.1f : 0.9f);
+    }
+  }
+  auto request        = std::make_shared<AlgoRequest>();
+  request->mRequestId = 700;
+  std::vector<unsigned char> mid;
+  for (float gain : {0.25f, 1.0f, 4.0f}) {
+    std::vector<unsigned char> yuvData(WIDTH * HEIGHT * 3 / 2, 128);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+      yuvData[i] = static_cast<unsigned char>(
+          std::min(255.0f, scene[i] * gain + 0.5f));
+    }
+    if (gain == 1.0f) {
+      mid = yuvData;
+    }
+    ASSERT_EQ(request->AddImage(ImageFormat::YUV420, WIDTH, HEIGHT,
+                                std::move(yuvData)),
+              0);
+  }
+
+  g_AlgoProcessTestCallback = 0;
+  g_JpegRoundTripOutput     = nullptr;
+  status = AlgoInterfaceProcess(&algoHandle, request, {ALGO_HDR});
+  ASSERT_EQ(status, 0);
+  while (g_AlgoProcessTestCallback == 0) {
+    usleep(50);
+  }
+
+  ASSERT_NE(g_JpegRoundTripOutput, nullptr);
+  int done = 0;
+  g_JpegRoundTripOutput->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE,
+                                               done);
+  EXPECT_TRUE(done & ALGO_MASK(ALGO_HDR));
+  ASSERT_EQ(g_JpegRoundTripOutput->GetImageCount(), 1u);
+  auto image = g_JpegRoundTripOutput->GetImage(0);
+  EXPECT_EQ(image->GetFormat(), ImageFormat::YUV420);
+  ASSERT_EQ(image->GetDataSize(), mid.size());
+
+  // Shadows are lifted and highlights pulled back from clipping
+  const auto& data = image->GetData();
+  size_t darkOut = 0, darkMid = 0, brightOut = 0;
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH / 8; x++) {
+      darkOut += data[y * WIDTH + x];
+      darkMid += mid[y * WIDTH + x];
+    }
+    for (int x = WIDTH - WIDTH / 8; x < WIDTH; x++) {
+      brightOut += data[y * WIDTH + x];
+    }
+  }
+  EXPECT_GT(darkOut, darkMid);
+  EXPECT_LT(brightOut, (size_t)250 * HEIGHT * (WIDTH / 8));
+}
+
+TEST_F(AlgoProcessTest, AssembledStereoPairReachesBokeh) {
+  auto AlgoInterfaceSubmitFrame = reinterpret_cast<SubmitFrame>(
+      dlsym(libhandle, "AlgoInterfaceSubmitFrame"));
+  ASSERT_NE(AlgoInterfaceSubmitFrame, nullptr);
+  int status = RegisterCallback(&algoHandle, JpegRoundTripCallback);
+  ASSERT_EQ(status, 0);
+
+  g_AlgoProcessTestCallback = 0;
+  g_JpegRoundTripOutput     = nullptr;
+  auto settings             = std::make_shared<AlgoRequest>();
+  settings->mRequestId      = 4242;
+  settings->mMetadata.SetMetadata(MetaId::ALGO_BOKEH_ENABLED, 1);
+  for (int view = 0; view < 2; view++) {
+    auto frame =
+        std::make_shared<ImageData>(ImageFormat::YUV420, WIDTH, HEIGHT);
+    frame->SetData(std::vector<unsigned char>(WIDTH * HEIGHT * 3 / 2, 128));
+    // Views captured 500us apart still form one request
+    status = AlgoInterfaceSubmitFrame(&algoHandle, view, 1000000 + view * 500,
+                                      0, frame, {ALGO_BOKEH}, settings);
+    ASSERT_EQ(status, 0);
+  }
+  while (g_AlgoProcessTestCallback == 0) {
+    usleep(50);
+  }
+
+  ASSERT_NE(g_JpegRoundTripOutput, nullptr);
+  int done = 0;
+  g_JpegRoundTripOutput->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE,
+                                               done);
+  EXPECT_TRUE(done & ALGO_MASK(ALGO_BOKEH));
+  EXPECT_EQ(g_JpegRoundTripOutput->GetImageCount(), 1u);
+  // The client's id and metadata travel with the pair
+  EXPECT_EQ(g_JpegRoundTripOutput->mRequestId, 4242);
+  int enabled = 0;
+  EXPECT_EQ(g_JpegRoundTripOutput->mMetadata.GetMetadata(
+                MetaId::ALGO_BOKEH_ENABLED, enabled),
+            0);
+  EXPECT_EQ(enabled, 1);
+  // The request was made inside the library, release it before dlclose
+  g_JpegRoundTripOutput = nullptr;
+}
+
+std::shared_ptr<AlgoRequest> g_ScalerOutput = nullptr;
+int ScalerCallback(std::shared_ptr<AlgoRequest> input) {
+  g_ScalerOutput = input;
+  g_AlgoProcessTestCallback++;
+  return 0;
+}
+
+TEST_F(AlgoProcessTest, ScalerEmitsPreviewAndThumbnail) {
+  int status = RegisterCallback(&algoHandle, ScalerCallback);
+  ASSERT_EQ(status, 0);
+
+  // Default config: full frame, 1/4 preview and a 160x120 thumbnail
+  const std::vector<std::vector<AlgoId>> pipelines = {
+      {ALGO_SCALER}, {ALGO_SCALER, ALGO_SWJPEG}};
+  for (size_t p = 0; p < pipelines.size(); p++) {
+    g_AlgoProcessTestCallback = 0;
+    g_ScalerOutput            = nullptr;
+    std::vector<unsigned char> yuvData(WIDTH * HEIGHT * 3 / 2, 128);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+      yuvData[i] = static_cast<unsigned char>(i % WIDTH);
+    }
+    const std::vector<unsigned char> input = yuvData;
+
+    auto request        = std::make_shared<AlgoRequest>();
+    request->mRequestId = 300 + static_cast<int>(p);
+    int rc              = request->AddImage(ImageFormat::YUV420, WIDTH, HEIGHT,
+                                            std::move(yuvData));
+    ASSERT_EQ(rc, 0);
+
+    status = AlgoInterfaceProcess(&algoHandle, request, pipelines[p]);
+    ASSERT_EQ(status, 0);
+    while (g_AlgoProcessTestCallback == 0) {
+      usleep(50);
+    }
+
+    ASSERT_NE(g_ScalerOutput, nullptr);
+    int thumbnail = 0;
+    ASSERT_EQ(g_ScalerOutput->mMetadata.GetMetadata(MetaId::THUMBNAIL,
+                                                    thumbnail),
+              0);
+    if (p == 0) {
+      ASSERT_EQ(g_ScalerOutput->GetImageCount(), 3u);
+      const ImageData& full    = *g_ScalerOutput->GetImage(0);
+      const ImageData& preview = *g_ScalerOutput->GetImage(1);
+      EXPECT_EQ(full.GetData(), input);
+      EXPECT_EQ(preview.GetWidth(), WIDTH / 4);
+      EXPECT_EQ(preview.GetHeight(), HEIGHT / 4);
+      // Area average of a horizontal ramp, 4 columns per output column
+      EXPECT_EQ(preview.GetData()[10], 42);
+      EXPECT_EQ(preview.GetData()[WIDTH / 4 * HEIGHT / 4], 128);
+      EXPECT_EQ(thumbnail, 2);
+      EXPECT_EQ(g_ScalerOutput->GetImage(2)->GetWidth(), 160);
+      EXPECT_EQ(g_ScalerOutput->GetImage(2)->GetHeight(), 120);
+    } else {
+      // SwJpeg keeps the encoded thumbnail next to the main image
+      ASSERT_EQ(g_ScalerOutput->GetImageCount(), 2u);
+      EXPECT_EQ(g_ScalerOutput->GetImage(0)->GetFormat(), ImageFormat::JPEG);
+      EXPECT_EQ(g_ScalerOutput->GetImage(1)->GetFormat(), ImageFormat::JPEG);
+      EXPECT_EQ(g_ScalerOutput->GetImage(1)->GetWidth(), 160);
+      EXPECT_EQ(thumbnail, 1);
+    }
+  }
+  // Outputs were made by the plugins, release them before unloading
+  g_ScalerOutput = nullptr;
+}
+
+std::shared_ptr<AlgoRequest> g_RotateOutput = nullptr;
+int RotateCallback(std::shared_ptr<AlgoRequest> input) {
+  g_RotateOutput = input;
+  g_AlgoProcessTestCallback++;
+  return 0;
+}
+
+TEST_F(AlgoProcessTest, RotateAppliesOrientation) {
+  int status = RegisterCallback(&algoHandle, RotateCallback);
+  ASSERT_EQ(status, 0);
+  g_AlgoProcessTestCallback = 0;
+
+  const int lumaSize = WIDTH * HEIGHT;
+  std::vector<unsigned char> yuvData(lumaSize * 3 / 2);
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      yuvData[y * WIDTH + x] = static_cast<unsigned char>((x + 3 * y) % 251);
+    }
+  }
+  for (int i = 0; i < lumaSize / 4; i++) {
+    yuvData[lumaSize + i]                = static_cast<unsigned char>(i % 7);
+    yuvData[lumaSize + lumaSize / 4 + i] = 200;
+  }
+  const std::vector<unsigned char> input = yuvData;
+
+  auto request        = std::make_shared<AlgoRequest>();
+  request->mRequestId = 310;
+  int rc              = request->AddImage(ImageFormat::YUV420, WIDTH, HEIGHT,
+                                          std::move(yuvData));
+  ASSERT_EQ(rc, 0);
+  request->mMetadata.SetMetadata(MetaId::IMAGE_ORIENTATION, 90);
+  request->mMetadata.SetMetadata(MetaId::IMAGE_MIRROR, true);
+  request->mMetadata.SetMetadata(MetaId::IMAGE_WIDTH, WIDTH);
+  request->mMetadata.SetMetadata(MetaId::IMAGE_HEIGHT, HEIGHT);
+
+  status = AlgoInterfaceProcess(&algoHandle, request, {ALGO_ROTATE});
+  ASSERT_EQ(status, 0);
+  while (g_AlgoProcessTestCallback == 0) {
+    usleep(50);
+  }
+
+  ASSERT_NE(g_RotateOutput, nullptr);
+  ASSERT_EQ(g_RotateOutput->GetImageCount(), 1u);
+  const ImageData& output = *g_RotateOutput->GetImage(0);
+  ASSERT_EQ(output.GetWidth(), HEIGHT);
+  ASSERT_EQ(output.GetHeight(), WIDTH);
+  // Mirrored then rotated 90: output (x, y) is input (W - 1 - y, H - 1 - x)
+  const std::vector<unsigned char>& data = output.GetData();
+  for (int y = 0; y < WIDTH; y += 37) {
+    for (int x = 0; x < HEIGHT; x += 29) {
+      ASSERT_EQ(data[y * HEIGHT + x],
+                input[(HEIGHT - 1 - x) * WIDTH + WIDTH - 1 - y]);
+    }
+  }
+  const int chromaWidth = HEIGHT / 2;
+  for (int y = 0; y < WIDTH / 2; y += 11) {
+    for (int x = 0; x < chromaWidth; x += 7) {
+      const int source = (HEIGHT / 2 - 1 - x) * (WIDTH / 2) + WIDTH / 2 - 1 - y;
+      ASSERT_EQ(data[lumaSize + y * chromaWidth + x], input[lumaSize + source]);
+    }
+  }
+  EXPECT_EQ(data[lumaSize * 5 / 4], 200);
+
+  int orientation = -1;
+  bool mirror     = true;
+  g_RotateOutput->mMetadata.GetMetadata(MetaId::IMAGE_ORIENTATION,
+                                        orientation);
+  g_RotateOutput->mMetadata.GetMetadata(MetaId::IMAGE_MIRROR, mirror);
+  EXPECT_EQ(orientation, 0);
+  EXPECT_FALSE(mirror);
+  // The JPEG encoder writes these into its header
+  int width  = 0;
+  int height = 0;
+  g_RotateOutput->mMetadata.GetMetadata(MetaId::IMAGE_WIDTH, width);
+  g_RotateOutput->mMetadata.GetMetadata(MetaId::IMAGE_HEIGHT, height);
+  EXPECT_EQ(width, HEIGHT);
+  EXPECT_EQ(height, WIDTH);
+  // The output was made by the plugin, release it before unloading
+  g_RotateOutput = nullptr;
+}
+
+std::shared_ptr<AlgoRequest> g_SemiPlanarOutput = nullptr;
+int SemiPlanarCallback(std::shared_ptr<AlgoRequest> input) {
+  g_SemiPlanarOutput = input;
+  g_AlgoProcessTestCallback++;
+  return 0;
+}
+
+// NV12 and NV21 frames go through every node without an I420 copy and come
+// out as the I420 frame would, with the chroma interleaved
+TEST_F(AlgoProcessTest, SemiPlanarMatchesPlanar) {
+  int status = RegisterCallback(&algoHandle, SemiPlanarCallback);
+  ASSERT_EQ(status, 0);
+
+  const int lumaSize   = WIDTH * HEIGHT;
+  const int chromaSize = lumaSize / 4;
+  std::vector<unsigned char> i420(lumaSize * 3 / 2);
+  for (int i = 0; i < lumaSize; i++) {
+    i420[i] = static_cast<unsigned char>((i % WIDTH + 2 * (i / WIDTH)) % 256);
+  }
+  for (int i = 0; i < chromaSize; i++) {
+    i420[lumaSize + i]              = static_cast<unsigned char>(64 + i % 61);
+    i420[lumaSize + chromaSize + i] = static_cast<unsigned char>(200 - i % 37);
+  }
+
+  auto run = [&](ImageFormat format, const std::vector<AlgoId>& algos) {
+    std::vector<unsigned char> data = i420;
+    if (format != ImageFormat::YUV420) {
+      const int first = format == ImageFormat::NV12 ? 0 : 1;
+      for (int i = 0; i < chromaSize; i++) {
+        data[lumaSize + i * 2 + first]     = i420[lumaSize + i];
+        data[lumaSize + i * 2 + 1 - first] = i420[lumaSize + chromaSize + i];
+      }
+    }
+    g_AlgoProcessTestCallback = 0;
+    g_SemiPlanarOutput        = nullptr;
+    auto request              = std::make_shared<AlgoRequest>();
+    request->mRequestId       = 320;
+    request->AddImage(format, WIDTH, HEIGHT, std::move(data));
+    request->mMetadata.SetMetadata(MetaId::IMAGE_ORIENTATION, 90);
+    EXPECT_EQ(AlgoInterfaceProcess(&algoHandle, request, algos), 0);
+    while (g_AlgoProcessTestCallback == 0) {
+      usleep(50);
+    }
+    auto output        = g_SemiPlanarOutput;
+    g_SemiPlanarOutput = nullptr;
+    return output;
+  };
+
+  const std::vector<AlgoId> nodes = {ALGO_FILTER, ALGO_LDC, ALGO_WATERMARK,
+                                     ALGO_SCALER, ALGO_ROTATE};
+  auto planar = run(ImageFormat::YUV420, nodes);
+  ASSERT_NE(planar, nullptr);
+  for (auto format : {ImageFormat::NV12, ImageFormat::NV21}) {
+    auto semi = run(format, nodes);
+    ASSERT_NE(semi, nullptr);
+    ASSERT_EQ(semi->GetImageCount(), planar->GetImageCount());
+    for (size_t i = 0; i < planar->GetImageCount(); i++) {
+      const ImageData& expected = *planar->GetImage(i);
+      const ImageData& actual   = *semi->GetImage(i);
+      ASSERT_EQ(actual.GetFormat(), format);
+      ASSERT_EQ(actual.GetWidth(), expected.GetWidth());
+      ASSERT_EQ(actual.GetHeight(), expected.GetHeight());
+      const size_t luma   = expected.GetWidth() * expected.GetHeight();
+      const size_t chroma = luma / 4;
+      const auto& e       = expected.GetData();
+      const auto& a       = actual.GetData();
+      ASSERT_TRUE(std::equal(e.begin(), e.begin() + luma, a.begin()));
+      const size_t first = format == ImageFormat::NV12 ? 0 : 1;
+      for (size_t c = 0; c < chroma; c++) {
+        ASSERT_EQ(a[luma + c * 2 + first], e[luma + c]) << i << ":" << c;
+        ASSERT_EQ(a[luma + c * 2 + 1 - first], e[luma + chroma + c]);
+      }
+    }
+  }
+
+  // The encoder reads the interleaved chroma in place
+  std::vector<AlgoId> encode = nodes;
+  encode.push_back(ALGO_SWJPEG);
+  auto jpeg = run(ImageFormat::YUV420, encode);
+  auto nv12 = run(ImageFormat::NV12, encode);
+  ASSERT_NE(jpeg, nullptr);
+  ASSERT_NE(nv12, nullptr);
+  ASSERT_EQ(nv12->GetImageCount(), jpeg->GetImageCount());
+  for (size_t i = 0; i < jpeg->GetImageCount(); i++) {
+    const ImageData& expected = *jpeg->GetImage(i);
+    const ImageData& actual   = *nv12->GetImage(i);
+    EXPECT_EQ(actual.GetFormat(), ImageFormat::JPEG);
+    EXPECT_EQ(actual.GetData(), expected.GetData());
+  }
+}
@@ -21,13 +21,84 @@
  */
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <chrono>
 #include <mutex>
+#include <thread>
+#include <utility>
+#include <unistd.h>
 #include "AlgoPipeline.h"  // Include the header file for your class
 #define STRESS_CNT 10000
 
-// Test fixture
+// Test fixture, pipelines from MakePipeline deliver their outputs to it
 class AlgoPipelineTest : public ::testing::Test {
  protected:
+  void TearDown() override {
+    // Outputs were made by the plugins, release them before unloading
+    {
+      std::lock_guard<std::mutex> lock(mOutputMutex);
+      mOutputs.clear();
+    }
+    mPipelines.clear();
+  }
+
+  // Pipeline collecting its outputs, kept alive until TearDown
+  std::shared_ptr<AlgoPipeline> MakePipeline() {
+    auto pipeline = std::make_shared<AlgoPipeline>(CollectOutput, this);
+    mPipelines.push_back(pipeline);
+    return pipeline;
+  }
+
+  // Request holding one image, nullptr if the image is rejected
+  static std::shared_ptr<AlgoRequest> MakeInput(
+      int requestId, ImageFormat format, int width, int height,
+      std::vector<unsigned char> data) {
+    auto input        = std::make_shared<AlgoRequest>();
+    input->mRequestId = requestId;
+    if (input->AddImage(format, width, height, std::move(data)) != 0) {
+      return nullptr;
+    }
+    return input;
+  }
+
+  // Process input and wait for its output, nullptr if none arrives
+  std::shared_ptr<AlgoRequest> Run(AlgoPipeline& pipeline,
+                                   std::shared_ptr<AlgoRequest> input) {
+    if (input == nullptr) {
+      return nullptr;
+    }
+    const size_t count = Outputs().size() + 1;
+    pipeline.Process(input);
+    pipeline.WaitForQueueCompetion();
+    // The session callback runs after the request left the queue, so
+    // WaitForQueueCompetion can return before the output was delivered
+    for (int i = 0; i < 1000; i++) {
+      {
+        std::lock_guard<std::mutex> lock(mOutputMutex);
+        if (mOutputs.size() >= count) {
+          return mOutputs.back();
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return nullptr;
+  }
+
+  // Outputs delivered so far, in delivery order
+  std::vector<std::shared_ptr<AlgoRequest>> Outputs() {
+    std::lock_guard<std::mutex> lock(mOutputMutex);
+    return mOutputs;
+  }
+
+ private:
+  static void CollectOutput(void* ctx, std::shared_ptr<AlgoRequest> output) {
+    auto test = static_cast<AlgoPipelineTest*>(ctx);
+    std::lock_guard<std::mutex> lock(test->mOutputMutex);
+    test->mOutputs.push_back(output);
+  }
+
+  std::mutex mOutputMutex;
+  std::vector<std::shared_ptr<AlgoRequest>> mOutputs;
+  std::vector<std::shared_ptr<AlgoPipeline>> mPipelines;
 };
 
 TEST_F(AlgoPipelineTest, CtorDtorID) {
@@ -102,3 +173,497 @@ TEST_F(AlgoPipelineTest, ProcesstestFail) {
   EXPECT_EQ(algoPipeline->GetProcessedFrames(), 0);
   EXPECT_EQ(ProcessedFrame, 0);
 }
+
+
+TEST_F(AlgoPipelineTest, DirtyBlocksMatchFullRecompute) {
+  const int width              = 320;
+  const int height             = 240;
+  std::vector<AlgoId> algoList = {ALGO_FILTER, ALGO_LDC};
+  auto algoPipeline            = MakePipeline();
+  algoPipeline->ConfigureAlgoPipeline(algoList);
+  ASSERT_EQ(algoPipeline->GetState(), AlgoPipelineState::ConfiguredWithId);
+  ChangeDetectorConfig config;
+  config.enabled   = true;
+  config.blockSize = 16;
+  algoPipeline->ConfigureChangeDetector(config);
+
+  std::vector<unsigned char> first(width * height * 3 / 2, 128);
+  for (int i = 0; i < width * height; i++) {
+    first[i] = static_cast<unsigned char>((i % width) * 3 + (i / width) * 5);
+  }
+  std::vector<unsigned char> second = first;
+  for (int y = 100; y < 110; y++) {
+    second[y * width + 150] = 0;
+  }
+
+  // Stream 0 sees both frames, stream 1 only the second one
+  int requestId = 0;
+  for (auto [streamId, frame] : {std::make_pair(0, &first),
+                                 std::make_pair(0, &second),
+                                 std::make_pair(1, &second)}) {
+    auto input = MakeInput(requestId++, ImageFormat::YUV420, width, height,
+                           *frame);
+    ASSERT_NE(input, nullptr);
+    input->mStreamId = streamId;
+    ASSERT_NE(Run(*algoPipeline, input), nullptr);
+  }
+
+  auto outputs = Outputs();
+  ASSERT_EQ(outputs.size(), 3u);
+  auto reused = outputs[1];
+  auto full   = outputs[2];
+  EXPECT_EQ(reused->GetImage(0)->GetData(), full->GetImage(0)->GetData());
+  EXPECT_NE(reused->GetImage(0)->GetData(), outputs[0]->GetImage(0)->GetData());
+
+  // Only the blocks around the changed column were recomputed
+  ASSERT_NE(reused->mDirtyBlocks, nullptr);
+  const size_t dirty = reused->mDirtyBlocks->GetDirtyCount();
+  EXPECT_GT(dirty, 0u);
+  EXPECT_LT(dirty, reused->mDirtyBlocks->dirty.size() / 4);
+  EXPECT_EQ(full->mDirtyBlocks->GetDirtyCount(),
+            full->mDirtyBlocks->dirty.size());
+}
+
+TEST_F(AlgoPipelineTest, FrameHashStamped) {
+  const int width              = 64;
+  const int height             = 48;
+  std::vector<AlgoId> algoList = {ALGO_FILTER, ALGO_NOP};
+  auto algoPipeline            = MakePipeline();
+  algoPipeline->SetFrameHashMode(FrameHashMode::EveryNode);
+  algoPipeline->ConfigureAlgoPipeline(algoList);
+  ASSERT_EQ(algoPipeline->GetState(), AlgoPipelineState::ConfiguredWithId);
+
+  std::vector<unsigned char> data(width * height * 3 / 2, 128);
+  for (int i = 0; i < width * height; i++) {
+    data[i] = static_cast<unsigned char>(i * 7);
+  }
+  auto input = MakeInput(0, ImageFormat::YUV420, width, height, data);
+  ASSERT_NE(input, nullptr);
+  const uint64_t inputHash = input->FrameHash();
+  auto output              = Run(*algoPipeline, input);
+  ASSERT_NE(output, nullptr);
+
+  int64_t inputStamp = 0;
+  int64_t stamp      = 0;
+  ASSERT_EQ(output->mMetadata.GetMetadata(MetaId::FRAME_HASH_INPUT,
+                                          inputStamp),
+            0);
+  ASSERT_EQ(output->mMetadata.GetMetadata(MetaId::FRAME_HASH, stamp), 0);
+  EXPECT_EQ(static_cast<uint64_t>(inputStamp), inputHash);
+  EXPECT_EQ(static_cast<uint64_t>(stamp), output->FrameHash());
+  EXPECT_NE(static_cast<uint64_t>(stamp), inputHash);
+}
+
+TEST_F(AlgoPipelineTest, FrameHashEveryNodeInStripeGroup) {
+  const int width              = 96;
+  const int height             = 64;
+  std::vector<AlgoId> algoList = {ALGO_FILTER, ALGO_WATERMARK};
+  auto striped                 = MakePipeline();
+  auto whole                   = MakePipeline();
+  striped->SetStripeStreaming(true, 16);
+  whole->SetStripeStreaming(false, 16);
+  striped->SetFrameHashMode(FrameHashMode::EveryNode);
+  striped->ConfigureAlgoPipeline(algoList);
+  whole->ConfigureAlgoPipeline(algoList);
+  ASSERT_EQ(striped->GetStripeGroupCount(), 1u);
+
+  // Hashing the filter output runs the group node by node, same result
+  std::vector<unsigned char> frame(width * height * 3 / 2);
+  for (size_t i = 0; i < frame.size(); i++) {
+    frame[i] = static_cast<unsigned char>(i * 5 + i / width);
+  }
+  auto hashed =
+      Run(*striped, MakeInput(0, ImageFormat::YUV420, width, height, frame));
+  auto plain =
+      Run(*whole, MakeInput(1, ImageFormat::YUV420, width, height, frame));
+  ASSERT_NE(hashed, nullptr);
+  ASSERT_NE(plain, nullptr);
+  EXPECT_EQ(hashed->GetImage(0)->GetData(), plain->GetImage(0)->GetData());
+  int64_t stamp = 0;
+  ASSERT_EQ(hashed->mMetadata.GetMetadata(MetaId::FRAME_HASH, stamp), 0);
+  EXPECT_EQ(static_cast<uint64_t>(stamp), hashed->FrameHash());
+}
+
+TEST_F(AlgoPipelineTest, ReadOnlyNodesKeepSharedInput) {
+  const int width  = 64;
+  const int height = 48;
+  std::vector<unsigned char> frame(width * height * 3 / 2);
+  for (size_t i = 0; i < frame.size(); i++) {
+    frame[i] = static_cast<unsigned char>(i * 7 + i / width);
+  }
+  // Filter reads one frame, Hdr reads every exposure
+  std::vector<std::pair<AlgoId, size_t>> nodes = {{ALGO_FILTER, 1},
+                                                  {ALGO_HDR, 2}};
+  for (const auto& [algoId, count] : nodes) {
+    auto input        = std::make_shared<AlgoRequest>();
+    input->mRequestId = static_cast<int>(algoId);
+    std::vector<std::shared_ptr<ImageData>> images;
+    std::vector<std::shared_ptr<ImageData>> history;
+    for (size_t i = 0; i < count; i++) {
+      auto image = std::make_shared<ImageData>(ImageFormat::YUV420, width,
+                                               height);
+      image->SetData(std::vector<unsigned char>(frame));
+      // Shared like the change detector and result cache share frames
+      history.push_back(image->Share());
+      ASSERT_EQ(input->AddImage(image), 0);
+      images.push_back(image);
+    }
+    std::vector<const unsigned char*> buffers;
+    std::vector<uint64_t> hashes;
+    std::vector<std::shared_ptr<const ImageData>> lumas;
+    for (const auto& image : images) {
+      buffers.push_back(std::as_const(*image).GetData().data());
+      hashes.push_back(image->GetHash());
+      lumas.push_back(image->Luma());
+    }
+
+    auto algoPipeline        = MakePipeline();
+    std::vector<AlgoId> list = {algoId};
+    algoPipeline->ConfigureAlgoPipeline(list);
+    ASSERT_NE(Run(*algoPipeline, input), nullptr);
+
+    // Not copied and the cached hash and views survive
+    for (size_t i = 0; i < images.size(); i++) {
+      EXPECT_EQ(std::as_const(*images[i]).GetData().data(), buffers[i]);
+      EXPECT_EQ(std::as_const(*history[i]).GetData().data(), buffers[i]);
+      EXPECT_EQ(images[i]->GetHash(), hashes[i]);
+      EXPECT_EQ(images[i]->Luma(), lumas[i]);
+    }
+  }
+}
+
+TEST_F(AlgoPipelineTest, FormatPlanConvertsForNode) {
+  const int width              = 64;
+  const int height             = 48;
+  const int lumaSize           = width * height;
+  std::vector<AlgoId> algoList = {ALGO_FILTER, ALGO_BOKEH};
+  auto algoPipeline            = MakePipeline();
+  algoPipeline->ConfigureAlgoPipeline(algoList);
+  ASSERT_EQ(algoPipeline->GetState(), AlgoPipelineState::ConfiguredWithId);
+
+  // Filter runs NV12 as is, Bokeh only takes YUV420
+  const auto steps = algoPipeline->GetFormatPlan().Trace(ImageFormat::NV12);
+  ASSERT_EQ(steps.size(), 2u);
+  EXPECT_EQ(steps[0].fed, ImageFormat::NV12);
+  EXPECT_EQ(steps[1].fed, ImageFormat::YUV420);
+
+  std::vector<unsigned char> i420(lumaSize * 3 / 2);
+  for (int i = 0; i < lumaSize * 3 / 2; i++) {
+    i420[i] = static_cast<unsigned char>(i * 13 + i / width);
+  }
+  std::vector<unsigned char> nv12 = i420;
+  for (int i = 0; i < lumaSize / 4; i++) {
+    nv12[lumaSize + 2 * i]     = i420[lumaSize + i];
+    nv12[lumaSize + 2 * i + 1] = i420[lumaSize + lumaSize / 4 + i];
+  }
+  auto planar    = Run(*algoPipeline,
+                        MakeInput(0, ImageFormat::YUV420, width, height, i420));
+  auto converted = Run(*algoPipeline,
+                       MakeInput(1, ImageFormat::NV12, width, height, nv12));
+  ASSERT_NE(planar, nullptr);
+  ASSERT_NE(converted, nullptr);
+  algoPipeline->Dump();
+
+  EXPECT_EQ(converted->GetImage(0)->GetFormat(), ImageFormat::YUV420);
+  EXPECT_EQ(converted->GetImage(0)->GetData(), planar->GetImage(0)->GetData());
+}
+
+TEST_F(AlgoPipelineTest, StripeStreamingMatchesNodeByNode) {
+  const int width              = 96;
+  const int height             = 100;
+  const int lumaSize           = width * height;
+  std::vector<AlgoId> algoList = {ALGO_FILTER, ALGO_WATERMARK};
+  auto striped                 = MakePipeline();
+  auto whole                   = MakePipeline();
+  striped->SetStripeStreaming(true, 16);
+  whole->SetStripeStreaming(false, 16);
+  striped->ConfigureAlgoPipeline(algoList);
+  whole->ConfigureAlgoPipeline(algoList);
+  ASSERT_EQ(striped->GetState(), AlgoPipelineState::ConfiguredWithId);
+  ASSERT_EQ(whole->GetState(), AlgoPipelineState::ConfiguredWithId);
+  EXPECT_EQ(striped->GetStripeGroupCount(), 1u);
+  EXPECT_EQ(whole->GetStripeGroupCount(), 0u);
+
+  int requestId = 0;
+  for (auto [format, size] :
+       {std::make_pair(ImageFormat::YUV420, lumaSize * 3 / 2),
+        std::make_pair(ImageFormat::NV12, lumaSize * 3 / 2),
+        std::make_pair(ImageFormat::RGB, lumaSize * 3)}) {
+    std::vector<unsigned char> frame(size);
+    for (int i = 0; i < size; i++) {
+      frame[i] = static_cast<unsigned char>(i * 7 + i / width * 3);
+    }
+    auto stripes =
+        Run(*striped, MakeInput(requestId++, format, width, height, frame));
+    auto nodes =
+        Run(*whole, MakeInput(requestId++, format, width, height, frame));
+    ASSERT_NE(stripes, nullptr);
+    ASSERT_NE(nodes, nullptr);
+    EXPECT_EQ(stripes->mProcessCnt, nodes->mProcessCnt);
+    ASSERT_EQ(stripes->GetImageCount(), 1u);
+    EXPECT_EQ(stripes->GetImage(0)->GetFormat(),
+              nodes->GetImage(0)->GetFormat());
+    EXPECT_EQ(stripes->GetImage(0)->GetData(), nodes->GetImage(0)->GetData());
+    int stripesDone = 0;
+    int nodesDone   = 0;
+    stripes->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, stripesDone);
+    nodes->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, nodesDone);
+    EXPECT_EQ(stripesDone, nodesDone);
+  }
+  striped->Dump();
+  EXPECT_EQ(striped->GetState(), AlgoPipelineState::ConfiguredWithId);
+}
+
+TEST_F(AlgoPipelineTest, PlanarRgbMatchesNodeByNode) {
+  const int width              = 96;
+  const int height             = 64;
+  std::vector<AlgoId> algoList = {ALGO_FILTER, ALGO_WATERMARK, ALGO_SCALER};
+  auto planar                  = MakePipeline();
+  planar->ConfigureAlgoPipeline(algoList);
+  ASSERT_EQ(planar->GetState(), AlgoPipelineState::ConfiguredWithId);
+
+  // Three RGB nodes pay for the shuffle to planar RGB and back
+  const auto steps = planar->GetFormatPlan().Trace(ImageFormat::RGB);
+  ASSERT_EQ(steps.size(), 3u);
+  for (const auto& step : steps) {
+    EXPECT_EQ(step.fed, ImageFormat::RGBP);
+  }
+
+  std::vector<unsigned char> frame(width * height * 3);
+  for (size_t i = 0; i < frame.size(); i++) {
+    frame[i] = static_cast<unsigned char>(i * 7 + i / width * 3);
+  }
+  auto planarOutput =
+      Run(*planar, MakeInput(0, ImageFormat::RGB, width, height, frame));
+  ASSERT_NE(planarOutput, nullptr);
+  planar->Dump();
+
+  // The same nodes one pipeline each stay on packed RGB
+  ImageFormat format = ImageFormat::RGB;
+  int imageWidth     = width;
+  int imageHeight    = height;
+  for (size_t i = 0; i < algoList.size(); i++) {
+    auto single              = MakePipeline();
+    std::vector<AlgoId> node = {algoList[i]};
+    single->ConfigureAlgoPipeline(node);
+    ASSERT_EQ(single->GetFormatPlan().Trace(format)[0].fed, format);
+    auto output = Run(*single, MakeInput(static_cast<int>(i) + 1, format,
+                                         imageWidth, imageHeight, frame));
+    ASSERT_NE(output, nullptr);
+    auto image  = output->GetImage(0);
+    format      = image->GetFormat();
+    imageWidth  = image->GetWidth();
+    imageHeight = image->GetHeight();
+    frame       = image->GetData();
+  }
+
+  auto output = planarOutput->GetImage(0);
+  EXPECT_EQ(output->GetFormat(), ImageFormat::RGB);
+  EXPECT_EQ(output->GetWidth(), imageWidth);
+  EXPECT_EQ(output->GetHeight(), imageHeight);
+  EXPECT_EQ(output->GetData(), frame);
+}
+
+TEST_F(AlgoPipelineTest, FrameStatsAttachedToOutput) {
+  const int width              = 64;
+  const int height             = 48;
+  std::vector<AlgoId> algoList = {ALGO_FILTER, ALGO_WATERMARK};
+  auto algoPipeline            = MakePipeline();
+  FrameStatsConfig config;
+  config.enabled   = true;
+  config.blockSize = 0;
+  EXPECT_EQ(algoPipeline->ConfigureFrameStats(config), -1);
+  config.blockSize = 16;
+  ASSERT_EQ(algoPipeline->ConfigureFrameStats(config), 0);
+  algoPipeline->ConfigureAlgoPipeline(algoList);
+  ASSERT_EQ(algoPipeline->GetState(), AlgoPipelineState::ConfiguredWithId);
+  EXPECT_EQ(algoPipeline->GetFrameStatsConfig().blockSize, 16);
+
+  std::vector<unsigned char> frame(width * height * 3 / 2);
+  for (size_t i = 0; i < frame.size(); i++) {
+    frame[i] = static_cast<unsigned char>(i * 11 + i / width);
+  }
+  ImageData image(ImageFormat::YUV420, width, height);
+  image.SetData(std::vector<unsigned char>(frame));
+  FrameStats expected;
+  ASSERT_EQ(ComputeFrameStats(image, 16, expected), 0);
+
+  auto withStats =
+      Run(*algoPipeline, MakeInput(0, ImageFormat::YUV420, width, height,
+                                   frame));
+  config.enabled = false;
+  ASSERT_EQ(algoPipeline->ConfigureFrameStats(config), 0);
+  auto withoutStats =
+      Run(*algoPipeline, MakeInput(1, ImageFormat::YUV420, width, height,
+                                   frame));
+  ASSERT_NE(withStats, nullptr);
+  ASSERT_NE(withoutStats, nullptr);
+
+  FrameStats stats;
+  // Stats describe the input, not the filtered output
+  ASSERT_EQ(GetFrameStats(withStats->mMetadata, stats), 0);
+  EXPECT_EQ(stats.histogram, expected.histogram);
+  EXPECT_EQ(stats.blockMeans, expected.blockMeans);
+  EXPECT_EQ(stats.blocksX, 4);
+  EXPECT_EQ(stats.min, expected.min);
+  EXPECT_EQ(stats.max, expected.max);
+  EXPECT_FLOAT_EQ(stats.mean, expected.mean);
+  EXPECT_EQ(GetFrameStats(withoutStats->mMetadata, stats), -1);
+}
+
+// Node taking packed RGB only, leaving it untouched
+class RgbOnlyAlgo : public AlgoBase {
+ public:
+  RgbOnlyAlgo() : AlgoBase("RgbOnly") {
+    SupportedFormatsMap.push_back({ImageFormat::RGB, ImageFormat::RGB});
+  }
+  ~RgbOnlyAlgo() override { StopAlgoThread(); }
+  AlgoStatus Open() override { return AlgoStatus::SUCCESS; }
+  AlgoStatus Process(std::shared_ptr<AlgoRequest> req) override {
+    (void)(req);
+    SetStatus(AlgoStatus::SUCCESS);
+    return GetAlgoStatus();
+  }
+  AlgoStatus Close() override { return AlgoStatus::SUCCESS; }
+  int GetTimeout() override { return 1000; }
+};
+
+TEST_F(AlgoPipelineTest, FrameStatsTakenAfterConversion) {
+  const int width                              = 64;
+  const int height                             = 48;
+  std::vector<std::shared_ptr<AlgoBase>> nodes = {
+      std::make_shared<RgbOnlyAlgo>()};
+  auto algoPipeline = MakePipeline();
+  FrameStatsConfig config;
+  config.enabled   = true;
+  config.blockSize = 16;
+  ASSERT_EQ(algoPipeline->ConfigureFrameStats(config), 0);
+  algoPipeline->ConfigureAlgoPipeline(nodes);
+  ASSERT_EQ(algoPipeline->GetState(), AlgoPipelineState::ConfiguredWithId);
+  ASSERT_EQ(algoPipeline->GetFormatPlan().Trace(ImageFormat::YUV420)[0].fed,
+            ImageFormat::RGB);
+
+  std::vector<unsigned char> frame(width * height * 3 / 2);
+  for (size_t i = 0; i < frame.size(); i++) {
+    frame[i] = static_cast<unsigned char>(i * 7 + i / width);
+  }
+  // The node reads the frame converted to RGB, clipped where the chroma is
+  // strong, so its luma is not the Y plane the request came with
+  ImageData image(ImageFormat::YUV420, width, height);
+  image.SetData(std::vector<unsigned char>(frame));
+  auto fed = ConvertImage(image, ImageFormat::RGB);
+  ASSERT_NE(fed, nullptr);
+  FrameStats expected;
+  ASSERT_EQ(ComputeFrameStats(*fed, 16, expected), 0);
+
+  auto output = Run(*algoPipeline, MakeInput(0, ImageFormat::YUV420, width,
+                                             height, frame));
+  ASSERT_NE(output, nullptr);
+  FrameStats stats;
+  ASSERT_EQ(GetFrameStats(output->mMetadata, stats), 0);
+  EXPECT_EQ(stats.histogram, expected.histogram);
+  EXPECT_EQ(stats.blockMeans, expected.blockMeans);
+}
+
+TEST_F(AlgoPipelineTest, DirtyRegionsFollowWrites) {
+  const int width                         = 64;
+  const int height                        = 48;
+  std::vector<std::vector<AlgoId>> chains = {{ALGO_WATERMARK}, {ALGO_FILTER}};
+  for (size_t i = 0; i < chains.size(); i++) {
+    auto algoPipeline = MakePipeline();
+    algoPipeline->ConfigureAlgoPipeline(chains[i]);
+    ASSERT_EQ(algoPipeline->GetState(), AlgoPipelineState::ConfiguredWithId);
+    auto input = MakeInput(static_cast<int>(i), ImageFormat::YUV420, width,
+                           height,
+                           std::vector<unsigned char>(width * height * 3 / 2,
+                                                      128));
+    ASSERT_NE(Run(*algoPipeline, input), nullptr);
+  }
+
+  auto outputs = Outputs();
+  // The watermark writes only its overlay, inside the frame
+  auto region = outputs[0]->GetDirtyRegion(0);
+  EXPECT_FALSE(region.all);
+  for (const auto& rect : region.rects) {
+    EXPECT_GE(rect.x, 0);
+    EXPECT_GE(rect.y, 0);
+    EXPECT_LE(rect.x + rect.width, width);
+    EXPECT_LE(rect.y + rect.height, height);
+  }
+  // The filter cannot say what it changed
+  EXPECT_TRUE(outputs[1]->GetDirtyRegion(0).all);
+}
+
+TEST_F(AlgoPipelineTest, TiledMatchesInMemory) {
+  const int width              = 96;
+  const int height             = 68;
+  std::vector<AlgoId> algoList = {ALGO_FILTER, ALGO_WATERMARK};
+  auto algoPipeline            = MakePipeline();
+  algoPipeline->ConfigureAlgoPipeline(algoList);
+  ASSERT_EQ(algoPipeline->GetState(), AlgoPipelineState::ConfiguredWithId);
+
+  std::vector<unsigned char> frame(width * height * 3 / 2);
+  for (size_t i = 0; i < frame.size(); i++) {
+    frame[i] = static_cast<unsigned char>(i * 13 + i / width);
+  }
+  auto inMemory =
+      Run(*algoPipeline, MakeInput(0, ImageFormat::YUV420, width, height,
+                                   frame));
+  ASSERT_NE(inMemory, nullptr);
+
+  char inPath[]  = "/tmp/gzero_tiled_in_XXXXXX";
+  char outPath[] = "/tmp/gzero_tiled_out_XXXXXX";
+  close(mkstemp(inPath));
+  close(mkstemp(outPath));
+  {
+    auto in  = TiledImage::Create(inPath, ImageFormat::YUV420, width, height,
+                                  16);
+    auto out = TiledImage::Create(outPath, ImageFormat::YUV420, width, height,
+                                  12);
+    ASSERT_NE(in, nullptr);
+    ASSERT_NE(out, nullptr);
+    in->SetCacheTiles(2);
+    out->SetCacheTiles(0);
+    ImageData image(ImageFormat::YUV420, width, height);
+    image.SetData(std::vector<unsigned char>(frame));
+    ASSERT_EQ(in->WriteImage(image), 0);
+    ASSERT_EQ(algoPipeline->ProcessTiled(*in, *out), 0);
+    auto result = out->ReadImage();
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->GetData(), inMemory->GetImage(0)->GetData());
+
+    // The output has to match the input
+    const std::string smallPath = std::string(outPath) + ".small";
+    auto small = TiledImage::Create(smallPath, ImageFormat::YUV420, width, 32);
+    ASSERT_NE(small, nullptr);
+    EXPECT_EQ(algoPipeline->ProcessTiled(*in, *small), -1);
+    unlink(smallPath.c_str());
+  }
+  unlink(inPath);
+  unlink(outPath);
+}
+
+TEST_F(AlgoPipelineTest, MandelbrotPlanarMatchesPacked) {
+  const int width              = 64;
+  const int height             = 48;
+  std::vector<AlgoId> algoList = {ALGO_MANDELBROTSET};
+  std::vector<std::shared_ptr<AlgoRequest>> outputs;
+  for (ImageFormat format : {ImageFormat::RGB, ImageFormat::RGBP}) {
+    auto algoPipeline = MakePipeline();
+    algoPipeline->ConfigureAlgoPipeline(algoList);
+    ASSERT_EQ(algoPipeline->GetState(), AlgoPipelineState::ConfiguredWithId);
+    outputs.push_back(Run(*algoPipeline,
+                          MakeInput(static_cast<int>(outputs.size()), format,
+                                    width, height,
+                                    std::vector<unsigned char>(
+                                        width * height * 3))));
+    ASSERT_NE(outputs.back(), nullptr);
+  }
+
+  // Planar output leaves the pipeline packed, the same pixels either way
+  auto packed = outputs[0]->GetImage(0);
+  auto planar = outputs[1]->GetImage(0);
+  EXPECT_EQ(packed->GetFormat(), ImageFormat::RGB);
+  EXPECT_EQ(planar->GetFormat(), ImageFormat::RGB);
+  EXPECT_EQ(planar->GetData(), packed->GetData());
+}
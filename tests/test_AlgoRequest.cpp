@@ -21,6 +21,8 @@
  */
 #include "../include/AlgoRequest.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
 
 constexpr int Width  = 100;
 constexpr int Height = 100;
@@ -80,6 +82,16 @@ TEST_F(AlgoRequestTest, VerifyAddImage) {
   EXPECT_EQ(request->GetImage(0)->GetDataSize(), Width * Height * 3 / 2);
 }
 
+TEST_F(AlgoRequestTest, AddSemiPlanarImage) {
+  EXPECT_EQ(request->AddImage(ImageFormat::NV12, Width, Height), 0);
+  EXPECT_EQ(request->AddImage(ImageFormat::NV21, Width, Height), 0);
+  ASSERT_EQ(request->GetImageCount(), 2);
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT_EQ(request->GetImage(i)->GetDataSize(), Width * Height * 3 / 2);
+  }
+  EXPECT_EQ(request->GetYUVImages().size(), 2u);
+}
+
 TEST_F(AlgoRequestTest, AddImage_MoveSemantics) {
   AlgoRequest request;
   std::vector<unsigned char> data(32 * 32 * 3, 123);
@@ -112,3 +124,159 @@ TEST(AlgoRequestTests, AddImage_ZeroWidthHeight) {
   ret = request.AddImage(ImageFormat::RGB, 0, 0, std::move(data3));
   EXPECT_EQ(ret, -1);
 }
+
+TEST(AlgoRequestTests, FrameHash) {
+  AlgoRequest request;
+  std::vector<unsigned char> data(64 * 32 * 3 / 2, 7);
+  ASSERT_EQ(request.AddImage(ImageFormat::YUV420, 64, 32, std::move(data)),
+            0);
+  auto image          = request.GetImage(0);
+  const uint64_t hash = request.FrameHash();
+  EXPECT_EQ(request.FrameHash(), hash);
+
+  // A shared image keeps the hash, a write drops it
+  auto shared = image->Share();
+  EXPECT_EQ(shared->GetHash(), image->GetHash());
+  shared->GetData()[100]++;
+  EXPECT_NE(shared->GetHash(), image->GetHash());
+
+  image->GetData()[100]++;
+  EXPECT_EQ(shared->GetHash(), image->GetHash());
+  EXPECT_NE(request.FrameHash(), hash);
+}
+
+TEST(AlgoRequestTests, SharedHashFromThreads) {
+  auto image = std::make_shared<ImageData>(ImageFormat::GRAYSCALE, 640, 480);
+  std::vector<unsigned char> data(640 * 480);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<unsigned char>(i * 13 + i / 640);
+  }
+  image->SetData(std::move(data));
+
+  // Node threads hash shares of one frame at once, the first one fills it
+  std::vector<uint64_t> hashes(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < hashes.size(); i++) {
+    auto shared = image->Share();
+    threads.emplace_back([shared, &hashes, i]() {
+      hashes[i] = shared->GetHash();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (uint64_t hash : hashes) {
+    EXPECT_EQ(hash, image->GetHash());
+  }
+}
+
+TEST(AlgoRequestTests, DerivedRepresentations) {
+  const int width  = 70;
+  const int height = 38;
+  std::vector<unsigned char> data(width * height * 3 / 2);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<unsigned char>(i * 7 + i / width);
+  }
+  auto image = std::make_shared<ImageData>(ImageFormat::NV12, width, height);
+  image->SetData(std::vector<unsigned char>(data));
+  const ImageData& frame = *image;
+
+  // Computed once, shared with images sharing the buffer
+  auto rgb = frame.AsRGB();
+  ASSERT_NE(rgb, nullptr);
+  EXPECT_EQ(rgb->GetFormat(), ImageFormat::RGB);
+  EXPECT_EQ(rgb->GetDataSize(), static_cast<size_t>(width * height * 3));
+  EXPECT_EQ(frame.AsRGB(), rgb);
+  auto shared = image->Share();
+  EXPECT_EQ(static_cast<const ImageData&>(*shared).AsRGB(), rgb);
+
+  auto luma = frame.Luma();
+  ASSERT_NE(luma, nullptr);
+  EXPECT_TRUE(std::equal(luma->GetData().begin(), luma->GetData().end(),
+                         data.begin()));
+
+  // Every level is the rounded 2x2 mean of the one above
+  std::vector<unsigned char> above(data.begin(), data.begin() + width * height);
+  int aboveWidth  = width;
+  int aboveHeight = height;
+  for (int level = 1; level <= 3; level++) {
+    auto pyramid = frame.Pyramid(level);
+    ASSERT_NE(pyramid, nullptr);
+    ASSERT_EQ(pyramid->GetWidth(), aboveWidth / 2);
+    ASSERT_EQ(pyramid->GetHeight(), aboveHeight / 2);
+    const auto& out = pyramid->GetData();
+    for (int y = 0; y < aboveHeight / 2; y++) {
+      for (int x = 0; x < aboveWidth / 2; x++) {
+        const unsigned char* p = &above[2 * y * aboveWidth + 2 * x];
+        const unsigned char* q = p + aboveWidth;
+        const int sum          = p[0] + p[1] + q[0] + q[1];
+        ASSERT_EQ(out[y * (aboveWidth / 2) + x], (sum + 2) / 4) << level;
+      }
+    }
+    above       = out;
+    aboveWidth  = pyramid->GetWidth();
+    aboveHeight = pyramid->GetHeight();
+  }
+  EXPECT_EQ(frame.Pyramid(2), frame.Pyramid(2));
+  EXPECT_EQ(frame.Pyramid(0), luma);
+  EXPECT_EQ(frame.Pyramid(6), nullptr);
+  EXPECT_EQ(frame.Pyramid(-1), nullptr);
+
+  // A write drops them for the writer only
+  image->GetData()[0] ^= 0xFF;
+  auto rewritten = frame.Luma();
+  ASSERT_NE(rewritten, nullptr);
+  EXPECT_NE(rewritten, luma);
+  EXPECT_EQ(rewritten->GetData()[0], data[0] ^ 0xFF);
+  EXPECT_EQ(static_cast<const ImageData&>(*shared).Luma(), luma);
+
+  // RGB images have their own luma, formats without one have none
+  EXPECT_EQ(rgb->AsRGB()->GetData().data(), rgb->GetData().data());
+  ASSERT_NE(rgb->Luma(), nullptr);
+  EXPECT_NE(rgb->Pyramid(1), nullptr);
+  ImageData jpeg(ImageFormat::JPEG, width, height);
+  jpeg.SetData(std::vector<unsigned char>(100, 0));
+  EXPECT_EQ(jpeg.AsRGB(), nullptr);
+  EXPECT_EQ(jpeg.Pyramid(1), nullptr);
+}
+
+TEST(AlgoRequestTests, DirtyRegions) {
+  AlgoRequest request;
+  ASSERT_EQ(request.AddImage(ImageFormat::YUV420, 64, 32,
+                             std::vector<unsigned char>(64 * 32 * 3 / 2)),
+            0);
+  // Untracked until the request enters a pipeline
+  EXPECT_TRUE(request.GetDirtyRegion(0).all);
+
+  request.ResetDirtyRegions();
+  EXPECT_FALSE(request.GetDirtyRegion(0).all);
+  EXPECT_TRUE(request.GetDirtyRegion(0).rects.empty());
+  EXPECT_TRUE(request.GetDirtyRegion(1).all);
+
+  // Clipped to the image, empty and contained rects dropped
+  request.MarkDirty(0, DirtyRect{-4, 20, 10, 20});
+  request.MarkDirty(0, DirtyRect{0, 0, 0, 8});
+  request.MarkDirty(0, DirtyRect{1, 22, 2, 2});
+  auto region = request.GetDirtyRegion(0);
+  ASSERT_EQ(region.rects.size(), 1u);
+  EXPECT_EQ(region.rects[0].x, 0);
+  EXPECT_EQ(region.rects[0].y, 20);
+  EXPECT_EQ(region.rects[0].width, 6);
+  EXPECT_EQ(region.rects[0].height, 12);
+
+  // Too many rects collapse into their bounds
+  for (int i = 0; i < 10; i++) {
+    request.MarkDirty(0, DirtyRect{10 + 4 * i, i, 2, 2});
+  }
+  region = request.GetDirtyRegion(0);
+  ASSERT_LE(region.rects.size(), 8u);
+  auto bounds = region.Bounds();
+  EXPECT_EQ(bounds.x, 0);
+  EXPECT_EQ(bounds.y, 0);
+  EXPECT_EQ(bounds.width, 48);
+  EXPECT_EQ(bounds.height, 32);
+
+  request.MarkDirty(0);
+  EXPECT_TRUE(request.GetDirtyRegion(0).all);
+  EXPECT_TRUE(request.GetDirtyRegion(0).rects.empty());
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+#include "../Utils/include/BilateralGrid.h"
+
+// Step from 60 to 180 at the middle column with +-8 noise
+static std::vector<unsigned char> NoisyStep(int width, int height) {
+  std::vector<unsigned char> plane(static_cast<size_t>(width) * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const int base = x < width / 2 ? 60 : 180;
+      plane[static_cast<size_t>(y) * width + x] =
+          static_cast<unsigned char>(base + (rand() % 17) - 8);
+    }
+  }
+  return plane;
+}
+
+// Sum of squared differences to the noise free step
+static double StepError(const std::vector<unsigned char>& plane, int width,
+                        int height) {
+  double error = 0.0;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const int d = plane[static_cast<size_t>(y) * width + x] -
+                    (x < width / 2 ? 60 : 180);
+      error += d * d;
+    }
+  }
+  return error;
+}
+
+TEST(BilateralGridTest, FlatStaysFlat) {
+  const int width  = 75;
+  const int height = 41;
+  std::vector<unsigned char> src(width * height, 97);
+  std::vector<unsigned char> dst(src.size(), 0);
+  BilateralFilterPlane(src.data(), dst.data(), width, height, width, 1, 6.0f,
+                       12.0f);
+  EXPECT_EQ(dst, src);
+
+  BilateralGrid grid;
+  BilateralInitGrid(grid, width, height, 6.0f, 12.0f);
+  EXPECT_EQ(grid.cellSize, 6);
+  EXPECT_EQ(grid.width, 75 / 6 + 1 + 1 + 2 * BILATERAL_GRID_PAD);
+  EXPECT_EQ(grid.depth, 22 + 1 + 2 * BILATERAL_GRID_PAD);
+}
+
+TEST(BilateralGridTest, SmoothsNoiseKeepsEdges) {
+  const int width  = 128;
+  const int height = 96;
+  srand(7);
+  const auto src = NoisyStep(width, height);
+  std::vector<unsigned char> dst(src.size(), 0);
+  BilateralFilterPlane(src.data(), dst.data(), width, height, width, 1, 4.0f,
+                       16.0f);
+  EXPECT_LT(StepError(dst, width, height), StepError(src, width, height) / 4);
+  // The columns either side of the step keep their level
+  for (int y = 0; y < height; y++) {
+    const unsigned char* row = &dst[static_cast<size_t>(y) * width];
+    EXPECT_NEAR(row[width / 2 - 1], 60, 8) << y;
+    EXPECT_NEAR(row[width / 2], 180, 8) << y;
+  }
+
+  // In place gives the same
+  std::vector<unsigned char> inPlace = src;
+  BilateralFilterPlane(inPlace.data(), inPlace.data(), width, height, width,
+                       1, 4.0f, 16.0f);
+  EXPECT_EQ(inPlace, dst);
+}
+
+TEST(BilateralGridTest, InterleavedMatchesPlanar) {
+  const int width  = 66;
+  const int height = 35;
+  const int stride = width * 3 + 5;
+  std::vector<unsigned char> packed(static_cast<size_t>(stride) * height);
+  for (auto& value : packed) {
+    value = static_cast<unsigned char>(rand() & 0xff);
+  }
+  std::vector<unsigned char> out = packed;
+  for (int c = 0; c < 3; c++) {
+    BilateralFilterPlane(&packed[c], &out[c], width, height, stride, 3, 3.0f,
+                         24.0f);
+  }
+  for (int c = 0; c < 3; c++) {
+    std::vector<unsigned char> plane(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        plane[y * width + x] = packed[y * stride + 3 * x + c];
+      }
+    }
+    std::vector<unsigned char> filtered(plane.size());
+    BilateralFilterPlane(plane.data(), filtered.data(), width, height, width,
+                         1, 3.0f, 24.0f);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        ASSERT_EQ(out[y * stride + 3 * x + c], filtered[y * width + x])
+            << c << ":" << x << "," << y;
+      }
+    }
+  }
+}
+
+TEST(BilateralGridTest, FullHdReducesNoise) {
+  const int width  = 1920;
+  const int height = 1080;
+  const auto src   = NoisyStep(width, height);
+  std::vector<unsigned char> dst(src.size());
+  BilateralFilterPlane(src.data(), dst.data(), width, height, width, 1, 8.0f,
+                       16.0f);
+  EXPECT_LT(StepError(dst, width, height), StepError(src, width, height));
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "../include/ChangeDetector.h"
+
+namespace {
+const int kWidth  = 64;
+const int kHeight = 48;
+
+// Request with a YUV420 ramp, stream 0 unless given
+std::shared_ptr<AlgoRequest> MakeFrame(std::vector<unsigned char> data,
+                                       int streamId = 0) {
+  auto req       = std::make_shared<AlgoRequest>();
+  req->mStreamId = streamId;
+  req->AddImage(ImageFormat::YUV420, kWidth, kHeight, std::move(data));
+  return req;
+}
+
+std::vector<unsigned char> Ramp() {
+  std::vector<unsigned char> data(kWidth * kHeight * 3 / 2, 128);
+  for (int i = 0; i < kWidth * kHeight; i++) {
+    data[i] = static_cast<unsigned char>(i * 7);
+  }
+  return data;
+}
+}  // namespace
+
+TEST(ChangeDetectorTest, MarksChangedBlocks) {
+  ChangeDetectorConfig config;
+  config.blockSize = 16;
+  ChangeDetector detector(config);
+
+  auto first = MakeFrame(Ramp());
+  ASSERT_EQ(detector.Detect(first), 0);
+  ASSERT_NE(first->mDirtyBlocks, nullptr);
+  EXPECT_EQ(first->mDirtyBlocks->blocksX, 4);
+  EXPECT_EQ(first->mDirtyBlocks->blocksY, 3);
+  EXPECT_EQ(first->mDirtyBlocks->prevFrame, 0u);
+  EXPECT_EQ(first->mDirtyBlocks->GetDirtyCount(), 12u);
+
+  auto same = MakeFrame(Ramp());
+  ASSERT_EQ(detector.Detect(same), 0);
+  EXPECT_EQ(same->mDirtyBlocks->prevFrame, first->mDirtyBlocks->frame);
+  EXPECT_EQ(same->mDirtyBlocks->GetDirtyCount(), 0u);
+
+  // One luma pixel in block (2, 1), one V sample in block (0, 2)
+  auto data = Ramp();
+  data[20 * kWidth + 40] ^= 1;
+  data[kWidth * kHeight * 5 / 4 + 17 * (kWidth / 2) + 3] ^= 1;
+  auto changed = MakeFrame(data);
+  ASSERT_EQ(detector.Detect(changed), 0);
+  EXPECT_EQ(changed->mDirtyBlocks->GetDirtyCount(), 2u);
+  EXPECT_TRUE(changed->mDirtyBlocks->IsDirty(2, 1));
+  EXPECT_TRUE(changed->mDirtyBlocks->IsDirty(0, 2));
+
+  // Other streams keep their own previous frame
+  auto other = MakeFrame(Ramp(), 1);
+  ASSERT_EQ(detector.Detect(other), 0);
+  EXPECT_EQ(other->mDirtyBlocks->GetDirtyCount(), 12u);
+}
+
+TEST(ChangeDetectorTest, ThresholdToleratesNoise) {
+  ChangeDetectorConfig config;
+  config.blockSize = 16;
+  config.threshold = 1;
+  ChangeDetector detector(config);
+  ASSERT_EQ(detector.Detect(MakeFrame(Ramp())), 0);
+
+  auto data = Ramp();
+  data[5 * kWidth + 5] ^= 1;
+  for (int i = 0; i < 16; i++) {
+    data[40 * kWidth + 48 + i] ^= 0xff;
+  }
+  auto noisy = MakeFrame(data);
+  ASSERT_EQ(detector.Detect(noisy), 0);
+  EXPECT_EQ(noisy->mDirtyBlocks->GetDirtyCount(), 1u);
+  EXPECT_TRUE(noisy->mDirtyBlocks->IsDirty(3, 2));
+
+  // Unsupported formats carry no mask
+  auto jpeg = std::make_shared<AlgoRequest>();
+  jpeg->AddImage(ImageFormat::JPEG, 8, 8, std::vector<unsigned char>(10, 0));
+  EXPECT_EQ(detector.Detect(jpeg), -2);
+  EXPECT_EQ(jpeg->mDirtyBlocks, nullptr);
+}
+
+TEST(ChangeDetectorTest, DilateCoversHalo) {
+  DirtyBlockMask mask;
+  mask.blockSize = 16;
+  mask.blocksX   = 5;
+  mask.blocksY   = 4;
+  mask.dirty.assign(20, 0);
+  mask.dirty[1 * 5 + 2] = 1;
+  mask.Dilate(1);
+  EXPECT_EQ(mask.GetDirtyCount(), 9u);
+  EXPECT_TRUE(mask.IsDirty(1, 0));
+  EXPECT_TRUE(mask.IsDirty(3, 2));
+  EXPECT_FALSE(mask.IsDirty(4, 1));
+  mask.Dilate(17);
+  EXPECT_EQ(mask.GetDirtyCount(), 20u);
+}
@@ -13,6 +13,7 @@ class ConfigParserTest : public ::testing::Test {
     configFile << "key4=[10,12,13]\n";
     configFile << "key5=[10.5,12.5,13.5]\n";
     configFile << "key6=[\"Alice\", \"Bob\", \"Charlie\"]\n";
+    configFile << "key7=-0.125\n";
     configFile.close();
   }
 
@@ -41,6 +42,16 @@ TEST_F(ConfigParserTest, TestLoadFile) {
   EXPECT_EQ(parser.getValue("key6"), "Alice,Bob,Charlie");
 }
 
+// Test float conversion and its error codes
+TEST_F(ConfigParserTest, TestGetFloatValue) {
+  ConfigParser parser = loadConfig();
+  EXPECT_FLOAT_EQ(parser.getFloatValue("key7"), -0.125f);
+  EXPECT_FLOAT_EQ(parser.getFloatValue("key2"), 42.0f);
+  EXPECT_EQ(parser.getErrorCode(), 0);
+  EXPECT_FLOAT_EQ(parser.getFloatValue("key1"), 0.0f);
+  EXPECT_EQ(parser.getErrorCode(), 4);
+}
+
 // Test when retrieving a non-existing key
 TEST_F(ConfigParserTest, TestGetValueNonExistingKey) {
   ConfigParser parser = loadConfig();
@@ -80,7 +91,8 @@ std::string ConfigList[] = {
     "BokehAlgorithm.config",         "FilterAlgorithm.config",
     "HdrAlgorithm.config",           "LdcAlgorithm.config",
     "MandelbrotSetAlgorithm.config", "NopAlgorithm.config",
-    "WaterMarkAlgorithm.config"};
+    "WaterMarkAlgorithm.config",     "SwJpegDecAlgorithm.config",
+    "ScalerAlgorithm.config",        "RotateAlgorithm.config"};
 
 TEST_F(ConfigParserTest, TestAllConfigFiles) {
   for (auto config : ConfigList) {
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "../Utils/include/ColorConvert.h"
+#include "FormatPlanner.h"
+
+namespace {
+std::vector<unsigned char> Noise(size_t size, uint32_t state) {
+  std::vector<unsigned char> data(size);
+  for (auto& value : data) {
+    state = state * 1103515245u + 12345u;
+    value = static_cast<unsigned char>(state >> 16);
+  }
+  return data;
+}
+
+std::shared_ptr<ImageData> MakeImage(ImageFormat format, int width,
+                                     int height, size_t size) {
+  auto image = std::make_shared<ImageData>(format, width, height);
+  image->SetData(Noise(size, width * 31 + height));
+  return image;
+}
+}  // namespace
+
+TEST(FormatPlannerTest, KernelsMatchNaive) {
+  for (int width : {2, 8, 30, 64, 102}) {
+    const auto y = Noise(width, 1);
+    const auto u = Noise(width / 2, 2);
+    const auto v = Noise(width / 2, 3);
+    std::vector<unsigned char> rgb(width * 3);
+    YuvToRgbRow(y.data(), u.data(), v.data(), rgb.data(), width);
+    for (int x = 0; x < width; x++) {
+      const int c = y[x] - 16;
+      const int d = u[x / 2] - 128;
+      const int e = v[x / 2] - 128;
+      const int r = std::clamp((298 * c + 409 * e + 128) >> 8, 0, 255);
+      const int g =
+          std::clamp((298 * c - 100 * d - 208 * e + 128) >> 8, 0, 255);
+      const int b = std::clamp((298 * c + 516 * d + 128) >> 8, 0, 255);
+      ASSERT_EQ(rgb[3 * x], r) << width << ":" << x;
+      ASSERT_EQ(rgb[3 * x + 1], g) << width << ":" << x;
+      ASSERT_EQ(rgb[3 * x + 2], b) << width << ":" << x;
+    }
+
+    std::vector<unsigned char> pairs(width * 2);
+    std::vector<unsigned char> a(width);
+    std::vector<unsigned char> b(width);
+    InterleavePlanes(y.data(), rgb.data(), pairs.data(), width);
+    for (int x = 0; x < width; x++) {
+      ASSERT_EQ(pairs[2 * x], y[x]);
+      ASSERT_EQ(pairs[2 * x + 1], rgb[x]);
+    }
+    SwapPairs(pairs.data(), pairs.data(), width);
+    DeinterleavePlanes(pairs.data(), b.data(), a.data(), width);
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), y.begin()));
+    EXPECT_TRUE(std::equal(b.begin(), b.end(), rgb.begin()));
+  }
+}
+
+TEST(FormatPlannerTest, ConvertImageRoundTrips) {
+  const int width   = 66;
+  const int height  = 34;
+  const size_t luma = width * height;
+
+  auto i420 = MakeImage(ImageFormat::YUV420, width, height, luma * 3 / 2);
+
+  // Chroma repacking is lossless in any order
+  auto nv12 = ConvertImage(*i420, ImageFormat::NV12);
+  ASSERT_NE(nv12, nullptr);
+  auto nv21 = ConvertImage(*nv12, ImageFormat::NV21);
+  ASSERT_NE(nv21, nullptr);
+  auto back = ConvertImage(*nv21, ImageFormat::YUV420);
+  ASSERT_NE(back, nullptr);
+  EXPECT_EQ(back->GetData(), i420->GetData());
+  EXPECT_EQ(nv12->GetData()[luma], i420->GetData()[luma]);
+  EXPECT_EQ(nv21->GetData()[luma], i420->GetData()[luma + luma / 4]);
+
+  // Every 4:2:0 layout gives the same RGB
+  auto rgb = ConvertImage(*i420, ImageFormat::RGB);
+  ASSERT_NE(rgb, nullptr);
+  ASSERT_EQ(rgb->GetDataSize(), luma * 3);
+  EXPECT_EQ(ConvertImage(*nv12, ImageFormat::RGB)->GetData(), rgb->GetData());
+  EXPECT_EQ(ConvertImage(*nv21, ImageFormat::RGB)->GetData(), rgb->GetData());
+
+  // A flat RGB image survives the trip through YUV within rounding
+  auto flat = std::make_shared<ImageData>(ImageFormat::RGB, width, height);
+  std::vector<unsigned char> pixels(luma * 3);
+  for (size_t i = 0; i < luma; i++) {
+    pixels[3 * i]     = 200;
+    pixels[3 * i + 1] = 90;
+    pixels[3 * i + 2] = 30;
+  }
+  flat->SetData(std::vector<unsigned char>(pixels));
+  for (auto format :
+       {ImageFormat::YUV420, ImageFormat::NV12, ImageFormat::NV21}) {
+    auto yuv = ConvertImage(*flat, format);
+    ASSERT_NE(yuv, nullptr);
+    auto trip = ConvertImage(*yuv, ImageFormat::RGB);
+    ASSERT_NE(trip, nullptr);
+    for (size_t i = 0; i < pixels.size(); i++) {
+      ASSERT_LE(std::abs(trip->GetData()[i] - pixels[i]), 3) << i;
+    }
+  }
+
+  auto gray = ConvertImage(*nv21, ImageFormat::GRAYSCALE);
+  ASSERT_NE(gray, nullptr);
+  EXPECT_TRUE(std::equal(gray->GetData().begin(), gray->GetData().end(),
+                         i420->GetData().begin()));
+  auto grayYuv = ConvertImage(*gray, ImageFormat::NV12);
+  ASSERT_NE(grayYuv, nullptr);
+  EXPECT_EQ(grayYuv->GetData()[luma], 128);
+
+  // Same format shares the buffer, impossible conversions fail
+  std::shared_ptr<const ImageData> source = i420;
+  std::shared_ptr<const ImageData> same =
+      ConvertImage(*source, ImageFormat::YUV420);
+  EXPECT_EQ(same->GetData().data(), source->GetData().data());
+  EXPECT_EQ(ConvertImage(*gray, ImageFormat::RGB), nullptr);
+  EXPECT_EQ(ConvertImage(*i420, ImageFormat::JPEG), nullptr);
+  auto odd = MakeImage(ImageFormat::YUV420, 5, 4, 30);
+  EXPECT_EQ(ConvertImage(*odd, ImageFormat::NV12), nullptr);
+}
+
+TEST(FormatPlannerTest, PicksCheapestPath) {
+  FormatPlanner planner;
+  const FormatMap nv12Only  = {{ImageFormat::NV12, ImageFormat::NV12}};
+  const FormatMap toRgb     = {{ImageFormat::YUV420, ImageFormat::RGB},
+                               {ImageFormat::NV12, ImageFormat::NV12}};
+  const FormatMap jpegOnly  = {{ImageFormat::JPEG, ImageFormat::YUV420}};
+  const FormatMap anyFormat = {};
+
+  // Keeping YUV420 at the first node would need an RGB to NV12 conversion
+  // later, converting to NV12 up front is cheaper
+  ASSERT_EQ(planner.Plan({anyFormat, toRgb, nv12Only}), 0);
+  ASSERT_EQ(planner.GetNodeCount(), 3u);
+  auto steps = planner.Trace(ImageFormat::YUV420);
+  ASSERT_EQ(steps.size(), 3u);
+  EXPECT_EQ(steps[0].fed, ImageFormat::YUV420);
+  EXPECT_EQ(steps[1].fed, ImageFormat::NV12);
+  EXPECT_EQ(steps[2].fed, ImageFormat::NV12);
+  EXPECT_FLOAT_EQ(planner.GetCost(ImageFormat::YUV420),
+                  FormatConversionCost(ImageFormat::YUV420,
+                                       ImageFormat::NV12));
+  EXPECT_EQ(planner.GetConversions(1).at(ImageFormat::YUV420),
+            ImageFormat::NV12);
+  EXPECT_TRUE(planner.GetConversions(0).empty());
+  EXPECT_EQ(planner.GetCost(ImageFormat::NV12), 0.0f);
+
+  // A node that cannot take the format converts it, equal costs convert
+  // as late as possible
+  ASSERT_EQ(planner.Plan({toRgb, nv12Only}), 0);
+  steps = planner.Trace(ImageFormat::NV21);
+  EXPECT_EQ(steps[0].fed, ImageFormat::NV12);
+  ASSERT_EQ(planner.Plan({anyFormat, nv12Only}), 0);
+  steps = planner.Trace(ImageFormat::NV21);
+  EXPECT_EQ(steps[0].fed, ImageFormat::NV21);
+  EXPECT_EQ(steps[1].fed, ImageFormat::NV12);
+
+  // A format with no way in passes through unconverted
+  ASSERT_EQ(planner.Plan({jpegOnly, nv12Only}), 0);
+  steps = planner.Trace(ImageFormat::YUV420);
+  EXPECT_FALSE(steps[0].supported);
+  EXPECT_EQ(steps[0].fed, ImageFormat::YUV420);
+  EXPECT_TRUE(steps[1].supported);
+  EXPECT_EQ(steps[1].fed, ImageFormat::NV12);
+  steps = planner.Trace(ImageFormat::JPEG);
+  EXPECT_EQ(steps[0].out, ImageFormat::YUV420);
+  EXPECT_EQ(steps[1].fed, ImageFormat::NV12);
+}
+
+TEST(FormatPlannerTest, PlanarRgbConversions) {
+  const int width   = 34;
+  const int height  = 18;
+  const size_t luma = width * height;
+
+  // Packed and planar RGB swap losslessly
+  auto rgb    = MakeImage(ImageFormat::RGB, width, height, luma * 3);
+  auto planar = ConvertImage(*rgb, ImageFormat::RGBP);
+  ASSERT_NE(planar, nullptr);
+  ASSERT_EQ(planar->GetDataSize(), luma * 3);
+  EXPECT_EQ(planar->GetData()[luma], rgb->GetData()[1]);
+  EXPECT_EQ(planar->GetData()[2 * luma + 1], rgb->GetData()[5]);
+  auto packed = ConvertImage(*planar, ImageFormat::RGB);
+  ASSERT_NE(packed, nullptr);
+  EXPECT_EQ(packed->GetData(), rgb->GetData());
+
+  // Every other conversion matches going through packed RGB
+  auto i420     = MakeImage(ImageFormat::YUV420, width, height, luma * 3 / 2);
+  auto fromYuv  = ConvertImage(*i420, ImageFormat::RGBP);
+  auto expected = ConvertImage(*ConvertImage(*i420, ImageFormat::RGB),
+                               ImageFormat::RGBP);
+  ASSERT_NE(fromYuv, nullptr);
+  EXPECT_EQ(fromYuv->GetData(), expected->GetData());
+  for (auto format : {ImageFormat::YUV420, ImageFormat::NV21,
+                      ImageFormat::GRAYSCALE}) {
+    auto direct = ConvertImage(*planar, format);
+    ASSERT_NE(direct, nullptr);
+    EXPECT_EQ(direct->GetData(), ConvertImage(*rgb, format)->GetData());
+  }
+  EXPECT_EQ(GetExternalFormat(ImageFormat::RGBP), ImageFormat::RGB);
+  EXPECT_EQ(GetExternalFormat(ImageFormat::NV12), ImageFormat::NV12);
+}
+
+TEST(FormatPlannerTest, PicksPlanarRgbForLongChains) {
+  FormatPlanner planner;
+  const FormatMap rgbNode = {{ImageFormat::RGB, ImageFormat::RGB},
+                             {ImageFormat::RGBP, ImageFormat::RGBP}};
+
+  // A single node does not pay the shuffle back
+  ASSERT_EQ(planner.Plan({rgbNode}), 0);
+  auto steps = planner.Trace(ImageFormat::RGB);
+  EXPECT_EQ(steps[0].fed, ImageFormat::RGB);
+  EXPECT_FLOAT_EQ(planner.GetCost(ImageFormat::RGB),
+                  FormatAccessCost(ImageFormat::RGB));
+
+  // Three nodes run planar and convert back at the end
+  ASSERT_EQ(planner.Plan({rgbNode, rgbNode, rgbNode}), 0);
+  steps = planner.Trace(ImageFormat::RGB);
+  ASSERT_EQ(steps.size(), 3u);
+  for (const auto& step : steps) {
+    EXPECT_EQ(step.fed, ImageFormat::RGBP);
+  }
+  EXPECT_FLOAT_EQ(planner.GetCost(ImageFormat::RGB),
+                  FormatConversionCost(ImageFormat::RGB, ImageFormat::RGBP) +
+                      FormatConversionCost(ImageFormat::RGBP,
+                                           ImageFormat::RGB));
+  EXPECT_EQ(planner.GetConversions(0).at(ImageFormat::RGB),
+            ImageFormat::RGBP);
+
+  // Layout never pays for a colour conversion, YUV stays YUV
+  FormatMap both = rgbNode;
+  both.push_back({ImageFormat::YUV420, ImageFormat::YUV420});
+  ASSERT_EQ(planner.Plan({both, both, both, both, both, both}), 0);
+  for (const auto& step : planner.Trace(ImageFormat::YUV420)) {
+    EXPECT_EQ(step.fed, ImageFormat::YUV420);
+  }
+  EXPECT_EQ(planner.Trace(ImageFormat::RGB)[0].fed, ImageFormat::RGBP);
+}
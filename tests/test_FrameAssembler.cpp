@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "../include/FrameAssembler.h"
+
+namespace {
+struct Collected {
+  std::vector<std::shared_ptr<AlgoRequest>> requests;
+  std::vector<std::vector<AlgoId>> algoLists;
+};
+
+void CollectRequest(void* pctx, std::shared_ptr<AlgoRequest> request,
+                    std::vector<AlgoId> algoList) {
+  auto collected = static_cast<Collected*>(pctx);
+  collected->requests.push_back(request);
+  collected->algoLists.push_back(algoList);
+}
+
+// Small YUV420 frame whose first byte tells the frames apart
+std::shared_ptr<ImageData> MakeFrame(unsigned char tag) {
+  auto frame = std::make_shared<ImageData>(ImageFormat::YUV420, 4, 4);
+  std::vector<unsigned char> data(4 * 4 * 3 / 2, 0);
+  data[0] = tag;
+  frame->SetData(std::move(data));
+  return frame;
+}
+}  // namespace
+
+TEST(FrameAssemblerTest, PairsStereoWithinTolerance) {
+  FrameAssemblerConfig config;
+  config.toleranceUs = 1000;
+  Collected collected;
+  FrameAssembler assembler(config, CollectRequest, &collected);
+
+  // Right view of the first pair arrives late, the third right view is
+  // too far off to match
+  ASSERT_EQ(assembler.SubmitFrame(0, 0, 0, MakeFrame(1), {ALGO_BOKEH}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(0, 33000, 0, MakeFrame(2), {ALGO_BOKEH}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(1, 33400, 0, MakeFrame(12), {ALGO_BOKEH}),
+            0);
+  ASSERT_EQ(assembler.SubmitFrame(1, 600, 0, MakeFrame(11), {ALGO_BOKEH}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(0, 66000, 0, MakeFrame(3), {ALGO_BOKEH}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(1, 68000, 0, MakeFrame(13), {ALGO_BOKEH}),
+            0);
+  EXPECT_EQ(assembler.SubmitFrame(2, 0, 0, MakeFrame(0), {ALGO_BOKEH}), -2);
+
+  ASSERT_EQ(collected.requests.size(), 2u);
+  EXPECT_EQ(collected.requests[0]->GetImage(0)->GetData()[0], 2);
+  EXPECT_EQ(collected.requests[0]->GetImage(1)->GetData()[0], 12);
+  EXPECT_EQ(collected.requests[1]->GetImage(0)->GetData()[0], 1);
+  EXPECT_EQ(collected.requests[1]->GetImage(1)->GetData()[0], 11);
+  EXPECT_EQ(collected.algoLists[0], std::vector<AlgoId>{ALGO_BOKEH});
+  EXPECT_EQ(assembler.GetPendingFrames(), 2u);
+
+  assembler.Flush();
+  EXPECT_EQ(collected.requests.size(), 2u);
+  EXPECT_EQ(assembler.GetPendingFrames(), 0u);
+  EXPECT_EQ(assembler.GetDroppedFrames(), 2u);
+}
+
+TEST(FrameAssemblerTest, UnmatchedFramesExpire) {
+  FrameAssemblerConfig config;
+  config.maxWaitUs  = 50000;
+  config.maxPending = 2;
+  Collected collected;
+  FrameAssembler assembler(config, CollectRequest, &collected);
+
+  // Left stream only, frames age out by timestamp and by count
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(assembler.SubmitFrame(0, i * 10000, 0, MakeFrame(i), {ALGO_NOP}),
+              0);
+  }
+  EXPECT_EQ(assembler.GetPendingFrames(), 2u);
+  ASSERT_EQ(assembler.SubmitFrame(0, 100000, 0, MakeFrame(9), {ALGO_NOP}), 0);
+  EXPECT_EQ(assembler.GetPendingFrames(), 1u);
+  EXPECT_EQ(assembler.GetDroppedFrames(), 4u);
+  EXPECT_TRUE(collected.requests.empty());
+}
+
+TEST(FrameAssemblerTest, GroupsBurstsByKey) {
+  FrameAssemblerConfig config;
+  config.mode       = AssemblyMode::BURST;
+  config.burstCount = 3;
+  config.dropPolicy = AssemblyDropPolicy::EMIT_PARTIAL;
+  Collected collected;
+  FrameAssembler assembler(config, CollectRequest, &collected);
+
+  // Two interleaved bursts, exposures of burst 7 arrive out of order
+  auto frame = MakeFrame(72);
+  const unsigned char* pixels = frame->GetData().data();
+  ASSERT_EQ(assembler.SubmitFrame(0, 2000, 7, frame, {ALGO_HDR}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(0, 3000, 8, MakeFrame(80), {ALGO_HDR}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(0, 1000, 7, MakeFrame(71), {ALGO_HDR}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(0, 4000, 8, MakeFrame(81), {ALGO_HDR}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(0, 3000, 7, MakeFrame(73), {ALGO_HDR}), 0);
+
+  ASSERT_EQ(collected.requests.size(), 1u);
+  auto burst = collected.requests[0];
+  ASSERT_EQ(burst->GetImageCount(), 3u);
+  EXPECT_EQ(burst->GetImage(0)->GetData()[0], 71);
+  EXPECT_EQ(burst->GetImage(1)->GetData()[0], 72);
+  EXPECT_EQ(burst->GetImage(2)->GetData()[0], 73);
+  // Frames are moved into the request, not copied
+  EXPECT_EQ(burst->GetImage(1)->GetData().data(), pixels);
+
+  // Incomplete burst is processed with what arrived
+  assembler.Flush();
+  ASSERT_EQ(collected.requests.size(), 2u);
+  EXPECT_EQ(collected.requests[1]->GetImageCount(), 2u);
+  EXPECT_EQ(assembler.GetAssembledCount(), 2u);
+  EXPECT_EQ(assembler.GetDroppedFrames(), 0u);
+}
+
+TEST(FrameAssemblerTest, KeepsSettingsAndUniqueIds) {
+  Collected collected;
+  auto settings        = std::make_shared<AlgoRequest>();
+  settings->mRequestId = 900;
+  settings->mMetadata.SetMetadata(MetaId::ALGO_BOKEH_ENABLED, 1);
+  {
+    FrameAssembler assembler(FrameAssemblerConfig(), CollectRequest,
+                             &collected);
+    ASSERT_EQ(
+        assembler.SubmitFrame(0, 0, 0, MakeFrame(1), {ALGO_BOKEH}, settings),
+        0);
+    ASSERT_EQ(
+        assembler.SubmitFrame(1, 0, 0, MakeFrame(2), {ALGO_BOKEH}, settings),
+        0);
+    ASSERT_EQ(assembler.SubmitFrame(0, 33000, 0, MakeFrame(3), {ALGO_BOKEH}),
+              0);
+    ASSERT_EQ(assembler.SubmitFrame(1, 33000, 0, MakeFrame(4), {ALGO_BOKEH}),
+              0);
+  }
+  // A new assembler does not hand out the ids of the last one again
+  FrameAssembler assembler(FrameAssemblerConfig(), CollectRequest, &collected);
+  ASSERT_EQ(assembler.SubmitFrame(0, 0, 0, MakeFrame(5), {ALGO_BOKEH}), 0);
+  ASSERT_EQ(assembler.SubmitFrame(1, 0, 0, MakeFrame(6), {ALGO_BOKEH}), 0);
+
+  ASSERT_EQ(collected.requests.size(), 3u);
+  EXPECT_EQ(collected.requests[0], settings);
+  EXPECT_EQ(settings->GetImageCount(), 2u);
+  int enabled = 0;
+  EXPECT_EQ(settings->mMetadata.GetMetadata(MetaId::ALGO_BOKEH_ENABLED,
+                                            enabled),
+            0);
+  EXPECT_EQ(enabled, 1);
+  int width = 0;
+  settings->mMetadata.GetMetadata(MetaId::IMAGE_WIDTH, width);
+  EXPECT_EQ(width, 4);
+  EXPECT_NE(collected.requests[1]->mRequestId,
+            collected.requests[2]->mRequestId);
+}
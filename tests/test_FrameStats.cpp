@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <tuple>
+#include <vector>
+#include "FrameStats.h"
+
+namespace {
+std::vector<unsigned char> Noise(size_t size, uint32_t state) {
+  std::vector<unsigned char> data(size);
+  for (auto& value : data) {
+    state = state * 1103515245u + 12345u;
+    value = static_cast<unsigned char>(state >> 16);
+  }
+  return data;
+}
+
+// Plain per pixel statistics of a luma plane
+FrameStats NaiveStats(const unsigned char* luma, int width, int height,
+                      int blockSize) {
+  FrameStats stats;
+  stats.blockSize = blockSize;
+  stats.blocksX   = (width + blockSize - 1) / blockSize;
+  stats.blocksY   = (height + blockSize - 1) / blockSize;
+  stats.histogram.assign(256, 0);
+  std::vector<int64_t> sums(stats.blocksX * stats.blocksY, 0);
+  std::vector<int64_t> counts(sums.size(), 0);
+  int64_t total = 0;
+  stats.min     = 255;
+  stats.max     = 0;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const int value = luma[y * width + x];
+      const int block = (y / blockSize) * stats.blocksX + x / blockSize;
+      stats.histogram[value]++;
+      stats.min = std::min(stats.min, value);
+      stats.max = std::max(stats.max, value);
+      sums[block] += value;
+      counts[block]++;
+      total += value;
+    }
+  }
+  stats.mean =
+      static_cast<float>(static_cast<double>(total) / (width * height));
+  for (size_t i = 0; i < sums.size(); i++) {
+    stats.blockMeans.push_back(
+        static_cast<int32_t>((sums[i] + counts[i] / 2) / counts[i]));
+  }
+  return stats;
+}
+
+void ExpectEqualStats(const FrameStats& a, const FrameStats& b) {
+  EXPECT_EQ(a.blockSize, b.blockSize);
+  EXPECT_EQ(a.blocksX, b.blocksX);
+  EXPECT_EQ(a.blocksY, b.blocksY);
+  EXPECT_EQ(a.min, b.min);
+  EXPECT_EQ(a.max, b.max);
+  EXPECT_FLOAT_EQ(a.mean, b.mean);
+  EXPECT_EQ(a.histogram, b.histogram);
+  EXPECT_EQ(a.blockMeans, b.blockMeans);
+}
+}  // namespace
+
+TEST(FrameStatsTest, MatchesNaive) {
+  for (auto [width, height, blockSize] :
+       {std::make_tuple(64, 48, 16), std::make_tuple(70, 34, 32),
+        std::make_tuple(6, 4, 5), std::make_tuple(102, 66, 7)}) {
+    const size_t luma = width * height;
+    auto data         = Noise(luma * 3 / 2, width * 7 + blockSize);
+    // Keep the range off the ends so min and max are found, not clamped
+    for (size_t i = 0; i < luma; i++) {
+      data[i] = static_cast<unsigned char>(20 + data[i] % 200);
+    }
+    ImageData image(ImageFormat::NV12, width, height);
+    image.SetData(std::vector<unsigned char>(data));
+
+    FrameStats stats;
+    ASSERT_EQ(ComputeFrameStats(image, blockSize, stats), 0);
+    ExpectEqualStats(stats, NaiveStats(data.data(), width, height, blockSize));
+  }
+
+  // RGB is measured on its luma
+  ImageData rgb(ImageFormat::RGB, 40, 30);
+  rgb.SetData(Noise(40 * 30 * 3, 5));
+  FrameStats stats;
+  ASSERT_EQ(ComputeFrameStats(rgb, 8, stats), 0);
+  auto luma = rgb.Luma();
+  ASSERT_NE(luma, nullptr);
+  ExpectEqualStats(stats, NaiveStats(luma->GetData().data(), 40, 30, 8));
+
+  ImageData jpeg(ImageFormat::JPEG, 40, 30);
+  jpeg.SetData(Noise(100, 6));
+  EXPECT_EQ(ComputeFrameStats(jpeg, 8, stats), -1);
+  EXPECT_EQ(ComputeFrameStats(rgb, 0, stats), -1);
+}
+
+TEST(FrameStatsTest, MetadataRoundTrip) {
+  ImageData image(ImageFormat::GRAYSCALE, 33, 17);
+  image.SetData(Noise(33 * 17, 9));
+  FrameStats stats;
+  ASSERT_EQ(ComputeFrameStats(image, 16, stats), 0);
+
+  AlgoMetadata metadata;
+  FrameStats read;
+  EXPECT_EQ(GetFrameStats(metadata, read), -1);
+  SetFrameStats(stats, metadata);
+  ASSERT_EQ(GetFrameStats(metadata, read), 0);
+  ExpectEqualStats(read, stats);
+  EXPECT_EQ(read.blocksY, 2);
+
+  // Survives serialization, as for cached results
+  AlgoMetadata copy;
+  ASSERT_EQ(copy.Deserialize(metadata.Serialize()), 0);
+  ASSERT_EQ(GetFrameStats(copy, read), 0);
+  ExpectEqualStats(read, stats);
+}
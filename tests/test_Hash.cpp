@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "../Utils/include/Hash.h"
+
+namespace {
+std::vector<unsigned char> Pattern(size_t size) {
+  std::vector<unsigned char> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<unsigned char>(i * 131 + 7);
+  }
+  return data;
+}
+}  // namespace
+
+// Reference values of the scalar build, every SIMD level must match them
+TEST(HashTest, KnownValues) {
+  const auto data = Pattern(4177);
+  EXPECT_EQ(Hash64(data.data(), 100), 0x9ddada11d3dc2d8fULL);
+  EXPECT_EQ(Hash64(data.data(), 1024), 0x1fc9b084c1cfe99cULL);
+  EXPECT_EQ(Hash64(data.data(), 4177), 0x5229d9f4b446051bULL);
+  EXPECT_EQ(Hash64(data.data(), 4177, 5), 0xf986a3221772ce63ULL);
+}
+
+TEST(HashTest, EveryByteCounts) {
+  auto data           = Pattern(3000);
+  const uint64_t hash = Hash64(data.data(), data.size());
+  // Positions in the first block, a partial stripe and the tail
+  for (size_t pos : {0ul, 63ul, 1023ul, 1024ul, 2900ul, 2999ul}) {
+    data[pos] ^= 1;
+    EXPECT_NE(Hash64(data.data(), data.size()), hash) << pos;
+    data[pos] ^= 1;
+  }
+  EXPECT_NE(Hash64(data.data(), data.size() - 1), hash);
+  EXPECT_NE(Hash64(data.data(), data.size(), 1), hash);
+}
+
+TEST(HashTest, UnalignedInput) {
+  const auto data = Pattern(5000);
+  for (size_t offset = 1; offset < 8; offset++) {
+    std::vector<unsigned char> copy(data.begin() + offset, data.end());
+    EXPECT_EQ(Hash64(data.data() + offset, copy.size()),
+              Hash64(copy.data(), copy.size()));
+  }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "../Utils/include/PixelKernels.h"
+
+namespace {
+// Counts calls so the tests can tell which path ran
+struct AddOp {
+  int calls = 0;
+  uint16_t operator()(uint16_t a, uint16_t b) {
+    calls++;
+    return static_cast<uint16_t>(a + b);
+  }
+};
+
+struct AddRowOp : AddOp {
+  // Vector body taking whole groups of 4 samples
+  int Row(int count, uint16_t* dst, const uint16_t* a, const uint16_t* b) {
+    const int body = count / 4 * 4;
+    for (int i = 0; i < body; i++) {
+      dst[i] = static_cast<uint16_t>(a[i] + b[i] + 1000);
+    }
+    return body;
+  }
+};
+
+// Sum of the 3x3 neighbourhood of a sample
+struct BoxSumOp {
+  static constexpr int kRadius = 1;
+  template <typename Step>
+  uint16_t operator()(const uint16_t* const* rows, int i, Step step) const {
+    int sum = 0;
+    for (int r = 0; r < 3; r++) {
+      sum += rows[r][i - step] + rows[r][i] + rows[r][i + step];
+    }
+    return static_cast<uint16_t>(sum);
+  }
+};
+}  // namespace
+
+TEST(PixelKernelsTest, FormatLayouts) {
+  const int width  = 36;
+  const int height = 20;
+  const size_t luma = width * height;
+  struct Expected {
+    ImageFormat format;
+    int planes;
+    size_t size;
+    size_t lastOffset;
+    int alignX;
+    int alignY;
+  };
+  const Expected cases[] = {
+      {ImageFormat::GRAYSCALE, 1, luma, 0, 1, 1},
+      {ImageFormat::RGB, 1, luma * 3, 0, 1, 1},
+      {ImageFormat::YUV420, 3, luma * 3 / 2, luma * 5 / 4, 2, 2},
+      {ImageFormat::YUV422, 3, luma * 2, luma * 3 / 2, 2, 1},
+      {ImageFormat::YUV444, 3, luma * 3, luma * 2, 1, 1},
+      {ImageFormat::NV12, 2, luma * 3 / 2, luma, 2, 2},
+      {ImageFormat::NV21, 2, luma * 3 / 2, luma, 2, 2},
+  };
+  for (const auto& expected : cases) {
+    bool called = false;
+    EXPECT_TRUE(DispatchFormat(expected.format, [&](auto layout) {
+      using Layout = decltype(layout);
+      called       = true;
+      EXPECT_EQ(Layout::kFormat, expected.format);
+      EXPECT_EQ(Layout::kPlanes, expected.planes);
+      EXPECT_EQ(Layout::Size(width, height), expected.size);
+      EXPECT_EQ(Layout::kAlignX, expected.alignX);
+      EXPECT_EQ(Layout::kAlignY, expected.alignY);
+      size_t offset = 0;
+      ForEachPlane<Layout>([&](auto plane) {
+        constexpr int p = decltype(plane)::value;
+        offset          = Layout::template Offset<p>(width, height);
+      });
+      EXPECT_EQ(offset, expected.lastOffset);
+    }));
+    EXPECT_TRUE(called);
+  }
+  EXPECT_FALSE(DispatchFormat(ImageFormat::JPEG, [](auto) { FAIL(); }));
+  static_assert(FormatLayout<ImageFormat::NV12>::Plane<1>::kChannels == 2,
+                "NV12 chroma interleaves U and V");
+}
+
+TEST(PixelKernelsTest, PointwiseRowUsesRowKernel) {
+  using Plane16 = PlaneLayout<uint16_t, 2>;
+  const int count = Plane16::RowSamples(7);
+  ASSERT_EQ(count, 14);
+  EXPECT_EQ(Plane16::RowSize(7), 28u);
+  std::vector<uint16_t> a(count), b(count), dst(count);
+  for (int i = 0; i < count; i++) {
+    a[i] = static_cast<uint16_t>(i * 300);
+    b[i] = static_cast<uint16_t>(i);
+  }
+
+  AddOp scalar;
+  PointwiseRow(scalar, count, dst.data(), a.data(), b.data());
+  EXPECT_EQ(scalar.calls, count);
+  for (int i = 0; i < count; i++) {
+    EXPECT_EQ(dst[i], i * 301);
+  }
+
+  // The row kernel takes 12 samples, op() the last 2
+  AddRowOp vector;
+  PointwiseRow(vector, count, dst.data(), a.data(), b.data());
+  EXPECT_EQ(vector.calls, 2);
+  EXPECT_EQ(dst[11], 11 * 301 + 1000);
+  EXPECT_EQ(dst[12], 12 * 301);
+}
+
+TEST(PixelKernelsTest, NeighbourhoodRowStepsByChannels) {
+  const int width = 6;
+  const int cn    = 3;
+  std::vector<uint16_t> frame(width * 3 * cn);
+  for (size_t i = 0; i < frame.size(); i++) {
+    frame[i] = static_cast<uint16_t>(i);
+  }
+  const uint16_t* rows[3] = {&frame[0], &frame[width * cn],
+                             &frame[2 * width * cn]};
+  std::vector<uint16_t> dst(width * cn, 0);
+  BoxSumOp op;
+  NeighbourhoodRow<cn>(op, rows, dst.data(), 1, width - 1);
+  for (int x = 0; x < width; x++) {
+    for (int c = 0; c < cn; c++) {
+      int expected = 0;
+      if (x > 0 && x < width - 1) {
+        for (int r = 0; r < 3; r++) {
+          for (int dx = -1; dx <= 1; dx++) {
+            expected += frame[(r * width + x + dx) * cn + c];
+          }
+        }
+      }
+      EXPECT_EQ(dst[x * cn + c], expected) << x << "," << c;
+    }
+  }
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+#include "../include/ResultCache.h"
+
+namespace {
+// Request holding one YUV420 frame filled with value
+std::shared_ptr<AlgoRequest> MakeRequest(unsigned char value, int frameNo) {
+  auto req = std::make_shared<AlgoRequest>();
+  std::vector<unsigned char> data(16 * 16 * 3 / 2, value);
+  req->AddImage(ImageFormat::YUV420, 16, 16, std::move(data));
+  req->mRequestId = frameNo;
+  req->mMetadata.SetMetadata(MetaId::ALGO_REQUSET_NUMBER, frameNo);
+  req->mMetadata.SetMetadata(MetaId::ALGO_FILTER_ENABLED, true);
+  return req;
+}
+
+// Bytes one MakeRequest output takes in the cache, metadata included
+size_t EntryBytes() {
+  ResultCache cache(ResultCacheConfig{});
+  cache.Store(1, MakeRequest(0, 0));
+  return cache.GetMemoryUsage();
+}
+}  // namespace
+
+TEST(ResultCacheTest, KeyIgnoresVolatileMetadata) {
+  ResultCacheConfig config;
+  ResultCache cache(config);
+  const std::vector<AlgoId> algos = {ALGO_FILTER};
+
+  uint64_t key = cache.GetKey(MakeRequest(7, 1), algos);
+  EXPECT_NE(key, 0u);
+  EXPECT_EQ(cache.GetKey(MakeRequest(7, 2), algos), key);
+  EXPECT_NE(cache.GetKey(MakeRequest(8, 1), algos), key);
+  EXPECT_NE(cache.GetKey(MakeRequest(7, 1), {ALGO_FILTER, ALGO_NOP}), key);
+
+  auto req = MakeRequest(7, 1);
+  req->mMetadata.SetMetadata(MetaId::IMAGE_BRIGHTNESS, 3);
+  EXPECT_NE(cache.GetKey(req, algos), key);
+}
+
+TEST(ResultCacheTest, HitSharesOutputCopyOnWrite) {
+  ResultCacheConfig config;
+  ResultCache cache(config);
+  auto output = MakeRequest(42, 1);
+  output->mMetadata.SetMetadata(MetaId::ALGO_PROCESS_DONE, 0x10);
+  cache.Store(1234, output);
+
+  auto req = MakeRequest(0, 9);
+  EXPECT_FALSE(cache.Lookup(99, req));
+  ASSERT_TRUE(cache.Lookup(1234, req));
+  EXPECT_EQ(cache.GetHitCount(), 1u);
+  EXPECT_EQ(cache.GetMissCount(), 1u);
+
+  int done = 0, frameNo = 0;
+  EXPECT_EQ(req->mMetadata.GetMetadata(MetaId::ALGO_PROCESS_DONE, done), 0);
+  EXPECT_EQ(done, 0x10);
+  EXPECT_EQ(req->mMetadata.GetMetadata(MetaId::ALGO_REQUSET_NUMBER, frameNo),
+            0);
+  EXPECT_EQ(frameNo, 9);
+
+  // Both read the same buffer until the request writes to its image
+  const ImageData& hit    = *req->GetImage(0);
+  const ImageData& stored = *output->GetImage(0);
+  EXPECT_EQ(hit.GetData().data(), stored.GetData().data());
+  req->GetImage(0)->GetData()[0] = 1;
+
+  auto again = MakeRequest(0, 10);
+  ASSERT_TRUE(cache.Lookup(1234, again));
+  EXPECT_EQ(again->GetImage(0)->GetData()[0], 42);
+  EXPECT_EQ(req->GetImage(0)->GetData()[0], 1);
+}
+
+TEST(ResultCacheTest, EvictsLeastRecentlyUsed) {
+  ResultCacheConfig config;
+  config.memoryBudget = EntryBytes() * 2;
+  ResultCache cache(config);
+
+  cache.Store(1, MakeRequest(1, 0));
+  cache.Store(2, MakeRequest(2, 0));
+  ASSERT_TRUE(cache.Lookup(1, MakeRequest(0, 0)));
+  cache.Store(3, MakeRequest(3, 0));
+
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_LE(cache.GetMemoryUsage(), config.memoryBudget);
+  EXPECT_TRUE(cache.Lookup(1, MakeRequest(0, 0)));
+  EXPECT_FALSE(cache.Lookup(2, MakeRequest(0, 0)));
+  EXPECT_TRUE(cache.Lookup(3, MakeRequest(0, 0)));
+}
+
+TEST(ResultCacheTest, SpillsToDiskAndPromotes) {
+  char dir[] = "/tmp/gzero_cache_XXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  ResultCacheConfig config;
+  config.memoryBudget = EntryBytes();
+  config.diskPath     = dir;
+  {
+    ResultCache cache(config);
+    cache.Store(1, MakeRequest(1, 0));
+    cache.Store(2, MakeRequest(2, 0));
+    EXPECT_EQ(cache.GetEntryCount(), 2u);
+    EXPECT_GT(cache.GetDiskUsage(), 0u);
+
+    // Entry 1 comes back from disk and pushes entry 2 out
+    auto req = MakeRequest(0, 0);
+    ASSERT_TRUE(cache.Lookup(1, req));
+    EXPECT_EQ(req->GetImage(0)->GetData()[0], 1);
+    EXPECT_EQ(req->GetImage(0)->GetDataSize(), 16u * 16 * 3 / 2);
+    ASSERT_TRUE(cache.Lookup(2, req));
+    EXPECT_EQ(req->GetImage(0)->GetData()[0], 2);
+  }
+  // Spilled files go with the cache
+  EXPECT_EQ(rmdir(dir), 0);
+}
+
+TEST(ResultCacheTest, SpillsFromThreads) {
+  char dir[] = "/tmp/gzero_cache_XXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  ResultCacheConfig config;
+  config.memoryBudget = EntryBytes();
+  config.diskBudget   = EntryBytes() * 4;
+  config.diskPath     = dir;
+  {
+    ResultCache cache(config);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+      threads.emplace_back([&cache, t]() {
+        for (int i = 0; i < 50; i++) {
+          const uint64_t key = 1 + (i + t) % 6;
+          auto req           = MakeRequest(0, 0);
+          if (cache.Lookup(key, req)) {
+            const ImageData& image = *req->GetImage(0);
+            EXPECT_EQ(image.GetData()[0], key);
+          } else {
+            cache.Store(key, MakeRequest(static_cast<unsigned char>(key), 0));
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    EXPECT_LE(cache.GetMemoryUsage(), config.memoryBudget);
+    EXPECT_LE(cache.GetDiskUsage(), config.diskBudget);
+  }
+  // No file outlives the entries that were indexed
+  EXPECT_EQ(rmdir(dir), 0);
+}
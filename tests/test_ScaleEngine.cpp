@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "../Utils/include/ScaleEngine.h"
+
+namespace {
+std::vector<unsigned char> Noise(size_t size) {
+  std::vector<unsigned char> data(size);
+  uint32_t state = 7;
+  for (auto& value : data) {
+    state = state * 1103515245u + 12345u;
+    value = static_cast<unsigned char>(state >> 16);
+  }
+  return data;
+}
+
+std::vector<unsigned char> Scale(const std::vector<unsigned char>& src,
+                                 int width, int height, int cn, int outWidth,
+                                 int outHeight, ScaleMode mode) {
+  ScaleAxis xAxis, yAxis;
+  ScaleInitAxis(xAxis, width, outWidth, mode);
+  ScaleInitAxis(yAxis, height, outHeight, mode);
+  std::vector<unsigned char> dst(outWidth * outHeight * cn);
+  ScalePlane(src.data(), width, height, width * cn, cn,
+             {{&xAxis, &yAxis, dst.data(), outWidth * cn}});
+  return dst;
+}
+}  // namespace
+
+TEST(ScaleEngineTest, IdentityAndConstant) {
+  const auto noise = Noise(97 * 61 * 3);
+  const std::vector<unsigned char> flat(97 * 61, 77);
+  for (auto mode : {ScaleMode::BILINEAR, ScaleMode::AREA, ScaleMode::LANCZOS}) {
+    EXPECT_EQ(Scale(noise, 97, 61, 3, 97, 61, mode), noise);
+    for (auto [w, h] : {std::make_pair(20, 13), std::make_pair(300, 200)}) {
+      const auto out = Scale(flat, 97, 61, 1, w, h, mode);
+      EXPECT_EQ(out, std::vector<unsigned char>(w * h, 77));
+    }
+  }
+}
+
+TEST(ScaleEngineTest, AreaHalvesAverage) {
+  const int width  = 64;
+  const int height = 32;
+  const auto src   = Noise(width * height);
+  const auto dst =
+      Scale(src, width, height, 1, width / 2, height / 2, ScaleMode::AREA);
+  for (int y = 0; y < height / 2; y++) {
+    for (int x = 0; x < width / 2; x++) {
+      const unsigned char* s = &src[2 * y * width + 2 * x];
+      const int sum          = s[0] + s[1] + s[width] + s[width + 1];
+      ASSERT_EQ(dst[y * width / 2 + x], (sum + 2) / 4) << x << "," << y;
+    }
+  }
+}
+
+// One pass to several sizes gives what separate passes give
+TEST(ScaleEngineTest, MultipleTargets) {
+  const int width  = 200;
+  const int height = 150;
+  const auto src   = Noise(width * height);
+  ScaleAxis axes[4];
+  ScaleInitAxis(axes[0], width, 50, ScaleMode::LANCZOS);
+  ScaleInitAxis(axes[1], height, 37, ScaleMode::LANCZOS);
+  ScaleInitAxis(axes[2], width, 333, ScaleMode::LANCZOS);
+  ScaleInitAxis(axes[3], height, 250, ScaleMode::LANCZOS);
+  std::vector<unsigned char> small(50 * 37), large(333 * 250);
+  ScalePlane(src.data(), width, height, width, 1,
+             {{&axes[0], &axes[1], small.data(), 50},
+              {&axes[2], &axes[3], large.data(), 333}});
+  EXPECT_EQ(small, Scale(src, width, height, 1, 50, 37, ScaleMode::LANCZOS));
+  EXPECT_EQ(large, Scale(src, width, height, 1, 333, 250, ScaleMode::LANCZOS));
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../Utils/include/TileExecutor.h"
+
+TEST(TileExecutorTest, RunsEveryTileOnce) {
+  TileExecutor executor(3);
+  std::vector<std::atomic<int>> hits(257);
+  for (auto& hit : hits) {
+    hit = 0;
+  }
+  executor.Run(static_cast<int>(hits.size()), [&](int tile) { hits[tile]++; });
+  for (auto& hit : hits) {
+    ASSERT_EQ(hit.load(), 1);
+  }
+  EXPECT_EQ(executor.GetConcurrency(), 4);
+}
+
+TEST(TileExecutorTest, ReusedAcrossRuns) {
+  TileExecutor executor(2);
+  std::atomic<int> total(0);
+  for (int run = 0; run < 100; run++) {
+    executor.Run(run % 7, [&](int) { total++; });
+  }
+  int expected = 0;
+  for (int run = 0; run < 100; run++) {
+    expected += run % 7;
+  }
+  EXPECT_EQ(total.load(), expected);
+}
+
+TEST(TileExecutorTest, NestedAndConcurrentRunsComplete) {
+  TileExecutor executor(2);
+  std::atomic<int> total(0);
+  auto job = [&]() {
+    executor.Run(8, [&](int) {
+      // Nested run executes inline on the worker
+      executor.Run(4, [&](int) { total++; });
+    });
+  };
+  std::thread other(job);
+  job();
+  other.join();
+  EXPECT_EQ(total.load(), 2 * 8 * 4);
+}
+
+TEST(TileExecutorTest, WithoutWorkersRunsInline) {
+  TileExecutor executor(0);
+  std::vector<int> order;
+  executor.Run(5, [&](int tile) { order.push_back(tile); });
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2, 3, 4}));
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "FormatPlanner.h"
+#include "TiledImage.h"
+
+namespace {
+std::vector<unsigned char> Noise(size_t size, uint32_t state) {
+  std::vector<unsigned char> data(size);
+  for (auto& value : data) {
+    state = state * 1103515245u + 12345u;
+    value = static_cast<unsigned char>(state >> 16);
+  }
+  return data;
+}
+
+std::string TempPath() {
+  char path[] = "/tmp/gzero_tiled_XXXXXX";
+  int fd      = mkstemp(path);
+  if (fd >= 0) {
+    close(fd);
+  }
+  return path;
+}
+}  // namespace
+
+TEST(TiledImageTest, RoundTripsEveryFormat) {
+  const int width  = 34;
+  const int height = 46;
+  for (ImageFormat format :
+       {ImageFormat::YUV420, ImageFormat::NV12, ImageFormat::NV21,
+        ImageFormat::RGB, ImageFormat::RGBP}) {
+    const std::string path = TempPath();
+    auto tiled = TiledImage::Create(path, format, width, height, 8);
+    ASSERT_NE(tiled, nullptr) << GetFormatName(format);
+    EXPECT_EQ(tiled->GetTileCount(), 6);
+
+    ImageData image(format, width, height);
+    image.SetData(Noise(GetStripeSize(format, width, 0, height), 5));
+    ASSERT_EQ(tiled->WriteImage(image), 0);
+    auto read = tiled->ReadImage();
+    ASSERT_NE(read, nullptr);
+    EXPECT_EQ(read->GetData(), image.GetData()) << GetFormatName(format);
+
+    // Rows across tiles read as the same rows of the frame
+    std::vector<unsigned char> buffer;
+    ImageStripe rows;
+    ASSERT_EQ(tiled->ReadRows(6, 30, buffer, rows), 0);
+    auto* frame = const_cast<unsigned char*>(image.GetData().data());
+    ImageStripe expected =
+        MapFrameStripe(format, width, height, frame, 6, 30);
+    for (int p = 0; p < rows.planes; p++) {
+      for (int y = rows.PlaneBegin(p); y < rows.PlaneEnd(p); y++) {
+        ASSERT_EQ(0, memcmp(rows.Row(p, y), expected.Row(p, y),
+                            rows.stride[p]))
+            << GetFormatName(format) << " plane " << p << " row " << y;
+      }
+    }
+    EXPECT_NE(tiled->ReadRows(5, 30, buffer, rows), 0);
+    EXPECT_NE(tiled->ReadRows(0, height + 2, buffer, rows), 0);
+    tiled.reset();
+    unlink(path.c_str());
+  }
+}
+
+TEST(TiledImageTest, ReopensAndRejects) {
+  const std::string path = TempPath();
+  EXPECT_EQ(TiledImage::Create(path, ImageFormat::YUV420, 33, 32), nullptr);
+  EXPECT_EQ(TiledImage::Create(path, ImageFormat::YUV420, 32, 32, 7),
+            nullptr);
+  EXPECT_EQ(TiledImage::Open(path), nullptr);
+
+  ImageData image(ImageFormat::NV12, 64, 40);
+  image.SetData(Noise(64 * 40 * 3 / 2, 9));
+  {
+    auto tiled = TiledImage::Create(path, ImageFormat::NV12, 64, 40, 16);
+    ASSERT_NE(tiled, nullptr);
+    ASSERT_EQ(tiled->WriteImage(image), 0);
+    ImageData other(ImageFormat::NV12, 32, 40);
+    EXPECT_NE(tiled->WriteImage(other), 0);
+  }
+  auto tiled = TiledImage::Open(path);
+  ASSERT_NE(tiled, nullptr);
+  EXPECT_EQ(tiled->GetFormat(), ImageFormat::NV12);
+  EXPECT_EQ(tiled->GetWidth(), 64);
+  EXPECT_EQ(tiled->GetHeight(), 40);
+  EXPECT_EQ(tiled->GetTileRows(), 16);
+  auto read = tiled->ReadImage();
+  ASSERT_NE(read, nullptr);
+  EXPECT_EQ(read->GetData(), image.GetData());
+  tiled.reset();
+  unlink(path.c_str());
+}
+
+TEST(TiledImageTest, CacheBoundsMappedTiles) {
+  const std::string path = TempPath();
+  const int before       = TiledImage::GetMappedTiles();
+  {
+    auto tiled = TiledImage::Create(path, ImageFormat::YUV420, 64, 256, 8);
+    ASSERT_NE(tiled, nullptr);
+    tiled->SetCacheTiles(3);
+    EXPECT_EQ(tiled->GetCacheTiles(), 3u);
+    for (int i = 0; i < tiled->GetTileCount(); i++) {
+      auto tile = tiled->AcquireTile(i);
+      ASSERT_NE(tile, nullptr);
+      EXPECT_EQ(tile->rows.rowBegin, i * 8);
+      tile->rows.Row(0, tile->rows.rowBegin)[0] = static_cast<uint8_t>(i);
+      EXPECT_LE(TiledImage::GetMappedTiles() - before, 3);
+    }
+    // A held tile outlives its eviction
+    auto held = tiled->AcquireTile(0);
+    tiled->SetCacheTiles(0);
+    EXPECT_EQ(TiledImage::GetMappedTiles() - before, 1);
+    EXPECT_EQ(tiled->AcquireTile(7)->rows.Row(0, 56)[0], 7);
+    EXPECT_EQ(tiled->AcquireTile(32), nullptr);
+    held.reset();
+    EXPECT_EQ(TiledImage::GetMappedTiles(), before);
+  }
+  unlink(path.c_str());
+}
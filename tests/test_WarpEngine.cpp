@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) [2025] [Uma Mahesh B]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "../Utils/include/WarpEngine.h"
+
+static std::vector<unsigned char> RandomPlane(int width, int height, int cn) {
+  std::vector<unsigned char> plane(static_cast<size_t>(width) * height * cn);
+  for (auto& value : plane) {
+    value = static_cast<unsigned char>(rand() & 0xff);
+  }
+  return plane;
+}
+
+static void ZoomMatrix(double matrix[9], int width, int height, double scale,
+                       double angle) {
+  // Output to source: rotate and scale about the image centre
+  const double c  = std::cos(angle) / scale;
+  const double s  = std::sin(angle) / scale;
+  const double cx = width * 0.5;
+  const double cy = height * 0.5;
+  matrix[0]       = c;
+  matrix[1]       = s;
+  matrix[2]       = cx - c * cx - s * cy;
+  matrix[3]       = -s;
+  matrix[4]       = c;
+  matrix[5]       = cy + s * cx - c * cy;
+  matrix[6]       = 1e-5;
+  matrix[7]       = -2e-5;
+  matrix[8]       = 1.0;
+}
+
+static void PerspectiveMap(WarpMap& map, int width, int height,
+                           const double m[9]) {
+  WarpInitMap(map, width, height);
+  // Same evaluation order as WarpPerspective so positions match bit for bit
+  for (int y = 0; y < height; y++) {
+    const double rowX = m[1] * y + m[2];
+    const double rowY = m[4] * y + m[5];
+    const double rowW = m[7] * y + m[8];
+    for (int x = 0; x < width; x++) {
+      const double ox   = x;
+      const double invW = 1.0 / (m[6] * ox + rowW);
+      WarpSetEntry(map, x, y, (m[0] * ox + rowX) * invW,
+                   (m[3] * ox + rowY) * invW);
+    }
+  }
+  WarpBuildTiles(map);
+}
+
+TEST(WarpEngineTest, IdentityMapCopies) {
+  const int width = 131, height = 67;
+  for (int cn : {1, 3}) {
+    WarpMap map;
+    WarpInitMap(map, width, height);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        WarpSetEntry(map, x, y, x, y);
+      }
+    }
+    WarpBuildTiles(map);
+    const auto input = RandomPlane(width, height, cn);
+    std::vector<unsigned char> output(input.size());
+    const unsigned char* src = input.data();
+    unsigned char* dst       = output.data();
+    WarpRemap(map, &src, &dst, 1, cn, 0);
+    EXPECT_EQ(input, output) << "cn=" << cn;
+  }
+}
+
+TEST(WarpEngineTest, HalfPixelShiftAverages) {
+  const int width = 64, height = 8;
+  WarpMap map;
+  WarpInitMap(map, width, height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      WarpSetEntry(map, x, y, x + 0.5, y);
+    }
+  }
+  const auto input = RandomPlane(width, height, 1);
+  std::vector<unsigned char> output(input.size());
+  const unsigned char* src = input.data();
+  unsigned char* dst       = output.data();
+  WarpRemap(map, &src, &dst, 1, 1, 0);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width - 1; x++) {
+      const int i = y * width + x;
+      ASSERT_EQ(output[i], (input[i] + input[i + 1] + 1) / 2);
+    }
+    // Right tap falls outside and reads the border
+    const int last = y * width + width - 1;
+    ASSERT_EQ(output[last], (input[last] + 1) / 2);
+  }
+}
+
+TEST(WarpEngineTest, MatchesReferenceWithBorders) {
+  const int width = 97, height = 53;
+  WarpMap map;
+  WarpInitMap(map, width, height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      WarpSetEntry(map, x, y, (rand() % ((width + 6) * 100)) / 100.0 - 3.0,
+                   (rand() % ((height + 6) * 100)) / 100.0 - 3.0);
+    }
+  }
+  WarpBuildTiles(map);
+  const unsigned char border = 77;
+  const auto input           = RandomPlane(width, height, 1);
+  std::vector<unsigned char> output(input.size());
+  const unsigned char* src = input.data();
+  unsigned char* dst       = output.data();
+  WarpRemap(map, &src, &dst, 1, 1, border);
+
+  auto pixel = [&](int x, int y) -> int {
+    if (x < 0 || y < 0 || x >= width || y >= height) {
+      return border;
+    }
+    return input[y * width + x];
+  };
+  for (int i = 0; i < width * height; i++) {
+    const int sx = map.xy[2 * i];
+    const int sy = map.xy[2 * i + 1];
+    const int fx = map.frac[i] & (WARP_MAP_SCALE - 1);
+    const int fy = map.frac[i] >> WARP_MAP_BITS;
+    const int expected =
+        (pixel(sx, sy) * (WARP_MAP_SCALE - fx) * (WARP_MAP_SCALE - fy) +
+         pixel(sx + 1, sy) * fx * (WARP_MAP_SCALE - fy) +
+         pixel(sx, sy + 1) * (WARP_MAP_SCALE - fx) * fy +
+         pixel(sx + 1, sy + 1) * fx * fy + (1 << (WARP_COEF_BITS - 1))) >>
+        WARP_COEF_BITS;
+    ASSERT_EQ(output[i], expected) << "i=" << i;
+  }
+}
+
+TEST(WarpEngineTest, TilesCoverOutputOnce) {
+  const int width = 1000, height = 300;
+  double matrix[9];
+  ZoomMatrix(matrix, width, height, 0.5, 0.3);
+  WarpMap map;
+  PerspectiveMap(map, width, height, matrix);
+  std::vector<int> covered(static_cast<size_t>(width) * height, 0);
+  for (const auto& tile : map.tiles) {
+    for (int y = tile.y; y < tile.y + tile.height; y++) {
+      for (int x = tile.x; x < tile.x + tile.width; x++) {
+        covered[y * width + x]++;
+      }
+    }
+  }
+  for (int count : covered) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+TEST(WarpEngineTest, PerspectiveMatchesRemap) {
+  const int width = 320, height = 240;
+  double matrix[9];
+  ZoomMatrix(matrix, width, height, 1.3, 0.2);
+  WarpMap map;
+  PerspectiveMap(map, width, height, matrix);
+
+  for (int cn : {1, 3}) {
+    const auto input = RandomPlane(width, height, cn);
+    std::vector<unsigned char> remapped(input.size());
+    std::vector<unsigned char> warped(input.size());
+    const unsigned char* src = input.data();
+    unsigned char* dst       = remapped.data();
+    WarpRemap(map, &src, &dst, 1, cn, 16);
+    dst = warped.data();
+    WarpPerspective(&src, &dst, 1, width, height, cn, matrix, 16);
+    EXPECT_EQ(remapped, warped) << "cn=" << cn;
+  }
+}
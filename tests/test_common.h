@@ -40,9 +40,13 @@ typedef int (*DeInit)(void**);
 typedef int (*Process)(void**, std::shared_ptr<AlgoRequest>,
                        std::vector<AlgoId>);
 typedef int (*Callback)(void**, int (*)(std::shared_ptr<AlgoRequest>));
+typedef int (*SubmitFrame)(void**, int, int64_t, int,
+                           std::shared_ptr<ImageData>, std::vector<AlgoId>,
+                           std::shared_ptr<AlgoRequest>);
 
 const std::string ALGOLIBPATH     = "/home/uma/workspace/Gzero/build/lib/";
 const std::string ALGOLIBNAME     = "libAlgoLib.so";
 const std::string FULLALGOLIBPATH = ALGOLIBPATH + ALGOLIBNAME;
+const std::string RESPATH         = "/home/uma/workspace/Gzero/res/";
 
 #endif  // TEST_COMMON_H
\ No newline at end of file